@@ -395,6 +395,8 @@ read: action [
 		index [number!]
 	/string {Convert UTF and line terminators to standard text string}
 	/lines {Convert to block of strings (implies /string)}
+	/map {Map file data into memory, not copied (read-only until changed)}
+	/deep {For a directory, read all subdirectories too, with size and date of each file}
 ;	/as {Convert to string using a specified encoding}
 ;		encoding [none! number!] {UTF number (0 8 16 -16)}
 ]
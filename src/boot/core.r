@@ -27,6 +27,11 @@ words: [
 	pub-key		;public key
 	g			;generator
 	pkcs1		;padding type
+	aes-gcm				;AEAD cipher
+	chacha20-poly1305	;AEAD cipher
+	curve		;elliptic curve
+	x25519		;curve
+	secp256r1	;curve
 ]
 
 init-words: command [
@@ -143,6 +148,29 @@ dh-compute-key: command [
     public-key [binary!] "Peer's public key"
 ]
 
+ecdh-make-key: func [
+	"Creates a key object for elliptic curve Diffie-Hellman algorithm."
+	curve [word!] "X25519 or SECP256R1"
+][
+	make object! compose [
+		priv-key:	;private key
+		pub-key:	;public key
+		none
+		curve: (to lit-word! curve)
+	]
+]
+
+ecdh-generate-key: command [
+    "Generates a new ECDH private/public key pair on the curve of the key object."
+    obj [object!] "The ECDH key object"
+]
+
+ecdh-compute-key: command [
+    "Computes the negotiated key from the private key and the peer's public key. Returns NONE if the peer's key is not valid."
+    obj [object!] "The ECDH key object"
+    public-key [binary!] "Peer's public key"
+]
+
 aes: command [
 	"Encrypt/decrypt data using AES algorithm. Returns stream cipher context handle or encrypted/decrypted data."
 	/key
@@ -153,3 +181,18 @@ aes: command [
 		data [binary! none!] "Data to encrypt/decrypt. Or NONE to close the cipher stream."
 	/decrypt "Use the crypt-key for decryption (default is to encrypt)"
 ]
+
+aead-key: command [
+	"Makes a cipher context handle for AEAD. Free it with AEAD (and NONE as nonce)."
+	method [word!] "AES-GCM or CHACHA20-POLY1305"
+	crypt-key [binary!] "Crypt key (16 or 32 bytes for AES-GCM, 32 bytes for CHACHA20-POLY1305)"
+]
+
+aead: command [
+	"Encrypt/decrypt a record using an AEAD cipher. Returns encrypted data with the tag at its tail, decrypted data, or NONE if the data is not authentic."
+	ctx [handle!] "Cipher context from AEAD-KEY."
+	nonce [binary! none!] "12 byte nonce (must not be used twice with a key). Or NONE to free the cipher context."
+	aad [binary!] "Additional data to authenticate (not encrypted)."
+	data [binary!] "Data to encrypt/decrypt."
+	/decrypt "Decrypt data (with the 16 byte tag at its tail)"
+]
@@ -20,3 +20,10 @@ group-execute
 world-read
 world-write
 world-execute
+sync
+sequential
+
+no-delay
+keep-alive
+fast-open
+reuse-port
@@ -206,11 +206,14 @@ map-each: native [
 	body [block!] {Block to evaluate each time}
 ]
 
-;replace-all: native [
-;	"Search and replace multiple values with a series; returns a new series."
-;	target [block! string! binary!]
-;	values [block!] "A block of [old new] search/replace pairs"
-;]
+replace-all: native [
+	{Replaces all occurrences of a value in a single pass. Used by REPLACE/all.}
+	target [any-string! binary! any-block!] "Series to replace within (modified)"
+	search "Value to be replaced (converted if necessary)"
+	replace "Value to replace with"
+	/case "Case-sensitive replacement"
+	/tail "Return target after the last replacement position"
+]
 
 quit: native [
 	{Stops evaluation and exits the interpreter.}
@@ -380,7 +383,7 @@ checksum: native [
 	/hash {Returns a hash value}
 	size [integer!] {Size of the hash table}
 	/method {Method to use}
-	word [word!] {Methods: SHA1 MD5 CRC32}
+	word [word!] {Methods: SHA1 SHA256 SHA384 SHA512 MD5 CRC32 CRC32C ADLER32}
 	/key {Returns keyed HMAC value}
 	key-value [any-string!] {Key to use}
 ]
@@ -390,6 +393,10 @@ compress: native [
 	data [binary! string!] {If string, it will be UTF8 encoded}
 	/part length {Length of data (elements)}
 	/gzip {Use GZIP checksum}
+	/level {Compression level}
+	lvl [integer!] {0 (none) to 9 (best), default 6}
+	/threads {Deflate blocks in parallel}
+	count [integer!] {Number of threads, 0 for one per CPU}
 ]
 
 decompress: native [
@@ -652,6 +659,7 @@ transcode: native [
 	/next "Translate next complete value (blocks as single value)"
 	/only "Translate only a single value (blocks dissected)"
 	/error "Do not cause errors - return error object as value in place"
+	/partial "Stop before a value cut off at the end (resume with more data)"
 ]
 
 echo: native [
@@ -939,7 +947,9 @@ do-codec: native [
 	{Evaluate a CODEC function to encode or decode media types.}
 	handle [handle!] "Internal link to codec"
 	action [word!] "Decode, encode, identify"
-	data [binary! image! string!]
+	data [binary! image! string! block! map! object! number! logic! none!]
+	/options "Codec specific options"
+	opts [object!]
 ]
 
 access-os: native [
@@ -225,6 +225,10 @@ standard: context [
 			none
 	]
 
+	port-spec-http-server: make port-spec-net [
+		max-body: none	; integer (default 16 MB): larger bodies are error 413
+	]
+
 	port-spec-serial: make port-spec-head [
 		speed: 115200
 		data-size: 8
@@ -236,6 +240,33 @@ standard: context [
 	port-spec-signal: make port-spec-head [
 		mask: [all]
 	]
+
+	port-spec-compress: make port-spec-head [
+		format: none	; zlib, deflate (raw) or gzip (inflate: none detects)
+		level: none		; 0 to 9 (deflate)
+		threads: none	; deflate blocks in parallel (0 for one per CPU)
+	]
+
+	port-spec-checksum: make port-spec-head [
+		method: none	; sha256, sha512, md5, crc32c, adler32... (default sha1)
+	]
+
+	port-spec-base: make port-spec-head [
+		base: none		; 64 (default), 16 or 2
+	]
+
+	port-spec-csv: make port-spec-head [
+		delimiter: none	; char (default comma)
+		quote: none		; char (default double quote)
+		infer: none		; true: numbers as integer! or decimal!, empty as none!
+		columns: none	; true: read gives columns (vector! for numbers)
+		encode: none	; true: write records, read gives CSV text
+	]
+
+	port-spec-process: make port-spec-head [
+		command: none	; command line string, block of program and args, or file
+		error: none		; string or binary for stderr output (else inherited)
+	]
 	
 	file-info: context [
 		name:
@@ -253,6 +284,18 @@ standard: context [
 			none
 	]
 
+	http-request: context [ ; (http-server port/locals)
+		method:		; word, e.g. GET
+		target:		; request target string, e.g. "/index.html?q=1"
+		version:	; 1.0 or 1.1
+		headers:	; block of field name and value strings
+		body:		; binary (at the body in port/data) or none
+		data:		; port/data buffer of the request
+		keep-alive:	; connection is persistent
+		error:		; HTTP status code for a bad request, or none
+			none
+	]
+
 	extension: context [
 		lib-base:	; handle to DLL
 		lib-file:	; file name loaded
@@ -144,9 +144,13 @@ shift
 
 ; Checksum
 sha1
+sha256
+sha384
+sha512
 md4
 md5
 crc32
+crc32c
 adler32
 
 ; Codec actions
@@ -166,6 +170,27 @@ udp
 clipboard
 serial
 signal
+process
+rope
+http-server
+deflate
+inflate
+checksum
+enbase
+debase
+json
+csv
+
+; Compression formats
+zlib
+gzip
+
+; CSV options
+delimiter
+
+; JSON events
+object
+array
 
 ; Serial parameters
 ; Parity
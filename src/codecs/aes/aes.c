@@ -352,6 +352,26 @@ void AES_cbc_decrypt(AES_CTX *ctx, const uint8_t *msg, uint8_t *out, int length)
     memcpy(ctx->iv, iv, AES_IV_SIZE);
 }
 
+/**
+ * Encrypt one block (16 bytes) with no chaining. Used for the counter
+ * mode of the GCM cipher (which never decrypts with the AES key).
+ */
+void AES_ecb_encrypt(const AES_CTX *ctx, const uint8_t *msg, uint8_t *out)
+{
+    int i;
+    uint32_t data[4], msg_32[4];
+
+    memcpy(msg_32, msg, AES_BLOCKSIZE);
+    for (i = 0; i < 4; i++)
+        data[i] = ntohl(msg_32[i]);
+
+    AES_encrypt(ctx, data);
+
+    for (i = 0; i < 4; i++)
+        msg_32[i] = htonl(data[i]);
+    memcpy(out, msg_32, AES_BLOCKSIZE);
+}
+
 /**
  * Encrypt a single block (16 bytes) of data
  */
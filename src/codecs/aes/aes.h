@@ -28,6 +28,9 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#ifndef AES_H
+#define AES_H
+
 #include <stdint.h>  // uint{8,16,32}_t
 
 /**************************************************************************
@@ -60,4 +63,7 @@ void AES_set_key(AES_CTX *ctx, const uint8_t *key,
 void AES_cbc_encrypt(AES_CTX *ctx, const uint8_t *msg,
 		uint8_t *out, int length);
 void AES_cbc_decrypt(AES_CTX *ks, const uint8_t *in, uint8_t *out, int length);
+void AES_ecb_encrypt(const AES_CTX *ctx, const uint8_t *msg, uint8_t *out);
 void AES_convert_key(AES_CTX *ctx);
+
+#endif
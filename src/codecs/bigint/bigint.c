@@ -46,6 +46,7 @@
  * - Karatsuba multiplication
  * - Squaring
  * - Sliding window exponentiation
+ * - Word level Montgomery exponentiation for odd moduli
  * - Chinese Remainder Theorem (implemented in rsa.c).
  *
  * All the algorithms used are pretty standard, and designed for different
@@ -81,7 +82,7 @@ static bigint *alloc(BI_CTX *ctx, int size);
 static bigint *trim(bigint *bi);
 static void more_comps(bigint *bi, int n);
 #if defined(CONFIG_BIGINT_KARATSUBA) || defined(CONFIG_BIGINT_BARRETT) || \
-    defined(CONFIG_BIGINT_MONTGOMERY)
+    defined(CONFIG_BIGINT_MONTGOMERY) || defined(CONFIG_BIGINT_MONT_EXP)
 static bigint *comp_right_shift(bigint *biR, int num_shifts);
 static bigint *comp_left_shift(bigint *biR, int num_shifts);
 #endif
@@ -556,7 +557,7 @@ static comp modular_inverse(bigint *bim)
 #endif
 
 #if defined(CONFIG_BIGINT_KARATSUBA) || defined(CONFIG_BIGINT_BARRETT) || \
-    defined(CONFIG_BIGINT_MONTGOMERY)
+    defined(CONFIG_BIGINT_MONTGOMERY) || defined(CONFIG_BIGINT_MONT_EXP)
 /**
  * Take each component and shift down (in terms of components)
  */
@@ -1333,6 +1334,166 @@ static void precompute_slide_window(BI_CTX *ctx, int window, bigint *g1)
 }
 #endif
 
+#ifdef CONFIG_BIGINT_MONT_EXP
+/*
+ * Montgomery product r = a*b/R mod m of n component numbers, using the
+ * CIOS method. t is scratch space of n+2 components. r may be a or b.
+ */
+static void mont_multiply(comp *r, const comp *a, const comp *b,
+        const comp *m, comp m0_dash, int n, comp *t)
+{
+    int i, j;
+    long_comp carry;
+    comp u;
+
+    memset(t, 0, (n+2)*COMP_BYTE_SIZE);
+
+    for (i = 0; i < n; i++)
+    {
+        /* t += a*b[i] */
+        carry = 0;
+        for (j = 0; j < n; j++)
+        {
+            carry += (long_comp)a[j]*b[i] + t[j];
+            t[j] = (comp)carry;
+            carry >>= COMP_BIT_SIZE;
+        }
+        carry += t[n];
+        t[n] = (comp)carry;
+        t[n+1] = (comp)(carry >> COMP_BIT_SIZE);
+
+        /* t = (t + u*m)/radix */
+        u = (comp)((long_comp)t[0]*m0_dash);
+        carry = ((long_comp)u*m[0] + t[0]) >> COMP_BIT_SIZE;
+        for (j = 1; j < n; j++)
+        {
+            carry += (long_comp)u*m[j] + t[j];
+            t[j-1] = (comp)carry;
+            carry >>= COMP_BIT_SIZE;
+        }
+        carry += t[n];
+        t[n-1] = (comp)carry;
+        t[n] = t[n+1] + (comp)(carry >> COMP_BIT_SIZE);
+    }
+
+    /* t < 2m, so one subtraction at most */
+    for (i = n-1; t[n] == 0 && i >= 0 && t[i] == m[i]; i--)
+        ;
+
+    if (t[n] || i < 0 || t[i] > m[i])
+    {
+        carry = 0;  /* the borrow */
+        for (j = 0; j < n; j++)
+        {
+            carry = (long_comp)t[j] - m[j] - carry;
+            t[j] = (comp)carry;
+            carry = (carry >> COMP_BIT_SIZE) & 1;
+        }
+    }
+
+    memcpy(r, t, n*COMP_BYTE_SIZE);
+}
+
+/*
+ * Copy a bigint (< m) to a zero padded array of n components.
+ */
+static void mont_import(comp *r, bigint *bi, int n)
+{
+    memset(r, 0, n*COMP_BYTE_SIZE);
+    memcpy(r, bi->comps, min(bi->size, n)*COMP_BYTE_SIZE);
+}
+
+/*
+ * Sliding-window exponentiation with all products done as Montgomery
+ * products of plain component arrays. This avoids the bigint allocations and
+ * the separate reductions of bi_residue(), and works for any base, so it can
+ * be used with CRT too. The modulus has to be odd.
+ */
+static bigint *mont_mod_power(BI_CTX *ctx, bigint *bi, bigint *biexp)
+{
+    bigint *bim = ctx->bi_mod[ctx->mod_offset];
+    int n = bim->size, i = find_max_exp_index(biexp), j, k;
+    int window_size = 1, part_exp;
+    comp *m, m0_dash, inv = bim->comps[0];
+    comp *g, *x2, *A, *t;
+    bigint *biR;
+
+    /* -1/m mod radix, by Newton's iteration (m[0]*m[0] = 1 mod 8) */
+    for (j = 0; j < 5; j++)
+    {
+        inv = (comp)(inv*(2 - (long_comp)bim->comps[0]*inv));
+    }
+
+    m0_dash = (comp)(0 - inv);
+
+    for (j = i; j > 32; j /= 5) /* work out an optimum size */
+        window_size++;
+
+    k = 1 << (window_size-1);
+    g = (comp *)malloc((k + 3)*n*COMP_BYTE_SIZE + (n+2)*COMP_BYTE_SIZE);
+    x2 = g + k*n;
+    A = x2 + n;
+    t = A + n;
+
+    /* g[0] = bi*R mod m, A = R mod m (Montgomery form of 1) */
+    bi = bi_mod(ctx, comp_left_shift(bi_mod(ctx, bi), n));
+    mont_import(g, bi, n);
+    bi_free(ctx, bi);
+    biR = bi_mod(ctx, comp_left_shift(int_to_bi(ctx, 1), n));
+    mont_import(A, biR, n);
+    bi_free(ctx, biR);
+
+    /* (bi_divide() may have reallocated the comps of the modulus) */
+    m = bim->comps;
+
+    /* g[j] = g^(2j+1) */
+    mont_multiply(x2, g, g, m, m0_dash, n, t);
+
+    for (j = 1; j < k; j++)
+    {
+        mont_multiply(g + j*n, g + (j-1)*n, x2, m, m0_dash, n, t);
+    }
+
+    while (i >= 0)
+    {
+        if (exp_bit_is_one(biexp, i))
+        {
+            int l = i-window_size+1;
+
+            if (l < 0)
+                l = 0;
+
+            while (exp_bit_is_one(biexp, l) == 0)
+                l++;
+
+            for (part_exp = 0, j = i; j >= l; j--)
+            {
+                mont_multiply(A, A, A, m, m0_dash, n, t);
+                part_exp = (part_exp << 1) | exp_bit_is_one(biexp, j);
+            }
+
+            mont_multiply(A, A, g + ((part_exp-1)/2)*n, m, m0_dash, n, t);
+            i = l-1;
+        }
+        else
+        {
+            mont_multiply(A, A, A, m, m0_dash, n, t);
+            i--;
+        }
+    }
+
+    /* convert back: A*1/R */
+    memset(x2, 0, n*COMP_BYTE_SIZE);
+    x2[0] = 1;
+    biR = alloc(ctx, n);
+    mont_multiply(biR->comps, A, x2, m, m0_dash, n, t);
+
+    free(g);
+    bi_free(ctx, biexp);
+    return trim(biR);
+}
+#endif
+
 /**
  * @brief Perform a modular exponentiation.
  *
@@ -1346,8 +1507,18 @@ static void precompute_slide_window(BI_CTX *ctx, int window, bigint *g1)
  */
 bigint *bi_mod_power(BI_CTX *ctx, bigint *bi, bigint *biexp)
 {
-    int i = find_max_exp_index(biexp), j, window_size = 1;
-    bigint *biR = int_to_bi(ctx, 1);
+    int i, j, window_size = 1;
+    bigint *biR;
+
+#ifdef CONFIG_BIGINT_MONT_EXP
+    if (ctx->bi_mod[ctx->mod_offset]->comps[0] & 1)
+    {
+        return mont_mod_power(ctx, bi, biexp);
+    }
+#endif
+
+    i = find_max_exp_index(biexp);
+    biR = int_to_bi(ctx, 1);
 
 #if defined(CONFIG_BIGINT_MONTGOMERY)
     uint8_t mod_offset = ctx->mod_offset;
@@ -1386,13 +1557,12 @@ bigint *bi_mod_power(BI_CTX *ctx, bigint *bi, bigint *biexp)
             int l = i-window_size+1;
             int part_exp = 0;
 
-            if (l < 0)  /* LSB of exponent will always be 1 */
+            if (l < 0)
                 l = 0;
-            else
-            {
-                while (exp_bit_is_one(biexp, l) == 0)
-                    l++;    /* go back up */
-            }
+
+            /* the window must end on a 1 bit (DH exponents may be even) */
+            while (exp_bit_is_one(biexp, l) == 0)
+                l++;    /* go back up */
 
             /* build up the section of the exponent */
             for (j = i; j >= l; j--)
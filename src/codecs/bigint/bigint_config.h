@@ -117,9 +117,17 @@
         It results in a considerable performance improvement with it enabled
         (it halves the decryption time) and so should be selected. 
 */
-//NOTE: the sliding window optimization doesn't work with Diffie-Hellman from some reason. Needs to be checked why --Cyphre
-//#define CONFIG_BIGINT_SLIDING_WINDOW 1
-#undef CONFIG_BIGINT_SLIDING_WINDOW
+#define CONFIG_BIGINT_SLIDING_WINDOW 1
+
+/*
+		CONFIG_BIGINT_MONT_EXP
+        Use Montgomery multiplication on the component arrays for modular
+        exponentiation with an odd modulus (RSA, Diffie-Hellman). It is done
+        without the bigint cache and without any division in the loop, and it
+        has no limitation on the base, so it is used with CRT too.
+        It is a few times faster than Barrett and should be selected.
+*/
+#define CONFIG_BIGINT_MONT_EXP 1
 
 /*
 		CONFIG_BIGINT_SQUARE
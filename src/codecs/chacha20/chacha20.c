@@ -0,0 +1,295 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************/
+
+/**
+ * ChaCha20-Poly1305 authenticated encryption (RFC 8439), as used by the
+ * TLS 1.2 cipher suites of RFC 7905. This is the fallback for CPUs that
+ * have no AES instructions: it is plain C, with no tables (so no cache
+ * timing), and the Poly1305 uses 26 bit limbs (no 128 bit multiply).
+ */
+
+#include <string.h>
+#include "chacha20.h"
+
+#define ROTL32(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+
+#define GET_U32_LE(b) \
+    ((uint32_t)(b)[0] | ((uint32_t)(b)[1] << 8) | \
+    ((uint32_t)(b)[2] << 16) | ((uint32_t)(b)[3] << 24))
+
+#define PUT_U32_LE(n, b) { \
+    (b)[0] = (uint8_t)(n); (b)[1] = (uint8_t)((n) >> 8); \
+    (b)[2] = (uint8_t)((n) >> 16); (b)[3] = (uint8_t)((n) >> 24); }
+
+#define QUARTER_ROUND(a, b, c, d) \
+    a += b; d ^= a; d = ROTL32(d, 16); \
+    c += d; b ^= c; b = ROTL32(b, 12); \
+    a += b; d ^= a; d = ROTL32(d, 8); \
+    c += d; b ^= c; b = ROTL32(b, 7)
+
+typedef struct
+{
+    uint32_t r[5];
+    uint32_t h[5];
+    uint32_t pad[4];
+} POLY1305_CTX;
+
+/**
+ * Set the 256 bit key.
+ */
+void ChaCha20_set_key(CHACHA20_CTX *ctx, const uint8_t *key)
+{
+    int i;
+
+    for (i = 0; i < 8; i++)
+        ctx->key[i] = GET_U32_LE(key + 4 * i);
+}
+
+/**
+ * Make one 64 byte block of key stream.
+ */
+static void chacha20_block(const CHACHA20_CTX *ctx, const uint8_t *nonce,
+        uint32_t counter, uint8_t *out)
+{
+    uint32_t s[16], x[16];
+    int i;
+
+    s[0] = 0x61707865;
+    s[1] = 0x3320646e;
+    s[2] = 0x79622d32;
+    s[3] = 0x6b206574;
+    for (i = 0; i < 8; i++)
+        s[4+i] = ctx->key[i];
+    s[12] = counter;
+    s[13] = GET_U32_LE(nonce);
+    s[14] = GET_U32_LE(nonce + 4);
+    s[15] = GET_U32_LE(nonce + 8);
+
+    memcpy(x, s, sizeof(x));
+
+    for (i = 0; i < 10; i++)
+    {
+        QUARTER_ROUND(x[0], x[4], x[8],  x[12]);
+        QUARTER_ROUND(x[1], x[5], x[9],  x[13]);
+        QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+        QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+        QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+        QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+        QUARTER_ROUND(x[2], x[7], x[8],  x[13]);
+        QUARTER_ROUND(x[3], x[4], x[9],  x[14]);
+    }
+
+    for (i = 0; i < 16; i++)
+    {
+        x[i] += s[i];
+        PUT_U32_LE(x[i], out + 4 * i);
+    }
+}
+
+/**
+ * XOR msg with the key stream, starting at block counter 1.
+ */
+static void chacha20_crypt(const CHACHA20_CTX *ctx, const uint8_t *nonce,
+        const uint8_t *msg, uint8_t *out, int length)
+{
+    uint8_t ks[64];
+    uint32_t counter = 1;
+    int i, n;
+
+    for (; length > 0; length -= 64, msg += 64, out += 64)
+    {
+        n = length < 64 ? length : 64;
+        chacha20_block(ctx, nonce, counter++, ks);
+        for (i = 0; i < n; i++)
+            out[i] = msg[i] ^ ks[i];
+    }
+}
+
+static void poly1305_init(POLY1305_CTX *ctx, const uint8_t *key)
+{
+    /* r is clamped as it is split into 26 bit limbs */
+    ctx->r[0] = (GET_U32_LE(key + 0)     ) & 0x3ffffff;
+    ctx->r[1] = (GET_U32_LE(key + 3) >> 2) & 0x3ffff03;
+    ctx->r[2] = (GET_U32_LE(key + 6) >> 4) & 0x3ffc0ff;
+    ctx->r[3] = (GET_U32_LE(key + 9) >> 6) & 0x3f03fff;
+    ctx->r[4] = (GET_U32_LE(key + 12) >> 8) & 0x00fffff;
+
+    memset(ctx->h, 0, sizeof(ctx->h));
+
+    ctx->pad[0] = GET_U32_LE(key + 16);
+    ctx->pad[1] = GET_U32_LE(key + 20);
+    ctx->pad[2] = GET_U32_LE(key + 24);
+    ctx->pad[3] = GET_U32_LE(key + 28);
+}
+
+/**
+ * Add data to the MAC, zero padded to 16 bytes (as the AEAD does).
+ */
+static void poly1305_update(POLY1305_CTX *ctx, const uint8_t *data, int length)
+{
+    const uint32_t r0 = ctx->r[0], r1 = ctx->r[1], r2 = ctx->r[2], r3 = ctx->r[3], r4 = ctx->r[4];
+    const uint32_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+    uint32_t h0 = ctx->h[0], h1 = ctx->h[1], h2 = ctx->h[2], h3 = ctx->h[3], h4 = ctx->h[4];
+    uint64_t d0, d1, d2, d3, d4;
+    uint32_t c;
+    uint8_t block[16];
+    const uint8_t *m;
+
+    for (; length > 0; length -= 16, data += 16)
+    {
+        m = data;
+        if (length < 16)
+        {
+            memset(block, 0, 16);
+            memcpy(block, data, length);
+            m = block;
+        }
+
+        h0 += (GET_U32_LE(m + 0)     ) & 0x3ffffff;
+        h1 += (GET_U32_LE(m + 3) >> 2) & 0x3ffffff;
+        h2 += (GET_U32_LE(m + 6) >> 4) & 0x3ffffff;
+        h3 += (GET_U32_LE(m + 9) >> 6) & 0x3ffffff;
+        h4 += (GET_U32_LE(m + 12) >> 8) | (1 << 24);
+
+        d0 = (uint64_t)h0 * r0 + (uint64_t)h1 * s4 + (uint64_t)h2 * s3 + (uint64_t)h3 * s2 + (uint64_t)h4 * s1;
+        d1 = (uint64_t)h0 * r1 + (uint64_t)h1 * r0 + (uint64_t)h2 * s4 + (uint64_t)h3 * s3 + (uint64_t)h4 * s2;
+        d2 = (uint64_t)h0 * r2 + (uint64_t)h1 * r1 + (uint64_t)h2 * r0 + (uint64_t)h3 * s4 + (uint64_t)h4 * s3;
+        d3 = (uint64_t)h0 * r3 + (uint64_t)h1 * r2 + (uint64_t)h2 * r1 + (uint64_t)h3 * r0 + (uint64_t)h4 * s4;
+        d4 = (uint64_t)h0 * r4 + (uint64_t)h1 * r3 + (uint64_t)h2 * r2 + (uint64_t)h3 * r1 + (uint64_t)h4 * r0;
+
+        c = (uint32_t)(d0 >> 26); h0 = (uint32_t)d0 & 0x3ffffff;
+        d1 += c; c = (uint32_t)(d1 >> 26); h1 = (uint32_t)d1 & 0x3ffffff;
+        d2 += c; c = (uint32_t)(d2 >> 26); h2 = (uint32_t)d2 & 0x3ffffff;
+        d3 += c; c = (uint32_t)(d3 >> 26); h3 = (uint32_t)d3 & 0x3ffffff;
+        d4 += c; c = (uint32_t)(d4 >> 26); h4 = (uint32_t)d4 & 0x3ffffff;
+        h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+        h1 += c;
+    }
+
+    ctx->h[0] = h0; ctx->h[1] = h1; ctx->h[2] = h2; ctx->h[3] = h3; ctx->h[4] = h4;
+}
+
+static void poly1305_finish(POLY1305_CTX *ctx, uint8_t *tag)
+{
+    uint32_t h0 = ctx->h[0], h1 = ctx->h[1], h2 = ctx->h[2], h3 = ctx->h[3], h4 = ctx->h[4];
+    uint32_t g0, g1, g2, g3, g4, c, mask;
+    uint64_t f;
+
+    /* fully carry h */
+    c = h1 >> 26; h1 &= 0x3ffffff;
+    h2 += c; c = h2 >> 26; h2 &= 0x3ffffff;
+    h3 += c; c = h3 >> 26; h3 &= 0x3ffffff;
+    h4 += c; c = h4 >> 26; h4 &= 0x3ffffff;
+    h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+    h1 += c;
+
+    /* g = h - p, used if h >= p (chosen without a branch) */
+    g0 = h0 + 5; c = g0 >> 26; g0 &= 0x3ffffff;
+    g1 = h1 + c; c = g1 >> 26; g1 &= 0x3ffffff;
+    g2 = h2 + c; c = g2 >> 26; g2 &= 0x3ffffff;
+    g3 = h3 + c; c = g3 >> 26; g3 &= 0x3ffffff;
+    g4 = h4 + c - (1 << 26);
+
+    mask = (g4 >> 31) - 1;
+    g0 &= mask; g1 &= mask; g2 &= mask; g3 &= mask; g4 &= mask;
+    mask = ~mask;
+    h0 = (h0 & mask) | g0;
+    h1 = (h1 & mask) | g1;
+    h2 = (h2 & mask) | g2;
+    h3 = (h3 & mask) | g3;
+    h4 = (h4 & mask) | g4;
+
+    /* h = (h + pad) mod 2^128 */
+    h0 = (h0      ) | (h1 << 26);
+    h1 = (h1 >>  6) | (h2 << 20);
+    h2 = (h2 >> 12) | (h3 << 14);
+    h3 = (h3 >> 18) | (h4 << 8);
+
+    f = (uint64_t)h0 + ctx->pad[0];             h0 = (uint32_t)f;
+    f = (uint64_t)h1 + ctx->pad[1] + (f >> 32); h1 = (uint32_t)f;
+    f = (uint64_t)h2 + ctx->pad[2] + (f >> 32); h2 = (uint32_t)f;
+    f = (uint64_t)h3 + ctx->pad[3] + (f >> 32); h3 = (uint32_t)f;
+
+    PUT_U32_LE(h0, tag);
+    PUT_U32_LE(h1, tag + 4);
+    PUT_U32_LE(h2, tag + 8);
+    PUT_U32_LE(h3, tag + 12);
+}
+
+/**
+ * The tag of the AEAD: Poly1305 over aad and the ciphertext (each
+ * padded to 16 bytes) and their 64 bit lengths, with the key from
+ * block 0 of the key stream.
+ */
+static void chacha20_poly1305_tag(const CHACHA20_CTX *ctx, const uint8_t *nonce,
+        const uint8_t *aad, int aad_len, const uint8_t *cipher, int length, uint8_t *tag)
+{
+    POLY1305_CTX poly;
+    uint8_t block[64];
+
+    chacha20_block(ctx, nonce, 0, block);
+    poly1305_init(&poly, block);
+
+    poly1305_update(&poly, aad, aad_len);
+    poly1305_update(&poly, cipher, length);
+
+    memset(block, 0, 16);
+    PUT_U32_LE((uint32_t)aad_len, block);
+    PUT_U32_LE((uint32_t)length, block + 8);
+    poly1305_update(&poly, block, 16);
+
+    poly1305_finish(&poly, tag);
+    memset(&poly, 0, sizeof(poly));
+}
+
+/**
+ * Encrypt length bytes of msg to out, with a 16 byte tag for msg and aad.
+ */
+void ChaCha20_Poly1305_encrypt(const CHACHA20_CTX *ctx, const uint8_t *nonce,
+        const uint8_t *aad, int aad_len, const uint8_t *msg, uint8_t *out,
+        int length, uint8_t *tag)
+{
+    chacha20_crypt(ctx, nonce, msg, out, length);
+    chacha20_poly1305_tag(ctx, nonce, aad, aad_len, out, length, tag);
+}
+
+/**
+ * Check the tag, then decrypt length bytes of msg to out. Returns 0
+ * (and does not decrypt) if the tag is wrong.
+ */
+int ChaCha20_Poly1305_decrypt(const CHACHA20_CTX *ctx, const uint8_t *nonce,
+        const uint8_t *aad, int aad_len, const uint8_t *msg, uint8_t *out,
+        int length, const uint8_t *tag)
+{
+    uint8_t check[POLY1305_TAG_SIZE];
+    uint8_t diff = 0;
+    int i;
+
+    chacha20_poly1305_tag(ctx, nonce, aad, aad_len, msg, length, check);
+
+    /* constant time compare */
+    for (i = 0; i < POLY1305_TAG_SIZE; i++)
+        diff |= check[i] ^ tag[i];
+    if (diff) return 0;
+
+    chacha20_crypt(ctx, nonce, msg, out, length);
+    return 1;
+}
@@ -0,0 +1,48 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************/
+
+#ifndef CHACHA20_H
+#define CHACHA20_H
+
+#include <stdint.h>
+
+/**************************************************************************
+ * ChaCha20-Poly1305 declarations (RFC 8439)
+ **************************************************************************/
+
+#define CHACHA20_KEY_SIZE   32
+#define CHACHA20_NONCE_SIZE 12
+#define POLY1305_TAG_SIZE   16
+
+typedef struct
+{
+    uint32_t key[8];
+} CHACHA20_CTX;
+
+void ChaCha20_set_key(CHACHA20_CTX *ctx, const uint8_t *key);
+void ChaCha20_Poly1305_encrypt(const CHACHA20_CTX *ctx, const uint8_t *nonce,
+        const uint8_t *aad, int aad_len, const uint8_t *msg, uint8_t *out,
+        int length, uint8_t *tag);
+int ChaCha20_Poly1305_decrypt(const CHACHA20_CTX *ctx, const uint8_t *nonce,
+        const uint8_t *aad, int aad_len, const uint8_t *msg, uint8_t *out,
+        int length, const uint8_t *tag);
+
+#endif
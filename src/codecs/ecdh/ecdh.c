@@ -0,0 +1,716 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************/
+
+/**
+ * Elliptic curve Diffie-Hellman for the ECDHE key exchange of TLS.
+ *
+ * X25519 follows RFC 7748 with the field arithmetic of TweetNaCl (public
+ * domain): 16 limbs of 16 bits and a constant time Montgomery ladder.
+ *
+ * P-256 uses 8 limbs of 32 bits in the Montgomery domain, Jacobian
+ * coordinates and a fixed 4 bit window with a constant time table lookup.
+ */
+
+#include <string.h>
+#include "ecdh.h"
+
+void get_random(size_t num_rand_bytes, uint8_t *rand_data); /* rsa.c */
+
+/**************************************************************************
+ * X25519
+ **************************************************************************/
+
+typedef int64_t gf[16];
+
+static const gf gf_121665 = {0xDB41, 1};
+
+static void car25519(gf o)
+{
+    int i;
+    int64_t c;
+
+    for (i = 0; i < 16; i++)
+    {
+        o[i] += ((int64_t)1 << 16);
+        c = o[i] >> 16;
+        o[(i+1)*(i<15)] += c-1 + 37*(c-1)*(i==15);
+        o[i] -= c * ((int64_t)1 << 16);
+    }
+}
+
+/* swap p and q if b is 1, in constant time */
+static void sel25519(gf p, gf q, int b)
+{
+    int i;
+    int64_t t, c = ~(int64_t)(b-1);
+
+    for (i = 0; i < 16; i++)
+    {
+        t = c & (p[i] ^ q[i]);
+        p[i] ^= t;
+        q[i] ^= t;
+    }
+}
+
+static void pack25519(uint8_t *o, const gf n)
+{
+    int i, j, b;
+    gf m, t;
+
+    memcpy(t, n, sizeof(gf));
+    car25519(t);
+    car25519(t);
+    car25519(t);
+
+    for (j = 0; j < 2; j++)
+    {
+        m[0] = t[0] - 0xffed;
+
+        for (i = 1; i < 15; i++)
+        {
+            m[i] = t[i] - 0xffff - ((m[i-1] >> 16) & 1);
+            m[i-1] &= 0xffff;
+        }
+
+        m[15] = t[15] - 0x7fff - ((m[14] >> 16) & 1);
+        b = (int)((m[15] >> 16) & 1);
+        m[14] &= 0xffff;
+        sel25519(t, m, 1-b);
+    }
+
+    for (i = 0; i < 16; i++)
+    {
+        o[2*i] = (uint8_t)t[i];
+        o[2*i+1] = (uint8_t)(t[i] >> 8);
+    }
+}
+
+static void unpack25519(gf o, const uint8_t *n)
+{
+    int i;
+
+    for (i = 0; i < 16; i++)
+    {
+        o[i] = n[2*i] + ((int64_t)n[2*i+1] << 8);
+    }
+
+    o[15] &= 0x7fff;
+}
+
+static void fe_add25519(gf o, const gf a, const gf b)
+{
+    int i;
+
+    for (i = 0; i < 16; i++)
+        o[i] = a[i] + b[i];
+}
+
+static void fe_sub25519(gf o, const gf a, const gf b)
+{
+    int i;
+
+    for (i = 0; i < 16; i++)
+        o[i] = a[i] - b[i];
+}
+
+static void fe_mul25519(gf o, const gf a, const gf b)
+{
+    int i, j;
+    int64_t t[31];
+
+    memset(t, 0, sizeof(t));
+
+    for (i = 0; i < 16; i++)
+        for (j = 0; j < 16; j++)
+            t[i+j] += a[i]*b[j];
+
+    for (i = 0; i < 15; i++)
+        t[i] += 38*t[i+16];
+
+    memcpy(o, t, sizeof(gf));
+    car25519(o);
+    car25519(o);
+}
+
+static void fe_inv25519(gf o, const gf i)
+{
+    gf c;
+    int a;
+
+    memcpy(c, i, sizeof(gf));
+
+    for (a = 253; a >= 0; a--)  /* i^(p-2) */
+    {
+        fe_mul25519(c, c, c);
+        if (a != 2 && a != 4)
+            fe_mul25519(c, c, i);
+    }
+
+    memcpy(o, c, sizeof(gf));
+}
+
+static void x25519(uint8_t *q, const uint8_t *n, const uint8_t *p)
+{
+    uint8_t z[32];
+    int i, r;
+    gf x, a, b, c, d, e, f;
+
+    /* clamp the scalar */
+    memcpy(z, n, 32);
+    z[31] = (z[31] & 127) | 64;
+    z[0] &= 248;
+
+    unpack25519(x, p);
+    memcpy(b, x, sizeof(gf));
+    memset(a, 0, sizeof(gf));
+    memset(c, 0, sizeof(gf));
+    memset(d, 0, sizeof(gf));
+    a[0] = d[0] = 1;
+
+    for (i = 254; i >= 0; i--)
+    {
+        r = (z[i >> 3] >> (i & 7)) & 1;
+        sel25519(a, b, r);
+        sel25519(c, d, r);
+        fe_add25519(e, a, c);
+        fe_sub25519(a, a, c);
+        fe_add25519(c, b, d);
+        fe_sub25519(b, b, d);
+        fe_mul25519(d, e, e);
+        fe_mul25519(f, a, a);
+        fe_mul25519(a, c, a);
+        fe_mul25519(c, b, e);
+        fe_add25519(e, a, c);
+        fe_sub25519(a, a, c);
+        fe_mul25519(b, a, a);
+        fe_sub25519(c, d, f);
+        fe_mul25519(a, c, gf_121665);
+        fe_add25519(a, a, d);
+        fe_mul25519(c, c, a);
+        fe_mul25519(a, d, f);
+        fe_mul25519(d, b, x);
+        fe_mul25519(b, e, e);
+        sel25519(a, b, r);
+        sel25519(c, d, r);
+    }
+
+    fe_inv25519(c, c);
+    fe_mul25519(a, a, c);
+    pack25519(q, a);
+    memset(z, 0, sizeof(z));
+}
+
+/**************************************************************************
+ * NIST P-256
+ **************************************************************************/
+
+typedef uint32_t fe[8];         /* little endian limbs, Montgomery form */
+
+typedef struct
+{
+    fe x, y, z;                 /* Jacobian, z = 0 is the point at infinity */
+} jpoint;
+
+static const fe p256_p = {
+    0xffffffff, 0xffffffff, 0xffffffff, 0x00000000,
+    0x00000000, 0x00000000, 0x00000001, 0xffffffff
+};
+
+static const fe p256_n = {
+    0xfc632551, 0xf3b9cac2, 0xa7179e84, 0xbce6faad,
+    0xffffffff, 0xffffffff, 0x00000000, 0xffffffff
+};
+
+static const fe p256_rr = {     /* R^2 mod p */
+    0x00000003, 0x00000000, 0xffffffff, 0xfffffffb,
+    0xfffffffe, 0xffffffff, 0xfffffffd, 0x00000004
+};
+
+static const fe p256_one = {    /* R mod p */
+    0x00000001, 0x00000000, 0x00000000, 0xffffffff,
+    0xffffffff, 0xffffffff, 0xfffffffe, 0x00000000
+};
+
+static const fe p256_b = {      /* b*R mod p */
+    0x29c4bddf, 0xd89cdf62, 0x78843090, 0xacf005cd,
+    0xf7212ed6, 0xe5a220ab, 0x04874834, 0xdc30061d
+};
+
+static const fe p256_gx = {     /* Gx*R mod p */
+    0x18a9143c, 0x79e730d4, 0x5fedb601, 0x75ba95fc,
+    0x77622510, 0x79fb732b, 0xa53755c6, 0x18905f76
+};
+
+static const fe p256_gy = {     /* Gy*R mod p */
+    0xce95560a, 0xddf25357, 0xba19e45c, 0x8b4ab8e4,
+    0xdd21f325, 0xd2e88688, 0x25885d85, 0x8571ff18
+};
+
+/* a < b, for numbers of 8 limbs */
+static int fe_less(const fe a, const fe b)
+{
+    int i;
+
+    for (i = 7; i >= 0; i--)
+    {
+        if (a[i] != b[i])
+            return a[i] < b[i];
+    }
+
+    return 0;
+}
+
+static int fe_is_zero(const fe a)
+{
+    uint32_t r = 0;
+    int i;
+
+    for (i = 0; i < 8; i++)
+        r |= a[i];
+
+    return r == 0;
+}
+
+/* r = a - b, returns the borrow */
+static uint32_t fe_sub_raw(fe r, const fe a, const fe b)
+{
+    uint64_t t = 0;
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        t = (uint64_t)a[i] - b[i] - t;
+        r[i] = (uint32_t)t;
+        t = (t >> 32) & 1;
+    }
+
+    return (uint32_t)t;
+}
+
+/* r = a + b, returns the carry */
+static uint32_t fe_add_raw(fe r, const fe a, const fe b)
+{
+    uint64_t t = 0;
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        t += (uint64_t)a[i] + b[i];
+        r[i] = (uint32_t)t;
+        t >>= 32;
+    }
+
+    return (uint32_t)t;
+}
+
+static void fe_add(fe r, const fe a, const fe b)
+{
+    fe t;
+    uint32_t carry = fe_add_raw(r, a, b);
+    uint32_t borrow = fe_sub_raw(t, r, p256_p);
+
+    if (carry || !borrow)
+        memcpy(r, t, sizeof(fe));
+}
+
+static void fe_sub(fe r, const fe a, const fe b)
+{
+    if (fe_sub_raw(r, a, b))
+        fe_add_raw(r, r, p256_p);
+}
+
+/* Montgomery product r = a*b/R mod p. -1/p mod 2^32 is 1. */
+static void fe_mul(fe r, const fe a, const fe b)
+{
+    uint32_t t[10];
+    uint64_t carry;
+    uint32_t u;
+    int i, j;
+
+    memset(t, 0, sizeof(t));
+
+    for (i = 0; i < 8; i++)
+    {
+        carry = 0;
+        for (j = 0; j < 8; j++)
+        {
+            carry += (uint64_t)a[j]*b[i] + t[j];
+            t[j] = (uint32_t)carry;
+            carry >>= 32;
+        }
+        carry += t[8];
+        t[8] = (uint32_t)carry;
+        t[9] = (uint32_t)(carry >> 32);
+
+        u = t[0];
+        carry = ((uint64_t)u*p256_p[0] + t[0]) >> 32;
+        for (j = 1; j < 8; j++)
+        {
+            carry += (uint64_t)u*p256_p[j] + t[j];
+            t[j-1] = (uint32_t)carry;
+            carry >>= 32;
+        }
+        carry += t[8];
+        t[7] = (uint32_t)carry;
+        t[8] = t[9] + (uint32_t)(carry >> 32);
+    }
+
+    if (t[8] || !fe_less(t, p256_p))
+        fe_sub_raw(t, t, p256_p);
+
+    memcpy(r, t, sizeof(fe));
+}
+
+static void fe_inv(fe r, const fe a)
+{
+    fe t;
+    int i;
+
+    /* a^(p-2), p-2 = ffffffff 00000001 00000000 00000000 00000000 ffffffff ffffffff fffffffd */
+    memcpy(t, p256_one, sizeof(fe));
+
+    for (i = 255; i >= 0; i--)
+    {
+        fe_mul(t, t, t);
+        if (((p256_p[i >> 5] - (i < 32 ? 2 : 0)) >> (i & 31)) & 1)
+            fe_mul(t, t, a);
+    }
+
+    memcpy(r, t, sizeof(fe));
+}
+
+static void fe_import(fe r, const uint8_t *data)
+{
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        const uint8_t *d = data + 28 - 4*i;
+        r[i] = ((uint32_t)d[0] << 24) | ((uint32_t)d[1] << 16) |
+            ((uint32_t)d[2] << 8) | d[3];
+    }
+}
+
+static void fe_export(uint8_t *data, const fe a)
+{
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        uint8_t *d = data + 28 - 4*i;
+        d[0] = (uint8_t)(a[i] >> 24);
+        d[1] = (uint8_t)(a[i] >> 16);
+        d[2] = (uint8_t)(a[i] >> 8);
+        d[3] = (uint8_t)a[i];
+    }
+}
+
+/* Doubling for a = -3 (dbl-2001-b) */
+static void jp_double(jpoint *r, const jpoint *p)
+{
+    fe delta, gamma, beta, alpha, t1, t2;
+
+    if (fe_is_zero(p->z))
+    {
+        *r = *p;
+        return;
+    }
+
+    fe_mul(delta, p->z, p->z);
+    fe_mul(gamma, p->y, p->y);
+    fe_mul(beta, p->x, gamma);
+
+    fe_sub(t1, p->x, delta);
+    fe_add(t2, p->x, delta);
+    fe_mul(alpha, t1, t2);
+    fe_add(t1, alpha, alpha);
+    fe_add(alpha, alpha, t1);       /* 3*(x-delta)*(x+delta) */
+
+    fe_add(t1, p->y, p->z);
+    fe_mul(t1, t1, t1);
+    fe_sub(t1, t1, gamma);
+    fe_sub(r->z, t1, delta);        /* (y+z)^2 - gamma - delta */
+
+    fe_add(beta, beta, beta);
+    fe_add(beta, beta, beta);       /* 4*beta */
+    fe_mul(t1, alpha, alpha);
+    fe_add(t2, beta, beta);
+    fe_sub(r->x, t1, t2);           /* alpha^2 - 8*beta */
+
+    fe_sub(t1, beta, r->x);
+    fe_mul(t1, alpha, t1);
+    fe_mul(gamma, gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_add(gamma, gamma, gamma);    /* 8*gamma^2 */
+    fe_sub(r->y, t1, gamma);
+}
+
+/* General addition (add-1998-cmo-2) */
+static void jp_add(jpoint *r, const jpoint *p, const jpoint *q)
+{
+    fe z1z1, z2z2, u1, u2, s1, s2, h, rr, hh, hhh, v, t;
+
+    if (fe_is_zero(p->z))
+    {
+        *r = *q;
+        return;
+    }
+
+    if (fe_is_zero(q->z))
+    {
+        *r = *p;
+        return;
+    }
+
+    fe_mul(z1z1, p->z, p->z);
+    fe_mul(z2z2, q->z, q->z);
+    fe_mul(u1, p->x, z2z2);
+    fe_mul(u2, q->x, z1z1);
+    fe_mul(s1, p->y, q->z);
+    fe_mul(s1, s1, z2z2);
+    fe_mul(s2, q->y, p->z);
+    fe_mul(s2, s2, z1z1);
+    fe_sub(h, u2, u1);
+    fe_sub(rr, s2, s1);
+
+    if (fe_is_zero(h))
+    {
+        if (fe_is_zero(rr))
+            jp_double(r, p);
+        else
+            memset(r, 0, sizeof(jpoint));   /* p = -q */
+        return;
+    }
+
+    fe_mul(hh, h, h);
+    fe_mul(hhh, h, hh);
+    fe_mul(v, u1, hh);
+
+    fe_mul(t, p->z, q->z);
+    fe_mul(r->z, t, h);
+
+    fe_mul(t, rr, rr);
+    fe_sub(t, t, hhh);
+    fe_sub(t, t, v);
+    fe_sub(r->x, t, v);
+
+    fe_sub(t, v, r->x);
+    fe_mul(t, rr, t);
+    fe_mul(s1, s1, hhh);
+    fe_sub(r->y, t, s1);
+}
+
+/* r = k*p, k is a 32 byte big endian scalar */
+static void jp_multiply(jpoint *r, const jpoint *p, const uint8_t *k)
+{
+    jpoint table[16], t;
+    uint32_t mask;
+    int i, j, w;
+
+    memset(&table[0], 0, sizeof(jpoint));
+    table[1] = *p;
+
+    for (i = 2; i < 16; i++)
+    {
+        if (i & 1)
+            jp_add(&table[i], &table[i-1], p);
+        else
+            jp_double(&table[i], &table[i/2]);
+    }
+
+    memset(r, 0, sizeof(jpoint));
+    memset(&t, 0, sizeof(jpoint));
+
+    for (i = 0; i < 64; i++)
+    {
+        w = (k[i >> 1] >> (i & 1 ? 0 : 4)) & 15;
+
+        for (j = 0; j < 4; j++)
+            jp_double(r, r);
+
+        /* read all of the table, so the access does not depend on w */
+        for (j = 0; j < 16; j++)
+        {
+            uint32_t *d = (uint32_t *)&t, *s = (uint32_t *)&table[j];
+            int n;
+
+            mask = (uint32_t)0 - (uint32_t)(j == w);
+            for (n = 0; n < (int)(sizeof(jpoint)/4); n++)
+                d[n] = (d[n] & ~mask) | (s[n] & mask);
+        }
+
+        jp_add(r, r, &t);
+    }
+}
+
+/* Affine coordinates (plain form) of a Jacobian point */
+static void jp_affine(uint8_t *x, uint8_t *y, const jpoint *p)
+{
+    fe zi, zi2, t, one = {1};
+
+    fe_inv(zi, p->z);
+    fe_mul(zi2, zi, zi);
+    fe_mul(t, p->x, zi2);
+    fe_mul(t, t, one);
+    fe_export(x, t);
+
+    if (y)
+    {
+        fe_mul(zi2, zi2, zi);
+        fe_mul(t, p->y, zi2);
+        fe_mul(t, t, one);
+        fe_export(y, t);
+    }
+}
+
+/* Loads an uncompressed point and checks that it is on the curve */
+static int jp_import(jpoint *r, const uint8_t *data, int len)
+{
+    fe x, y, lhs, rhs, t;
+
+    if (len != 65 || data[0] != 4)
+        return 0;
+
+    fe_import(x, data + 1);
+    fe_import(y, data + 33);
+
+    if (!fe_less(x, p256_p) || !fe_less(y, p256_p))
+        return 0;
+
+    fe_mul(r->x, x, p256_rr);
+    fe_mul(r->y, y, p256_rr);
+    memcpy(r->z, p256_one, sizeof(fe));
+
+    /* y^2 = x^3 - 3x + b */
+    fe_mul(lhs, r->y, r->y);
+    fe_mul(rhs, r->x, r->x);
+    fe_mul(rhs, rhs, r->x);
+    fe_add(t, r->x, r->x);
+    fe_add(t, t, r->x);
+    fe_sub(rhs, rhs, t);
+    fe_add(rhs, rhs, p256_b);
+
+    return memcmp(lhs, rhs, sizeof(fe)) == 0;
+}
+
+/* A valid private key is 0 < k < n */
+static int p256_valid_scalar(const uint8_t *k)
+{
+    fe t;
+
+    fe_import(t, k);
+    return !fe_is_zero(t) && fe_less(t, p256_n);
+}
+
+/**************************************************************************
+ * ECDH
+ **************************************************************************/
+
+/**
+ * Size of a public key of the curve (0 if the curve is not known).
+ */
+int ECDH_pub_size(int curve)
+{
+    switch (curve)
+    {
+        case ECDH_X25519:
+            return 32;
+        case ECDH_SECP256R1:
+            return 65;
+    }
+
+    return 0;
+}
+
+/**
+ * Makes a random private key and its public key.
+ */
+int ECDH_generate_key(ECDH_CTX *ctx)
+{
+    static const uint8_t base[32] = {9};
+    jpoint g, q;
+
+    switch (ctx->curve)
+    {
+        case ECDH_X25519:
+            get_random(ECDH_PRIV_SIZE, ctx->priv);
+            x25519(ctx->pub, ctx->priv, base);
+            return 1;
+
+        case ECDH_SECP256R1:
+            do
+            {
+                get_random(ECDH_PRIV_SIZE, ctx->priv);
+            } while (!p256_valid_scalar(ctx->priv));
+
+            memcpy(g.x, p256_gx, sizeof(fe));
+            memcpy(g.y, p256_gy, sizeof(fe));
+            memcpy(g.z, p256_one, sizeof(fe));
+            jp_multiply(&q, &g, ctx->priv);
+            ctx->pub[0] = 4;
+            jp_affine(ctx->pub + 1, ctx->pub + 33, &q);
+            return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Computes the shared secret from the private key and the peer's public
+ * key. Returns 0 if the peer's key is not valid.
+ */
+int ECDH_compute_key(ECDH_CTX *ctx)
+{
+    jpoint p, q;
+    uint8_t zero = 0;
+    int i;
+
+    switch (ctx->curve)
+    {
+        case ECDH_X25519:
+            if (ctx->peer_len != 32)
+                return 0;
+
+            x25519(ctx->k, ctx->priv, ctx->peer);
+
+            /* reject the all zero output of small order points */
+            for (i = 0; i < ECDH_SECRET_SIZE; i++)
+                zero |= ctx->k[i];
+
+            return zero != 0;
+
+        case ECDH_SECP256R1:
+            if (!jp_import(&p, ctx->peer, ctx->peer_len) ||
+                    !p256_valid_scalar(ctx->priv))
+                return 0;
+
+            jp_multiply(&q, &p, ctx->priv);
+
+            if (fe_is_zero(q.z))
+                return 0;
+
+            jp_affine(ctx->k, NULL, &q);
+            return 1;
+    }
+
+    return 0;
+}
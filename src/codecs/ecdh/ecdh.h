@@ -0,0 +1,51 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************/
+
+#ifndef ECDH_H
+#define ECDH_H
+
+#include <stdint.h>
+
+/**************************************************************************
+ * Elliptic curve Diffie-Hellman declarations (X25519 and NIST P-256)
+ **************************************************************************/
+
+#define ECDH_X25519         1   /* RFC 7748 */
+#define ECDH_SECP256R1      2   /* NIST P-256 (uncompressed points) */
+
+#define ECDH_PRIV_SIZE      32
+#define ECDH_SECRET_SIZE    32
+
+typedef struct
+{
+    int curve;          /* ECDH_X25519 or ECDH_SECP256R1 */
+    uint8_t *priv;      /* private key (ECDH_PRIV_SIZE bytes) */
+    uint8_t *pub;       /* public key (self), ECDH_pub_size() bytes */
+    const uint8_t *peer;/* public key (peer) */
+    int peer_len;
+    uint8_t *k;         /* negotiated key (ECDH_SECRET_SIZE bytes) */
+} ECDH_CTX;
+
+int ECDH_pub_size(int curve);
+int ECDH_generate_key(ECDH_CTX *ctx);
+int ECDH_compute_key(ECDH_CTX *ctx);
+
+#endif
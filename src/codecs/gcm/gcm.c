@@ -0,0 +1,547 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************/
+
+/**
+ * AES-GCM authenticated encryption, as used by the TLS 1.2 AEAD cipher
+ * suites (RFC 5288). Only the 96 bit IV and full 128 bit tag are done.
+ *
+ * On x86 CPUs with AES-NI and PCLMULQDQ, the counter mode encrypts four
+ * blocks at a time and GHASH uses carry-less multiplies (four blocks per
+ * step, with H^1..H^4). Elsewhere, the small table AES of aes.c and a 4 bit
+ * table GHASH (Shoup's method) are used.
+ */
+
+#include <string.h>
+#include "gcm.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GCM_NI
+#include <cpuid.h>
+#include <wmmintrin.h>
+#include <smmintrin.h>
+#define NI_FUNC static __attribute__((target("aes,pclmul,sse4.1")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define GCM_NI
+#include <intrin.h>
+#include <wmmintrin.h>
+#include <smmintrin.h>
+#define NI_FUNC static
+#endif
+
+#define GET_U32_BE(b, i) \
+    (((uint32_t)(b)[i] << 24) | ((uint32_t)(b)[i+1] << 16) | \
+    ((uint32_t)(b)[i+2] << 8) | (uint32_t)(b)[i+3])
+
+#define PUT_U32_BE(n, b, i) { \
+    (b)[i] = (uint8_t)((n) >> 24); (b)[i+1] = (uint8_t)((n) >> 16); \
+    (b)[i+2] = (uint8_t)((n) >> 8); (b)[i+3] = (uint8_t)(n); }
+
+/* Reduction constants for the 4 bit table method */
+static const uint64_t last4[16] =
+{
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+/**
+ * Make the tables of the multiples of H for the software GHASH.
+ */
+static void gcm_gen_table(GCM_CTX *ctx, const uint8_t *h)
+{
+    int i, j;
+    uint64_t vh, vl;
+
+    vh = ((uint64_t)GET_U32_BE(h, 0) << 32) | GET_U32_BE(h, 4);
+    vl = ((uint64_t)GET_U32_BE(h, 8) << 32) | GET_U32_BE(h, 12);
+
+    ctx->hl[8] = vl;
+    ctx->hh[8] = vh;
+    ctx->hl[0] = 0;
+    ctx->hh[0] = 0;
+
+    for (i = 4; i > 0; i >>= 1)
+    {
+        uint32_t t = (uint32_t)(vl & 1) * 0xe1000000U;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ ((uint64_t)t << 32);
+        ctx->hl[i] = vl;
+        ctx->hh[i] = vh;
+    }
+
+    for (i = 2; i <= 8; i *= 2)
+    {
+        vh = ctx->hh[i];
+        vl = ctx->hl[i];
+        for (j = 1; j < i; j++)
+        {
+            ctx->hh[i+j] = vh ^ ctx->hh[j];
+            ctx->hl[i+j] = vl ^ ctx->hl[j];
+        }
+    }
+}
+
+/**
+ * Multiply x by H in GF(2^128), with the tables.
+ */
+static void gcm_mult(const GCM_CTX *ctx, uint8_t *x)
+{
+    int i;
+    uint8_t lo, hi, rem;
+    uint64_t zh, zl;
+
+    lo = x[15] & 0xf;
+    zh = ctx->hh[lo];
+    zl = ctx->hl[lo];
+
+    for (i = 15; i >= 0; i--)
+    {
+        lo = x[i] & 0xf;
+        hi = (x[i] >> 4) & 0xf;
+
+        if (i != 15)
+        {
+            rem = (uint8_t)zl & 0xf;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ (last4[rem] << 48);
+            zh ^= ctx->hh[lo];
+            zl ^= ctx->hl[lo];
+        }
+
+        rem = (uint8_t)zl & 0xf;
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ (last4[rem] << 48);
+        zh ^= ctx->hh[hi];
+        zl ^= ctx->hl[hi];
+    }
+
+    PUT_U32_BE((uint32_t)(zh >> 32), x, 0);
+    PUT_U32_BE((uint32_t)zh, x, 4);
+    PUT_U32_BE((uint32_t)(zl >> 32), x, 8);
+    PUT_U32_BE((uint32_t)zl, x, 12);
+}
+
+/**
+ * Add data to the GHASH value x (the last block is zero padded).
+ */
+static void gcm_hash(const GCM_CTX *ctx, uint8_t *x, const uint8_t *data, int length)
+{
+    int i, n;
+
+    for (; length > 0; length -= 16, data += 16)
+    {
+        n = length < 16 ? length : 16;
+        for (i = 0; i < n; i++)
+            x[i] ^= data[i];
+        gcm_mult(ctx, x);
+    }
+}
+
+/**
+ * Software AES-GCM. The counter mode output is XORed with msg, and
+ * the ciphertext (out when encrypting, msg when decrypting) is hashed.
+ */
+static void gcm_crypt(GCM_CTX *ctx, const uint8_t *iv, const uint8_t *aad, int aad_len,
+        const uint8_t *msg, uint8_t *out, int length, uint8_t *tag, int decrypt)
+{
+    uint8_t cb[16], ks[16], x[16], len_block[16];
+    uint32_t ctr = 2;
+    int total = length;
+    int i, n;
+
+    memset(x, 0, 16);
+    gcm_hash(ctx, x, aad, aad_len);
+
+    memcpy(cb, iv, GCM_IV_SIZE);
+
+    for (; length > 0; length -= 16, msg += 16, out += 16)
+    {
+        n = length < 16 ? length : 16;
+        PUT_U32_BE(ctr, cb, 12);
+        ctr++;
+        AES_ecb_encrypt(&ctx->aes, cb, ks);
+        if (decrypt) gcm_hash(ctx, x, msg, n);
+        for (i = 0; i < n; i++)
+            out[i] = msg[i] ^ ks[i];
+        if (!decrypt) gcm_hash(ctx, x, out, n);
+    }
+
+    memset(len_block, 0, 16);
+    PUT_U32_BE((uint32_t)aad_len >> 29, len_block, 0);
+    PUT_U32_BE((uint32_t)aad_len << 3, len_block, 4);
+    PUT_U32_BE((uint32_t)total >> 29, len_block, 8);
+    PUT_U32_BE((uint32_t)total << 3, len_block, 12);
+    gcm_hash(ctx, x, len_block, 16);
+
+    /* the tag is GHASH xor E(K, IV || 1) */
+    PUT_U32_BE(1, cb, 12);
+    AES_ecb_encrypt(&ctx->aes, cb, ks);
+    for (i = 0; i < 16; i++)
+        tag[i] = x[i] ^ ks[i];
+}
+
+#ifdef GCM_NI
+
+/**
+ * Check for AES-NI, PCLMULQDQ and SSE4.1 (CPUID leaf 1, ECX).
+ */
+static int gcm_has_ni(void)
+{
+    unsigned int ecx;
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    ecx = (unsigned int)info[2];
+#else
+    unsigned int eax, ebx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return 0;
+#endif
+    return (ecx & (1 << 25)) && (ecx & (1 << 1)) && (ecx & (1 << 19));
+}
+
+NI_FUNC __m128i ni_key_assist(__m128i t1, __m128i t2)
+{
+    __m128i t3;
+
+    t2 = _mm_shuffle_epi32(t2, 0xff);
+    t3 = _mm_slli_si128(t1, 4);
+    t1 = _mm_xor_si128(t1, t3);
+    t3 = _mm_slli_si128(t3, 4);
+    t1 = _mm_xor_si128(t1, t3);
+    t3 = _mm_slli_si128(t3, 4);
+    t1 = _mm_xor_si128(t1, t3);
+    return _mm_xor_si128(t1, t2);
+}
+
+NI_FUNC __m128i ni_key_assist2(__m128i t1, __m128i t3)
+{
+    __m128i t2, t4;
+
+    t4 = _mm_aeskeygenassist_si128(t1, 0);
+    t2 = _mm_shuffle_epi32(t4, 0xaa);
+    t4 = _mm_slli_si128(t3, 4);
+    t3 = _mm_xor_si128(t3, t4);
+    t4 = _mm_slli_si128(t4, 4);
+    t3 = _mm_xor_si128(t3, t4);
+    t4 = _mm_slli_si128(t4, 4);
+    t3 = _mm_xor_si128(t3, t4);
+    return _mm_xor_si128(t3, t2);
+}
+
+/* The round constant must be an immediate, so the steps are unrolled: */
+#define KEY128(n, rcon) \
+    rk[n] = ni_key_assist(rk[n-1], _mm_aeskeygenassist_si128(rk[n-1], rcon))
+#define KEY256(n, rcon) \
+    rk[n] = ni_key_assist(rk[n-2], _mm_aeskeygenassist_si128(rk[n-1], rcon))
+#define KEY256B(n) \
+    rk[n] = ni_key_assist2(rk[n-1], rk[n-2])
+
+/**
+ * Bit reflected GF(2^128) multiply (Intel white paper, "gfmul").
+ * Both values are in byte reversed order.
+ */
+NI_FUNC __m128i ni_gfmul(__m128i a, __m128i b)
+{
+    __m128i t2, t3, t4, t5, t6, t7, t8, t9;
+
+    t3 = _mm_clmulepi64_si128(a, b, 0x00);
+    t4 = _mm_clmulepi64_si128(a, b, 0x10);
+    t5 = _mm_clmulepi64_si128(a, b, 0x01);
+    t6 = _mm_clmulepi64_si128(a, b, 0x11);
+
+    t4 = _mm_xor_si128(t4, t5);
+    t5 = _mm_slli_si128(t4, 8);
+    t4 = _mm_srli_si128(t4, 8);
+    t3 = _mm_xor_si128(t3, t5);
+    t6 = _mm_xor_si128(t6, t4);
+
+    /* shift the 256 bit product left by one (reflected bits) */
+    t7 = _mm_srli_epi32(t3, 31);
+    t8 = _mm_srli_epi32(t6, 31);
+    t3 = _mm_slli_epi32(t3, 1);
+    t6 = _mm_slli_epi32(t6, 1);
+    t9 = _mm_srli_si128(t7, 12);
+    t8 = _mm_slli_si128(t8, 4);
+    t7 = _mm_slli_si128(t7, 4);
+    t3 = _mm_or_si128(t3, t7);
+    t6 = _mm_or_si128(t6, t8);
+    t6 = _mm_or_si128(t6, t9);
+
+    /* reduce modulo x^128 + x^7 + x^2 + x + 1 */
+    t7 = _mm_slli_epi32(t3, 31);
+    t8 = _mm_slli_epi32(t3, 30);
+    t9 = _mm_slli_epi32(t3, 25);
+    t7 = _mm_xor_si128(t7, t8);
+    t7 = _mm_xor_si128(t7, t9);
+    t8 = _mm_srli_si128(t7, 4);
+    t7 = _mm_slli_si128(t7, 12);
+    t3 = _mm_xor_si128(t3, t7);
+
+    t2 = _mm_srli_epi32(t3, 1);
+    t4 = _mm_srli_epi32(t3, 2);
+    t5 = _mm_srli_epi32(t3, 7);
+    t2 = _mm_xor_si128(t2, t4);
+    t2 = _mm_xor_si128(t2, t5);
+    t2 = _mm_xor_si128(t2, t8);
+    t3 = _mm_xor_si128(t3, t2);
+    return _mm_xor_si128(t6, t3);
+}
+
+NI_FUNC __m128i ni_encrypt(const __m128i *rk, int rounds, __m128i b)
+{
+    int r;
+
+    b = _mm_xor_si128(b, rk[0]);
+    for (r = 1; r < rounds; r++)
+        b = _mm_aesenc_si128(b, rk[r]);
+    return _mm_aesenclast_si128(b, rk[rounds]);
+}
+
+/**
+ * Expand the key for AES-NI, and compute H, H^2, H^3, H^4.
+ */
+NI_FUNC void ni_set_key(GCM_CTX *ctx, const uint8_t *key, int length)
+{
+    const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i rk[15];
+    __m128i h, hn;
+    int i;
+
+    rk[0] = _mm_loadu_si128((const __m128i *)key);
+    if (length == 16)
+    {
+        KEY128(1, 0x01); KEY128(2, 0x02); KEY128(3, 0x04); KEY128(4, 0x08);
+        KEY128(5, 0x10); KEY128(6, 0x20); KEY128(7, 0x40); KEY128(8, 0x80);
+        KEY128(9, 0x1b); KEY128(10, 0x36);
+        ctx->rounds = 10;
+    }
+    else
+    {
+        rk[1] = _mm_loadu_si128((const __m128i *)(key + 16));
+        KEY256(2, 0x01); KEY256B(3); KEY256(4, 0x02); KEY256B(5);
+        KEY256(6, 0x04); KEY256B(7); KEY256(8, 0x08); KEY256B(9);
+        KEY256(10, 0x10); KEY256B(11); KEY256(12, 0x20); KEY256B(13);
+        KEY256(14, 0x40);
+        ctx->rounds = 14;
+    }
+
+    for (i = 0; i <= ctx->rounds; i++)
+        _mm_storeu_si128((__m128i *)(ctx->rk + 16 * i), rk[i]);
+
+    h = ni_encrypt(rk, ctx->rounds, _mm_setzero_si128());
+    h = _mm_shuffle_epi8(h, bswap);
+    hn = h;
+    for (i = 0; i < 4; i++)
+    {
+        _mm_storeu_si128((__m128i *)(ctx->h + 16 * i), hn);
+        hn = ni_gfmul(hn, h);
+    }
+}
+
+/**
+ * Load up to 16 bytes (zero padded) in byte reversed order.
+ */
+NI_FUNC __m128i ni_load_partial(const uint8_t *data, int n)
+{
+    const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    uint8_t block[16];
+
+    memset(block, 0, 16);
+    memcpy(block, data, n);
+    return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)block), bswap);
+}
+
+/**
+ * AES-NI and PCLMUL version of gcm_crypt.
+ */
+NI_FUNC void ni_crypt(GCM_CTX *ctx, const uint8_t *iv, const uint8_t *aad, int aad_len,
+        const uint8_t *msg, uint8_t *out, int length, uint8_t *tag, int decrypt)
+{
+    const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i rk[15], h[4];
+    __m128i x, base, b0, b1, b2, b3, c0, c1, c2, c3;
+    uint8_t block[16];
+    uint32_t ctr = 2;
+    int rounds = ctx->rounds;
+    int aad_total = aad_len;
+    int total = length;
+    int r, n;
+
+    for (r = 0; r <= rounds; r++)
+        rk[r] = _mm_loadu_si128((const __m128i *)(ctx->rk + 16 * r));
+    for (r = 0; r < 4; r++)
+        h[r] = _mm_loadu_si128((const __m128i *)(ctx->h + 16 * r));
+
+    x = _mm_setzero_si128();
+    for (; aad_len > 0; aad_len -= 16, aad += 16)
+    {
+        n = aad_len < 16 ? aad_len : 16;
+        x = ni_gfmul(_mm_xor_si128(x, ni_load_partial(aad, n)), h[0]);
+    }
+
+    memset(block, 0, 16);
+    memcpy(block, iv, GCM_IV_SIZE);
+    base = _mm_loadu_si128((const __m128i *)block);
+
+#define CTR_BLOCK(c) _mm_insert_epi32(base, (int)(((c) >> 24) | (((c) >> 8) & 0xff00) | \
+        (((c) << 8) & 0xff0000) | ((c) << 24)), 3)
+
+    /* four blocks at a time, with the hash aggregated over H^4..H^1 */
+    for (; length >= 64; length -= 64, msg += 64, out += 64)
+    {
+        b0 = CTR_BLOCK(ctr);
+        b1 = CTR_BLOCK(ctr + 1);
+        b2 = CTR_BLOCK(ctr + 2);
+        b3 = CTR_BLOCK(ctr + 3);
+        ctr += 4;
+
+        b0 = _mm_xor_si128(b0, rk[0]);
+        b1 = _mm_xor_si128(b1, rk[0]);
+        b2 = _mm_xor_si128(b2, rk[0]);
+        b3 = _mm_xor_si128(b3, rk[0]);
+        for (r = 1; r < rounds; r++)
+        {
+            b0 = _mm_aesenc_si128(b0, rk[r]);
+            b1 = _mm_aesenc_si128(b1, rk[r]);
+            b2 = _mm_aesenc_si128(b2, rk[r]);
+            b3 = _mm_aesenc_si128(b3, rk[r]);
+        }
+        b0 = _mm_aesenclast_si128(b0, rk[rounds]);
+        b1 = _mm_aesenclast_si128(b1, rk[rounds]);
+        b2 = _mm_aesenclast_si128(b2, rk[rounds]);
+        b3 = _mm_aesenclast_si128(b3, rk[rounds]);
+
+        c0 = _mm_loadu_si128((const __m128i *)msg);
+        c1 = _mm_loadu_si128((const __m128i *)(msg + 16));
+        c2 = _mm_loadu_si128((const __m128i *)(msg + 32));
+        c3 = _mm_loadu_si128((const __m128i *)(msg + 48));
+
+        b0 = _mm_xor_si128(b0, c0);
+        b1 = _mm_xor_si128(b1, c1);
+        b2 = _mm_xor_si128(b2, c2);
+        b3 = _mm_xor_si128(b3, c3);
+
+        _mm_storeu_si128((__m128i *)out, b0);
+        _mm_storeu_si128((__m128i *)(out + 16), b1);
+        _mm_storeu_si128((__m128i *)(out + 32), b2);
+        _mm_storeu_si128((__m128i *)(out + 48), b3);
+
+        if (!decrypt)
+        {
+            c0 = b0; c1 = b1; c2 = b2; c3 = b3;
+        }
+        c0 = _mm_shuffle_epi8(c0, bswap);
+        c1 = _mm_shuffle_epi8(c1, bswap);
+        c2 = _mm_shuffle_epi8(c2, bswap);
+        c3 = _mm_shuffle_epi8(c3, bswap);
+
+        x = _mm_xor_si128(
+            _mm_xor_si128(ni_gfmul(_mm_xor_si128(x, c0), h[3]), ni_gfmul(c1, h[2])),
+            _mm_xor_si128(ni_gfmul(c2, h[1]), ni_gfmul(c3, h[0])));
+    }
+
+    for (; length > 0; length -= 16, msg += 16, out += 16)
+    {
+        n = length < 16 ? length : 16;
+        b0 = ni_encrypt(rk, rounds, CTR_BLOCK(ctr));
+        ctr++;
+        _mm_storeu_si128((__m128i *)block, b0);
+        for (r = 0; r < n; r++)
+            out[r] = msg[r] ^ block[r];
+        x = ni_gfmul(_mm_xor_si128(x, ni_load_partial(decrypt ? msg : out, n)), h[0]);
+    }
+
+    /* lengths in bits, [aad]64 || [data]64 (byte reversed) */
+    x = ni_gfmul(_mm_xor_si128(x, _mm_set_epi64x((long long)aad_total << 3, (long long)total << 3)), h[0]);
+
+    b0 = ni_encrypt(rk, rounds, CTR_BLOCK(1));
+    x = _mm_xor_si128(_mm_shuffle_epi8(x, bswap), b0);
+    _mm_storeu_si128((__m128i *)tag, x);
+#undef CTR_BLOCK
+}
+
+#endif
+
+/**
+ * Set the key (16 or 32 bytes). Returns 0 for a bad key length.
+ */
+int GCM_set_key(GCM_CTX *ctx, const uint8_t *key, int length)
+{
+    uint8_t h[16];
+
+    if (length != 16 && length != 32) return 0;
+
+    memset(ctx, 0, sizeof(*ctx));
+
+#ifdef GCM_NI
+    if (gcm_has_ni())
+    {
+        ctx->hw = 1;
+        ni_set_key(ctx, key, length);
+        return 1;
+    }
+#endif
+
+    memset(h, 0, 16);
+    AES_set_key(&ctx->aes, key, h, length == 16 ? AES_MODE_128 : AES_MODE_256);
+    AES_ecb_encrypt(&ctx->aes, h, h);
+    gcm_gen_table(ctx, h);
+    return 1;
+}
+
+/**
+ * Encrypt length bytes of msg to out, with a 16 byte tag for msg and aad.
+ */
+void GCM_encrypt(GCM_CTX *ctx, const uint8_t *iv, const uint8_t *aad, int aad_len,
+        const uint8_t *msg, uint8_t *out, int length, uint8_t *tag)
+{
+#ifdef GCM_NI
+    if (ctx->hw)
+    {
+        ni_crypt(ctx, iv, aad, aad_len, msg, out, length, tag, 0);
+        return;
+    }
+#endif
+    gcm_crypt(ctx, iv, aad, aad_len, msg, out, length, tag, 0);
+}
+
+/**
+ * Decrypt length bytes of msg to out. Returns 0 if the tag is wrong
+ * (then out must not be used).
+ */
+int GCM_decrypt(GCM_CTX *ctx, const uint8_t *iv, const uint8_t *aad, int aad_len,
+        const uint8_t *msg, uint8_t *out, int length, const uint8_t *tag)
+{
+    uint8_t check[GCM_TAG_SIZE];
+    uint8_t diff = 0;
+    int i;
+
+#ifdef GCM_NI
+    if (ctx->hw)
+        ni_crypt(ctx, iv, aad, aad_len, msg, out, length, check, 1);
+    else
+#endif
+    gcm_crypt(ctx, iv, aad, aad_len, msg, out, length, check, 1);
+
+    /* constant time compare */
+    for (i = 0; i < GCM_TAG_SIZE; i++)
+        diff |= check[i] ^ tag[i];
+    return diff == 0;
+}
@@ -0,0 +1,51 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************/
+
+#ifndef GCM_H
+#define GCM_H
+
+#include <stdint.h>
+#include "aes/aes.h"
+
+/**************************************************************************
+ * AES-GCM declarations (NIST SP 800-38D, 96 bit IV, 128 bit tag)
+ **************************************************************************/
+
+#define GCM_IV_SIZE     12
+#define GCM_TAG_SIZE    16
+
+typedef struct
+{
+    int hw;                     /* use AES-NI and PCLMULQDQ */
+    int rounds;
+    AES_CTX aes;                /* key schedule for the software AES */
+    uint64_t hl[16], hh[16];    /* 4 bit tables of H for the software GHASH */
+    uint8_t rk[15*16];          /* round keys for AES-NI */
+    uint8_t h[4*16];            /* H, H^2, H^3, H^4 (byte reversed) for PCLMUL */
+} GCM_CTX;
+
+int GCM_set_key(GCM_CTX *ctx, const uint8_t *key, int length);
+void GCM_encrypt(GCM_CTX *ctx, const uint8_t *iv, const uint8_t *aad, int aad_len,
+        const uint8_t *msg, uint8_t *out, int length, uint8_t *tag);
+int GCM_decrypt(GCM_CTX *ctx, const uint8_t *iv, const uint8_t *aad, int aad_len,
+        const uint8_t *msg, uint8_t *out, int length, const uint8_t *tag);
+
+#endif
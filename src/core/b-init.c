@@ -836,6 +836,9 @@ extern const REBYTE Str_Banner[];
 	Register_Codec((REBYTE*)"utf-16le", Codec_UTF16LE);
 	Register_Codec((REBYTE*)"utf-16be", Codec_UTF16BE);
 	Register_Codec((REBYTE*)"markup", Codec_Markup);
+	Register_Codec((REBYTE*)"gzip", Codec_GZIP);
+	Register_Codec((REBYTE*)"json", Codec_JSON);
+	Register_Codec((REBYTE*)"csv", Codec_CSV);
 	Init_BMP_Codec();
 	Init_GIF_Codec();
 	Init_PNG_Codec();
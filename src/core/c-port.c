@@ -484,6 +484,126 @@ xx*/	REBINT Wait_Device(REBREQ *req, REBCNT timeout)
 		Trap0(RE_INVALID_PORT);
 }
 
+/***********************************************************************
+**
+*/	int Do_Stream_Port(REBVAL *ds, REBSER *port, REBCNT action, const STREAM_PORT *sp)
+/*
+**		Actor for a port that transforms the data written to it,
+**		a part at a time (such as deflate and inflate):
+**
+**			write port part	; output is added to port/data
+**			out: read port	; takes the output so far
+**			update port		; ends the data (it can then start again)
+**
+**		CLEAR starts again. WRITE takes a binary or a string (as
+**		UTF-8), or a block if the port has a write function. The
+**		state is made from the port spec on first use. The port
+**		file gives the functions (see STREAM_PORT).
+**
+***********************************************************************/
+{
+	REBVAL *state;
+	REBVAL *data;
+	REBVAL *arg;
+	REBSER *ser;	// output
+	REBSER *bin;
+	REBCNT index;
+	REBCNT len;
+	REBCNT args;
+
+	Validate_Port(port, action);
+
+	arg = D_ARG(2);
+	state = BLK_SKIP(port, STD_PORT_STATE);
+	data = BLK_SKIP(port, STD_PORT_DATA);
+
+	if (!ANY_SERIES(state)) {
+		switch (action) {
+		case A_OPENQ:
+			return R_FALSE;
+		case A_CLOSE:
+			return R_ARG1;
+		case A_OPEN:
+		case A_READ:
+		case A_WRITE:
+		case A_UPDATE:
+			sp->make(port, state);
+			break;
+		case A_CLEAR:	// makes it below
+			break;
+		default:
+			Trap_Port(RE_NOT_OPEN, port, -12);
+		}
+	}
+
+	// Output is added to port/data:
+	if (sp->output && VAL_TYPE(data) != sp->output) {
+		ser = (sp->output == REB_BLOCK) ? Make_Block(100) : Make_Binary(32*1024);
+		Set_Series(sp->output, data, ser);
+	}
+	ser = sp->output ? VAL_SERIES(data) : 0;
+
+	switch (action) {
+
+	case A_OPEN:
+		break;
+
+	case A_OPENQ:
+		return R_TRUE;
+
+	case A_CLOSE:
+		SET_NONE(state);
+		SET_NONE(data);
+		break;
+
+	case A_WRITE:
+		if (IS_BLOCK(arg) && sp->write) {
+			sp->write(VAL_SERIES(state), ser, arg);
+			break;
+		}
+		if (!sp->transform || (!IS_BINARY(arg) && !IS_STRING(arg))) Trap_Arg(arg);
+		args = Find_Refines(ds, ALL_WRITE_REFS);
+		len = VAL_LEN(arg);
+		if (args & AM_WRITE_PART) {
+			REBCNT n = Int32s(D_ARG(ARG_WRITE_LENGTH), 0);
+			if (n < len) len = n;
+		}
+		if (len == 0) break;
+		bin = Prep_Bin_Str(arg, &index, &len); // UTF-8 for a string
+		sp->transform(VAL_SERIES(state), ser, BIN_SKIP(bin, index), len, FALSE);
+		break;
+
+	case A_UPDATE:
+		if (sp->transform) sp->transform(VAL_SERIES(state), ser, 0, 0, TRUE);
+		break;
+
+	case A_READ:
+		// Take the output so far:
+		if (ser) {
+			*D_RET = *data;
+			SET_NONE(data);
+		}
+		else SET_NONE(D_RET);
+		if (sp->read) sp->read(port, state, D_RET);
+		return R_RET;
+
+	case A_CLEAR:
+		sp->make(port, state);
+		if (ser) SET_NONE(data);
+		break;
+
+	case A_LENGTHQ:
+		SET_INTEGER(D_RET, sp->length ? sp->length(state) : (REBI64)VAL_LEN(data));
+		return R_RET;
+
+	default:
+		Trap_Action(REB_PORT, action);
+	}
+
+	return R_ARG1; // port
+}
+
+
 /***********************************************************************
 **
 **  Scheme Native Action Support
@@ -508,11 +628,7 @@ xx*/	REBINT Wait_Device(REBREQ *req, REBCNT timeout)
 **
 ***********************************************************************/
 
-#ifdef HAS_POSIX_SIGNAL
-#define MAX_SCHEMES 12		// max native schemes
-#else
-#define MAX_SCHEMES 11		// max native schemes
-#endif
+#define SCHEMES_INIT 16		// initial size of the scheme table (it grows)
 
 typedef struct rebol_scheme_actions {
 	REBCNT sym;
@@ -521,6 +637,8 @@ typedef struct rebol_scheme_actions {
 } SCHEME_ACTIONS;
 
 SCHEME_ACTIONS *Scheme_Actions;	// Initial Global (not threaded)
+static REBCNT Num_Schemes;		// schemes registered
+static REBCNT Max_Schemes;		// size of the table
 
 
 /***********************************************************************
@@ -530,16 +648,26 @@ SCHEME_ACTIONS *Scheme_Actions;	// Initial Global (not threaded)
 **		Associate a scheme word (e.g. FILE) with a set of native
 **		scheme actions. This will be used by the Set_Scheme native
 **
+**		The table grows as schemes are registered, so adding a
+**		scheme needs no limit to be raised.
+**
 ***********************************************************************/
 {
-	REBINT n;
-
-	for (n = 0; n < MAX_SCHEMES && Scheme_Actions[n].sym; n++);
-	ASSERT2(n < MAX_SCHEMES, RP_MAX_SCHEMES);
+	SCHEME_ACTIONS *table;
+
+	if (Num_Schemes == Max_Schemes) {
+		table = Make_Mem(sizeof(SCHEME_ACTIONS) * Max_Schemes * 2);
+		if (!table) Crash(RP_NO_MEMORY, sizeof(SCHEME_ACTIONS) * Max_Schemes * 2);
+		memcpy(table, Scheme_Actions, sizeof(SCHEME_ACTIONS) * Max_Schemes);
+		Free_Mem(Scheme_Actions, sizeof(SCHEME_ACTIONS) * Max_Schemes);
+		Scheme_Actions = table;
+		Max_Schemes *= 2;
+	}
 
-	Scheme_Actions[n].sym = sym;
-	Scheme_Actions[n].map = map;
-	Scheme_Actions[n].fun = fun;
+	Scheme_Actions[Num_Schemes].sym = sym;
+	Scheme_Actions[Num_Schemes].map = map;
+	Scheme_Actions[Num_Schemes].fun = fun;
+	Num_Schemes++;
 }
 
 
@@ -564,10 +692,10 @@ SCHEME_ACTIONS *Scheme_Actions;	// Initial Global (not threaded)
 	if (!actor) return R_NONE;
 
 	// Does this scheme have native actor or actions?
-	for (n = 0; n < MAX_SCHEMES && Scheme_Actions[n].sym; n++) {
+	for (n = 0; n < Num_Schemes; n++) {
 		if (Scheme_Actions[n].sym == VAL_WORD_SYM(act)) break;
 	}
-	if (n == MAX_SCHEMES || !Scheme_Actions[n].sym) return R_NONE;
+	if (n == Num_Schemes) return R_NONE;
 
 	// The scheme uses a native actor:
 	if (Scheme_Actions[n].fun) {
@@ -618,7 +746,9 @@ SCHEME_ACTIONS *Scheme_Actions;	// Initial Global (not threaded)
 **
 ***********************************************************************/
 {
-	Scheme_Actions = Make_Mem(sizeof(SCHEME_ACTIONS) * MAX_SCHEMES);
+	Max_Schemes = SCHEMES_INIT;
+	Num_Schemes = 0;
+	Scheme_Actions = Make_Mem(sizeof(SCHEME_ACTIONS) * Max_Schemes);
 
 	Init_Console_Scheme();
 	Init_File_Scheme();
@@ -626,12 +756,22 @@ SCHEME_ACTIONS *Scheme_Actions;	// Initial Global (not threaded)
 	Init_Event_Scheme();
 	Init_TCP_Scheme();
 	Init_UDP_Scheme();
+	Init_HTTP_Server_Scheme();
 	Init_DNS_Scheme();
 #ifndef MIN_OS
 	Init_Clipboard_Scheme();
 #endif
 	Init_Serial_Scheme();
+	Init_Rope_Scheme();
+	Init_Compress_Scheme();
+	Init_Checksum_Scheme();
+	Init_Base_Scheme();
+	Init_JSON_Scheme();
+	Init_CSV_Scheme();
 #ifdef HAS_POSIX_SIGNAL
 	Init_Signal_Scheme();
 #endif
+#ifdef HAS_POSIX_SPAWN
+	Init_Process_Scheme();
+#endif
 }
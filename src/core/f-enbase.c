@@ -24,6 +24,9 @@
 **  Section: functional
 **  Author:  Carl Sassenrath
 **  Notes:
+**		Base-64 and 16 use SSSE3 or AVX2 on x86 when the CPU has it.
+**		Make_Base_Stream and Base_Stream convert a part at a time
+**		for the enbase and debase ports (p-enbase.c).
 **
 ***********************************************************************/
 
@@ -174,20 +177,378 @@
 
 /***********************************************************************
 **
-*/	static REBSER *Decode_Base2(REBYTE **src, REBCNT len, REBYTE delim)
+**	SIMD Conversions
+**
+**		Base-64 is done as in the SSSE3 and AVX2 code of Wojciech
+**		Mula and Alfred Klomp: bytes are shuffled and multiplied into
+**		6 bit indexes, which are turned into chars with a nibble
+**		lookup (PSHUFB), and the reverse. Hex uses the same lookup.
+**
+**		The decoders only take a chunk (16 or 32 chars) that is all
+**		digits. One with a line break, space, padding or other char
+**		is left to the byte code, which then tries again.
+**
+***********************************************************************/
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BASE_SIMD
+#include <cpuid.h>
+#include <immintrin.h>
+#define SSSE3_FUNC static __attribute__((target("ssse3")))
+#define AVX2_FUNC static __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define BASE_SIMD
+#include <intrin.h>
+#include <immintrin.h>
+#define SSSE3_FUNC static
+#define AVX2_FUNC static
+#endif
+
+#define DEBASE_SLOP 32	// the SIMD decoders store up to this many bytes past the output
+
+#ifdef BASE_SIMD
+
+static REBINT Base_SIMD = -1;	// 0 none, 1 SSSE3, 2 AVX2 (checked on first use)
+
+/***********************************************************************
+**
+*/	static REBINT Check_Base_CPU(void)
 /*
+**		Check for SSSE3 (CPUID leaf 1 ECX) and AVX2 (leaf 7 EBX),
+**		and that the OS saves the AVX registers (XCR0).
+**
 ***********************************************************************/
 {
-	REBYTE *bp;
-	REBYTE *cp;
-	REBCNT count = 0;
-	REBINT accum = 0;
-	REBYTE lex;
-	REBSER *ser;
+	unsigned int ecx1, ebx7 = 0;
+	unsigned int xcr0 = 0;
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] >= 7) {
+		__cpuidex(info, 7, 0);
+		ebx7 = (unsigned int)info[1];
+	}
+	__cpuid(info, 1);
+	ecx1 = (unsigned int)info[2];
+	if (ecx1 & (1 << 27)) xcr0 = (unsigned int)_xgetbv(0);
+#else
+	unsigned int eax, ebx, ecx, edx;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return 0;
+	ecx1 = ecx;
+	if (__get_cpuid_max(0, 0) >= 7) {
+		__cpuid_count(7, 0, eax, ebx, ecx, edx);
+		ebx7 = ebx;
+	}
+	if (ecx1 & (1 << 27)) __asm__ ("xgetbv" : "=a" (xcr0), "=d" (edx) : "c" (0));
+#endif
+	if (!(ecx1 & (1 << 9))) return 0;
+	return ((ebx7 & (1 << 5)) && (xcr0 & 6) == 6) ? 2 : 1;
+}
+
+
+/***********************************************************************
+**
+*/	SSSE3_FUNC REBCNT Enbase64_SSSE3(REBYTE *dst, REBYTE *src, REBCNT len, REBYTE *end)
+/*
+**		Encode 12 bytes to 16 chars at a time. Reads 16 bytes, so
+**		stops 4 short of the end of the source. Returns bytes done.
+**
+***********************************************************************/
+{
+	const __m128i shuf = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+	const __m128i lut = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+	__m128i in, t0, t1, t2, t3, idx;
+	REBCNT n;
+
+	for (n = 0; n + 12 <= len && src + n + 16 <= end; n += 12, dst += 16) {
+		in = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)(src + n)), shuf);
+		t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+		t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+		t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+		t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+		idx = _mm_or_si128(t1, t3);
+		// 0-25 A-Z, 26-51 a-z, 52-61 0-9, 62 +, 63 /
+		t0 = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+		t0 = _mm_sub_epi8(t0, _mm_cmpgt_epi8(idx, _mm_set1_epi8(25)));
+		_mm_storeu_si128((__m128i *)dst, _mm_add_epi8(idx, _mm_shuffle_epi8(lut, t0)));
+	}
+	return n;
+}
+
+
+/***********************************************************************
+**
+*/	AVX2_FUNC REBCNT Enbase64_AVX2(REBYTE *dst, REBYTE *src, REBCNT len, REBYTE *end)
+/*
+**		As above, 24 bytes to 32 chars. The two halves are loaded
+**		12 bytes apart, as the shuffle can't cross them.
+**
+***********************************************************************/
+{
+	const __m256i shuf = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+		1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+	const __m256i lut = _mm256_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+		65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+	__m256i in, t0, t1, t2, t3, idx;
+	REBCNT n;
+
+	for (n = 0; n + 24 <= len && src + n + 28 <= end; n += 24, dst += 32) {
+		in = _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)(src + n)));
+		in = _mm256_inserti128_si256(in, _mm_loadu_si128((__m128i *)(src + n + 12)), 1);
+		in = _mm256_shuffle_epi8(in, shuf);
+		t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+		t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+		t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+		t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+		idx = _mm256_or_si256(t1, t3);
+		t0 = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+		t0 = _mm256_sub_epi8(t0, _mm256_cmpgt_epi8(idx, _mm256_set1_epi8(25)));
+		_mm256_storeu_si256((__m256i *)dst, _mm256_add_epi8(idx, _mm256_shuffle_epi8(lut, t0)));
+	}
+	return n;
+}
+
+
+/***********************************************************************
+**
+*/	SSSE3_FUNC REBCNT Debase64_SSSE3(REBYTE *dst, REBYTE *src, REBCNT len)
+/*
+**		Decode 16 chars to 12 bytes at a time, while they are all
+**		base-64 digits. Stores 16 bytes. Returns chars done.
+**
+***********************************************************************/
+{
+	// Nibble classes: a char is a digit if its lo and hi classes don't share a bit.
+	const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+		0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+	const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+		0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m128i out_shuf = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	const __m128i mask_2f = _mm_set1_epi8(0x2f);
+	__m128i in, hi, lo, bad;
+	REBCNT n;
+
+	for (n = 0; n + 16 <= len; n += 16, dst += 12) {
+		in = _mm_loadu_si128((__m128i *)(src + n));
+		hi = _mm_and_si128(_mm_srli_epi32(in, 4), mask_2f);
+		lo = _mm_shuffle_epi8(lut_lo, _mm_and_si128(in, mask_2f));
+		bad = _mm_and_si128(lo, _mm_shuffle_epi8(lut_hi, hi));
+		if (_mm_movemask_epi8(_mm_cmpgt_epi8(bad, _mm_setzero_si128()))) break;
+		// Chars to 6 bit values ('/' is the odd one in its nibble):
+		hi = _mm_add_epi8(_mm_cmpeq_epi8(in, mask_2f), hi);
+		in = _mm_add_epi8(in, _mm_shuffle_epi8(lut_roll, hi));
+		// Pack four 6 bit values into 3 bytes:
+		in = _mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140));
+		in = _mm_madd_epi16(in, _mm_set1_epi32(0x00011000));
+		_mm_storeu_si128((__m128i *)dst, _mm_shuffle_epi8(in, out_shuf));
+	}
+	return n;
+}
+
+
+/***********************************************************************
+**
+*/	AVX2_FUNC REBCNT Debase64_AVX2(REBYTE *dst, REBYTE *src, REBCNT len)
+/*
+**		As above, 32 chars to 24 bytes. Stores 32 bytes.
+**
+***********************************************************************/
+{
+	const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+		0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a,
+		0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+		0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+	const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+		0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+		0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+		0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m256i out_shuf = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+		2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	const __m256i mask_2f = _mm256_set1_epi8(0x2f);
+	__m256i in, hi, lo, bad;
+	REBCNT n;
+
+	for (n = 0; n + 32 <= len; n += 32, dst += 24) {
+		in = _mm256_loadu_si256((__m256i *)(src + n));
+		hi = _mm256_and_si256(_mm256_srli_epi32(in, 4), mask_2f);
+		lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(in, mask_2f));
+		bad = _mm256_and_si256(lo, _mm256_shuffle_epi8(lut_hi, hi));
+		if (!_mm256_testz_si256(bad, bad)) break;
+		hi = _mm256_add_epi8(_mm256_cmpeq_epi8(in, mask_2f), hi);
+		in = _mm256_add_epi8(in, _mm256_shuffle_epi8(lut_roll, hi));
+		in = _mm256_maddubs_epi16(in, _mm256_set1_epi32(0x01400140));
+		in = _mm256_madd_epi16(in, _mm256_set1_epi32(0x00011000));
+		in = _mm256_shuffle_epi8(in, out_shuf);
+		// Join the 12 bytes of each half:
+		in = _mm256_permutevar8x32_epi32(in, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+		_mm256_storeu_si256((__m256i *)dst, in);
+	}
+	return n;
+}
+
+
+/***********************************************************************
+**
+*/	SSSE3_FUNC REBCNT Enbase16_SSSE3(REBYTE *dst, REBYTE *src, REBCNT len)
+/*
+**		Encode 16 bytes to 32 hex chars at a time. Returns bytes done.
+**
+***********************************************************************/
+{
+	const __m128i lut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+		'8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+	const __m128i mask_0f = _mm_set1_epi8(0x0f);
+	__m128i in, hi, lo;
+	REBCNT n;
+
+	for (n = 0; n + 16 <= len; n += 16, dst += 32) {
+		in = _mm_loadu_si128((__m128i *)(src + n));
+		hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(in, 4), mask_0f));
+		lo = _mm_shuffle_epi8(lut, _mm_and_si128(in, mask_0f));
+		_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128((__m128i *)(dst + 16), _mm_unpackhi_epi8(hi, lo));
+	}
+	return n;
+}
+
+
+/***********************************************************************
+**
+*/	SSSE3_FUNC REBCNT Debase16_SSSE3(REBYTE *dst, REBYTE *src, REBCNT len)
+/*
+**		Decode 16 hex chars (either case) to 8 bytes at a time,
+**		while they are all hex digits. Returns chars done.
+**
+***********************************************************************/
+{
+	__m128i in, dig, let, is_dig, is_let;
+	REBCNT n;
+
+	for (n = 0; n + 16 <= len; n += 16, dst += 8) {
+		in = _mm_loadu_si128((__m128i *)(src + n));
+		dig = _mm_sub_epi8(in, _mm_set1_epi8('0'));
+		let = _mm_sub_epi8(_mm_or_si128(in, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+		is_dig = _mm_and_si128(_mm_cmpgt_epi8(dig, _mm_set1_epi8(-1)), _mm_cmplt_epi8(dig, _mm_set1_epi8(10)));
+		is_let = _mm_and_si128(_mm_cmpgt_epi8(let, _mm_set1_epi8(-1)), _mm_cmplt_epi8(let, _mm_set1_epi8(6)));
+		if (_mm_movemask_epi8(_mm_or_si128(is_dig, is_let)) != 0xffff) break;
+		in = _mm_or_si128(_mm_and_si128(is_dig, dig),
+			_mm_and_si128(is_let, _mm_add_epi8(let, _mm_set1_epi8(10))));
+		// Hi nibble * 16 + lo nibble, then to bytes:
+		in = _mm_maddubs_epi16(in, _mm_set1_epi16(0x0110));
+		_mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(in, in));
+	}
+	return n;
+}
+
+#endif
+
+
+/***********************************************************************
+**
+*/	static REBYTE *Enbase64_Groups(REBYTE *dst, REBYTE *src, REBCNT len, REBYTE *end)
+/*
+**		Encode whole 3 byte groups of len. End is the end of the
+**		source, as the SIMD code reads a little ahead.
+**
+***********************************************************************/
+{
+#ifdef BASE_SIMD
+	REBCNT n = 0;
+
+	if (Base_SIMD < 0) Base_SIMD = Check_Base_CPU();
+	if (Base_SIMD == 2) n = Enbase64_AVX2(dst, src, len, end);
+	if (Base_SIMD >= 1) n += Enbase64_SSSE3(dst + n / 3 * 4, src + n, len - n, end);
+	dst += n / 3 * 4;
+	src += n;
+	len -= n;
+#endif
+
+	for (; len >= 3; len -= 3, src += 3) {
+		*dst++ = Enbase64[src[0] >> 2];
+		*dst++ = Enbase64[((src[0] & 0x3) << 4) + (src[1] >> 4)];
+		*dst++ = Enbase64[((src[1] & 0xF) << 2) + (src[2] >> 6)];
+		*dst++ = Enbase64[src[2] & 0x3F];
+	}
+
+	return dst;
+}
+
+
+/***********************************************************************
+**
+*/	static REBYTE *Enbase64_Last(REBYTE *dst, REBYTE *src, REBCNT len)
+/*
+**		Encode the last 1 or 2 bytes, with "=" padding.
+**
+***********************************************************************/
+{
+	if (len == 0) return dst;
+	dst[0] = Enbase64[src[0] >> 2];
+	if (len == 1) {
+		dst[1] = Enbase64[(src[0] & 0x3) << 4];
+		dst[2] = '=';
+	}
+	else {
+		dst[1] = Enbase64[((src[0] & 0x3) << 4) + (src[1] >> 4)];
+		dst[2] = Enbase64[(src[1] & 0xF) << 2];
+	}
+	dst[3] = '=';
+	return dst + 4;
+}
+
+
+/***********************************************************************
+**
+*/	static REBYTE *Enbase16_Bytes(REBYTE *dst, REBYTE *src, REBCNT len)
+/*
+***********************************************************************/
+{
+#ifdef BASE_SIMD
+	REBCNT n = 0;
+
+	if (Base_SIMD < 0) Base_SIMD = Check_Base_CPU();
+	if (Base_SIMD >= 1) n = Enbase16_SSSE3(dst, src, len);
+	dst += n * 2;
+	src += n;
+	len -= n;
+#endif
+
+	for (; len > 0; len--, src++) {
+		*dst++ = Hex_Digits[*src >> 4];
+		*dst++ = Hex_Digits[*src & 0xf];
+	}
+
+	return dst;
+}
+
+
+// State of a conversion done a part at a time (see Base_Stream):
+typedef struct rebol_base_stream {
+	REBINT base;	// 2, 16 or 64
+	REBFLG decode;
+	REBINT accum;	// digits of a partial byte, or bytes of a partial base-64 group
+	REBCNT count;	// digits or bytes in accum
+	REBCNT pad;		// base-64 "=": 1 wants a second one, 2 is the end
+} BASE_STREAM;
+
 
-	ser = Make_Binary(len >> 3);
-	bp = BIN_HEAD(ser);
-	cp = *src;
+/***********************************************************************
+**
+*/	static REBYTE *Debase2_Part(BASE_STREAM *bs, REBYTE *bp, REBYTE **src, REBCNT len, REBYTE delim)
+/*
+**		The Debase*_Part functions decode chars into bp, up to the
+**		delimiter or end, and return the end of the output, or zero
+**		for an invalid char at *src.
+**
+***********************************************************************/
+{
+	REBYTE *cp = *src;
+	REBCNT count = bs->count;
+	REBINT accum = bs->accum;
+	REBYTE lex;
 
 	for (; len > 0; cp++, len--) {
 
@@ -209,14 +570,13 @@
 		}
 		else if (!*cp || lex > LEX_DELIMIT_RETURN) goto err;
 	}
-	if (count) goto err; // improper modulus
 
-	*bp = 0;
-	ser->tail = bp - STR_HEAD(ser);
-	return ser;
+	bs->count = count;
+	bs->accum = accum;
+	*src = cp;
+	return bp;
 
 err:
-	Free_Series(ser);
 	*src = cp;
 	return 0;
 }
@@ -224,24 +584,33 @@ err:
 
 /***********************************************************************
 **
-*/	static REBSER *Decode_Base16(REBYTE **src, REBCNT len, REBYTE delim)
+*/	static REBYTE *Debase16_Part(BASE_STREAM *bs, REBYTE *bp, REBYTE **src, REBCNT len, REBYTE delim)
 /*
 ***********************************************************************/
 {
-	REBYTE *bp;
-	REBYTE *cp;
-	REBCNT count = 0;
-	REBINT accum = 0;
+	REBYTE *cp = *src;
+	REBCNT count = bs->count;
+	REBINT accum = bs->accum;
 	REBYTE lex;
 	REBINT val;
-	REBSER *ser;
+#ifdef BASE_SIMD
+	REBCNT n;
 
-	ser = Make_Binary(len / 2);
-	bp = STR_HEAD(ser);
-	cp = *src;
+	if (Base_SIMD < 0) Base_SIMD = Check_Base_CPU();
+#endif
 
 	for (; len > 0; cp++, len--) {
 
+#ifdef BASE_SIMD
+		if (Base_SIMD && !(count & 1) && len >= 16) {
+			n = Debase16_SSSE3(bp, cp, len);
+			bp += n / 2;
+			cp += n;
+			len -= n;
+			if (!len) break;
+		}
+#endif
+
 		if (delim && *cp == delim) break;
 
 		lex = Lex_Map[*cp];
@@ -249,44 +618,60 @@ err:
 		if (lex > LEX_WORD) {
 			val = lex & LEX_VALUE; // char num encoded into lex
 			if (!val && lex < LEX_NUMBER) goto err;  // invalid char (word but no val)
-			accum = (accum << 4) + val;
+			accum = ((accum << 4) + val) & 0xff;
 			if (count++ & 1) *bp++ = (REBYTE)accum;
 		}
 		else if (!*cp || lex > LEX_DELIMIT_RETURN) goto err;
 	}
-	if (count & 1) goto err; // improper modulus
 
-	*bp = 0;
-	ser->tail = bp - STR_HEAD(ser);
-	return ser;
+	bs->count = count & 1;
+	bs->accum = accum;
+	*src = cp;
+	return bp;
 
 err:
-	Free_Series(ser);
 	*src = cp;
 	return 0;
 }
 
-								
+
 /***********************************************************************
 **
-*/	static REBSER *Decode_Base64(REBYTE **src, REBCNT len, REBYTE delim)
+*/	static REBYTE *Debase64_Part(BASE_STREAM *bs, REBYTE *bp, REBYTE **src, REBCNT len, REBYTE delim)
 /*
+**		Decoding ends at the "=" padding. After a single "=", the
+**		chars are skipped up to the second.
+**
 ***********************************************************************/
 {
-	REBYTE *bp;
-	REBYTE *cp;
-	REBCNT flip = 0;
-	REBINT accum = 0;
+	REBYTE *cp = *src;
+	REBCNT flip = bs->count;
+	REBINT accum = bs->accum;
 	REBYTE lex;
-	REBSER *ser;
+#ifdef BASE_SIMD
+	REBCNT n;
 
-	// Allocate buffer large enough to hold result:
-	// Accounts for e bytes decoding into 3 bytes.
-	ser = Make_Binary(((len + 3) * 3) / 4);
-	bp = STR_HEAD(ser);
-	cp = *src;
+	if (Base_SIMD < 0) Base_SIMD = Check_Base_CPU();
+#endif
 
-	for (; len > 0; cp++, len--) {
+	for (; len > 0 && bs->pad < 2; cp++, len--) {
+
+		// Skip to the second "=" of padding:
+		if (bs->pad) {
+			if (*cp == '=') bs->pad = 2;
+			continue;
+		}
+
+#ifdef BASE_SIMD
+		if (Base_SIMD && !flip && len >= 16) {
+			n = (Base_SIMD == 2) ? Debase64_AVX2(bp, cp, len) : 0;
+			n += Debase64_SSSE3(bp + n / 4 * 3, cp + n, len - n);
+			bp += n / 4 * 3;
+			cp += n;
+			len -= n;
+			if (!len) break;
+		}
+#endif
 
 		// Check for terminating delimiter (optional):
 		if (delim && *cp == delim) break;
@@ -312,39 +697,78 @@ err:
 				}
 			} else {
 				// Special padding: "="
-				cp++;
-				len--;
 				if (flip == 3) {
 					*bp++ = (REBYTE)(accum >> 10);
 					*bp++ = (REBYTE)(accum >> 2);
-					flip = 0;
+					bs->pad = 2;
 				}
 				else if (flip == 2) {
-					if (!Skip_To_Char(cp, cp + len, '=')) goto err;
-					cp++;
 					*bp++ = (REBYTE)(accum >> 4);
-					flip = 0;
+					bs->pad = 1;
 				}
 				else goto err;
-				break;
+				accum = 0;
+				flip = 0;
 			}
 		}
 		else if (lex == BIN_ERROR) goto err;
 	}
 
-	if (flip) goto err;
-
-	*bp = 0;
-	ser->tail = bp - STR_HEAD(ser);
-	return ser;
+	bs->count = flip;
+	bs->accum = accum;
+	*src = cp;
+	return bp;
 
 err:
-	Free_Series(ser);
 	*src = cp;
 	return 0;
 }
 
 
+/***********************************************************************
+**
+*/	static REBSER *Decode_Base(REBYTE **src, REBCNT len, REBYTE delim, REBINT base)
+/*
+***********************************************************************/
+{
+	BASE_STREAM bs;
+	REBYTE *cp = *src;
+	REBYTE *bp;
+	REBSER *ser;
+
+	CLEAR(&bs, sizeof(bs));
+	bs.base = base;
+	bs.decode = TRUE;
+
+	// Allocate buffer large enough to hold result:
+	// Accounts for 4 bytes decoding into 3 bytes.
+	ser = Make_Binary((base == 64 ? ((len + 3) * 3) / 4 : len / (base == 16 ? 2 : 8)) + DEBASE_SLOP);
+
+	if (base == 64) {
+		bp = Debase64_Part(&bs, STR_HEAD(ser), &cp, len, delim);
+		if (bp && (bs.count || bs.pad == 1)) bp = 0;
+	}
+	else if (base == 16) {
+		bp = Debase16_Part(&bs, STR_HEAD(ser), &cp, len, delim);
+		if (bs.count) bp = 0; // improper modulus
+	}
+	else {
+		bp = Debase2_Part(&bs, STR_HEAD(ser), &cp, len, delim);
+		if (bs.count) bp = 0; // improper modulus
+	}
+
+	if (!bp) {
+		Free_Series(ser);
+		*src = cp;
+		return 0;
+	}
+
+	*bp = 0;
+	ser->tail = bp - STR_HEAD(ser);
+	return ser;
+}
+
+
 /***********************************************************************
 **
 */	REBYTE *Decode_Binary(REBVAL *value, REBYTE *src, REBCNT len, REBINT base, REBYTE delim)
@@ -355,17 +779,8 @@ err:
 {
 	REBSER *ser = 0;
 
-	switch (base) {
-	case 64:
-		ser = Decode_Base64(&src, len, delim);
-		break;
-	case 16:
-		ser = Decode_Base16(&src, len, delim);
-		break;
-	case 2:
-		ser = Decode_Base2 (&src, len, delim);
-		break;
-	}
+	if (base == 64 || base == 16 || base == 2)
+		ser = Decode_Base(&src, len, delim, base);
 
 	if (!ser) return 0;
 
@@ -422,28 +837,32 @@ err:
 */  REBSER *Encode_Base16(REBVAL *value, REBSER *series, REBFLG brk)
 /*
 **		Base16 encode a given series. Must be BYTES, not UNICODE.
+**		Lines are 32 bytes (64 chars) when brk is set.
 **
 ***********************************************************************/
 {
-	REBCNT count;
 	REBCNT len;
+	REBCNT n;
 	REBYTE *bp;
 	REBYTE *src;
 
 	len = VAL_LEN(value);
 	src = VAL_BIN_DATA(value);
 
-	// Account for hex, lines, and extra syntax:
-	series = Prep_String(series, &bp, len*2 + len/32 + 32);
+	// Hex, line breaks and terminator:
+	series = Prep_String(series, &bp, len * 2 + (brk ? len / 32 + 2 : 0) + 1);
 	// (Note: tail not properly set yet)
 
-	if (len >= 32 && brk) *bp++ = LF;
-	for (count = 1; count <= len; count++) {
-		bp = Form_Hex2(bp, *src++);
-		if (brk && ((count % 32) == 0)) *bp++ = LF;
+	if (!brk) bp = Enbase16_Bytes(bp, src, len);
+	else {
+		if (len >= 32) *bp++ = LF;
+		for (; len > 0; len -= n, src += n) {
+			n = MIN(len, 32);
+			bp = Enbase16_Bytes(bp, src, n);
+			if (n == 32) *bp++ = LF;
+		}
+		if (VAL_LEN(value) >= 32 && *(bp-1) != LF) *bp++ = LF;
 	}
-
-	if ((len >= 32) && brk && *(bp-1) != LF) *bp++ = LF;
 	*bp = 0;
 	
 	SERIES_TAIL(series) = DIFF_PTRS(bp, series->data);
@@ -457,47 +876,146 @@ err:
 */  REBSER *Encode_Base64(REBVAL *value, REBSER *series, REBFLG brk)
 /*
 **		Base64 encode a given series. Must be BYTES, not UNICODE.
+**		Lines are 48 bytes (64 chars) when brk is set.
 **
 ***********************************************************************/
 {
 	REBYTE *p;
 	REBYTE *src;
+	REBYTE *end;
 	REBCNT len;
-	REBINT x, loop;
+	REBCNT groups;	// whole 3 byte groups
+	REBCNT n;
 
 	len = VAL_LEN(value);
-	src = VAL_BIN(value);
-	
-	// slop-factor
-  	series = Prep_String (series, &p, 4 * len / 3 + 2 * (len / 32) + 5);
-	loop = (int) (len / 3) - 1;
-	if (4 * loop > 64 && brk) *p++ = LF;
-
- 	for (x = 0; x <= 3 * loop; x += 3) {
-		*p++ = Enbase64[src[x] >> 2];
-		*p++ = Enbase64[((src[x] & 0x3) << 4) + (src[x + 1] >> 4)];
-		*p++ = Enbase64[((src[x + 1] & 0xF) << 2) + (src[x + 2] >> 6)];
-		*p++ = Enbase64[(src[x + 2] % 0x40)];
-		if ((x+3) % 48 == 0 && brk)
-			*p++ = LF;
+	src = VAL_BIN_DATA(value);
+	end = src + len;
+	groups = len / 3;
+
+	// Chars, line breaks and terminator:
+	series = Prep_String(series, &p, (len + 2) / 3 * 4 + (brk ? groups / 16 + 2 : 0) + 1);
+
+	if (!brk) p = Enbase64_Groups(p, src, len, end);
+	else {
+		if (groups > 17) *p++ = LF;
+		for (n = groups * 3; n > 0; n -= MIN(n, 48), src += 48) {
+			p = Enbase64_Groups(p, src, MIN(n, 48), end);
+			if (n >= 48) *p++ = LF;
+		}
 	}
 
-	if ((len % 3) != 0) {
-		p[2] = p[3] = '=';
-		*p++ = Enbase64[src[x] >> 2];
-		if ((len - x) >= 1)
-			*p++ = Enbase64[((src[x] & 0x3) << 4) + ((len - x) == 1 ? 0 : src[x + 1] >> 4)];
-		else p++;
-		if ((len - x) == 2)
-			*p++ = Enbase64[(src[x + 1] & 0xF) << 2];
-		else p++;
-		p++;
-	}
+	p = Enbase64_Last(p, VAL_BIN_DATA(value) + groups * 3, len % 3);
 
-	if (*(p-1) != LF && x > 49 && brk) *p++ = LF;
+	if (brk && groups > 16 && *(p-1) != LF) *p++ = LF;
 	*p = 0;
 
-	SERIES_TAIL(series) = DIFF_PTRS(p, series->data); /* 4 * (int) (len % 3 ? (len / 3) + 1 : len / 3); */
+	SERIES_TAIL(series) = DIFF_PTRS(p, series->data);
 
 	return series;
 }
+
+
+/***********************************************************************
+**
+*/	REBSER *Make_Base_Stream(REBINT base, REBFLG decode)
+/*
+**		Make the state to encode or decode base 2, 16 or 64 a part
+**		at a time (see Base_Stream). The output has no line breaks.
+**
+***********************************************************************/
+{
+	REBSER *ser;
+	BASE_STREAM *bs;
+
+	if (base != 64 && base != 16 && base != 2) Trap_Num(RE_OUT_OF_RANGE, base);
+
+	ser = Make_Binary(sizeof(BASE_STREAM));
+	bs = (BASE_STREAM*)BIN_HEAD(ser);
+	CLEAR(bs, sizeof(BASE_STREAM));
+	bs->base = base;
+	bs->decode = decode;
+	SERIES_TAIL(ser) = sizeof(BASE_STREAM);
+
+	return ser;
+}
+
+
+/***********************************************************************
+**
+*/	void Base_Stream(REBSER *stream, REBSER *out, REBYTE *data, REBCNT len, REBFLG end)
+/*
+**		Encode or decode a part of the data, adding the result to
+**		the out binary. End adds the base-64 padding, or checks that
+**		decoded data was complete. After it, the stream starts again.
+**
+***********************************************************************/
+{
+	BASE_STREAM *bs = (BASE_STREAM*)BIN_HEAD(stream);
+	REBCNT tail = SERIES_TAIL(out);
+	REBYTE *bp;
+	REBYTE *cp = data;
+	REBYTE held[3];
+	REBCNT n;
+
+	if (bs->decode) {
+		EXPAND_SERIES_TAIL(out, len + DEBASE_SLOP);
+		bp = BIN_SKIP(out, tail);
+		if (bs->base == 64) bp = Debase64_Part(bs, bp, &cp, len, 0);
+		else if (bs->base == 16) bp = Debase16_Part(bs, bp, &cp, len, 0);
+		else bp = Debase2_Part(bs, bp, &cp, len, 0);
+		if (bp && end) {
+			if (bs->base == 64 ? (bs->count || bs->pad == 1) : (bs->count != 0)) bp = 0;
+			bs->count = bs->accum = bs->pad = 0;
+		}
+		if (!bp) {
+			SERIES_TAIL(out) = tail;
+			bs->count = bs->accum = bs->pad = 0;
+			if (len == 0 || cp >= data + len) Trap0(RE_PAST_END);
+			SET_CHAR(DS_RETURN, *cp);
+			Trap1(RE_INVALID_DATA, DS_RETURN);
+		}
+	}
+	else if (bs->base == 64) {
+		EXPAND_SERIES_TAIL(out, (len + 2) / 3 * 4 + 5);
+		bp = BIN_SKIP(out, tail);
+		// Finish a group held from the last part:
+		if (bs->count) {
+			for (; bs->count < 3 && len > 0; len--) {
+				bs->accum = (bs->accum << 8) | *cp++;
+				bs->count++;
+			}
+			if (bs->count == 3) {
+				held[0] = (REBYTE)(bs->accum >> 16);
+				held[1] = (REBYTE)(bs->accum >> 8);
+				held[2] = (REBYTE)bs->accum;
+				bp = Enbase64_Groups(bp, held, 3, held + 3);
+				bs->count = bs->accum = 0;
+			}
+		}
+		n = len - len % 3;
+		bp = Enbase64_Groups(bp, cp, n, cp + len);
+		for (cp += n, len -= n; len > 0; len--) {
+			bs->accum = (bs->accum << 8) | *cp++;
+			bs->count++;
+		}
+		if (end) {
+			held[0] = (REBYTE)(bs->accum >> (bs->count == 2 ? 8 : 0));
+			held[1] = (REBYTE)bs->accum;
+			bp = Enbase64_Last(bp, held, bs->count);
+			bs->count = bs->accum = 0;
+		}
+	}
+	else {
+		EXPAND_SERIES_TAIL(out, len * (bs->base == 16 ? 2 : 8) + 1);
+		bp = BIN_SKIP(out, tail);
+		if (bs->base == 16) bp = Enbase16_Bytes(bp, cp, len);
+		else {
+			for (; len > 0; len--, cp++) {
+				for (n = 0x80; n > 0; n >>= 1) *bp++ = (*cp & n) ? '1' : '0';
+			}
+		}
+	}
+
+	SERIES_TAIL(out) = bp - BIN_HEAD(out);
+	TERM_SERIES(out);
+}
@@ -85,6 +85,8 @@ x*/	RXIARG Value_To_RXI(REBVAL *val)
 		arg.int64 = VAL_INT64(val);
 		break;
 	case RXE_SER:
+		// The host gets the data pointer and may write through it:
+		if (IS_SHARED_SERIES(VAL_SERIES(val))) Unshare_Series(VAL_SERIES(val));
 		arg.series = VAL_SERIES(val);
 		arg.index = VAL_INDEX(val);
 		break;
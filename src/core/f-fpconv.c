@@ -0,0 +1,1178 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  f-fpconv.c
+**  Summary: fast decimal to/from text conversions
+**  Section: functional
+**  Notes:
+**    Fast paths in front of the David Gay code in f-dtoa.c, which is
+**    still used for the rare inputs these cannot decide exactly.
+**
+**    Fast_Dtoa is Grisu3 (Florian Loitsch, "Printing Floating-Point
+**    Numbers Quickly and Accurately with Integers", PLDI 2010). It
+**    gives the same shortest round-trip digits as dtoa mode 0, or
+**    reports failure for about 0.5% of doubles.
+**
+**    Fast_Strtod is the Clinger fast path followed by the Eisel-Lemire
+**    algorithm (Daniel Lemire, "Number Parsing at a Gigabyte per
+**    Second", 2021). It handles up to 19 significant digits.
+**
+**    The tables below were generated with exact integer arithmetic.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+typedef struct {
+	u64 f;
+	REBINT e;
+} DIY_FP;	// f * 2^e
+
+#define DBL_HIDDEN_BIT	U64_C(0x0010000000000000)
+#define DBL_SIG_MASK	U64_C(0x000FFFFFFFFFFFFF)
+#define DBL_EXP_MASK	U64_C(0x7FF0000000000000)
+#define DBL_EXP_BIAS	(0x3FF + 52)
+#define DBL_DENORM_EXP	(1 - DBL_EXP_BIAS)
+
+// Grisu target range for the binary exponent of the scaled value:
+#define MIN_TARGET_EXP	-60
+#define MAX_TARGET_EXP	-32
+
+// Decimal exponent range of Pow5_128 table:
+#define MIN_POW5		-342
+#define MAX_POW5		308
+
+/***********************************************************************
+**
+**  Normalized 64 bit approximations of 10^k (k = -348 to 340 by 8).
+**
+***********************************************************************/
+
+static const struct {u64 f; i16 e; i16 k;} Cached_Powers[] = {
+	{U64_C(0xfa8fd5a0081c0288), -1220, -348},
+	{U64_C(0xbaaee17fa23ebf76), -1193, -340},
+	{U64_C(0x8b16fb203055ac76), -1166, -332},
+	{U64_C(0xcf42894a5dce35ea), -1140, -324},
+	{U64_C(0x9a6bb0aa55653b2d), -1113, -316},
+	{U64_C(0xe61acf033d1a45df), -1087, -308},
+	{U64_C(0xab70fe17c79ac6ca), -1060, -300},
+	{U64_C(0xff77b1fcbebcdc4f), -1034, -292},
+	{U64_C(0xbe5691ef416bd60c), -1007, -284},
+	{U64_C(0x8dd01fad907ffc3c), -980, -276},
+	{U64_C(0xd3515c2831559a83), -954, -268},
+	{U64_C(0x9d71ac8fada6c9b5), -927, -260},
+	{U64_C(0xea9c227723ee8bcb), -901, -252},
+	{U64_C(0xaecc49914078536d), -874, -244},
+	{U64_C(0x823c12795db6ce57), -847, -236},
+	{U64_C(0xc21094364dfb5637), -821, -228},
+	{U64_C(0x9096ea6f3848984f), -794, -220},
+	{U64_C(0xd77485cb25823ac7), -768, -212},
+	{U64_C(0xa086cfcd97bf97f4), -741, -204},
+	{U64_C(0xef340a98172aace5), -715, -196},
+	{U64_C(0xb23867fb2a35b28e), -688, -188},
+	{U64_C(0x84c8d4dfd2c63f3b), -661, -180},
+	{U64_C(0xc5dd44271ad3cdba), -635, -172},
+	{U64_C(0x936b9fcebb25c996), -608, -164},
+	{U64_C(0xdbac6c247d62a584), -582, -156},
+	{U64_C(0xa3ab66580d5fdaf6), -555, -148},
+	{U64_C(0xf3e2f893dec3f126), -529, -140},
+	{U64_C(0xb5b5ada8aaff80b8), -502, -132},
+	{U64_C(0x87625f056c7c4a8b), -475, -124},
+	{U64_C(0xc9bcff6034c13053), -449, -116},
+	{U64_C(0x964e858c91ba2655), -422, -108},
+	{U64_C(0xdff9772470297ebd), -396, -100},
+	{U64_C(0xa6dfbd9fb8e5b88f), -369, -92},
+	{U64_C(0xf8a95fcf88747d94), -343, -84},
+	{U64_C(0xb94470938fa89bcf), -316, -76},
+	{U64_C(0x8a08f0f8bf0f156b), -289, -68},
+	{U64_C(0xcdb02555653131b6), -263, -60},
+	{U64_C(0x993fe2c6d07b7fac), -236, -52},
+	{U64_C(0xe45c10c42a2b3b06), -210, -44},
+	{U64_C(0xaa242499697392d3), -183, -36},
+	{U64_C(0xfd87b5f28300ca0e), -157, -28},
+	{U64_C(0xbce5086492111aeb), -130, -20},
+	{U64_C(0x8cbccc096f5088cc), -103, -12},
+	{U64_C(0xd1b71758e219652c), -77, -4},
+	{U64_C(0x9c40000000000000), -50, 4},
+	{U64_C(0xe8d4a51000000000), -24, 12},
+	{U64_C(0xad78ebc5ac620000), 3, 20},
+	{U64_C(0x813f3978f8940984), 30, 28},
+	{U64_C(0xc097ce7bc90715b3), 56, 36},
+	{U64_C(0x8f7e32ce7bea5c70), 83, 44},
+	{U64_C(0xd5d238a4abe98068), 109, 52},
+	{U64_C(0x9f4f2726179a2245), 136, 60},
+	{U64_C(0xed63a231d4c4fb27), 162, 68},
+	{U64_C(0xb0de65388cc8ada8), 189, 76},
+	{U64_C(0x83c7088e1aab65db), 216, 84},
+	{U64_C(0xc45d1df942711d9a), 242, 92},
+	{U64_C(0x924d692ca61be758), 269, 100},
+	{U64_C(0xda01ee641a708dea), 295, 108},
+	{U64_C(0xa26da3999aef774a), 322, 116},
+	{U64_C(0xf209787bb47d6b85), 348, 124},
+	{U64_C(0xb454e4a179dd1877), 375, 132},
+	{U64_C(0x865b86925b9bc5c2), 402, 140},
+	{U64_C(0xc83553c5c8965d3d), 428, 148},
+	{U64_C(0x952ab45cfa97a0b3), 455, 156},
+	{U64_C(0xde469fbd99a05fe3), 481, 164},
+	{U64_C(0xa59bc234db398c25), 508, 172},
+	{U64_C(0xf6c69a72a3989f5c), 534, 180},
+	{U64_C(0xb7dcbf5354e9bece), 561, 188},
+	{U64_C(0x88fcf317f22241e2), 588, 196},
+	{U64_C(0xcc20ce9bd35c78a5), 614, 204},
+	{U64_C(0x98165af37b2153df), 641, 212},
+	{U64_C(0xe2a0b5dc971f303a), 667, 220},
+	{U64_C(0xa8d9d1535ce3b396), 694, 228},
+	{U64_C(0xfb9b7cd9a4a7443c), 720, 236},
+	{U64_C(0xbb764c4ca7a44410), 747, 244},
+	{U64_C(0x8bab8eefb6409c1a), 774, 252},
+	{U64_C(0xd01fef10a657842c), 800, 260},
+	{U64_C(0x9b10a4e5e9913129), 827, 268},
+	{U64_C(0xe7109bfba19c0c9d), 853, 276},
+	{U64_C(0xac2820d9623bf429), 880, 284},
+	{U64_C(0x80444b5e7aa7cf85), 907, 292},
+	{U64_C(0xbf21e44003acdd2d), 933, 300},
+	{U64_C(0x8e679c2f5e44ff8f), 960, 308},
+	{U64_C(0xd433179d9c8cb841), 986, 316},
+	{U64_C(0x9e19db92b4e31ba9), 1013, 324},
+	{U64_C(0xeb96bf6ebadf77d9), 1039, 332},
+	{U64_C(0xaf87023b9bf0ee6b), 1066, 340}
+};
+
+/***********************************************************************
+**
+**  128 bit truncated approximations of 5^q (q = -342 to 308), as
+**  high and low word pairs, scaled so the top bit is set.
+**
+***********************************************************************/
+
+static const u64 Pow5_128[] = {
+	U64_C(0xeef453d6923bd65a), U64_C(0x113faa2906a13b3f),
+	U64_C(0x9558b4661b6565f8), U64_C(0x4ac7ca59a424c507),
+	U64_C(0xbaaee17fa23ebf76), U64_C(0x5d79bcf00d2df649),
+	U64_C(0xe95a99df8ace6f53), U64_C(0xf4d82c2c107973dc),
+	U64_C(0x91d8a02bb6c10594), U64_C(0x79071b9b8a4be869),
+	U64_C(0xb64ec836a47146f9), U64_C(0x9748e2826cdee284),
+	U64_C(0xe3e27a444d8d98b7), U64_C(0xfd1b1b2308169b25),
+	U64_C(0x8e6d8c6ab0787f72), U64_C(0xfe30f0f5e50e20f7),
+	U64_C(0xb208ef855c969f4f), U64_C(0xbdbd2d335e51a935),
+	U64_C(0xde8b2b66b3bc4723), U64_C(0xad2c788035e61382),
+	U64_C(0x8b16fb203055ac76), U64_C(0x4c3bcb5021afcc31),
+	U64_C(0xaddcb9e83c6b1793), U64_C(0xdf4abe242a1bbf3d),
+	U64_C(0xd953e8624b85dd78), U64_C(0xd71d6dad34a2af0d),
+	U64_C(0x87d4713d6f33aa6b), U64_C(0x8672648c40e5ad68),
+	U64_C(0xa9c98d8ccb009506), U64_C(0x680efdaf511f18c2),
+	U64_C(0xd43bf0effdc0ba48), U64_C(0x0212bd1b2566def2),
+	U64_C(0x84a57695fe98746d), U64_C(0x014bb630f7604b57),
+	U64_C(0xa5ced43b7e3e9188), U64_C(0x419ea3bd35385e2d),
+	U64_C(0xcf42894a5dce35ea), U64_C(0x52064cac828675b9),
+	U64_C(0x818995ce7aa0e1b2), U64_C(0x7343efebd1940993),
+	U64_C(0xa1ebfb4219491a1f), U64_C(0x1014ebe6c5f90bf8),
+	U64_C(0xca66fa129f9b60a6), U64_C(0xd41a26e077774ef6),
+	U64_C(0xfd00b897478238d0), U64_C(0x8920b098955522b4),
+	U64_C(0x9e20735e8cb16382), U64_C(0x55b46e5f5d5535b0),
+	U64_C(0xc5a890362fddbc62), U64_C(0xeb2189f734aa831d),
+	U64_C(0xf712b443bbd52b7b), U64_C(0xa5e9ec7501d523e4),
+	U64_C(0x9a6bb0aa55653b2d), U64_C(0x47b233c92125366e),
+	U64_C(0xc1069cd4eabe89f8), U64_C(0x999ec0bb696e840a),
+	U64_C(0xf148440a256e2c76), U64_C(0xc00670ea43ca250d),
+	U64_C(0x96cd2a865764dbca), U64_C(0x380406926a5e5728),
+	U64_C(0xbc807527ed3e12bc), U64_C(0xc605083704f5ecf2),
+	U64_C(0xeba09271e88d976b), U64_C(0xf7864a44c633682e),
+	U64_C(0x93445b8731587ea3), U64_C(0x7ab3ee6afbe0211d),
+	U64_C(0xb8157268fdae9e4c), U64_C(0x5960ea05bad82964),
+	U64_C(0xe61acf033d1a45df), U64_C(0x6fb92487298e33bd),
+	U64_C(0x8fd0c16206306bab), U64_C(0xa5d3b6d479f8e056),
+	U64_C(0xb3c4f1ba87bc8696), U64_C(0x8f48a4899877186c),
+	U64_C(0xe0b62e2929aba83c), U64_C(0x331acdabfe94de87),
+	U64_C(0x8c71dcd9ba0b4925), U64_C(0x9ff0c08b7f1d0b14),
+	U64_C(0xaf8e5410288e1b6f), U64_C(0x07ecf0ae5ee44dd9),
+	U64_C(0xdb71e91432b1a24a), U64_C(0xc9e82cd9f69d6150),
+	U64_C(0x892731ac9faf056e), U64_C(0xbe311c083a225cd2),
+	U64_C(0xab70fe17c79ac6ca), U64_C(0x6dbd630a48aaf406),
+	U64_C(0xd64d3d9db981787d), U64_C(0x092cbbccdad5b108),
+	U64_C(0x85f0468293f0eb4e), U64_C(0x25bbf56008c58ea5),
+	U64_C(0xa76c582338ed2621), U64_C(0xaf2af2b80af6f24e),
+	U64_C(0xd1476e2c07286faa), U64_C(0x1af5af660db4aee1),
+	U64_C(0x82cca4db847945ca), U64_C(0x50d98d9fc890ed4d),
+	U64_C(0xa37fce126597973c), U64_C(0xe50ff107bab528a0),
+	U64_C(0xcc5fc196fefd7d0c), U64_C(0x1e53ed49a96272c8),
+	U64_C(0xff77b1fcbebcdc4f), U64_C(0x25e8e89c13bb0f7a),
+	U64_C(0x9faacf3df73609b1), U64_C(0x77b191618c54e9ac),
+	U64_C(0xc795830d75038c1d), U64_C(0xd59df5b9ef6a2417),
+	U64_C(0xf97ae3d0d2446f25), U64_C(0x4b0573286b44ad1d),
+	U64_C(0x9becce62836ac577), U64_C(0x4ee367f9430aec32),
+	U64_C(0xc2e801fb244576d5), U64_C(0x229c41f793cda73f),
+	U64_C(0xf3a20279ed56d48a), U64_C(0x6b43527578c1110f),
+	U64_C(0x9845418c345644d6), U64_C(0x830a13896b78aaa9),
+	U64_C(0xbe5691ef416bd60c), U64_C(0x23cc986bc656d553),
+	U64_C(0xedec366b11c6cb8f), U64_C(0x2cbfbe86b7ec8aa8),
+	U64_C(0x94b3a202eb1c3f39), U64_C(0x7bf7d71432f3d6a9),
+	U64_C(0xb9e08a83a5e34f07), U64_C(0xdaf5ccd93fb0cc53),
+	U64_C(0xe858ad248f5c22c9), U64_C(0xd1b3400f8f9cff68),
+	U64_C(0x91376c36d99995be), U64_C(0x23100809b9c21fa1),
+	U64_C(0xb58547448ffffb2d), U64_C(0xabd40a0c2832a78a),
+	U64_C(0xe2e69915b3fff9f9), U64_C(0x16c90c8f323f516c),
+	U64_C(0x8dd01fad907ffc3b), U64_C(0xae3da7d97f6792e3),
+	U64_C(0xb1442798f49ffb4a), U64_C(0x99cd11cfdf41779c),
+	U64_C(0xdd95317f31c7fa1d), U64_C(0x40405643d711d583),
+	U64_C(0x8a7d3eef7f1cfc52), U64_C(0x482835ea666b2572),
+	U64_C(0xad1c8eab5ee43b66), U64_C(0xda3243650005eecf),
+	U64_C(0xd863b256369d4a40), U64_C(0x90bed43e40076a82),
+	U64_C(0x873e4f75e2224e68), U64_C(0x5a7744a6e804a291),
+	U64_C(0xa90de3535aaae202), U64_C(0x711515d0a205cb36),
+	U64_C(0xd3515c2831559a83), U64_C(0x0d5a5b44ca873e03),
+	U64_C(0x8412d9991ed58091), U64_C(0xe858790afe9486c2),
+	U64_C(0xa5178fff668ae0b6), U64_C(0x626e974dbe39a872),
+	U64_C(0xce5d73ff402d98e3), U64_C(0xfb0a3d212dc8128f),
+	U64_C(0x80fa687f881c7f8e), U64_C(0x7ce66634bc9d0b99),
+	U64_C(0xa139029f6a239f72), U64_C(0x1c1fffc1ebc44e80),
+	U64_C(0xc987434744ac874e), U64_C(0xa327ffb266b56220),
+	U64_C(0xfbe9141915d7a922), U64_C(0x4bf1ff9f0062baa8),
+	U64_C(0x9d71ac8fada6c9b5), U64_C(0x6f773fc3603db4a9),
+	U64_C(0xc4ce17b399107c22), U64_C(0xcb550fb4384d21d3),
+	U64_C(0xf6019da07f549b2b), U64_C(0x7e2a53a146606a48),
+	U64_C(0x99c102844f94e0fb), U64_C(0x2eda7444cbfc426d),
+	U64_C(0xc0314325637a1939), U64_C(0xfa911155fefb5308),
+	U64_C(0xf03d93eebc589f88), U64_C(0x793555ab7eba27ca),
+	U64_C(0x96267c7535b763b5), U64_C(0x4bc1558b2f3458de),
+	U64_C(0xbbb01b9283253ca2), U64_C(0x9eb1aaedfb016f16),
+	U64_C(0xea9c227723ee8bcb), U64_C(0x465e15a979c1cadc),
+	U64_C(0x92a1958a7675175f), U64_C(0x0bfacd89ec191ec9),
+	U64_C(0xb749faed14125d36), U64_C(0xcef980ec671f667b),
+	U64_C(0xe51c79a85916f484), U64_C(0x82b7e12780e7401a),
+	U64_C(0x8f31cc0937ae58d2), U64_C(0xd1b2ecb8b0908810),
+	U64_C(0xb2fe3f0b8599ef07), U64_C(0x861fa7e6dcb4aa15),
+	U64_C(0xdfbdcece67006ac9), U64_C(0x67a791e093e1d49a),
+	U64_C(0x8bd6a141006042bd), U64_C(0xe0c8bb2c5c6d24e0),
+	U64_C(0xaecc49914078536d), U64_C(0x58fae9f773886e18),
+	U64_C(0xda7f5bf590966848), U64_C(0xaf39a475506a899e),
+	U64_C(0x888f99797a5e012d), U64_C(0x6d8406c952429603),
+	U64_C(0xaab37fd7d8f58178), U64_C(0xc8e5087ba6d33b83),
+	U64_C(0xd5605fcdcf32e1d6), U64_C(0xfb1e4a9a90880a64),
+	U64_C(0x855c3be0a17fcd26), U64_C(0x5cf2eea09a55067f),
+	U64_C(0xa6b34ad8c9dfc06f), U64_C(0xf42faa48c0ea481e),
+	U64_C(0xd0601d8efc57b08b), U64_C(0xf13b94daf124da26),
+	U64_C(0x823c12795db6ce57), U64_C(0x76c53d08d6b70858),
+	U64_C(0xa2cb1717b52481ed), U64_C(0x54768c4b0c64ca6e),
+	U64_C(0xcb7ddcdda26da268), U64_C(0xa9942f5dcf7dfd09),
+	U64_C(0xfe5d54150b090b02), U64_C(0xd3f93b35435d7c4c),
+	U64_C(0x9efa548d26e5a6e1), U64_C(0xc47bc5014a1a6daf),
+	U64_C(0xc6b8e9b0709f109a), U64_C(0x359ab6419ca1091b),
+	U64_C(0xf867241c8cc6d4c0), U64_C(0xc30163d203c94b62),
+	U64_C(0x9b407691d7fc44f8), U64_C(0x79e0de63425dcf1d),
+	U64_C(0xc21094364dfb5636), U64_C(0x985915fc12f542e4),
+	U64_C(0xf294b943e17a2bc4), U64_C(0x3e6f5b7b17b2939d),
+	U64_C(0x979cf3ca6cec5b5a), U64_C(0xa705992ceecf9c42),
+	U64_C(0xbd8430bd08277231), U64_C(0x50c6ff782a838353),
+	U64_C(0xece53cec4a314ebd), U64_C(0xa4f8bf5635246428),
+	U64_C(0x940f4613ae5ed136), U64_C(0x871b7795e136be99),
+	U64_C(0xb913179899f68584), U64_C(0x28e2557b59846e3f),
+	U64_C(0xe757dd7ec07426e5), U64_C(0x331aeada2fe589cf),
+	U64_C(0x9096ea6f3848984f), U64_C(0x3ff0d2c85def7621),
+	U64_C(0xb4bca50b065abe63), U64_C(0x0fed077a756b53a9),
+	U64_C(0xe1ebce4dc7f16dfb), U64_C(0xd3e8495912c62894),
+	U64_C(0x8d3360f09cf6e4bd), U64_C(0x64712dd7abbbd95c),
+	U64_C(0xb080392cc4349dec), U64_C(0xbd8d794d96aacfb3),
+	U64_C(0xdca04777f541c567), U64_C(0xecf0d7a0fc5583a0),
+	U64_C(0x89e42caaf9491b60), U64_C(0xf41686c49db57244),
+	U64_C(0xac5d37d5b79b6239), U64_C(0x311c2875c522ced5),
+	U64_C(0xd77485cb25823ac7), U64_C(0x7d633293366b828b),
+	U64_C(0x86a8d39ef77164bc), U64_C(0xae5dff9c02033197),
+	U64_C(0xa8530886b54dbdeb), U64_C(0xd9f57f830283fdfc),
+	U64_C(0xd267caa862a12d66), U64_C(0xd072df63c324fd7b),
+	U64_C(0x8380dea93da4bc60), U64_C(0x4247cb9e59f71e6d),
+	U64_C(0xa46116538d0deb78), U64_C(0x52d9be85f074e608),
+	U64_C(0xcd795be870516656), U64_C(0x67902e276c921f8b),
+	U64_C(0x806bd9714632dff6), U64_C(0x00ba1cd8a3db53b6),
+	U64_C(0xa086cfcd97bf97f3), U64_C(0x80e8a40eccd228a4),
+	U64_C(0xc8a883c0fdaf7df0), U64_C(0x6122cd128006b2cd),
+	U64_C(0xfad2a4b13d1b5d6c), U64_C(0x796b805720085f81),
+	U64_C(0x9cc3a6eec6311a63), U64_C(0xcbe3303674053bb0),
+	U64_C(0xc3f490aa77bd60fc), U64_C(0xbedbfc4411068a9c),
+	U64_C(0xf4f1b4d515acb93b), U64_C(0xee92fb5515482d44),
+	U64_C(0x991711052d8bf3c5), U64_C(0x751bdd152d4d1c4a),
+	U64_C(0xbf5cd54678eef0b6), U64_C(0xd262d45a78a0635d),
+	U64_C(0xef340a98172aace4), U64_C(0x86fb897116c87c34),
+	U64_C(0x9580869f0e7aac0e), U64_C(0xd45d35e6ae3d4da0),
+	U64_C(0xbae0a846d2195712), U64_C(0x8974836059cca109),
+	U64_C(0xe998d258869facd7), U64_C(0x2bd1a438703fc94b),
+	U64_C(0x91ff83775423cc06), U64_C(0x7b6306a34627ddcf),
+	U64_C(0xb67f6455292cbf08), U64_C(0x1a3bc84c17b1d542),
+	U64_C(0xe41f3d6a7377eeca), U64_C(0x20caba5f1d9e4a93),
+	U64_C(0x8e938662882af53e), U64_C(0x547eb47b7282ee9c),
+	U64_C(0xb23867fb2a35b28d), U64_C(0xe99e619a4f23aa43),
+	U64_C(0xdec681f9f4c31f31), U64_C(0x6405fa00e2ec94d4),
+	U64_C(0x8b3c113c38f9f37e), U64_C(0xde83bc408dd3dd04),
+	U64_C(0xae0b158b4738705e), U64_C(0x9624ab50b148d445),
+	U64_C(0xd98ddaee19068c76), U64_C(0x3badd624dd9b0957),
+	U64_C(0x87f8a8d4cfa417c9), U64_C(0xe54ca5d70a80e5d6),
+	U64_C(0xa9f6d30a038d1dbc), U64_C(0x5e9fcf4ccd211f4c),
+	U64_C(0xd47487cc8470652b), U64_C(0x7647c3200069671f),
+	U64_C(0x84c8d4dfd2c63f3b), U64_C(0x29ecd9f40041e073),
+	U64_C(0xa5fb0a17c777cf09), U64_C(0xf468107100525890),
+	U64_C(0xcf79cc9db955c2cc), U64_C(0x7182148d4066eeb4),
+	U64_C(0x81ac1fe293d599bf), U64_C(0xc6f14cd848405530),
+	U64_C(0xa21727db38cb002f), U64_C(0xb8ada00e5a506a7c),
+	U64_C(0xca9cf1d206fdc03b), U64_C(0xa6d90811f0e4851c),
+	U64_C(0xfd442e4688bd304a), U64_C(0x908f4a166d1da663),
+	U64_C(0x9e4a9cec15763e2e), U64_C(0x9a598e4e043287fe),
+	U64_C(0xc5dd44271ad3cdba), U64_C(0x40eff1e1853f29fd),
+	U64_C(0xf7549530e188c128), U64_C(0xd12bee59e68ef47c),
+	U64_C(0x9a94dd3e8cf578b9), U64_C(0x82bb74f8301958ce),
+	U64_C(0xc13a148e3032d6e7), U64_C(0xe36a52363c1faf01),
+	U64_C(0xf18899b1bc3f8ca1), U64_C(0xdc44e6c3cb279ac1),
+	U64_C(0x96f5600f15a7b7e5), U64_C(0x29ab103a5ef8c0b9),
+	U64_C(0xbcb2b812db11a5de), U64_C(0x7415d448f6b6f0e7),
+	U64_C(0xebdf661791d60f56), U64_C(0x111b495b3464ad21),
+	U64_C(0x936b9fcebb25c995), U64_C(0xcab10dd900beec34),
+	U64_C(0xb84687c269ef3bfb), U64_C(0x3d5d514f40eea742),
+	U64_C(0xe65829b3046b0afa), U64_C(0x0cb4a5a3112a5112),
+	U64_C(0x8ff71a0fe2c2e6dc), U64_C(0x47f0e785eaba72ab),
+	U64_C(0xb3f4e093db73a093), U64_C(0x59ed216765690f56),
+	U64_C(0xe0f218b8d25088b8), U64_C(0x306869c13ec3532c),
+	U64_C(0x8c974f7383725573), U64_C(0x1e414218c73a13fb),
+	U64_C(0xafbd2350644eeacf), U64_C(0xe5d1929ef90898fa),
+	U64_C(0xdbac6c247d62a583), U64_C(0xdf45f746b74abf39),
+	U64_C(0x894bc396ce5da772), U64_C(0x6b8bba8c328eb783),
+	U64_C(0xab9eb47c81f5114f), U64_C(0x066ea92f3f326564),
+	U64_C(0xd686619ba27255a2), U64_C(0xc80a537b0efefebd),
+	U64_C(0x8613fd0145877585), U64_C(0xbd06742ce95f5f36),
+	U64_C(0xa798fc4196e952e7), U64_C(0x2c48113823b73704),
+	U64_C(0xd17f3b51fca3a7a0), U64_C(0xf75a15862ca504c5),
+	U64_C(0x82ef85133de648c4), U64_C(0x9a984d73dbe722fb),
+	U64_C(0xa3ab66580d5fdaf5), U64_C(0xc13e60d0d2e0ebba),
+	U64_C(0xcc963fee10b7d1b3), U64_C(0x318df905079926a8),
+	U64_C(0xffbbcfe994e5c61f), U64_C(0xfdf17746497f7052),
+	U64_C(0x9fd561f1fd0f9bd3), U64_C(0xfeb6ea8bedefa633),
+	U64_C(0xc7caba6e7c5382c8), U64_C(0xfe64a52ee96b8fc0),
+	U64_C(0xf9bd690a1b68637b), U64_C(0x3dfdce7aa3c673b0),
+	U64_C(0x9c1661a651213e2d), U64_C(0x06bea10ca65c084e),
+	U64_C(0xc31bfa0fe5698db8), U64_C(0x486e494fcff30a62),
+	U64_C(0xf3e2f893dec3f126), U64_C(0x5a89dba3c3efccfa),
+	U64_C(0x986ddb5c6b3a76b7), U64_C(0xf89629465a75e01c),
+	U64_C(0xbe89523386091465), U64_C(0xf6bbb397f1135823),
+	U64_C(0xee2ba6c0678b597f), U64_C(0x746aa07ded582e2c),
+	U64_C(0x94db483840b717ef), U64_C(0xa8c2a44eb4571cdc),
+	U64_C(0xba121a4650e4ddeb), U64_C(0x92f34d62616ce413),
+	U64_C(0xe896a0d7e51e1566), U64_C(0x77b020baf9c81d17),
+	U64_C(0x915e2486ef32cd60), U64_C(0x0ace1474dc1d122e),
+	U64_C(0xb5b5ada8aaff80b8), U64_C(0x0d819992132456ba),
+	U64_C(0xe3231912d5bf60e6), U64_C(0x10e1fff697ed6c69),
+	U64_C(0x8df5efabc5979c8f), U64_C(0xca8d3ffa1ef463c1),
+	U64_C(0xb1736b96b6fd83b3), U64_C(0xbd308ff8a6b17cb2),
+	U64_C(0xddd0467c64bce4a0), U64_C(0xac7cb3f6d05ddbde),
+	U64_C(0x8aa22c0dbef60ee4), U64_C(0x6bcdf07a423aa96b),
+	U64_C(0xad4ab7112eb3929d), U64_C(0x86c16c98d2c953c6),
+	U64_C(0xd89d64d57a607744), U64_C(0xe871c7bf077ba8b7),
+	U64_C(0x87625f056c7c4a8b), U64_C(0x11471cd764ad4972),
+	U64_C(0xa93af6c6c79b5d2d), U64_C(0xd598e40d3dd89bcf),
+	U64_C(0xd389b47879823479), U64_C(0x4aff1d108d4ec2c3),
+	U64_C(0x843610cb4bf160cb), U64_C(0xcedf722a585139ba),
+	U64_C(0xa54394fe1eedb8fe), U64_C(0xc2974eb4ee658828),
+	U64_C(0xce947a3da6a9273e), U64_C(0x733d226229feea32),
+	U64_C(0x811ccc668829b887), U64_C(0x0806357d5a3f525f),
+	U64_C(0xa163ff802a3426a8), U64_C(0xca07c2dcb0cf26f7),
+	U64_C(0xc9bcff6034c13052), U64_C(0xfc89b393dd02f0b5),
+	U64_C(0xfc2c3f3841f17c67), U64_C(0xbbac2078d443ace2),
+	U64_C(0x9d9ba7832936edc0), U64_C(0xd54b944b84aa4c0d),
+	U64_C(0xc5029163f384a931), U64_C(0x0a9e795e65d4df11),
+	U64_C(0xf64335bcf065d37d), U64_C(0x4d4617b5ff4a16d5),
+	U64_C(0x99ea0196163fa42e), U64_C(0x504bced1bf8e4e45),
+	U64_C(0xc06481fb9bcf8d39), U64_C(0xe45ec2862f71e1d6),
+	U64_C(0xf07da27a82c37088), U64_C(0x5d767327bb4e5a4c),
+	U64_C(0x964e858c91ba2655), U64_C(0x3a6a07f8d510f86f),
+	U64_C(0xbbe226efb628afea), U64_C(0x890489f70a55368b),
+	U64_C(0xeadab0aba3b2dbe5), U64_C(0x2b45ac74ccea842e),
+	U64_C(0x92c8ae6b464fc96f), U64_C(0x3b0b8bc90012929d),
+	U64_C(0xb77ada0617e3bbcb), U64_C(0x09ce6ebb40173744),
+	U64_C(0xe55990879ddcaabd), U64_C(0xcc420a6a101d0515),
+	U64_C(0x8f57fa54c2a9eab6), U64_C(0x9fa946824a12232d),
+	U64_C(0xb32df8e9f3546564), U64_C(0x47939822dc96abf9),
+	U64_C(0xdff9772470297ebd), U64_C(0x59787e2b93bc56f7),
+	U64_C(0x8bfbea76c619ef36), U64_C(0x57eb4edb3c55b65a),
+	U64_C(0xaefae51477a06b03), U64_C(0xede622920b6b23f1),
+	U64_C(0xdab99e59958885c4), U64_C(0xe95fab368e45eced),
+	U64_C(0x88b402f7fd75539b), U64_C(0x11dbcb0218ebb414),
+	U64_C(0xaae103b5fcd2a881), U64_C(0xd652bdc29f26a119),
+	U64_C(0xd59944a37c0752a2), U64_C(0x4be76d3346f0495f),
+	U64_C(0x857fcae62d8493a5), U64_C(0x6f70a4400c562ddb),
+	U64_C(0xa6dfbd9fb8e5b88e), U64_C(0xcb4ccd500f6bb952),
+	U64_C(0xd097ad07a71f26b2), U64_C(0x7e2000a41346a7a7),
+	U64_C(0x825ecc24c873782f), U64_C(0x8ed400668c0c28c8),
+	U64_C(0xa2f67f2dfa90563b), U64_C(0x728900802f0f32fa),
+	U64_C(0xcbb41ef979346bca), U64_C(0x4f2b40a03ad2ffb9),
+	U64_C(0xfea126b7d78186bc), U64_C(0xe2f610c84987bfa8),
+	U64_C(0x9f24b832e6b0f436), U64_C(0x0dd9ca7d2df4d7c9),
+	U64_C(0xc6ede63fa05d3143), U64_C(0x91503d1c79720dbb),
+	U64_C(0xf8a95fcf88747d94), U64_C(0x75a44c6397ce912a),
+	U64_C(0x9b69dbe1b548ce7c), U64_C(0xc986afbe3ee11aba),
+	U64_C(0xc24452da229b021b), U64_C(0xfbe85badce996168),
+	U64_C(0xf2d56790ab41c2a2), U64_C(0xfae27299423fb9c3),
+	U64_C(0x97c560ba6b0919a5), U64_C(0xdccd879fc967d41a),
+	U64_C(0xbdb6b8e905cb600f), U64_C(0x5400e987bbc1c920),
+	U64_C(0xed246723473e3813), U64_C(0x290123e9aab23b68),
+	U64_C(0x9436c0760c86e30b), U64_C(0xf9a0b6720aaf6521),
+	U64_C(0xb94470938fa89bce), U64_C(0xf808e40e8d5b3e69),
+	U64_C(0xe7958cb87392c2c2), U64_C(0xb60b1d1230b20e04),
+	U64_C(0x90bd77f3483bb9b9), U64_C(0xb1c6f22b5e6f48c2),
+	U64_C(0xb4ecd5f01a4aa828), U64_C(0x1e38aeb6360b1af3),
+	U64_C(0xe2280b6c20dd5232), U64_C(0x25c6da63c38de1b0),
+	U64_C(0x8d590723948a535f), U64_C(0x579c487e5a38ad0e),
+	U64_C(0xb0af48ec79ace837), U64_C(0x2d835a9df0c6d851),
+	U64_C(0xdcdb1b2798182244), U64_C(0xf8e431456cf88e65),
+	U64_C(0x8a08f0f8bf0f156b), U64_C(0x1b8e9ecb641b58ff),
+	U64_C(0xac8b2d36eed2dac5), U64_C(0xe272467e3d222f3f),
+	U64_C(0xd7adf884aa879177), U64_C(0x5b0ed81dcc6abb0f),
+	U64_C(0x86ccbb52ea94baea), U64_C(0x98e947129fc2b4e9),
+	U64_C(0xa87fea27a539e9a5), U64_C(0x3f2398d747b36224),
+	U64_C(0xd29fe4b18e88640e), U64_C(0x8eec7f0d19a03aad),
+	U64_C(0x83a3eeeef9153e89), U64_C(0x1953cf68300424ac),
+	U64_C(0xa48ceaaab75a8e2b), U64_C(0x5fa8c3423c052dd7),
+	U64_C(0xcdb02555653131b6), U64_C(0x3792f412cb06794d),
+	U64_C(0x808e17555f3ebf11), U64_C(0xe2bbd88bbee40bd0),
+	U64_C(0xa0b19d2ab70e6ed6), U64_C(0x5b6aceaeae9d0ec4),
+	U64_C(0xc8de047564d20a8b), U64_C(0xf245825a5a445275),
+	U64_C(0xfb158592be068d2e), U64_C(0xeed6e2f0f0d56712),
+	U64_C(0x9ced737bb6c4183d), U64_C(0x55464dd69685606b),
+	U64_C(0xc428d05aa4751e4c), U64_C(0xaa97e14c3c26b886),
+	U64_C(0xf53304714d9265df), U64_C(0xd53dd99f4b3066a8),
+	U64_C(0x993fe2c6d07b7fab), U64_C(0xe546a8038efe4029),
+	U64_C(0xbf8fdb78849a5f96), U64_C(0xde98520472bdd033),
+	U64_C(0xef73d256a5c0f77c), U64_C(0x963e66858f6d4440),
+	U64_C(0x95a8637627989aad), U64_C(0xdde7001379a44aa8),
+	U64_C(0xbb127c53b17ec159), U64_C(0x5560c018580d5d52),
+	U64_C(0xe9d71b689dde71af), U64_C(0xaab8f01e6e10b4a6),
+	U64_C(0x9226712162ab070d), U64_C(0xcab3961304ca70e8),
+	U64_C(0xb6b00d69bb55c8d1), U64_C(0x3d607b97c5fd0d22),
+	U64_C(0xe45c10c42a2b3b05), U64_C(0x8cb89a7db77c506a),
+	U64_C(0x8eb98a7a9a5b04e3), U64_C(0x77f3608e92adb242),
+	U64_C(0xb267ed1940f1c61c), U64_C(0x55f038b237591ed3),
+	U64_C(0xdf01e85f912e37a3), U64_C(0x6b6c46dec52f6688),
+	U64_C(0x8b61313bbabce2c6), U64_C(0x2323ac4b3b3da015),
+	U64_C(0xae397d8aa96c1b77), U64_C(0xabec975e0a0d081a),
+	U64_C(0xd9c7dced53c72255), U64_C(0x96e7bd358c904a21),
+	U64_C(0x881cea14545c7575), U64_C(0x7e50d64177da2e54),
+	U64_C(0xaa242499697392d2), U64_C(0xdde50bd1d5d0b9e9),
+	U64_C(0xd4ad2dbfc3d07787), U64_C(0x955e4ec64b44e864),
+	U64_C(0x84ec3c97da624ab4), U64_C(0xbd5af13bef0b113e),
+	U64_C(0xa6274bbdd0fadd61), U64_C(0xecb1ad8aeacdd58e),
+	U64_C(0xcfb11ead453994ba), U64_C(0x67de18eda5814af2),
+	U64_C(0x81ceb32c4b43fcf4), U64_C(0x80eacf948770ced7),
+	U64_C(0xa2425ff75e14fc31), U64_C(0xa1258379a94d028d),
+	U64_C(0xcad2f7f5359a3b3e), U64_C(0x096ee45813a04330),
+	U64_C(0xfd87b5f28300ca0d), U64_C(0x8bca9d6e188853fc),
+	U64_C(0x9e74d1b791e07e48), U64_C(0x775ea264cf55347e),
+	U64_C(0xc612062576589dda), U64_C(0x95364afe032a819e),
+	U64_C(0xf79687aed3eec551), U64_C(0x3a83ddbd83f52205),
+	U64_C(0x9abe14cd44753b52), U64_C(0xc4926a9672793543),
+	U64_C(0xc16d9a0095928a27), U64_C(0x75b7053c0f178294),
+	U64_C(0xf1c90080baf72cb1), U64_C(0x5324c68b12dd6339),
+	U64_C(0x971da05074da7bee), U64_C(0xd3f6fc16ebca5e04),
+	U64_C(0xbce5086492111aea), U64_C(0x88f4bb1ca6bcf585),
+	U64_C(0xec1e4a7db69561a5), U64_C(0x2b31e9e3d06c32e6),
+	U64_C(0x9392ee8e921d5d07), U64_C(0x3aff322e62439fd0),
+	U64_C(0xb877aa3236a4b449), U64_C(0x09befeb9fad487c3),
+	U64_C(0xe69594bec44de15b), U64_C(0x4c2ebe687989a9b4),
+	U64_C(0x901d7cf73ab0acd9), U64_C(0x0f9d37014bf60a11),
+	U64_C(0xb424dc35095cd80f), U64_C(0x538484c19ef38c95),
+	U64_C(0xe12e13424bb40e13), U64_C(0x2865a5f206b06fba),
+	U64_C(0x8cbccc096f5088cb), U64_C(0xf93f87b7442e45d4),
+	U64_C(0xafebff0bcb24aafe), U64_C(0xf78f69a51539d749),
+	U64_C(0xdbe6fecebdedd5be), U64_C(0xb573440e5a884d1c),
+	U64_C(0x89705f4136b4a597), U64_C(0x31680a88f8953031),
+	U64_C(0xabcc77118461cefc), U64_C(0xfdc20d2b36ba7c3e),
+	U64_C(0xd6bf94d5e57a42bc), U64_C(0x3d32907604691b4d),
+	U64_C(0x8637bd05af6c69b5), U64_C(0xa63f9a49c2c1b110),
+	U64_C(0xa7c5ac471b478423), U64_C(0x0fcf80dc33721d54),
+	U64_C(0xd1b71758e219652b), U64_C(0xd3c36113404ea4a9),
+	U64_C(0x83126e978d4fdf3b), U64_C(0x645a1cac083126ea),
+	U64_C(0xa3d70a3d70a3d70a), U64_C(0x3d70a3d70a3d70a4),
+	U64_C(0xcccccccccccccccc), U64_C(0xcccccccccccccccd),
+	U64_C(0x8000000000000000), U64_C(0x0000000000000000),
+	U64_C(0xa000000000000000), U64_C(0x0000000000000000),
+	U64_C(0xc800000000000000), U64_C(0x0000000000000000),
+	U64_C(0xfa00000000000000), U64_C(0x0000000000000000),
+	U64_C(0x9c40000000000000), U64_C(0x0000000000000000),
+	U64_C(0xc350000000000000), U64_C(0x0000000000000000),
+	U64_C(0xf424000000000000), U64_C(0x0000000000000000),
+	U64_C(0x9896800000000000), U64_C(0x0000000000000000),
+	U64_C(0xbebc200000000000), U64_C(0x0000000000000000),
+	U64_C(0xee6b280000000000), U64_C(0x0000000000000000),
+	U64_C(0x9502f90000000000), U64_C(0x0000000000000000),
+	U64_C(0xba43b74000000000), U64_C(0x0000000000000000),
+	U64_C(0xe8d4a51000000000), U64_C(0x0000000000000000),
+	U64_C(0x9184e72a00000000), U64_C(0x0000000000000000),
+	U64_C(0xb5e620f480000000), U64_C(0x0000000000000000),
+	U64_C(0xe35fa931a0000000), U64_C(0x0000000000000000),
+	U64_C(0x8e1bc9bf04000000), U64_C(0x0000000000000000),
+	U64_C(0xb1a2bc2ec5000000), U64_C(0x0000000000000000),
+	U64_C(0xde0b6b3a76400000), U64_C(0x0000000000000000),
+	U64_C(0x8ac7230489e80000), U64_C(0x0000000000000000),
+	U64_C(0xad78ebc5ac620000), U64_C(0x0000000000000000),
+	U64_C(0xd8d726b7177a8000), U64_C(0x0000000000000000),
+	U64_C(0x878678326eac9000), U64_C(0x0000000000000000),
+	U64_C(0xa968163f0a57b400), U64_C(0x0000000000000000),
+	U64_C(0xd3c21bcecceda100), U64_C(0x0000000000000000),
+	U64_C(0x84595161401484a0), U64_C(0x0000000000000000),
+	U64_C(0xa56fa5b99019a5c8), U64_C(0x0000000000000000),
+	U64_C(0xcecb8f27f4200f3a), U64_C(0x0000000000000000),
+	U64_C(0x813f3978f8940984), U64_C(0x4000000000000000),
+	U64_C(0xa18f07d736b90be5), U64_C(0x5000000000000000),
+	U64_C(0xc9f2c9cd04674ede), U64_C(0xa400000000000000),
+	U64_C(0xfc6f7c4045812296), U64_C(0x4d00000000000000),
+	U64_C(0x9dc5ada82b70b59d), U64_C(0xf020000000000000),
+	U64_C(0xc5371912364ce305), U64_C(0x6c28000000000000),
+	U64_C(0xf684df56c3e01bc6), U64_C(0xc732000000000000),
+	U64_C(0x9a130b963a6c115c), U64_C(0x3c7f400000000000),
+	U64_C(0xc097ce7bc90715b3), U64_C(0x4b9f100000000000),
+	U64_C(0xf0bdc21abb48db20), U64_C(0x1e86d40000000000),
+	U64_C(0x96769950b50d88f4), U64_C(0x1314448000000000),
+	U64_C(0xbc143fa4e250eb31), U64_C(0x17d955a000000000),
+	U64_C(0xeb194f8e1ae525fd), U64_C(0x5dcfab0800000000),
+	U64_C(0x92efd1b8d0cf37be), U64_C(0x5aa1cae500000000),
+	U64_C(0xb7abc627050305ad), U64_C(0xf14a3d9e40000000),
+	U64_C(0xe596b7b0c643c719), U64_C(0x6d9ccd05d0000000),
+	U64_C(0x8f7e32ce7bea5c6f), U64_C(0xe4820023a2000000),
+	U64_C(0xb35dbf821ae4f38b), U64_C(0xdda2802c8a800000),
+	U64_C(0xe0352f62a19e306e), U64_C(0xd50b2037ad200000),
+	U64_C(0x8c213d9da502de45), U64_C(0x4526f422cc340000),
+	U64_C(0xaf298d050e4395d6), U64_C(0x9670b12b7f410000),
+	U64_C(0xdaf3f04651d47b4c), U64_C(0x3c0cdd765f114000),
+	U64_C(0x88d8762bf324cd0f), U64_C(0xa5880a69fb6ac800),
+	U64_C(0xab0e93b6efee0053), U64_C(0x8eea0d047a457a00),
+	U64_C(0xd5d238a4abe98068), U64_C(0x72a4904598d6d880),
+	U64_C(0x85a36366eb71f041), U64_C(0x47a6da2b7f864750),
+	U64_C(0xa70c3c40a64e6c51), U64_C(0x999090b65f67d924),
+	U64_C(0xd0cf4b50cfe20765), U64_C(0xfff4b4e3f741cf6d),
+	U64_C(0x82818f1281ed449f), U64_C(0xbff8f10e7a8921a4),
+	U64_C(0xa321f2d7226895c7), U64_C(0xaff72d52192b6a0d),
+	U64_C(0xcbea6f8ceb02bb39), U64_C(0x9bf4f8a69f764490),
+	U64_C(0xfee50b7025c36a08), U64_C(0x02f236d04753d5b4),
+	U64_C(0x9f4f2726179a2245), U64_C(0x01d762422c946590),
+	U64_C(0xc722f0ef9d80aad6), U64_C(0x424d3ad2b7b97ef5),
+	U64_C(0xf8ebad2b84e0d58b), U64_C(0xd2e0898765a7deb2),
+	U64_C(0x9b934c3b330c8577), U64_C(0x63cc55f49f88eb2f),
+	U64_C(0xc2781f49ffcfa6d5), U64_C(0x3cbf6b71c76b25fb),
+	U64_C(0xf316271c7fc3908a), U64_C(0x8bef464e3945ef7a),
+	U64_C(0x97edd871cfda3a56), U64_C(0x97758bf0e3cbb5ac),
+	U64_C(0xbde94e8e43d0c8ec), U64_C(0x3d52eeed1cbea317),
+	U64_C(0xed63a231d4c4fb27), U64_C(0x4ca7aaa863ee4bdd),
+	U64_C(0x945e455f24fb1cf8), U64_C(0x8fe8caa93e74ef6a),
+	U64_C(0xb975d6b6ee39e436), U64_C(0xb3e2fd538e122b44),
+	U64_C(0xe7d34c64a9c85d44), U64_C(0x60dbbca87196b616),
+	U64_C(0x90e40fbeea1d3a4a), U64_C(0xbc8955e946fe31cd),
+	U64_C(0xb51d13aea4a488dd), U64_C(0x6babab6398bdbe41),
+	U64_C(0xe264589a4dcdab14), U64_C(0xc696963c7eed2dd1),
+	U64_C(0x8d7eb76070a08aec), U64_C(0xfc1e1de5cf543ca2),
+	U64_C(0xb0de65388cc8ada8), U64_C(0x3b25a55f43294bcb),
+	U64_C(0xdd15fe86affad912), U64_C(0x49ef0eb713f39ebe),
+	U64_C(0x8a2dbf142dfcc7ab), U64_C(0x6e3569326c784337),
+	U64_C(0xacb92ed9397bf996), U64_C(0x49c2c37f07965404),
+	U64_C(0xd7e77a8f87daf7fb), U64_C(0xdc33745ec97be906),
+	U64_C(0x86f0ac99b4e8dafd), U64_C(0x69a028bb3ded71a3),
+	U64_C(0xa8acd7c0222311bc), U64_C(0xc40832ea0d68ce0c),
+	U64_C(0xd2d80db02aabd62b), U64_C(0xf50a3fa490c30190),
+	U64_C(0x83c7088e1aab65db), U64_C(0x792667c6da79e0fa),
+	U64_C(0xa4b8cab1a1563f52), U64_C(0x577001b891185938),
+	U64_C(0xcde6fd5e09abcf26), U64_C(0xed4c0226b55e6f86),
+	U64_C(0x80b05e5ac60b6178), U64_C(0x544f8158315b05b4),
+	U64_C(0xa0dc75f1778e39d6), U64_C(0x696361ae3db1c721),
+	U64_C(0xc913936dd571c84c), U64_C(0x03bc3a19cd1e38e9),
+	U64_C(0xfb5878494ace3a5f), U64_C(0x04ab48a04065c723),
+	U64_C(0x9d174b2dcec0e47b), U64_C(0x62eb0d64283f9c76),
+	U64_C(0xc45d1df942711d9a), U64_C(0x3ba5d0bd324f8394),
+	U64_C(0xf5746577930d6500), U64_C(0xca8f44ec7ee36479),
+	U64_C(0x9968bf6abbe85f20), U64_C(0x7e998b13cf4e1ecb),
+	U64_C(0xbfc2ef456ae276e8), U64_C(0x9e3fedd8c321a67e),
+	U64_C(0xefb3ab16c59b14a2), U64_C(0xc5cfe94ef3ea101e),
+	U64_C(0x95d04aee3b80ece5), U64_C(0xbba1f1d158724a12),
+	U64_C(0xbb445da9ca61281f), U64_C(0x2a8a6e45ae8edc97),
+	U64_C(0xea1575143cf97226), U64_C(0xf52d09d71a3293bd),
+	U64_C(0x924d692ca61be758), U64_C(0x593c2626705f9c56),
+	U64_C(0xb6e0c377cfa2e12e), U64_C(0x6f8b2fb00c77836c),
+	U64_C(0xe498f455c38b997a), U64_C(0x0b6dfb9c0f956447),
+	U64_C(0x8edf98b59a373fec), U64_C(0x4724bd4189bd5eac),
+	U64_C(0xb2977ee300c50fe7), U64_C(0x58edec91ec2cb657),
+	U64_C(0xdf3d5e9bc0f653e1), U64_C(0x2f2967b66737e3ed),
+	U64_C(0x8b865b215899f46c), U64_C(0xbd79e0d20082ee74),
+	U64_C(0xae67f1e9aec07187), U64_C(0xecd8590680a3aa11),
+	U64_C(0xda01ee641a708de9), U64_C(0xe80e6f4820cc9495),
+	U64_C(0x884134fe908658b2), U64_C(0x3109058d147fdcdd),
+	U64_C(0xaa51823e34a7eede), U64_C(0xbd4b46f0599fd415),
+	U64_C(0xd4e5e2cdc1d1ea96), U64_C(0x6c9e18ac7007c91a),
+	U64_C(0x850fadc09923329e), U64_C(0x03e2cf6bc604ddb0),
+	U64_C(0xa6539930bf6bff45), U64_C(0x84db8346b786151c),
+	U64_C(0xcfe87f7cef46ff16), U64_C(0xe612641865679a63),
+	U64_C(0x81f14fae158c5f6e), U64_C(0x4fcb7e8f3f60c07e),
+	U64_C(0xa26da3999aef7749), U64_C(0xe3be5e330f38f09d),
+	U64_C(0xcb090c8001ab551c), U64_C(0x5cadf5bfd3072cc5),
+	U64_C(0xfdcb4fa002162a63), U64_C(0x73d9732fc7c8f7f6),
+	U64_C(0x9e9f11c4014dda7e), U64_C(0x2867e7fddcdd9afa),
+	U64_C(0xc646d63501a1511d), U64_C(0xb281e1fd541501b8),
+	U64_C(0xf7d88bc24209a565), U64_C(0x1f225a7ca91a4226),
+	U64_C(0x9ae757596946075f), U64_C(0x3375788de9b06958),
+	U64_C(0xc1a12d2fc3978937), U64_C(0x0052d6b1641c83ae),
+	U64_C(0xf209787bb47d6b84), U64_C(0xc0678c5dbd23a49a),
+	U64_C(0x9745eb4d50ce6332), U64_C(0xf840b7ba963646e0),
+	U64_C(0xbd176620a501fbff), U64_C(0xb650e5a93bc3d898),
+	U64_C(0xec5d3fa8ce427aff), U64_C(0xa3e51f138ab4cebe),
+	U64_C(0x93ba47c980e98cdf), U64_C(0xc66f336c36b10137),
+	U64_C(0xb8a8d9bbe123f017), U64_C(0xb80b0047445d4184),
+	U64_C(0xe6d3102ad96cec1d), U64_C(0xa60dc059157491e5),
+	U64_C(0x9043ea1ac7e41392), U64_C(0x87c89837ad68db2f),
+	U64_C(0xb454e4a179dd1877), U64_C(0x29babe4598c311fb),
+	U64_C(0xe16a1dc9d8545e94), U64_C(0xf4296dd6fef3d67a),
+	U64_C(0x8ce2529e2734bb1d), U64_C(0x1899e4a65f58660c),
+	U64_C(0xb01ae745b101e9e4), U64_C(0x5ec05dcff72e7f8f),
+	U64_C(0xdc21a1171d42645d), U64_C(0x76707543f4fa1f73),
+	U64_C(0x899504ae72497eba), U64_C(0x6a06494a791c53a8),
+	U64_C(0xabfa45da0edbde69), U64_C(0x0487db9d17636892),
+	U64_C(0xd6f8d7509292d603), U64_C(0x45a9d2845d3c42b6),
+	U64_C(0x865b86925b9bc5c2), U64_C(0x0b8a2392ba45a9b2),
+	U64_C(0xa7f26836f282b732), U64_C(0x8e6cac7768d7141e),
+	U64_C(0xd1ef0244af2364ff), U64_C(0x3207d795430cd926),
+	U64_C(0x8335616aed761f1f), U64_C(0x7f44e6bd49e807b8),
+	U64_C(0xa402b9c5a8d3a6e7), U64_C(0x5f16206c9c6209a6),
+	U64_C(0xcd036837130890a1), U64_C(0x36dba887c37a8c0f),
+	U64_C(0x802221226be55a64), U64_C(0xc2494954da2c9789),
+	U64_C(0xa02aa96b06deb0fd), U64_C(0xf2db9baa10b7bd6c),
+	U64_C(0xc83553c5c8965d3d), U64_C(0x6f92829494e5acc7),
+	U64_C(0xfa42a8b73abbf48c), U64_C(0xcb772339ba1f17f9),
+	U64_C(0x9c69a97284b578d7), U64_C(0xff2a760414536efb),
+	U64_C(0xc38413cf25e2d70d), U64_C(0xfef5138519684aba),
+	U64_C(0xf46518c2ef5b8cd1), U64_C(0x7eb258665fc25d69),
+	U64_C(0x98bf2f79d5993802), U64_C(0xef2f773ffbd97a61),
+	U64_C(0xbeeefb584aff8603), U64_C(0xaafb550ffacfd8fa),
+	U64_C(0xeeaaba2e5dbf6784), U64_C(0x95ba2a53f983cf38),
+	U64_C(0x952ab45cfa97a0b2), U64_C(0xdd945a747bf26183),
+	U64_C(0xba756174393d88df), U64_C(0x94f971119aeef9e4),
+	U64_C(0xe912b9d1478ceb17), U64_C(0x7a37cd5601aab85d),
+	U64_C(0x91abb422ccb812ee), U64_C(0xac62e055c10ab33a),
+	U64_C(0xb616a12b7fe617aa), U64_C(0x577b986b314d6009),
+	U64_C(0xe39c49765fdf9d94), U64_C(0xed5a7e85fda0b80b),
+	U64_C(0x8e41ade9fbebc27d), U64_C(0x14588f13be847307),
+	U64_C(0xb1d219647ae6b31c), U64_C(0x596eb2d8ae258fc8),
+	U64_C(0xde469fbd99a05fe3), U64_C(0x6fca5f8ed9aef3bb),
+	U64_C(0x8aec23d680043bee), U64_C(0x25de7bb9480d5854),
+	U64_C(0xada72ccc20054ae9), U64_C(0xaf561aa79a10ae6a),
+	U64_C(0xd910f7ff28069da4), U64_C(0x1b2ba1518094da04),
+	U64_C(0x87aa9aff79042286), U64_C(0x90fb44d2f05d0842),
+	U64_C(0xa99541bf57452b28), U64_C(0x353a1607ac744a53),
+	U64_C(0xd3fa922f2d1675f2), U64_C(0x42889b8997915ce8),
+	U64_C(0x847c9b5d7c2e09b7), U64_C(0x69956135febada11),
+	U64_C(0xa59bc234db398c25), U64_C(0x43fab9837e699095),
+	U64_C(0xcf02b2c21207ef2e), U64_C(0x94f967e45e03f4bb),
+	U64_C(0x8161afb94b44f57d), U64_C(0x1d1be0eebac278f5),
+	U64_C(0xa1ba1ba79e1632dc), U64_C(0x6462d92a69731732),
+	U64_C(0xca28a291859bbf93), U64_C(0x7d7b8f7503cfdcfe),
+	U64_C(0xfcb2cb35e702af78), U64_C(0x5cda735244c3d43e),
+	U64_C(0x9defbf01b061adab), U64_C(0x3a0888136afa64a7),
+	U64_C(0xc56baec21c7a1916), U64_C(0x088aaa1845b8fdd0),
+	U64_C(0xf6c69a72a3989f5b), U64_C(0x8aad549e57273d45),
+	U64_C(0x9a3c2087a63f6399), U64_C(0x36ac54e2f678864b),
+	U64_C(0xc0cb28a98fcf3c7f), U64_C(0x84576a1bb416a7dd),
+	U64_C(0xf0fdf2d3f3c30b9f), U64_C(0x656d44a2a11c51d5),
+	U64_C(0x969eb7c47859e743), U64_C(0x9f644ae5a4b1b325),
+	U64_C(0xbc4665b596706114), U64_C(0x873d5d9f0dde1fee),
+	U64_C(0xeb57ff22fc0c7959), U64_C(0xa90cb506d155a7ea),
+	U64_C(0x9316ff75dd87cbd8), U64_C(0x09a7f12442d588f2),
+	U64_C(0xb7dcbf5354e9bece), U64_C(0x0c11ed6d538aeb2f),
+	U64_C(0xe5d3ef282a242e81), U64_C(0x8f1668c8a86da5fa),
+	U64_C(0x8fa475791a569d10), U64_C(0xf96e017d694487bc),
+	U64_C(0xb38d92d760ec4455), U64_C(0x37c981dcc395a9ac),
+	U64_C(0xe070f78d3927556a), U64_C(0x85bbe253f47b1417),
+	U64_C(0x8c469ab843b89562), U64_C(0x93956d7478ccec8e),
+	U64_C(0xaf58416654a6babb), U64_C(0x387ac8d1970027b2),
+	U64_C(0xdb2e51bfe9d0696a), U64_C(0x06997b05fcc0319e),
+	U64_C(0x88fcf317f22241e2), U64_C(0x441fece3bdf81f03),
+	U64_C(0xab3c2fddeeaad25a), U64_C(0xd527e81cad7626c3),
+	U64_C(0xd60b3bd56a5586f1), U64_C(0x8a71e223d8d3b074),
+	U64_C(0x85c7056562757456), U64_C(0xf6872d5667844e49),
+	U64_C(0xa738c6bebb12d16c), U64_C(0xb428f8ac016561db),
+	U64_C(0xd106f86e69d785c7), U64_C(0xe13336d701beba52),
+	U64_C(0x82a45b450226b39c), U64_C(0xecc0024661173473),
+	U64_C(0xa34d721642b06084), U64_C(0x27f002d7f95d0190),
+	U64_C(0xcc20ce9bd35c78a5), U64_C(0x31ec038df7b441f4),
+	U64_C(0xff290242c83396ce), U64_C(0x7e67047175a15271),
+	U64_C(0x9f79a169bd203e41), U64_C(0x0f0062c6e984d386),
+	U64_C(0xc75809c42c684dd1), U64_C(0x52c07b78a3e60868),
+	U64_C(0xf92e0c3537826145), U64_C(0xa7709a56ccdf8a82),
+	U64_C(0x9bbcc7a142b17ccb), U64_C(0x88a66076400bb691),
+	U64_C(0xc2abf989935ddbfe), U64_C(0x6acff893d00ea435),
+	U64_C(0xf356f7ebf83552fe), U64_C(0x0583f6b8c4124d43),
+	U64_C(0x98165af37b2153de), U64_C(0xc3727a337a8b704a),
+	U64_C(0xbe1bf1b059e9a8d6), U64_C(0x744f18c0592e4c5c),
+	U64_C(0xeda2ee1c7064130c), U64_C(0x1162def06f79df73),
+	U64_C(0x9485d4d1c63e8be7), U64_C(0x8addcb5645ac2ba8),
+	U64_C(0xb9a74a0637ce2ee1), U64_C(0x6d953e2bd7173692),
+	U64_C(0xe8111c87c5c1ba99), U64_C(0xc8fa8db6ccdd0437),
+	U64_C(0x910ab1d4db9914a0), U64_C(0x1d9c9892400a22a2),
+	U64_C(0xb54d5e4a127f59c8), U64_C(0x2503beb6d00cab4b),
+	U64_C(0xe2a0b5dc971f303a), U64_C(0x2e44ae64840fd61d),
+	U64_C(0x8da471a9de737e24), U64_C(0x5ceaecfed289e5d2),
+	U64_C(0xb10d8e1456105dad), U64_C(0x7425a83e872c5f47),
+	U64_C(0xdd50f1996b947518), U64_C(0xd12f124e28f77719),
+	U64_C(0x8a5296ffe33cc92f), U64_C(0x82bd6b70d99aaa6f),
+	U64_C(0xace73cbfdc0bfb7b), U64_C(0x636cc64d1001550b),
+	U64_C(0xd8210befd30efa5a), U64_C(0x3c47f7e05401aa4e),
+	U64_C(0x8714a775e3e95c78), U64_C(0x65acfaec34810a71),
+	U64_C(0xa8d9d1535ce3b396), U64_C(0x7f1839a741a14d0d),
+	U64_C(0xd31045a8341ca07c), U64_C(0x1ede48111209a050),
+	U64_C(0x83ea2b892091e44d), U64_C(0x934aed0aab460432),
+	U64_C(0xa4e4b66b68b65d60), U64_C(0xf81da84d5617853f),
+	U64_C(0xce1de40642e3f4b9), U64_C(0x36251260ab9d668e),
+	U64_C(0x80d2ae83e9ce78f3), U64_C(0xc1d72b7c6b426019),
+	U64_C(0xa1075a24e4421730), U64_C(0xb24cf65b8612f81f),
+	U64_C(0xc94930ae1d529cfc), U64_C(0xdee033f26797b627),
+	U64_C(0xfb9b7cd9a4a7443c), U64_C(0x169840ef017da3b1),
+	U64_C(0x9d412e0806e88aa5), U64_C(0x8e1f289560ee864e),
+	U64_C(0xc491798a08a2ad4e), U64_C(0xf1a6f2bab92a27e2),
+	U64_C(0xf5b5d7ec8acb58a2), U64_C(0xae10af696774b1db),
+	U64_C(0x9991a6f3d6bf1765), U64_C(0xacca6da1e0a8ef29),
+	U64_C(0xbff610b0cc6edd3f), U64_C(0x17fd090a58d32af3),
+	U64_C(0xeff394dcff8a948e), U64_C(0xddfc4b4cef07f5b0),
+	U64_C(0x95f83d0a1fb69cd9), U64_C(0x4abdaf101564f98e),
+	U64_C(0xbb764c4ca7a4440f), U64_C(0x9d6d1ad41abe37f1),
+	U64_C(0xea53df5fd18d5513), U64_C(0x84c86189216dc5ed),
+	U64_C(0x92746b9be2f8552c), U64_C(0x32fd3cf5b4e49bb4),
+	U64_C(0xb7118682dbb66a77), U64_C(0x3fbc8c33221dc2a1),
+	U64_C(0xe4d5e82392a40515), U64_C(0x0fabaf3feaa5334a),
+	U64_C(0x8f05b1163ba6832d), U64_C(0x29cb4d87f2a7400e),
+	U64_C(0xb2c71d5bca9023f8), U64_C(0x743e20e9ef511012),
+	U64_C(0xdf78e4b2bd342cf6), U64_C(0x914da9246b255416),
+	U64_C(0x8bab8eefb6409c1a), U64_C(0x1ad089b6c2f7548e),
+	U64_C(0xae9672aba3d0c320), U64_C(0xa184ac2473b529b1),
+	U64_C(0xda3c0f568cc4f3e8), U64_C(0xc9e5d72d90a2741e),
+	U64_C(0x8865899617fb1871), U64_C(0x7e2fa67c7a658892),
+	U64_C(0xaa7eebfb9df9de8d), U64_C(0xddbb901b98feeab7),
+	U64_C(0xd51ea6fa85785631), U64_C(0x552a74227f3ea565),
+	U64_C(0x8533285c936b35de), U64_C(0xd53a88958f87275f),
+	U64_C(0xa67ff273b8460356), U64_C(0x8a892abaf368f137),
+	U64_C(0xd01fef10a657842c), U64_C(0x2d2b7569b0432d85),
+	U64_C(0x8213f56a67f6b29b), U64_C(0x9c3b29620e29fc73),
+	U64_C(0xa298f2c501f45f42), U64_C(0x8349f3ba91b47b8f),
+	U64_C(0xcb3f2f7642717713), U64_C(0x241c70a936219a73),
+	U64_C(0xfe0efb53d30dd4d7), U64_C(0xed238cd383aa0110),
+	U64_C(0x9ec95d1463e8a506), U64_C(0xf4363804324a40aa),
+	U64_C(0xc67bb4597ce2ce48), U64_C(0xb143c6053edcd0d5),
+	U64_C(0xf81aa16fdc1b81da), U64_C(0xdd94b7868e94050a),
+	U64_C(0x9b10a4e5e9913128), U64_C(0xca7cf2b4191c8326),
+	U64_C(0xc1d4ce1f63f57d72), U64_C(0xfd1c2f611f63a3f0),
+	U64_C(0xf24a01a73cf2dccf), U64_C(0xbc633b39673c8cec),
+	U64_C(0x976e41088617ca01), U64_C(0xd5be0503e085d813),
+	U64_C(0xbd49d14aa79dbc82), U64_C(0x4b2d8644d8a74e18),
+	U64_C(0xec9c459d51852ba2), U64_C(0xddf8e7d60ed1219e),
+	U64_C(0x93e1ab8252f33b45), U64_C(0xcabb90e5c942b503),
+	U64_C(0xb8da1662e7b00a17), U64_C(0x3d6a751f3b936243),
+	U64_C(0xe7109bfba19c0c9d), U64_C(0x0cc512670a783ad4),
+	U64_C(0x906a617d450187e2), U64_C(0x27fb2b80668b24c5),
+	U64_C(0xb484f9dc9641e9da), U64_C(0xb1f9f660802dedf6),
+	U64_C(0xe1a63853bbd26451), U64_C(0x5e7873f8a0396973),
+	U64_C(0x8d07e33455637eb2), U64_C(0xdb0b487b6423e1e8),
+	U64_C(0xb049dc016abc5e5f), U64_C(0x91ce1a9a3d2cda62),
+	U64_C(0xdc5c5301c56b75f7), U64_C(0x7641a140cc7810fb),
+	U64_C(0x89b9b3e11b6329ba), U64_C(0xa9e904c87fcb0a9d),
+	U64_C(0xac2820d9623bf429), U64_C(0x546345fa9fbdcd44),
+	U64_C(0xd732290fbacaf133), U64_C(0xa97c177947ad4095),
+	U64_C(0x867f59a9d4bed6c0), U64_C(0x49ed8eabcccc485d),
+	U64_C(0xa81f301449ee8c70), U64_C(0x5c68f256bfff5a74),
+	U64_C(0xd226fc195c6a2f8c), U64_C(0x73832eec6fff3111),
+	U64_C(0x83585d8fd9c25db7), U64_C(0xc831fd53c5ff7eab),
+	U64_C(0xa42e74f3d032f525), U64_C(0xba3e7ca8b77f5e55),
+	U64_C(0xcd3a1230c43fb26f), U64_C(0x28ce1bd2e55f35eb),
+	U64_C(0x80444b5e7aa7cf85), U64_C(0x7980d163cf5b81b3),
+	U64_C(0xa0555e361951c366), U64_C(0xd7e105bcc332621f),
+	U64_C(0xc86ab5c39fa63440), U64_C(0x8dd9472bf3fefaa7),
+	U64_C(0xfa856334878fc150), U64_C(0xb14f98f6f0feb951),
+	U64_C(0x9c935e00d4b9d8d2), U64_C(0x6ed1bf9a569f33d3),
+	U64_C(0xc3b8358109e84f07), U64_C(0x0a862f80ec4700c8),
+	U64_C(0xf4a642e14c6262c8), U64_C(0xcd27bb612758c0fa),
+	U64_C(0x98e7e9cccfbd7dbd), U64_C(0x8038d51cb897789c),
+	U64_C(0xbf21e44003acdd2c), U64_C(0xe0470a63e6bd56c3),
+	U64_C(0xeeea5d5004981478), U64_C(0x1858ccfce06cac74),
+	U64_C(0x95527a5202df0ccb), U64_C(0x0f37801e0c43ebc8),
+	U64_C(0xbaa718e68396cffd), U64_C(0xd30560258f54e6ba),
+	U64_C(0xe950df20247c83fd), U64_C(0x47c6b82ef32a2069),
+	U64_C(0x91d28b7416cdd27e), U64_C(0x4cdc331d57fa5441),
+	U64_C(0xb6472e511c81471d), U64_C(0xe0133fe4adf8e952),
+	U64_C(0xe3d8f9e563a198e5), U64_C(0x58180fddd97723a6),
+	U64_C(0x8e679c2f5e44ff8f), U64_C(0x570f09eaa7ea7648)
+};
+
+static const u32 Small_Powers_10[] = {
+	0, 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+	1000000000
+};
+
+static const double Exact_Powers_10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+
+/***********************************************************************
+**
+*/	static void Mul_64(u64 a, u64 b, u64 *hi, u64 *lo)
+/*
+**		Full 64 x 64 to 128 bit unsigned multiply.
+**
+***********************************************************************/
+{
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 r = (unsigned __int128)a * b;
+	*hi = (u64)(r >> 64);
+	*lo = (u64)r;
+#else
+	u64 a_lo = (u32)a, a_hi = a >> 32;
+	u64 b_lo = (u32)b, b_hi = b >> 32;
+	u64 p0 = a_lo * b_lo;
+	u64 p1 = a_lo * b_hi;
+	u64 p2 = a_hi * b_lo;
+	u64 p3 = a_hi * b_hi;
+	u64 mid = (p0 >> 32) + (u32)p1 + (u32)p2;
+	*lo = (mid << 32) | (u32)p0;
+	*hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+#endif
+}
+
+
+/***********************************************************************
+**
+*/	static DIY_FP Mul_Diy(DIY_FP x, DIY_FP y)
+/*
+**		Multiply keeping the rounded upper 64 bits.
+**
+***********************************************************************/
+{
+	DIY_FP r;
+	u64 hi, lo;
+
+	Mul_64(x.f, y.f, &hi, &lo);
+	r.f = hi + (lo >> 63);
+	r.e = x.e + y.e + 64;
+	return r;
+}
+
+
+/***********************************************************************
+**
+*/	static DIY_FP Normalize_Diy(DIY_FP x)
+/*
+***********************************************************************/
+{
+	while (!(x.f & U64_C(0xFFC0000000000000))) {
+		x.f <<= 10;
+		x.e -= 10;
+	}
+	while (!(x.f & U64_C(0x8000000000000000))) {
+		x.f <<= 1;
+		x.e--;
+	}
+	return x;
+}
+
+
+/***********************************************************************
+**
+*/	static REBOOL Round_Weed(REBYTE *buf, REBINT len, u64 dist_high_w, u64 unsafe, u64 rest, u64 ten_kappa, u64 unit)
+/*
+**		Move the last digit toward w, then verify that the result
+**		is the unique closest shortest candidate.
+**
+***********************************************************************/
+{
+	u64 small_dist = dist_high_w - unit;
+	u64 big_dist = dist_high_w + unit;
+
+	while (
+		rest < small_dist
+		&& unsafe - rest >= ten_kappa
+		&& (rest + ten_kappa < small_dist || small_dist - rest >= rest + ten_kappa - small_dist)
+	) {
+		buf[len - 1]--;
+		rest += ten_kappa;
+	}
+
+	if (
+		rest < big_dist
+		&& unsafe - rest >= ten_kappa
+		&& (rest + ten_kappa < big_dist || big_dist - rest > rest + ten_kappa - big_dist)
+	) return FALSE;
+
+	return (2 * unit <= rest) && (rest <= unsafe - 4 * unit);
+}
+
+
+/***********************************************************************
+**
+*/	static REBOOL Digit_Gen(DIY_FP low, DIY_FP w, DIY_FP high, REBYTE *buf, REBINT *len, REBINT *kappa)
+/*
+**		Generate the shortest digits in the (scaled) interval.
+**
+***********************************************************************/
+{
+	u64 unit = 1;
+	u64 too_low = low.f - unit;
+	u64 too_high = high.f + unit;
+	u64 unsafe = too_high - too_low;
+	REBINT shift = -w.e;
+	u64 one = (u64)1 << shift;
+	u32 integrals = (u32)(too_high >> shift);
+	u64 fractionals = too_high & (one - 1);
+	u32 divisor;
+	REBINT n;
+	u64 rest;
+
+	// Biggest power of ten not above integrals:
+	n = ((64 - shift + 1) * 1233 >> 12) + 1;
+	if (integrals < Small_Powers_10[n]) n--;
+	divisor = Small_Powers_10[n];
+	*kappa = n;
+	*len = 0;
+
+	while (*kappa > 0) {
+		buf[(*len)++] = (REBYTE)('0' + integrals / divisor);
+		integrals %= divisor;
+		(*kappa)--;
+		rest = ((u64)integrals << shift) + fractionals;
+		if (rest < unsafe)
+			return Round_Weed(buf, *len, too_high - w.f, unsafe, rest, (u64)divisor << shift, unit);
+		divisor /= 10;
+	}
+
+	while (TRUE) {
+		fractionals *= 10;
+		unit *= 10;
+		unsafe *= 10;
+		buf[(*len)++] = (REBYTE)('0' + (fractionals >> shift));
+		fractionals &= one - 1;
+		(*kappa)--;
+		if (fractionals < unsafe)
+			return Round_Weed(buf, *len, (too_high - w.f) * unit, unsafe, fractionals, one, unit);
+	}
+}
+
+
+/***********************************************************************
+**
+*/	REBINT Fast_Dtoa(REBDEC d, REBYTE *buf, REBINT *decpt)
+/*
+**		Shortest digits that read back as the same decimal. Puts
+**		the digits (no sign, no trailing zeros) into buf, which must
+**		hold 18 bytes, and the decimal point position into decpt, as
+**		dtoa() mode 0 would do.
+**
+**		Returns the number of digits, or zero when the value is not
+**		handled (zero, INF, NaN, or a case Grisu3 cannot decide), in
+**		which case the caller should use dtoa().
+**
+***********************************************************************/
+{
+	union {REBDEC d; u64 u;} bits;
+	DIY_FP w, m_plus, m_minus, c_mk, sw, sm, sp;
+	REBINT exp, idx, len, kappa, k;
+
+	bits.d = d;
+	if ((bits.u & DBL_EXP_MASK) == DBL_EXP_MASK) return 0; // INF, NaN
+	if (!(bits.u & ~U64_C(0x8000000000000000))) return 0; // +/- zero
+
+	exp = (REBINT)((bits.u & DBL_EXP_MASK) >> 52);
+	if (exp) {
+		w.f = (bits.u & DBL_SIG_MASK) + DBL_HIDDEN_BIT;
+		w.e = exp - DBL_EXP_BIAS;
+	} else {
+		w.f = bits.u & DBL_SIG_MASK;
+		w.e = DBL_DENORM_EXP;
+	}
+
+	// Boundaries halfway to the neighboring doubles:
+	m_plus.f = (w.f << 1) + 1;
+	m_plus.e = w.e - 1;
+	m_plus = Normalize_Diy(m_plus);
+	if (w.f == DBL_HIDDEN_BIT && exp > 1) {
+		m_minus.f = (w.f << 2) - 1;	// lower boundary is closer
+		m_minus.e = w.e - 2;
+	} else {
+		m_minus.f = (w.f << 1) - 1;
+		m_minus.e = w.e - 1;
+	}
+	m_minus.f <<= m_minus.e - m_plus.e;
+	m_minus.e = m_plus.e;
+	w = Normalize_Diy(w);
+
+	// Cached power of ten bringing w into the target exponent range:
+	k = (REBINT)ceil((MIN_TARGET_EXP - (w.e + 64) + 63) * 0.30102999566398114);
+	idx = (348 + k - 1) / 8 + 1;
+	c_mk.f = Cached_Powers[idx].f;
+	c_mk.e = Cached_Powers[idx].e;
+
+	sw = Mul_Diy(w, c_mk);
+	sm = Mul_Diy(m_minus, c_mk);
+	sp = Mul_Diy(m_plus, c_mk);
+
+	if (!Digit_Gen(sm, sw, sp, buf, &len, &kappa)) return 0;
+
+	while (len > 1 && buf[len - 1] == '0') len--, kappa++;
+	buf[len] = 0;
+	*decpt = len + kappa - Cached_Powers[idx].k;
+
+	return len;
+}
+
+
+/***********************************************************************
+**
+*/	static REBOOL Eisel_Lemire(u64 w, REBINT q, REBOOL neg, REBDEC *out)
+/*
+**		Compute the double nearest to w * 10^q, where w is nonzero.
+**		Returns FALSE if the result cannot be decided this way.
+**
+***********************************************************************/
+{
+	union {REBDEC d; u64 u;} bits;
+	const u64 *pow5;
+	u64 hi, lo, hi2, lo2, mant;
+	REBINT lz, upper, shift, power2;
+
+	if (q < MIN_POW5) {
+		bits.u = 0;
+		goto done;
+	}
+	if (q > MAX_POW5) {
+		bits.u = DBL_EXP_MASK;
+		goto done;
+	}
+
+	for (lz = 0; !(w & U64_C(0x8000000000000000)); lz++) w <<= 1;
+
+	pow5 = &Pow5_128[2 * (q - MIN_POW5)];
+	Mul_64(w, pow5[0], &hi, &lo);
+	if ((hi & 0x1FF) == 0x1FF) {
+		// Truncated product may be too low, so include lower word:
+		Mul_64(w, pow5[1], &hi2, &lo2);
+		lo += hi2;
+		if (hi2 > lo) hi++;
+		if (lo == MAX_U64 && (q < -27 || q > 55)) return FALSE;
+	}
+
+	upper = (REBINT)(hi >> 63);
+	shift = upper + 64 - 52 - 3;
+	mant = hi >> shift;
+	power2 = (((152170 + 65536) * q) >> 16) + 63 + upper - lz + 1023;
+
+	if (power2 <= 0) { // subnormal
+		if (-power2 + 1 >= 64) {
+			bits.u = 0;
+			goto done;
+		}
+		mant >>= -power2 + 1;
+		mant += mant & 1;
+		mant >>= 1;
+		power2 = (mant < DBL_HIDDEN_BIT) ? 0 : 1;
+		bits.u = (mant & DBL_SIG_MASK) | ((u64)power2 << 52);
+		goto done;
+	}
+
+	// Exact halfway case, round to even:
+	if (lo <= 1 && q >= -4 && q <= 23 && (mant & 3) == 1 && (mant << shift) == hi)
+		mant &= ~(u64)1;
+
+	mant += mant & 1;
+	mant >>= 1;
+	if (mant >= (DBL_HIDDEN_BIT << 1)) {
+		mant = DBL_HIDDEN_BIT;
+		power2++;
+	}
+	mant &= DBL_SIG_MASK;
+	if (power2 >= 0x7FF) {
+		power2 = 0x7FF;
+		mant = 0;
+	}
+	bits.u = mant | ((u64)power2 << 52);
+
+done:
+	if (neg) bits.u |= U64_C(0x8000000000000000);
+	*out = bits.d;
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	REBOOL Fast_Strtod(REBYTE *cp, REBDEC *out)
+/*
+**		Convert a plain decimal string: [+-]digits[.digits][e[+-]digits]
+**		terminated by a null. Returns FALSE if the string is not in
+**		that form or has too many significant digits, in which case
+**		the caller should use STRTOD().
+**
+***********************************************************************/
+{
+	u64 w = 0;
+	REBINT q = 0;
+	REBINT digits = 0;
+	REBINT e = 0;
+	REBOOL neg = FALSE;
+	REBOOL eneg = FALSE;
+	REBOOL any = FALSE;
+
+	if (*cp == '-') neg = TRUE, cp++;
+	else if (*cp == '+') cp++;
+
+	for (; *cp == '0'; cp++) any = TRUE;
+	for (; *cp >= '0' && *cp <= '9'; cp++, digits++) w = w * 10 + (*cp - '0');
+
+	if (*cp == '.') {
+		cp++;
+		if (!digits) for (; *cp == '0'; cp++) q--, any = TRUE;
+		for (; *cp >= '0' && *cp <= '9'; cp++, digits++, q--) w = w * 10 + (*cp - '0');
+	}
+
+	if (digits > 19) return FALSE;
+	if (!digits && !any) return FALSE;
+
+	if (*cp == 'e' || *cp == 'E') {
+		cp++;
+		if (*cp == '-') eneg = TRUE, cp++;
+		else if (*cp == '+') cp++;
+		if (*cp < '0' || *cp > '9') return FALSE;
+		for (; *cp >= '0' && *cp <= '9'; cp++) {
+			if (e < 100000) e = e * 10 + (*cp - '0');
+		}
+		q += eneg ? -e : e;
+	}
+
+	if (*cp) return FALSE;
+
+	if (w == 0) {
+		*out = neg ? -0.0 : 0.0;
+		return TRUE;
+	}
+
+	// Clinger: both w and 10^q exact as doubles, so one rounding:
+	if (w <= (U64_C(1) << 53) && q >= -22 && q <= 22) {
+		*out = (q < 0) ? (REBDEC)w / Exact_Powers_10[-q] : (REBDEC)w * Exact_Powers_10[q];
+		if (neg) *out = -*out;
+		return TRUE;
+	}
+
+	return Eisel_Lemire(w, q, neg, out);
+}
@@ -250,6 +250,7 @@
 
 REBINT Emit_Decimal(REBYTE *cp, REBDEC d, REBFLG trim, REBYTE point, REBINT decimal_digits) {
 	REBYTE *start = cp, *sig, *rve;
+	REBYTE fast[MAX_DIGITS + 2];
 	int e, sgn;
 	REBINT digits_obtained;
 
@@ -257,9 +258,16 @@ REBINT Emit_Decimal(REBYTE *cp, REBDEC d, REBFLG trim, REBYTE point, REBINT deci
 	if (decimal_digits < MIN_DIGITS) decimal_digits = MIN_DIGITS;
 	else if (decimal_digits > MAX_DIGITS) decimal_digits = MAX_DIGITS;
 
-	sig = (REBYTE *) dtoa (d, 0, decimal_digits, &e, &sgn, (char **) &rve);
-
-	digits_obtained = rve - sig;
+	/* mode 0 is shortest round-trip, so try the fast path first */
+	digits_obtained = Fast_Dtoa(d, fast, &e);
+	if (digits_obtained) {
+		sig = fast;
+		sgn = d < 0;
+	}
+	else {
+		sig = (REBYTE *) dtoa (d, 0, decimal_digits, &e, &sgn, (char **) &rve);
+		digits_obtained = rve - sig;
+	}
 
 	/* handle sign */
 	if (sgn) *cp++ = '-';
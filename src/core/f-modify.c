@@ -124,6 +124,7 @@
 
 	if (dups < 0) return (action == A_APPEND) ? 0 : dst_idx;
 	if (action == A_APPEND || dst_idx > tail) dst_idx = tail;
+	if (IS_SHARED_SERIES(dst_ser)) Unshare_Series(dst_ser);
 
 	// If the src_val is not a string, then we need to create a string:
 	if (GET_FLAG(flags, AN_SERIES)) { // used to indicate a BINARY series
@@ -196,3 +197,164 @@
 
 	return (action == A_APPEND) ? 0 : dst_idx;
 }
+
+
+/***********************************************************************
+**
+*/	REBCNT Replace_String(REBVAL *target, REBVAL *search, REBVAL *rep, REBCNT flags)
+/*
+**		Replace all occurrences of search within the string or
+**		binary target (from its index to its tail).
+**
+**		The result is built in a single pass into a new series and
+**		copied back at the end, rather than moving the whole tail
+**		of the target on each match (as CHANGE would do).
+**
+**		rep:		converted as done by CHANGE
+**		flags:		AM_FIND_CASE (binary is always case-sensitive)
+**
+**		return: position after the last replacement, or NOT_FOUND
+**
+***********************************************************************/
+{
+	REBSER *ser = VAL_SERIES(target);
+	REBCNT index = VAL_INDEX(target);
+	REBCNT tail = VAL_TAIL(target);
+	REBSER *pat;
+	REBCNT pidx;
+	REBCNT plen;
+	REBSER *rser = 0;
+	REBCNT ridx = 0;
+	REBCNT rlen;
+	REBSER *out;
+	REBCNT last = NOT_FOUND;
+	REBCNT pos;
+	REBCNT n;
+	REBFLG fast;
+
+	if (IS_SHARED_SERIES(ser)) Unshare_Series(ser);
+
+	if (IS_BINARY(target)) {
+		if (!IS_BINARY(search)) Trap_Arg(search);
+		flags |= AM_FIND_CASE;
+		if (IS_INTEGER(rep)) {
+			rser = Append_Byte(0, Int8u(rep));
+		}
+		else if (IS_BLOCK(rep)) {
+			rser = Join_Binary(rep); // NOTE: it's the shared FORM buffer!
+		}
+		else if (IS_CHAR(rep)) {
+			rser = Make_Binary(6);
+			rser->tail = Encode_UTF8_Char(BIN_HEAD(rser), VAL_CHAR(rep));
+		}
+		else if (!ANY_BINSTR(rep)) Trap_Arg(rep);
+		else if (!VAL_BYTE_SIZE(rep)) {
+			rser = Encode_UTF8_Value(rep, VAL_LEN(rep), 0);
+		}
+	}
+	else {
+		if (!ANY_STR(search) || IS_TAG(search))
+			Set_String(search, Copy_Form_Value(search, 0));
+		if (IS_CHAR(rep)) {
+			rser = Append_Byte(0, VAL_CHAR(rep)); // unicode ok too
+		}
+		else if (IS_BLOCK(rep)) {
+			rser = Form_Tight_Block(rep);
+		}
+		else if (!ANY_STR(rep) || IS_TAG(rep)) {
+			rser = Copy_Form_Value(rep, 0);
+		}
+	}
+
+	if (rser) rlen = SERIES_TAIL(rser);
+	else {
+		rser = VAL_SERIES(rep);
+		ridx = VAL_INDEX(rep);
+		rlen = VAL_LEN(rep);
+	}
+
+	pat  = VAL_SERIES(search);
+	pidx = VAL_INDEX(search);
+	plen = VAL_LEN(search);
+	if (plen == 0 || index + plen > tail) return NOT_FOUND;
+
+	// Byte strings are searched with the optimized byte compare:
+	fast = BYTE_SIZE(ser) && BYTE_SIZE(pat);
+
+	out = BYTE_SIZE(ser) ? Make_Binary(tail - index) : Make_Unicode(tail - index);
+
+	for (pos = index; pos < tail; pos = n + plen) {
+		if (fast)
+			n = Find_Byte_Str(ser, pos, BIN_SKIP(pat, pidx), plen, !(flags & AM_FIND_CASE), FALSE);
+		else
+			n = Find_Str_Str(ser, 0, pos, tail - plen + 1, 1, pat, pidx, plen, flags & AM_FIND_CASE);
+		if (n == NOT_FOUND) break;
+		Append_String(out, ser, pos, n - pos);
+		Append_String(out, rser, ridx, rlen);
+		last = SERIES_TAIL(out);
+	}
+
+	if (last == NOT_FOUND) return NOT_FOUND;
+
+	// Copy the rest, then put the result back into the target:
+	if (pos < tail) Append_String(out, ser, pos, tail - pos);
+	SERIES_TAIL(ser) = index;
+	Append_String(ser, out, 0, SERIES_TAIL(out));
+	TERM_SERIES(ser);
+	Free_Series(out);
+
+	return index + last;
+}
+
+
+/***********************************************************************
+**
+*/	REBCNT Replace_Block(REBVAL *target, REBVAL *search, REBVAL *rep, REBCNT flags)
+/*
+**		Replace all occurrences of search within the block target.
+**		A block search matches a sequence of values, and a block
+**		replacement inserts its values (as with CHANGE).
+**
+**		flags:		AM_FIND_CASE
+**
+**		return: position after the last replacement, or NOT_FOUND
+**
+***********************************************************************/
+{
+	REBSER *ser = VAL_SERIES(target);
+	REBCNT index = VAL_INDEX(target);
+	REBCNT tail = VAL_TAIL(target);
+	REBCNT len = ANY_BLOCK(search) ? VAL_LEN(search) : 1;
+	REBVAL *rval = rep;
+	REBCNT rlen = 1;
+	REBSER *out;
+	REBCNT last = NOT_FOUND;
+	REBCNT pos;
+	REBCNT n;
+
+	if (len == 0 || index + len > tail) return NOT_FOUND;
+
+	if (ANY_BLOCK(rep)) {
+		rval = VAL_BLK_DATA(rep);
+		rlen = VAL_LEN(rep);
+	}
+
+	out = Make_Block(tail - index);
+
+	for (pos = index; pos < tail; pos = n + len) {
+		n = Find_Block(ser, pos, tail - len + 1, search, len, flags, 1);
+		if (n == NOT_FOUND) break;
+		Append_Series(out, (REBYTE *)BLK_SKIP(ser, pos), n - pos);
+		Append_Series(out, (REBYTE *)rval, rlen);
+		last = SERIES_TAIL(out);
+	}
+
+	if (last == NOT_FOUND) return NOT_FOUND;
+
+	if (pos < tail) Append_Series(out, (REBYTE *)BLK_SKIP(ser, pos), tail - pos);
+	SERIES_TAIL(ser) = index;
+	Append_Series(ser, (REBYTE *)BLK_HEAD(out), SERIES_TAIL(out));
+	Free_Series(out);
+
+	return index + last;
+}
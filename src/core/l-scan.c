@@ -423,11 +423,17 @@
         switch (chr) {
 
 		case 0:
-			return 0; // Scan_state shows error location.
+			// Scan_state shows error location.
+			if (scan_state) scan_state->incomplete = (src >= scan_state->limit);
+			return 0;
         
 		case '^':
 			chr = Scan_Char(&src);
-			if (chr == -1) return 0;
+			if (chr == -1) {
+				// Escape may be cut off, e.g. ^(12
+				if (scan_state) scan_state->incomplete = (src + 8 >= scan_state->limit);
+				return 0;
+			}
 			src--;
             break;
 
@@ -451,7 +457,10 @@
 		default:
 			if (chr >= 0x80) {
 				chr = Decode_UTF8_Char(&src, 0); // zero on error
-				if (chr == 0) return 0;
+				if (chr == 0) {
+					if (scan_state) scan_state->incomplete = (src + 4 >= scan_state->limit);
+					return 0;
+				}
 			}
 		}
 
@@ -1050,6 +1059,7 @@ scanword:
     scan_state->line_count = 1;
 	scan_state->opts = 0;
 	scan_state->errors = 0;
+	scan_state->incomplete = FALSE;
 //    scan_state->error_id = (REBYTE *)"";
 }
 
@@ -1150,6 +1160,39 @@ scanword:
 
 extern REBSER *Scan_Full_Block(SCAN_STATE *scan_state, REBYTE mode_char);
 
+/***********************************************************************
+**
+*/  static REBOOL Partial_Token(SCAN_STATE *scan_state, REBINT token)
+/*
+**		For SCAN_PARTIAL, determine if the input ended before the
+**		token was complete. A token that runs up to the limit may
+**		still continue with more input (e.g. 12 becoming 123), unless
+**		it ends with its own closing char.
+**
+***********************************************************************/
+{
+	if (scan_state->incomplete) return TRUE;
+
+	if (token == -TOKEN_TAG) return (scan_state->incomplete = TRUE); // no '>'
+
+	if (scan_state->end < scan_state->limit) return FALSE;
+
+	switch (token) {
+	case TOKEN_BLOCK_END:
+	case TOKEN_PAREN_END:
+	case TOKEN_STRING:
+	case TOKEN_CHAR:
+	case TOKEN_BINARY:
+	case TOKEN_TAG:
+		return FALSE;
+	case TOKEN_FILE:
+		if (scan_state->end[-1] == '"') return FALSE;
+	}
+
+	return (scan_state->incomplete = TRUE);
+}
+
+
 /***********************************************************************
 **
 */  static REBSER *Scan_Block(SCAN_STATE *scan_state, REBYTE mode_char)
@@ -1173,6 +1216,9 @@ extern REBSER *Scan_Full_Block(SCAN_STATE *scan_state, REBYTE mode_char);
 #endif
 	REBCNT start = scan_state->line_count;
 	REBYTE *start_line = scan_state->head_line;
+	REBYTE *resume = scan_state->begin;	// SCAN_PARTIAL restart point
+	REBCNT resume_line = start;
+	REBYTE *resume_head = start_line;
 	// just_once for load/next see Load_Script for more info.
 	REBOOL just_once = GET_FLAG(scan_state->opts, SCAN_NEXT);
 
@@ -1183,17 +1229,27 @@ extern REBSER *Scan_Full_Block(SCAN_STATE *scan_state, REBYTE mode_char);
 
 	//scan_state->error_id = (REBYTE *) "";
 
-    while (
+    while (TRUE) {
+
+		// Where to restart a partial value (top level only):
+		if (!mode_char) {
+			resume = scan_state->begin;
+			resume_line = scan_state->line_count;
+			resume_head = scan_state->head_line;
+		}
+
 #ifdef COMP_LINES
-		linenum=scan_state->line_count,
+		linenum=scan_state->line_count;
 #endif
-		((token = Scan_Token(scan_state)) != TOKEN_EOF)
-	) {
+		if ((token = Scan_Token(scan_state)) == TOKEN_EOF) break;
 
 		bp = scan_state->begin;
 		ep = scan_state->end;
 		len = (REBCNT)(ep - bp);
 
+		if (GET_FLAG(scan_state->opts, SCAN_PARTIAL) && Partial_Token(scan_state, token))
+			goto partial_value;
+
 		if (token < 0) {	// Check for error tokens
 			token = -token;
 			ACCEPT_TOKEN(scan_state);
@@ -1222,6 +1278,7 @@ extern REBSER *Scan_Full_Block(SCAN_STATE *scan_state, REBYTE mode_char);
 					&& mode_char != '/') {
 			//line = VAL_GET_LINE(value);
 			block = Scan_Block(scan_state, '/');  // (could realloc emitbuf)
+			if (SCAN_INCOMPLETE(scan_state)) goto partial_value;
 			value = BLK_TAIL(emitbuf);
 			VAL_SERIES(value) = block;
 			if (token == TOKEN_LIT) {
@@ -1300,6 +1357,7 @@ extern REBSER *Scan_Full_Block(SCAN_STATE *scan_state, REBYTE mode_char);
 			//line = VAL_GET_LINE(value);
 			block = Scan_Block(scan_state, (REBYTE)((token == TOKEN_BLOCK) ? ']' : ')'));
 			// (above line could have realloced emitbuf)
+			if (SCAN_INCOMPLETE(scan_state)) goto partial_value;
 			ep = scan_state->end;
 			value = BLK_TAIL(emitbuf);
 			if (scan_state->errors) {
@@ -1424,6 +1482,7 @@ extern REBSER *Scan_Full_Block(SCAN_STATE *scan_state, REBYTE mode_char);
 
 		case TOKEN_CONSTRUCT:
 			block = Scan_Full_Block(scan_state, ']');
+			if (SCAN_INCOMPLETE(scan_state)) goto partial_value;
 			value = BLK_TAIL(emitbuf);
 			emitbuf->tail++; // Protect the block from GC
 //			if (!Construct_Simple(value, block)) {
@@ -1461,6 +1520,8 @@ extern REBSER *Scan_Full_Block(SCAN_STATE *scan_state, REBYTE mode_char);
 		if (VAL_TYPE(value)) emitbuf->tail++;
 		else {
 		syntax_error:
+			if (GET_FLAG(scan_state->opts, SCAN_PARTIAL) && ep >= scan_state->limit)
+				goto partial_value;
 			value = BLK_TAIL(emitbuf);
 			Scan_Error(RE_INVALID, scan_state, (REBCNT)token, bp, (REBCNT)(ep-bp), GET_FLAG(scan_state->opts, SCAN_RELAX) ? value : 0);
 			emitbuf->tail++;
@@ -1496,7 +1557,22 @@ extern REBSER *Scan_Full_Block(SCAN_STATE *scan_state, REBYTE mode_char);
 	    if (GET_FLAG(scan_state->opts, SCAN_ONLY) || just_once) goto exit_block;
 	}
 
-    if (mode_char == ']' || mode_char == ')') goto missing_error;
+    if (mode_char == ']' || mode_char == ')') {
+		if (GET_FLAG(scan_state->opts, SCAN_PARTIAL)) goto partial_value;
+		goto missing_error;
+	}
+	goto exit_block;
+
+partial_value:
+	// Input ended inside a value. The top level drops it and backs up
+	// to where it began, so the caller can rescan it with more input.
+	scan_state->incomplete = TRUE;
+	if (!mode_char) {
+		scan_state->begin = scan_state->end = resume;
+		scan_state->line_count = resume_line;
+		scan_state->head_line = resume_head;
+		value = 0;
+	}
 
 exit_block:
 	if (line && value) VAL_SET_LINE(value);
@@ -1616,16 +1692,25 @@ exit_block:
 /*
 **		Allows BINARY! input only!
 **
+**		With /partial, a value cut off by the end of the input is not
+**		an error. Scanning stops before it and the returned binary is
+**		positioned at its start, so more data can be appended to the
+**		same binary and the scan resumed from there (streamed input).
+**
 ***********************************************************************/
 {
 	REBSER *blk;
     SCAN_STATE scan_state;
 
+	// Slices and file mappings are not NUL terminated; the scanner needs one:
+	if (IS_SHARED_SERIES(VAL_SERIES(D_ARG(1)))) Unshare_Series(VAL_SERIES(D_ARG(1)));
+
     Init_Scan_State(&scan_state, VAL_BIN_DATA(D_ARG(1)), VAL_LEN(D_ARG(1)));
 
 	if (D_REF(2)) SET_FLAG(scan_state.opts, SCAN_NEXT);
 	if (D_REF(3)) SET_FLAG(scan_state.opts, SCAN_ONLY);
 	if (D_REF(4)) SET_FLAG(scan_state.opts, SCAN_RELAX);
+	if (D_REF(5)) SET_FLAG(scan_state.opts, SCAN_PARTIAL);
 
 	blk = Scan_Code(&scan_state, 0);
 	DS_RELOAD(ds); // in case stack moved
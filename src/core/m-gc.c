@@ -437,6 +437,7 @@ mark_obj:
 			if (SERIES_WIDE(ser) > sizeof(REBUNI))
 				Crash(RP_BAD_WIDTH, sizeof(REBUNI), SERIES_WIDE(ser), VAL_TYPE(val));
 			MARK_SERIES(ser);
+			if (IS_SHARED_SERIES(ser)) MARK_SERIES(SERIES_LINK(ser)); // slice data
 			break;
 
 		case REB_IMAGE:
@@ -524,6 +525,9 @@ mark_obj:
 
 	MARK_SERIES(series);
 
+	// Keep the data of a slice (or series that was sliced):
+	if (IS_SHARED_SERIES(series)) MARK_SERIES(SERIES_LINK(series));
+
 	// If not a block, go no further
 	if (SERIES_WIDE(series) != sizeof(REBVAL) || IS_BARE_SERIES(series) || IS_EXT_SERIES(series)) return;
 
@@ -560,7 +560,6 @@ clear_header:
 	REBCNT n;
 
 	PG_Reb_Stats->Series_Freed++;
-	PG_Reb_Stats->Series_Memory -= SERIES_TOTAL(series);
 
 	// Remove series from expansion list, if found:
 	for (n = 1; n < MAX_EXPAND_LIST; n++) {
@@ -568,8 +567,10 @@ clear_header:
 	}
 
 	if (!IS_EXT_SERIES(series)) {
+		PG_Reb_Stats->Series_Memory -= SERIES_TOTAL(series);
 		Free_Series_Data(series, TRUE);
 	}
+	else if (IS_MAPPED_SERIES(series)) OS_UNMAP_FILE(series->data, series->tail);
 	series->info = 0; // includes width
 	//series->data = BAD_MEM_PTR;
 	//series->tail = 0xBAD2BAD2;
@@ -68,6 +68,8 @@
 	REBUPT n;
 	REBCNT x;
 
+	if (IS_SHARED_SERIES(series)) Unshare_Series(series);
+
 	if (delta == 0) return;
 
 	// Optimized case of head insertion:
@@ -295,6 +297,124 @@
 }
 
 
+/***********************************************************************
+**
+*/	REBSER *Make_Slice(REBSER *series, REBCNT index, REBCNT length)
+/*
+**		Make a series for part of a binary that shares the data
+**		rather than copying it. Returns zero if it cannot be done.
+**
+**		On the first slice, the data buffer is handed to a hidden
+**		series linked from both (so the GC keeps it while either is
+**		used). The series and its slices become external, and each
+**		one gets its own copy on its first change (Unshare_Series).
+**
+**		A slice has no terminator of its own, so this is not used
+**		for strings or blocks. Code that scans binary data up to a
+**		NUL (LOAD, TRANSCODE, the script header) must unshare it
+**		first.
+**
+***********************************************************************/
+{
+	REBSER *slice;
+	REBSER *holder;
+
+	if (!BYTE_SIZE(series) || index + length > SERIES_TAIL(series)) return 0;
+
+	if (!IS_SHARED_SERIES(series)) {
+		if (IS_EXT_SERIES(series) || IS_LOCK_SERIES(series)) return 0;
+		holder = (REBSER *)Make_Node(SERIES_POOL);
+		*holder = *series; // now owns the data
+		EXT_SERIES(series);
+		SERIES_LINK(series) = holder;
+		PG_Reb_Stats->Series_Made++;
+	}
+
+	slice = (REBSER *)Make_Node(SERIES_POOL);
+	slice->data = SERIES_SKIP(series, index);
+	slice->tail = length;
+	slice->rest = length + 1; // so any expansion must unshare first
+	slice->info = SERIES_WIDE(series); // also clears flags
+	EXT_SERIES(slice);
+	SERIES_LINK(slice) = SERIES_LINK(series);
+	LABEL_SERIES(slice, "slice");
+
+	PG_Reb_Stats->Series_Made++;
+
+	return slice;
+}
+
+
+/***********************************************************************
+**
+*/	REBSER *Make_Mapped_Binary(REBYTE *data, REBCNT length)
+/*
+**		Make a binary for memory mapped file data (see OS_Map_File).
+**		The data does not come from the memory pools and is not
+**		counted by them.
+**
+**		The binary shares the data as a slice does (see Make_Slice),
+**		so it gets its own copy on its first change. The data is
+**		held by a hidden series that links to itself, and is unmapped
+**		when the GC frees that series.
+**		The pages are mapped copy-on-write as well, so a write that
+**		bypasses the series (as a host command may) changes only
+**		the memory, never the file, and does not fault.
+**
+**		Nothing follows the data (when the file size is a multiple of
+**		the page size, not even readable memory), so code that needs
+**		a NUL must unshare the binary first, as for a slice.
+**
+***********************************************************************/
+{
+	REBSER *series;
+	REBSER *holder;
+
+	holder = (REBSER *)Make_Node(SERIES_POOL);
+	holder->data = data;
+	holder->tail = length;
+	holder->rest = length;
+	holder->info = 1; // byte wide, also clears flags
+	EXT_SERIES(holder);
+	SERIES_LINK(holder) = holder;
+	LABEL_SERIES(holder, "mapped file");
+	PG_Reb_Stats->Series_Made++;
+
+	series = Make_Slice(holder, 0, length);
+	LABEL_SERIES(series, "mapped binary");
+	return series;
+}
+
+
+/***********************************************************************
+**
+*/	void Unshare_Series(REBSER *series)
+/*
+**		Give a series that shares its data (see Make_Slice) its own
+**		copy of the data, before it gets modified.
+**
+***********************************************************************/
+{
+	REBSER *newser;
+
+	if (!IS_SHARED_SERIES(series)) return;
+
+	newser = Make_Series(series->tail + 1, SERIES_WIDE(series), FALSE);
+	memcpy(newser->data, series->data, series->tail * SERIES_WIDE(series));
+
+	series->data = newser->data;
+	series->rest = newser->rest;
+	SERIES_SET_BIAS(series, 0);
+	SERIES_CLR_FLAG(series, SER_EXT);
+	SERIES_LINK(series) = 0;
+	TERM_SERIES(series);
+
+	// The data now belongs to the series, so just free the header:
+	EXT_SERIES(newser);
+	Free_Series(newser);
+}
+
+
 #ifdef NOT_USED
 /***********************************************************************
 **
@@ -338,6 +458,8 @@
 
 	if (len <= 0) return;
 
+	if (IS_SHARED_SERIES(series)) Unshare_Series(series);
+
 	// Optimized case of head removal:
 	if (index == 0) {
 		if ((REBCNT)len > series->tail) len = series->tail;
@@ -896,64 +896,31 @@ static int Do_Ordinal(REBVAL *ds, REBINT n)
 }
 
 
-#ifdef not_fast_enough
 /***********************************************************************
 **
-**/	REBNATIVE(replace_all)
+*/	REBNATIVE(replace_all)
 /*
+**		Used by REPLACE/all when the replacement is not a function.
+**		The target is scanned once and the result built in a new
+**		series, so many matches do not each move the whole tail.
+**
 ***********************************************************************/
 {
-#define BIT_CHAR(c) (((REBU64)1) << (c % 64))
-	REBVAL *a1   = D_ARG(1);
-	REBVAL *a2   = D_ARG(2);
-	REBSER *ser  = VAL_SERIES(a1);
-	REBCNT tail  = ser->tail;
-	REBVAL *pats = VAL_BLK(a2);
-	REBCNT tail2 = VAL_TAIL(a2);
-	REBSER *outs;
-	REBUNI chr;
-	REBU64 chash = 0;
-	REBCNT i, n;
-	REBVAL *val;
+	REBVAL *target = D_ARG(1);
+	REBCNT flags = D_REF(4) ? AM_FIND_CASE : 0;
+	REBCNT n;
 
-	// Check substitution strings, and compute hash and size diff.
-	n = 0;
-	for (val = VAL_BLK(a2); NOT_END(val); val += 2) {
-		if (VAL_TYPE(a1) != VAL_TYPE(val)) Trap0(RE_NOT_SAME_TYPE); // !! would be good to show it
-		if (IS_END(val+1)) Trap0(RE_MISSING_ARG);
-		if (VAL_TYPE(a1) != VAL_TYPE(val+1)) Trap0(RE_NOT_SAME_TYPE); // !! would be good to show it
-		chr = GET_ANY_CHAR(VAL_SERIES(val), 0);
-		chash |= BIT_CHAR(chr);
-		n += 3 * (VAL_LEN(val+1) - VAL_LEN(val)); // assume it occurs three times
-	}
+	if (IS_PROTECT_SERIES(VAL_SERIES(target))) Trap0(RE_PROTECTED);
 
-	outs = Make_Unicode(VAL_LEN(a1) + n);
+	if (ANY_BLOCK(target))
+		n = Replace_Block(target, D_ARG(2), D_ARG(3), flags);
+	else
+		n = Replace_String(target, D_ARG(2), D_ARG(3), flags);
 
-	for (i = VAL_INDEX(a1); i < tail; i++) {
-		chr = GET_ANY_CHAR(ser, i);
-		val = 0; // default for check below
-		if (BIT_CHAR(chr) & chash) {
-			for (val = VAL_BLK(a2); NOT_END(val); val += 2) {
-				if (NOT_FOUND != Find_Str_Str(ser, 0, i, tail, 0, VAL_SERIES(val), 0, VAL_TAIL(val), AM_FIND_MATCH)) {
-					Insert_String(outs, SERIES_TAIL(outs), VAL_SERIES(val+1), 0, VAL_TAIL(val+1), 0);
-					i += VAL_TAIL(val) - 1;
-					break;
-				}
-			}
-			if (IS_END(val)) val = 0; // for test below
-		}
-		// If not found, just copy the character:
-		if (!val) {
-			n = SERIES_TAIL(outs);
-			EXPAND_SERIES_TAIL(outs, 1);
-			*UNI_SKIP(outs, n) = chr;
-		}
-	}
-	UNI_TERM(outs); // Because we don't do it for single chars.
-	Set_String(D_RET, outs);
-	return R_RET;
+	if (D_REF(5) && n != NOT_FOUND) VAL_INDEX(target) = n; // /tail
+
+	return R_ARG1;
 }
-#endif
 
 
 /***********************************************************************
@@ -28,6 +28,7 @@
 ***********************************************************************/
 
 #include "sys-core.h"
+#include "reb-evtypes.h"
 
 //#define HELPER
 
@@ -408,6 +409,9 @@ chk_neg:
 	val = OFV(port, STD_PORT_ACTOR);
 	if (IS_NATIVE(val)) {
 		Do_Port_Action(port, A_UPDATE); // uses current stack frame
+		// The actor may consume the event (e.g. a partial read):
+		val = D_ARG(2);
+		if (IS_EVENT(val) && VAL_EVENT_TYPE(val) == EVT_IGNORE) return R_FALSE;
 	}
 
 	val = OFV(port, STD_PORT_AWAKE);
@@ -57,6 +57,24 @@ int  MD5_CtxSize(void);
 #endif
 #endif
 
+#ifdef HAS_SHA256
+REBYTE *SHA256(REBYTE *, REBCNT, REBYTE *);
+void SHA256_Init(void *c);
+void SHA256_Update(void *c, REBYTE *data, REBCNT len);
+void SHA256_Final(REBYTE *md, void *c);
+int  SHA256_CtxSize(void);
+#endif
+
+#ifdef HAS_SHA512
+REBYTE *SHA384(REBYTE *, REBCNT, REBYTE *);
+REBYTE *SHA512(REBYTE *, REBCNT, REBYTE *);
+void SHA384_Init(void *c);
+void SHA512_Init(void *c);
+void SHA512_Update(void *c, REBYTE *data, REBCNT len);
+void SHA512_Final(REBYTE *md, void *c);
+int  SHA512_CtxSize(void);
+#endif
+
 #ifdef HAS_MD4
 REBYTE *MD4(REBYTE *, REBCNT, REBYTE *);
 void MD4_Init(void *c);
@@ -65,6 +83,8 @@ void MD4_Final(REBYTE *md, void *c);
 int  MD4_CtxSize(void);
 #endif
 
+REBCNT Update_CRC32(u32 crc, REBYTE *buf, int len);
+
 // Table of has functions and parameters:
 static struct digest {
 	REBYTE *(*digest)(REBYTE *, REBCNT, REBYTE *);
@@ -81,6 +101,15 @@ static struct digest {
 	{SHA1, SHA1_Init, SHA1_Update, SHA1_Final, SHA1_CtxSize, SYM_SHA1, 20, 64},
 #endif
 
+#ifdef HAS_SHA256
+	{SHA256, SHA256_Init, SHA256_Update, SHA256_Final, SHA256_CtxSize, SYM_SHA256, 32, 64},
+#endif
+
+#ifdef HAS_SHA512
+	{SHA384, SHA384_Init, SHA512_Update, SHA512_Final, SHA512_CtxSize, SYM_SHA384, 48, 128},
+	{SHA512, SHA512_Init, SHA512_Update, SHA512_Final, SHA512_CtxSize, SYM_SHA512, 64, 128},
+#endif
+
 #ifdef HAS_MD4
 	{MD4, MD4_Init, MD4_Update, MD4_Final, MD4_CtxSize, SYM_MD4, 16, 64},
 #endif
@@ -93,6 +122,102 @@ static struct digest {
 
 };
 
+#define MAX_DIGEST_LEN	64		// max of all digests[].len
+#define MAX_HMAC_BLOCK	128		// max of all digests[].hmacblock
+
+
+/***********************************************************************
+**
+*/	static struct digest *Find_Digest(REBCNT sym)
+/*
+***********************************************************************/
+{
+	struct digest *d;
+
+	for (d = digests; d->digest; d++) if (d->index == (REBINT)sym) return d;
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	REBCNT Checksum_Size(REBCNT sym)
+/*
+**		Size of the state of a checksum method, for the functions
+**		below that checksum a stream of data (the checksum port).
+**		Zero if there is no such method.
+**
+***********************************************************************/
+{
+	struct digest *d;
+
+	if (sym == SYM_CRC32 || sym == SYM_CRC32C || sym == SYM_ADLER32) return sizeof(u32);
+	d = Find_Digest(sym);
+	return d ? d->ctxsize() : 0;
+}
+
+
+/***********************************************************************
+**
+*/	void Checksum_Init(REBCNT sym, void *ctx)
+/*
+***********************************************************************/
+{
+	if (sym == SYM_CRC32 || sym == SYM_CRC32C) *(u32*)ctx = 0;
+	else if (sym == SYM_ADLER32) *(u32*)ctx = 1;
+	else Find_Digest(sym)->init(ctx);
+}
+
+
+/***********************************************************************
+**
+*/	void Checksum_Update(REBCNT sym, void *ctx, REBYTE *data, REBCNT len)
+/*
+***********************************************************************/
+{
+	if (sym == SYM_CRC32) *(u32*)ctx = Update_CRC32(*(u32*)ctx, data, len);
+	else if (sym == SYM_CRC32C) *(u32*)ctx = Update_CRC32C(*(u32*)ctx, data, len);
+	else if (sym == SYM_ADLER32) *(u32*)ctx = Update_ADLER32(*(u32*)ctx, data, len);
+	else Find_Digest(sym)->update(ctx, data, len);
+}
+
+
+/***********************************************************************
+**
+*/	void Checksum_Final(REBCNT sym, void *ctx, REBVAL *out)
+/*
+**		Set out to the checksum of the data so far: an integer for
+**		CRC and Adler, else a binary digest. The state is not changed,
+**		so more data can be added.
+**
+**		The integer is signed for CRC32 and unsigned for CRC32C and
+**		ADLER32, as CHECKSUM returns them.
+**
+***********************************************************************/
+{
+	struct digest *d;
+	REBSER *digest;
+	void *tmp;
+
+	if (sym == SYM_CRC32) {
+		SET_INTEGER(out, (REBINT)*(u32*)ctx);
+		return;
+	}
+	if (sym == SYM_CRC32C || sym == SYM_ADLER32) {
+		SET_INTEGER(out, *(u32*)ctx);
+		return;
+	}
+
+	d = Find_Digest(sym);
+	digest = Make_Binary(d->len);
+	tmp = Make_Mem(d->ctxsize());
+	memcpy(tmp, ctx, d->ctxsize());
+	d->final(BIN_HEAD(digest), tmp);
+	Free_Mem(tmp, d->ctxsize());
+	SERIES_TAIL(digest) = d->len;
+	Set_Binary(out, digest);
+}
+
 
 /***********************************************************************
 **
@@ -154,7 +279,7 @@ static struct digest {
 **		/hash {Returns a hash value}
 **		size [integer!] {Size of the hash table}
 **		/method {Method to use}
-**		word [word!] {Method: SHA1 MD5}
+**		word [word!] {Method: SHA1 SHA256 SHA384 SHA512 MD5 CRC32 CRC32C ADLER32}
 **		/key {Returns keyed HMAC value}
 **		key-value [any-string!] {Key to use}
 **
@@ -184,6 +309,12 @@ static struct digest {
 			return R_RET;
 		}
 
+		if (sym == SYM_CRC32C) {
+			if (D_REF(ARG_CHECKSUM_SECURE) || D_REF(ARG_CHECKSUM_KEY)) Trap0(RE_BAD_REFINES);
+			DS_RET_INT(CRC32C(data, len));
+			return R_RET;
+		}
+
 		if (sym == SYM_ADLER32) {
 			if (D_REF(ARG_CHECKSUM_SECURE) || D_REF(ARG_CHECKSUM_KEY)) Trap0(RE_BAD_REFINES);
 			DS_RET_INT(ADLER32(data, len));
@@ -198,8 +329,8 @@ static struct digest {
 				LABEL_SERIES(digest, "checksum digest");
 
 				if (D_REF(ARG_CHECKSUM_KEY)) {
-					REBYTE tmpdigest[20];		// Size must be max of all digest[].len;
-					REBYTE ipad[64],opad[64];	// Size must be max of all digest[].hmacblock;
+					REBYTE tmpdigest[MAX_DIGEST_LEN];
+					REBYTE ipad[MAX_HMAC_BLOCK],opad[MAX_HMAC_BLOCK];
 					void *ctx = Make_Mem(digests[i].ctxsize());
 					REBVAL *key = D_ARG(ARG_CHECKSUM_KEY_VALUE);
 					REBYTE *keycp = VAL_BIN_DATA(key);
@@ -280,7 +411,7 @@ static struct digest {
 
 	ser = Prep_Bin_Str(D_ARG(1), &index, &len); // result may be a SHARED BUFFER!
 
-	Set_Binary(D_RET, Compress(ser, index, len, D_REF(4))); // /gzip
+	Set_Binary(D_RET, Compress(ser, index, len, D_REF(4), D_REF(5) ? Int32(D_ARG(6)) : -1, D_REF(7) ? Int32(D_ARG(8)) : 1)); // /gzip /level /threads
 
 	return R_RET;
 }
@@ -418,6 +549,8 @@ static struct digest {
 	REBVAL *data = D_ARG(1);
 	REBVAL *key  = D_ARG(2);
 
+	if (IS_SHARED_SERIES(VAL_SERIES(data))) Unshare_Series(VAL_SERIES(data));
+
 	if (!Cloak(TRUE, VAL_BIN_DATA(data), VAL_LEN(data), (REBYTE*)key, 0, D_REF(3)))
 		Trap_Arg(key);
 
@@ -436,6 +569,8 @@ static struct digest {
 	REBVAL *data = D_ARG(1);
 	REBVAL *key  = D_ARG(2);
 
+	if (IS_SHARED_SERIES(VAL_SERIES(data))) Unshare_Series(VAL_SERIES(data));
+
 	if (!Cloak(FALSE, VAL_BIN_DATA(data), VAL_LEN(data), (REBYTE*)key, 0, D_REF(3)))
 		Trap_Arg(key);
 
@@ -707,6 +842,9 @@ static struct digest {
 	REBVAL *arg = D_ARG(1);
 	REBINT n;
 
+	// Scan_Header needs the NUL that slices and file mappings lack:
+	if (IS_SHARED_SERIES(VAL_SERIES(arg))) Unshare_Series(VAL_SERIES(arg));
+
 	n = What_UTF(VAL_BIN_DATA(arg), VAL_LEN(arg));
 
 	if (n != 0 && n != 8) return R_NONE;  // UTF8 only
@@ -390,8 +390,9 @@ err:
 **	Args:
 **		1: codec:  handle!
 **		2: action: word! (identify, decode, encode)
-**		3: data:   binary! image! sound!
-**		4: option: (optional)
+**		3: data:   binary! image! sound! (encode: block! map! etc.)
+**		4: /options
+**		5: opts:   object! (codec specific, e.g. CSV delimiter)
 **
 ***********************************************************************/
 {
@@ -403,6 +404,7 @@ err:
 	CLEAR(&codi, sizeof(codi));
 
 	codi.action = CODI_DECODE;
+	if (D_REF(4)) codi.options = D_ARG(5);
 
 	val = D_ARG(3);
 
@@ -414,6 +416,7 @@ err:
 		if (!IS_BINARY(val)) Trap1(RE_INVALID_ARG, val);
 		codi.data = VAL_BIN_DATA(D_ARG(3));
 		codi.len  = VAL_LEN(D_ARG(3));
+		codi.value = D_RET;
 		break;
 
 	case SYM_ENCODE:
@@ -423,13 +426,16 @@ err:
 			codi.w = VAL_IMAGE_WIDE(val);
 			codi.h = VAL_IMAGE_HIGH(val);
 			codi.alpha = Image_Has_Alpha(val, 0);
-		} else if (IS_STRING(val)) {
+		} else if (IS_STRING(val) || IS_BINARY(val)) {
 			codi.w = VAL_SERIES_WIDTH(val);
 			codi.len = VAL_LEN(val);
 			codi.other = VAL_BIN_DATA(val);
 		}
-		else
+		// Only the JSON and CSV codecs encode other values:
+		else if (VAL_HANDLE(D_ARG(1)) != (ANYFUNC)Codec_JSON
+			&& VAL_HANDLE(D_ARG(1)) != (ANYFUNC)Codec_CSV)
 			Trap1(RE_INVALID_ARG, val);
+		codi.value = val;
 		break;
 
 	default:
@@ -493,6 +499,9 @@ err:
 		Set_Block(D_RET, codi.other);
 		break;
 
+	case CODI_VALUE: // (already in D_RET)
+		break;
+
 	default:
 		Trap0(RE_BAD_MEDIA); // need better!!!
 	}
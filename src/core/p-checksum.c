@@ -0,0 +1,147 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  p-checksum.c
+**  Summary: checksum stream port
+**  Section: ports
+**  Notes:
+**		The checksum port computes a CHECKSUM method a part at a
+**		time, so a large file does not need to be in memory:
+**
+**			sum: open checksum://sha256
+**			write sum part
+**			write sum part
+**			digest: read sum	; checksum of all data so far
+**
+**		READ does not end the stream; more can be written after it.
+**		CLEAR starts again. Methods are those of CHECKSUM/method
+**		(SHA1 if none is given). CRC and Adler return an integer,
+**		the others a binary.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+typedef struct rebol_checksum_state {
+	REBCNT sym;		// method
+	REBCNT pad;		// so the context is 8 byte aligned
+	REBI64 len;		// bytes so far
+} REBSUM;
+
+#define SUM_CTX(s) ((void*)((REBSUM*)(s) + 1))
+
+
+/***********************************************************************
+**
+*/	static void Make_Port_Stream(REBSER *port, REBVAL *state)
+/*
+**		Make the checksum state of a port from its spec.
+**
+***********************************************************************/
+{
+	REBVAL *spec = OFV(port, STD_PORT_SPEC);
+	REBVAL *val;
+	REBCNT sym = SYM_SHA1;
+	REBCNT size;
+	REBSER *ser;
+	REBSUM *sum;
+
+	if (!IS_OBJECT(spec)) Trap0(RE_INVALID_PORT);
+
+	val = Obj_Value(spec, STD_PORT_SPEC_CHECKSUM_METHOD);
+	if (ANY_WORD(val)) sym = VAL_WORD_CANON(val);
+	else if (!IS_NONE(val)) Trap_Port(RE_INVALID_SPEC, port, -10);
+
+	size = Checksum_Size(sym);
+	if (!size) Trap_Port(RE_INVALID_SPEC, port, -10);
+
+	size += sizeof(REBSUM);
+	ser = Make_Binary(size);
+	CLEAR(BIN_HEAD(ser), size);
+	SERIES_TAIL(ser) = size;
+
+	sum = (REBSUM*)BIN_HEAD(ser);
+	sum->sym = sym;
+	Checksum_Init(sym, SUM_CTX(sum));
+
+	Set_Binary(state, ser);
+}
+
+
+/***********************************************************************
+**
+*/	static void Checksum_Stream(REBSER *state, REBSER *out, REBYTE *data, REBCNT len, REBFLG end)
+/*
+**		Add a part of the data. The checksum has no output until READ,
+**		and the end of the data changes nothing.
+**
+***********************************************************************/
+{
+	REBSUM *sum = (REBSUM*)BIN_HEAD(state);
+
+	if (end) return;
+	Checksum_Update(sum->sym, SUM_CTX(sum), data, len);
+	sum->len += len;
+}
+
+
+/***********************************************************************
+**
+*/	static void Read_Checksum(REBSER *port, REBVAL *state, REBVAL *out)
+/*
+***********************************************************************/
+{
+	REBSUM *sum = (REBSUM*)VAL_BIN(state);
+
+	Checksum_Final(sum->sym, SUM_CTX(sum), out);
+}
+
+
+/***********************************************************************
+**
+*/	static REBI64 Checksum_Length(REBVAL *state)
+/*
+***********************************************************************/
+{
+	return ((REBSUM*)VAL_BIN(state))->len;
+}
+
+static const STREAM_PORT Checksum_Port = {Make_Port_Stream, Checksum_Stream, 0, Read_Checksum, Checksum_Length, 0};
+
+
+/***********************************************************************
+**
+*/	static int Checksum_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+***********************************************************************/
+{
+	return Do_Stream_Port(ds, port, action, &Checksum_Port);
+}
+
+
+/***********************************************************************
+**
+*/	void Init_Checksum_Scheme(void)
+/*
+***********************************************************************/
+{
+	Register_Scheme(SYM_CHECKSUM, 0, Checksum_Actor);
+}
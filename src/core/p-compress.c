@@ -0,0 +1,140 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  p-compress.c
+**  Summary: compression stream ports
+**  Section: ports
+**  Notes:
+**		The deflate and inflate ports compress and decompress data
+**		as it is written, a part at a time, so a large file does not
+**		need to be in memory all at once:
+**
+**			z: open [scheme: 'deflate format: 'gzip level: 9]
+**			write z part		; compressed data is added to z/data
+**			out: read z		; takes the output so far
+**			update z		; ends the stream (gzip trailer)
+**			append out read z
+**
+**		CLEAR drops the output and starts a new stream.
+**
+**		Formats are zlib (the default), deflate (raw, no header or
+**		check) and gzip. Inflate detects zlib or gzip if no format
+**		is given, and reads all members of a gzip file. UPDATE of an
+**		inflate port checks that the data was complete. After it,
+**		the port can be used for another stream.
+**
+**		A deflate port with threads: (0 for one per CPU) deflates
+**		blocks of the data in parallel. The output is the same format,
+**		but comes when a block for each thread has been written.
+**
+**		See Z_Stream() in u-compress.c.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+
+/***********************************************************************
+**
+*/	static void Make_Port_Stream(REBSER *port, REBVAL *state, REBFLG inflate)
+/*
+**		Make the zlib stream of a port from its spec.
+**
+***********************************************************************/
+{
+	REBVAL *spec = OFV(port, STD_PORT_SPEC);
+	REBVAL *val;
+	REBCNT format = inflate ? 0 : SYM_ZLIB;
+	REBINT level = inflate ? -2 : -1;
+	REBINT threads = 1;
+
+	if (!IS_OBJECT(spec)) Trap0(RE_INVALID_PORT);
+
+	val = Obj_Value(spec, STD_PORT_SPEC_COMPRESS_FORMAT);
+	if (IS_WORD(val)) {
+		format = VAL_WORD_CANON(val);
+		if (format != SYM_ZLIB && format != SYM_DEFLATE && format != SYM_GZIP)
+			Trap_Port(RE_INVALID_SPEC, port, -10);
+	}
+	else if (!IS_NONE(val)) Trap_Port(RE_INVALID_SPEC, port, -10);
+
+	val = Obj_Value(spec, STD_PORT_SPEC_COMPRESS_LEVEL);
+	if (!inflate && IS_INTEGER(val)) level = Int32(val);
+
+	val = Obj_Value(spec, STD_PORT_SPEC_COMPRESS_THREADS);
+	if (!inflate && IS_INTEGER(val)) threads = Int32(val);
+
+	Set_Block(state, Make_Z_Stream(format, level, threads));
+}
+
+
+/***********************************************************************
+**
+*/	static void Make_Deflate_Stream(REBSER *port, REBVAL *state)
+/*
+***********************************************************************/
+{
+	Make_Port_Stream(port, state, FALSE);
+}
+
+
+/***********************************************************************
+**
+*/	static void Make_Inflate_Stream(REBSER *port, REBVAL *state)
+/*
+***********************************************************************/
+{
+	Make_Port_Stream(port, state, TRUE);
+}
+
+static const STREAM_PORT Deflate_Port = {Make_Deflate_Stream, Z_Stream, 0, 0, 0, REB_BINARY};
+static const STREAM_PORT Inflate_Port = {Make_Inflate_Stream, Z_Stream, 0, 0, 0, REB_BINARY};
+
+
+/***********************************************************************
+**
+*/	static int Deflate_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+***********************************************************************/
+{
+	return Do_Stream_Port(ds, port, action, &Deflate_Port);
+}
+
+
+/***********************************************************************
+**
+*/	static int Inflate_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+***********************************************************************/
+{
+	return Do_Stream_Port(ds, port, action, &Inflate_Port);
+}
+
+
+/***********************************************************************
+**
+*/	void Init_Compress_Scheme(void)
+/*
+***********************************************************************/
+{
+	Register_Scheme(SYM_DEFLATE, 0, Deflate_Actor);
+	Register_Scheme(SYM_INFLATE, 0, Inflate_Actor);
+}
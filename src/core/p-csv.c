@@ -0,0 +1,125 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  p-csv.c
+**  Summary: CSV record stream port
+**  Section: ports
+**  Notes:
+**		The csv port scans CSV a part at a time, as data is written,
+**		for files too large to DECODE at once:
+**
+**			c: open [scheme: 'csv delimiter: #";" infer: true]
+**			write c part		; records are added to c/data
+**			records: read c		; takes the records so far
+**			update c		; ends the stream (the last record)
+**
+**		With encode: true it goes the other way, as ENCODE does:
+**
+**			c: open [scheme: 'csv encode: true delimiter: #"^-"]
+**			write c records		; CSV text is added to c/data
+**			text: read c		; takes the text so far (binary)
+**
+**		Spec fields:
+**
+**			delimiter	- char (default comma)
+**			quote		- char (default double quote)
+**			infer		- true to scan numbers (integer! or decimal!)
+**						  and give none! for empty fields
+**			columns		- true for READ to give a block of columns:
+**						  a vector! for numbers, else a block
+**			encode		- true to write records (blocks)
+**
+**		See CSV_Stream() in u-csv.c.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+
+/***********************************************************************
+**
+*/	static void Make_Port_Stream(REBSER *port, REBVAL *state)
+/*
+**		Make the CSV stream of a port from its spec.
+**
+***********************************************************************/
+{
+	REBVAL *spec = OFV(port, STD_PORT_SPEC);
+	REBVAL *val;
+	REBYTE chars[2];
+
+	if (!IS_OBJECT(spec)) Trap0(RE_INVALID_PORT);
+
+	if (!Get_CSV_Chars(Obj_Value(spec, STD_PORT_SPEC_CSV_DELIMITER),
+		Obj_Value(spec, STD_PORT_SPEC_CSV_QUOTE), chars))
+		Trap_Port(RE_INVALID_SPEC, port, -10);
+
+	val = Obj_Value(spec, STD_PORT_SPEC_CSV_INFER);
+
+	Set_Block(state, Make_CSV_Stream(chars, val && IS_TRUE(val)));
+}
+
+
+/***********************************************************************
+**
+*/	static void Read_CSV(REBSER *port, REBVAL *state, REBVAL *out)
+/*
+**		With columns: true, READ gives columns, not records.
+**
+***********************************************************************/
+{
+	REBVAL *val = Obj_Value(OFV(port, STD_PORT_SPEC), STD_PORT_SPEC_CSV_COLUMNS);
+
+	if (val && IS_TRUE(val))
+		Set_Block(out, CSV_Columns(VAL_SERIES(out)));
+}
+
+static const STREAM_PORT CSV_Port = {Make_Port_Stream, CSV_Stream, 0, Read_CSV, 0, REB_BLOCK};
+static const STREAM_PORT CSV_Encode_Port = {Make_Port_Stream, 0, CSV_Write_Stream, 0, 0, REB_BINARY};
+
+
+/***********************************************************************
+**
+*/	static int CSV_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+***********************************************************************/
+{
+	REBVAL *val;
+
+	Validate_Port(port, action);
+
+	// With encode: true, records are written:
+	val = Obj_Value(OFV(port, STD_PORT_SPEC), STD_PORT_SPEC_CSV_ENCODE);
+	if (val && IS_TRUE(val))
+		return Do_Stream_Port(ds, port, action, &CSV_Encode_Port);
+
+	return Do_Stream_Port(ds, port, action, &CSV_Port);
+}
+
+
+/***********************************************************************
+**
+*/	void Init_CSV_Scheme(void)
+/*
+***********************************************************************/
+{
+	Register_Scheme(SYM_CSV, 0, CSV_Actor);
+}
@@ -35,8 +35,13 @@
 
 /***********************************************************************
 **
-*/	static int Read_Dir(REBREQ *dir, REBSER *files)
+*/	static int Read_Dir(REBREQ *dir, REBSER *files, REBVAL *prefix)
 /*
+**		Append the files of a dir to the files block.
+**
+**		For READ/DEEP (RFM_DEEP), each name is followed by its size
+**		and date, and starts with the prefix (the subdir path).
+**
 **		Provide option to get file info too.
 **		Provide option to prepend dir path.
 **		Provide option to use wildcards.
@@ -48,8 +53,8 @@
 	REBSER *fname;
 	REBSER *name;
 	REBREQ file;
+	REBOL_DAT dat;
 
-	RESET_TAIL(files);
 	CLEARS(&file);
 
 	// Temporary filename storage:
@@ -66,7 +71,13 @@
 		name = Copy_OS_Str(file.file.path, len);
 		if (GET_FLAG(file.modes, RFM_DIR))
 			SET_ANY_CHAR(name, name->tail-1, '/');
+		if (prefix) Insert_String(name, 0, VAL_SERIES(prefix), VAL_INDEX(prefix), VAL_LEN(prefix), 0);
 		Set_Series(REB_FILE, Append_Value(files), name);
+		if (GET_FLAG(dir->modes, RFM_DEEP)) {
+			SET_INTEGER(Append_Value(files), file.file.size);
+			OS_FILE_TIME(&file, &dat);
+			Set_Date(Append_Value(files), &dat);
+		}
 	}
 
 	if (result < 0 && dir->error != -RFE_OPEN_FAIL
@@ -209,6 +220,43 @@
 }
 
 
+/***********************************************************************
+**
+*/	static void Read_Deep(REBREQ *dir, REBVAL *path, REBSER *files)
+/*
+**		Read all subdirs for READ/DEEP. The files block is also the
+**		list of dirs to walk: it grows as each subdir is read, and
+**		the walk is done when its end is reached (breadth first).
+**		Only one dir is open at a time.
+**
+**		A subdir that cannot be read is listed, but not walked.
+**
+***********************************************************************/
+{
+	REBREQ sub;
+	REBVAL name;
+	REBVAL subpath;
+	REBSER *ser;
+	REBCNT n;
+
+	for (n = 0; n < SERIES_TAIL(files); n += 3) {
+		name = *BLK_SKIP(files, n); // copy it, the block can move
+		if (GET_ANY_CHAR(VAL_SERIES(&name), VAL_TAIL(&name)-1) != '/') continue;
+
+		ser = Copy_String(VAL_SERIES(path), VAL_INDEX(path), VAL_LEN(path));
+		Append_String(ser, VAL_SERIES(&name), VAL_INDEX(&name), VAL_LEN(&name));
+		Set_Series(REB_FILE, &subpath, ser);
+
+		CLEARS(&sub);
+		sub.port = dir->port;
+		sub.device = RDI_FILE;
+		SET_FLAG(sub.modes, RFM_DEEP);
+		Init_Dir_Path(&sub, &subpath, 1, POL_READ);
+		Read_Dir(&sub, files, &name);
+	}
+}
+
+
 /***********************************************************************
 **
 */	static int Dir_Actor(REBVAL *ds, REBSER *port, REBCNT action)
@@ -254,9 +302,17 @@
 		//Trap_Security(flags[POL_READ], POL_READ, path);
 		args = Find_Refines(ds, ALL_READ_REFS);
 		if (!IS_BLOCK(state)) {		// !!! ignores /SKIP and /PART, for now
+			if (args & AM_READ_DEEP) {
+				// Walk from a dir, not a wildcard:
+				if (VAL_LEN(path) == 0 || GET_ANY_CHAR(VAL_SERIES(path), VAL_TAIL(path)-1) != '/')
+					Trap1(RE_BAD_FILE_PATH, path);
+				SET_FLAG(dir.modes, RFM_DEEP);
+			}
 			Init_Dir_Path(&dir, path, 1, POL_READ);
 			Set_Block(state, Make_Block(7)); // initial guess
-			result = Read_Dir(&dir, VAL_SERIES(state));
+			result = Read_Dir(&dir, VAL_SERIES(state), 0);
+			if (result >= 0 && GET_FLAG(dir.modes, RFM_DEEP))
+				Read_Deep(&dir, path, VAL_SERIES(state));
 			///OS_FREE(dir.file.path);
 			if (result < 0) Trap_Port(RE_CANNOT_OPEN, port, dir.error);
 			*D_RET = *state;
@@ -315,7 +371,7 @@ create:
 		//if (args & ~AM_OPEN_READ) Trap1(RE_INVALID_SPEC, path);
 		Set_Block(state, Make_Block(7));
 		Init_Dir_Path(&dir, path, 1, POL_READ);
-		result = Read_Dir(&dir, VAL_SERIES(state));
+		result = Read_Dir(&dir, VAL_SERIES(state), 0);
 		///OS_FREE(dir.file.path);
 		if (result < 0) Trap_Port(RE_CANNOT_OPEN, port, dir.error);
 		break;
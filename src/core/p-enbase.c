@@ -0,0 +1,130 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  p-enbase.c
+**  Summary: base-64, 16 and 2 stream ports
+**  Section: ports
+**  Notes:
+**		The enbase and debase ports do ENBASE and DEBASE a part at a
+**		time, as data is written:
+**
+**			b: open [scheme: 'debase base: 64]
+**			write b part		; decoded data is added to b/data
+**			out: read b		; takes the output so far
+**			update b		; ends the stream (checks it was complete)
+**
+**		UPDATE of an enbase port adds the base-64 padding. The output
+**		has no line breaks. Base is 64 if not given.
+**
+**		See Base_Stream() in f-enbase.c.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+
+/***********************************************************************
+**
+*/	static void Make_Port_Stream(REBSER *port, REBVAL *state, REBFLG decode)
+/*
+**		Make the base stream of a port from its spec.
+**
+***********************************************************************/
+{
+	REBVAL *spec = OFV(port, STD_PORT_SPEC);
+	REBVAL *val;
+	REBINT base = 64;
+
+	if (!IS_OBJECT(spec)) Trap0(RE_INVALID_PORT);
+
+	val = Obj_Value(spec, STD_PORT_SPEC_BASE_BASE);
+	if (IS_INTEGER(val)) base = Int32(val);
+	else if (!IS_NONE(val)) Trap_Port(RE_INVALID_SPEC, port, -10);
+	if (base != 64 && base != 16 && base != 2) Trap_Port(RE_INVALID_SPEC, port, -10);
+
+	Set_Binary(state, Make_Base_Stream(base, decode));
+}
+
+
+/***********************************************************************
+**
+*/	static void Make_Enbase_Stream(REBSER *port, REBVAL *state)
+/*
+***********************************************************************/
+{
+	Make_Port_Stream(port, state, FALSE);
+}
+
+
+/***********************************************************************
+**
+*/	static void Make_Debase_Stream(REBSER *port, REBVAL *state)
+/*
+***********************************************************************/
+{
+	Make_Port_Stream(port, state, TRUE);
+}
+
+
+/***********************************************************************
+**
+*/	static void Read_Enbase(REBSER *port, REBVAL *state, REBVAL *out)
+/*
+**		The encoded text is READ as a string.
+**
+***********************************************************************/
+{
+	Set_String(out, VAL_SERIES(out));
+}
+
+static const STREAM_PORT Enbase_Port = {Make_Enbase_Stream, Base_Stream, 0, Read_Enbase, 0, REB_BINARY};
+static const STREAM_PORT Debase_Port = {Make_Debase_Stream, Base_Stream, 0, 0, 0, REB_BINARY};
+
+
+/***********************************************************************
+**
+*/	static int Enbase_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+***********************************************************************/
+{
+	return Do_Stream_Port(ds, port, action, &Enbase_Port);
+}
+
+
+/***********************************************************************
+**
+*/	static int Debase_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+***********************************************************************/
+{
+	return Do_Stream_Port(ds, port, action, &Debase_Port);
+}
+
+
+/***********************************************************************
+**
+*/	void Init_Base_Scheme(void)
+/*
+***********************************************************************/
+{
+	Register_Scheme(SYM_ENBASE, 0, Enbase_Actor);
+	Register_Scheme(SYM_DEBASE, 0, Debase_Actor);
+}
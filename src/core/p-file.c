@@ -179,6 +179,97 @@ REBINT Mode_Syms[] = {
 }
 
 
+/***********************************************************************
+**
+*/	static REBINT Finish_File_IO(REBREQ *file)
+/*
+**		Wait for a READ or WRITE the device left pending. Other
+**		devices keep running while we wait for it.
+**
+***********************************************************************/
+{
+	while (GET_FLAG(file->flags, RRF_PENDING)) OS_WAIT(1000, 0); // woken when done
+
+	return file->error ? DR_ERROR : DR_DONE;
+}
+
+
+/***********************************************************************
+**
+*/	static REBINT Do_File_IO(REBREQ *file, REBCNT command)
+/*
+**		Read or write a file. The device may do it in the
+**		background (e.g. io_uring) and leave it pending.
+**
+**		For a port with an AWAKE function (RFM_AWAKE), return
+**		without waiting. The port gets a READ or WROTE event when
+**		the transfer is done (or an ERROR event), just as a network
+**		port does, and A_UPDATE then sets its DATA. A transfer that
+**		did not need to wait gets its event queued here.
+**
+**		Otherwise, wait for it.
+**
+***********************************************************************/
+{
+	REBINT result;
+	REBVAL *event;
+
+	file->actual = 0;
+	result = OS_DO_DEVICE(file, command);
+
+	if (GET_FLAG(file->modes, RFM_AWAKE)) {
+		if (result == DR_DONE && NZ(event = Append_Event())) { // sets signal
+			VAL_SET(event, REB_EVENT);
+			VAL_EVENT_TYPE(event) = (command == RDC_READ) ? EVT_READ : EVT_WROTE;
+			VAL_EVENT_FLAGS(event) = 0;
+			VAL_EVENT_WIN(event) = 0;
+			VAL_EVENT_MODEL(event) = EVM_DEVICE;
+			VAL_EVENT_DATA(event) = 0;
+			VAL_EVENT_REQ(event) = file;
+		}
+		return result;
+	}
+
+	if (result != DR_PEND) return result;
+
+	return Finish_File_IO(file);
+}
+
+
+/***********************************************************************
+**
+*/	static void Update_File_Port(REBSER *port, REBREQ *file)
+/*
+**		Set the port DATA for a READ or WRITE done with an event:
+**		the binary that was read, or NONE when the write is done.
+**
+**		A read was done into a buffer of the port (see Read_File_Port),
+**		which is copied to a new binary and freed here.
+**
+***********************************************************************/
+{
+	REBVAL *data = OFV(port, STD_PORT_DATA);
+	REBSER *ser;
+
+	if (!GET_FLAG(file->modes, RFM_AWAKE)) return;
+
+	if (file->command == RDC_READ) {
+		if (!file->data) return; // (its event came after an earlier update)
+		if (file->error) SET_NONE(data);
+		else {
+			ser = Make_Binary(file->actual);
+			COPY_MEM(BIN_HEAD(ser), file->data, file->actual);
+			SERIES_TAIL(ser) = file->actual;
+			STR_TERM(ser);
+			Set_Binary(data, ser);
+		}
+		Free_Mem(file->data, file->length + 1);
+		file->data = 0;
+	}
+	else if (file->command == RDC_WRITE) SET_NONE(data);
+}
+
+
 /***********************************************************************
 **
 */	static void Read_File_Port(REBSER *port, REBREQ *file, REBVAL *path, REBCNT args, REBCNT len)
@@ -189,17 +280,42 @@ REBINT Mode_Syms[] = {
 {
 	REBSER *ser;
 	REBVAL *ds = DS_RETURN;
-
-	// Allocate read result buffer:
-	ser = Make_Binary(len);
-	Set_Series(REB_BINARY, ds, ser); //??? what if already set?
-
-	// Do the read, check for errors:
-	file->data = BIN_HEAD(ser);
-	file->length = len;
-	if (OS_DO_DEVICE(file, RDC_READ) < 0) Trap_Port(RE_READ_ERROR, port, file->error);
-	SERIES_TAIL(ser) = file->actual;
-	STR_TERM(ser);
+	REBYTE *data;
+
+	// Map the file data, rather than read it, if that can be done:
+	if ((args & AM_READ_MAP) && NZ(data = OS_MAP_FILE(file, file->file.index, len))) {
+		ser = Make_Mapped_Binary(data, len);
+		Set_Series(REB_BINARY, ds, ser);
+		file->actual = len;
+		file->file.index += len;
+		SET_FLAG(file->modes, RFM_RESEEK); // (file position is not moved)
+	}
+	else if (GET_FLAG(file->modes, RFM_AWAKE)) {
+		// The device fills the buffer until the READ event. It is not
+		// a series, as port/data could be changed, expanded or freed
+		// by then, so it is copied to port/data by Update_File_Port:
+		file->data = Make_Mem(len + 1);
+		if (!file->data) Trap0(RE_NO_MEMORY);
+		file->length = len;
+		if (Do_File_IO(file, RDC_READ) < 0) {
+			Free_Mem(file->data, len + 1);
+			file->data = 0;
+			Trap_Port(RE_READ_ERROR, port, file->error);
+		}
+		return;
+	}
+	else {
+		// Allocate read result buffer:
+		ser = Make_Binary(len);
+		Set_Series(REB_BINARY, ds, ser); //??? what if already set?
+
+		// Do the read, check for errors:
+		file->data = BIN_HEAD(ser);
+		file->length = len;
+		if (Do_File_IO(file, RDC_READ) < 0) Trap_Port(RE_READ_ERROR, port, file->error);
+		SERIES_TAIL(ser) = file->actual;
+		STR_TERM(ser);
+	}
 
 	// Convert to string or block of strings.
 	// NOTE: This code is incorrect for files read in chunks!!!
@@ -216,7 +332,7 @@ REBINT Mode_Syms[] = {
 
 /***********************************************************************
 **
-*/	static void Write_File_Port(REBREQ *file, REBVAL *data, REBCNT len, REBCNT args)
+*/	static void Write_File_Port(REBSER *port, REBREQ *file, REBVAL *data, REBCNT len, REBCNT args)
 /*
 ***********************************************************************/
 {
@@ -243,10 +359,18 @@ REBINT Mode_Syms[] = {
 		len = SERIES_TAIL(ser);
 	}
 	else {
+		ser = 0;
 		file->data = VAL_BIN_DATA(data);
 	}
 	file->length = len;
-	OS_DO_DEVICE(file, RDC_WRITE);
+
+	// Keep the data while it is written in the background:
+	if (GET_FLAG(file->modes, RFM_AWAKE)) {
+		if (ser) Set_Binary(OFV(port, STD_PORT_DATA), ser);
+		else *OFV(port, STD_PORT_DATA) = *data;
+	}
+
+	Do_File_IO(file, RDC_WRITE);
 }
 
 
@@ -270,7 +394,7 @@ REBINT Mode_Syms[] = {
 	// Compute and bound bytes remaining:
 	len = file->file.size - file->file.index; // already read
 	if (len < 0) return 0;
-	len &= MAX_READ_MASK; // limit the size
+	if (len > MAX_READ_MASK) len = MAX_READ_MASK; // limit the size
 
 	// Return requested length:
 	if (!D_REF(arg)) return (REBCNT)len;
@@ -315,6 +439,7 @@ REBINT Mode_Syms[] = {
 	REBREQ *file = 0;
 	REBCNT args = 0;
 	REBCNT len;
+	REBCNT sym;
 	REBOOL opened = FALSE;	// had to be opened (shortcut case)
 
 	//Print("FILE ACTION: %r", Get_Action_Word(action));
@@ -335,8 +460,19 @@ REBINT Mode_Syms[] = {
 	// Get or setup internal state data:
 	file = (REBREQ*)Use_Port_State(port, RDI_FILE, sizeof(*file));
 
+	// Finish a READ or WRITE still done in the background first:
+	if (action != A_UPDATE && GET_FLAG(file->flags, RRF_PENDING)) {
+		Finish_File_IO(file);
+		Update_File_Port(port, file);
+	}
+
 	switch (action) {
 
+	case A_UPDATE:
+		// Called by WAKE-UP for the event of a READ or WRITE:
+		Update_File_Port(port, file);
+		return R_NONE;
+
 	case A_READ:
 		args = Find_Refines(ds, ALL_READ_REFS);
 
@@ -349,10 +485,19 @@ REBINT Mode_Syms[] = {
 			opened = TRUE;
 		}
 
+		// An open port with an AWAKE function reads in the background:
+		if (!opened && ANY_FUNC(OFV(port, STD_PORT_AWAKE))
+			&& !(args & (AM_READ_STRING | AM_READ_LINES | AM_READ_MAP)))
+			SET_FLAG(file->modes, RFM_AWAKE);
+		else CLR_FLAG(file->modes, RFM_AWAKE);
+
 		if (args & AM_READ_SEEK) Set_Seek(file, D_ARG(ARG_READ_INDEX));
 		len = Set_Length(ds, file, ARG_READ_PART);
 		Read_File_Port(port, file, path, args, len);
 
+		// Return the port; the data comes with the READ event:
+		if (GET_FLAG(file->modes, RFM_AWAKE)) *D_RET = *D_ARG(1);
+
 		if (opened) {
 			OS_DO_DEVICE(file, RDC_CLOSE);
 			Cleanup_File(file);
@@ -391,6 +536,11 @@ REBINT Mode_Syms[] = {
 		}
 		if (args & AM_WRITE_SEEK) Set_Seek(file, D_ARG(ARG_WRITE_INDEX));
 
+		// An open port with an AWAKE function writes in the background:
+		if (!opened && ANY_FUNC(OFV(port, STD_PORT_AWAKE)))
+			SET_FLAG(file->modes, RFM_AWAKE);
+		else CLR_FLAG(file->modes, RFM_AWAKE);
+
 		// Determine length. Clip /PART to size of string if needed.
 		len = VAL_LEN(spec);
 		if (args & AM_WRITE_PART) {
@@ -398,7 +548,7 @@ REBINT Mode_Syms[] = {
 			if (n <= len) len = n;
 		}
 
-		Write_File_Port(file, spec, len, args);
+		Write_File_Port(port, file, spec, len, args);
 
 		if (opened) {
 			OS_DO_DEVICE(file, RDC_CLOSE);
@@ -475,6 +625,19 @@ REBINT Mode_Syms[] = {
 		break;
 
 	case A_MODIFY:
+		// Flush or give a hint for an open file (done by the device):
+		//   MODIFY port 'sync none       - write the data to the disk
+		//   MODIFY port 'sequential true - the file is used in order
+		if (IS_OPEN(file) && IS_WORD(D_ARG(2))) {
+			sym = VAL_WORD_CANON(D_ARG(2));
+			if (sym == SYM_SYNC || sym == SYM_SEQUENTIAL) {
+				if (sym == SYM_SYNC) SET_FLAG(file->modes, RFM_SYNC);
+				else if (IS_TRUE(D_ARG(3))) SET_FLAG(file->modes, RFM_SEQUENTIAL);
+				else CLR_FLAG(file->modes, RFM_SEQUENTIAL);
+				if (OS_DO_DEVICE(file, RDC_MODIFY) < 0) Trap_Port(RE_WRITE_ERROR, port, file->error);
+				return R_TRUE;
+			}
+		}
 		Set_Mode_Value(file, Get_Mode_Id(D_ARG(2)), D_ARG(3));
 		if (!IS_OPEN(file)) {
 			Setup_File(file, 0, path);
@@ -0,0 +1,76 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  p-json.c
+**  Summary: JSON event stream port
+**  Section: ports
+**  Notes:
+**		The json port scans JSON a part at a time, as data is written,
+**		for documents too large to DECODE at once:
+**
+**			j: open json://
+**			write j part		; events are added to j/data
+**			events: read j		; takes the events so far
+**			update j		; ends the stream (checks it was complete)
+**
+**		Events are a flat block of the words object, array, end and
+**		key (followed by the key string), and the values themselves:
+**
+**			{"a": [1, null]}  ->  [object key "a" array 1 none end end]
+**
+**		Any number of values can be written (as in JSON Lines).
+**		See JSON_Stream() in u-json.c.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+
+/***********************************************************************
+**
+*/	static void Make_Port_Stream(REBSER *port, REBVAL *state)
+/*
+***********************************************************************/
+{
+	Set_Block(state, Make_JSON_Stream());
+}
+
+static const STREAM_PORT JSON_Port = {Make_Port_Stream, JSON_Stream, 0, 0, 0, REB_BLOCK};
+
+
+/***********************************************************************
+**
+*/	static int JSON_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+***********************************************************************/
+{
+	return Do_Stream_Port(ds, port, action, &JSON_Port);
+}
+
+
+/***********************************************************************
+**
+*/	void Init_JSON_Scheme(void)
+/*
+***********************************************************************/
+{
+	Register_Scheme(SYM_JSON, 0, JSON_Actor);
+}
@@ -24,6 +24,8 @@
 **  Section: ports
 **  Author:  Carl Sassenrath
 **  Notes:
+**		The http-server scheme is a TCP port that reads whole HTTP
+**		requests. See HTTP_Server_Actor().
 **
 ***********************************************************************/
 
@@ -33,12 +35,88 @@
 #include "reb-evtypes.h"
 
 #define NET_BUF_SIZE 32*1024
+#define NET_BUF_MAX (4*1024*1024)	// max that a read buffer grows at once
+
+#define GATHER_MAX 0x40000000	// max length of one gathered write (more is sent in turns)
+
+#define HTTP_MAX_HEAD 64*1024	// max size of the request line and headers
+#define HTTP_MAX_CHUNK_LINE 1024
+#define HTTP_MAX_BODY (16*1024*1024)	// default max size of a request body (spec max-body)
 
 enum Transport_Types {
 	TRANSPORT_TCP,
-	TRANSPORT_UDP
+	TRANSPORT_UDP,
+	TRANSPORT_HTTP				// TCP, reading HTTP requests
+};
+
+// State of an http-server connection (the TCP request, extended):
+typedef struct {
+	REBREQ sock;				// must be first
+	REBCNT scan;				// data parsed so far (headers or raw chunks)
+	REBCNT head;				// length of the request line and headers (0 if not all read)
+	REBCNT body;				// length of the body (decoded so far, if chunked)
+	REBINT length;				// content length, or -1 for a chunked body
+	REBCNT max_body;			// max length of the body
+	REBCNT used;				// data of the request being answered (0 if none)
+	REBYTE *rest;				// data read after it (pipelined requests), or zero
+	REBCNT rest_len;			// length of that data
+} HTTP_CONN;
+
+// Request methods (as words):
+static const char *HTTP_Methods[] = {
+	"get", "head", "post", "put", "delete", "options", "patch", "trace", "connect", 0
+};
+
+// Socket options for MODIFY (in RSO_ order):
+static REBINT Net_Mode_Syms[] = {
+	SYM_NO_DELAY,
+	SYM_KEEP_ALIVE,
+	SYM_FAST_OPEN,
+	SYM_REUSE_PORT,
+	0
 };
 
+
+/***********************************************************************
+**
+*/	static REBSER *Form_IPv6(REBYTE *ip6)
+/*
+**		Return the text form of an IPv6 address (as RFC 5952):
+**		hex groups, with the longest run of zero groups as "::".
+**
+***********************************************************************/
+{
+	REBYTE buf[40];
+	REBYTE *bp = buf;
+	REBCNT group[8];
+	REBINT zero = -1;	// longest zero run
+	REBINT zlen = 1;	// (must be at least two groups)
+	REBINT n, m, len;
+
+	for (n = 0; n < 8; n++) group[n] = (ip6[n*2] << 8) | ip6[n*2+1];
+
+	for (n = 0; n < 8; n++) {
+		for (m = n; m < 8 && !group[m]; m++);
+		if (m - n > zlen) zero = n, zlen = m - n;
+		if (m > n) n = m;
+	}
+
+	for (n = 0; n < 8; n++) {
+		if (n == zero) {
+			*bp++ = ':';
+			*bp++ = ':';
+			n += zlen - 1;
+			continue;
+		}
+		if (n > 0 && n != zero + zlen) *bp++ = ':';
+		for (len = 12; len > 0 && !(group[n] >> len); len -= 4);
+		for (; len >= 0; len -= 4) *bp++ = "0123456789abcdef"[(group[n] >> len) & 15];
+	}
+
+	return Copy_Bytes(buf, bp - buf);
+}
+
+
 /***********************************************************************
 **
 */	static void Ret_Query_Net(REBSER *port, REBREQ *sock, REBVAL *ret)
@@ -53,8 +131,15 @@ enum Transport_Types {
 	obj = CLONE_OBJECT(VAL_OBJ_FRAME(info));
 
 	SET_OBJECT(ret, obj);
-	Set_Tuple(OFV(obj, STD_NET_INFO_LOCAL_IP), (REBYTE*)&sock->net.local_ip, 4);
-	Set_Tuple(OFV(obj, STD_NET_INFO_REMOTE_IP), (REBYTE*)&sock->net.remote_ip, 4);
+	if (GET_FLAG(sock->state, RSM_IPV6)) {
+		// A tuple! is too short for an IPv6 address, so use a string:
+		Set_String(OFV(obj, STD_NET_INFO_LOCAL_IP), Form_IPv6(sock->net.local_ip6));
+		Set_String(OFV(obj, STD_NET_INFO_REMOTE_IP), Form_IPv6(sock->net.remote_ip6));
+	}
+	else {
+		Set_Tuple(OFV(obj, STD_NET_INFO_LOCAL_IP), (REBYTE*)&sock->net.local_ip, 4);
+		Set_Tuple(OFV(obj, STD_NET_INFO_REMOTE_IP), (REBYTE*)&sock->net.remote_ip, 4);
+	}
 	SET_INTEGER(OFV(obj, STD_NET_INFO_LOCAL_PORT), sock->net.local_port);
 	SET_INTEGER(OFV(obj, STD_NET_INFO_REMOTE_PORT), sock->net.remote_port);
 }
@@ -62,9 +147,10 @@ enum Transport_Types {
 
 /***********************************************************************
 **
-*/	static void Accept_New_Port(REBVAL *ds, REBSER *port, REBREQ *sock)
+*/	static void Accept_New_Port(REBVAL *ds, REBSER *port, REBREQ *sock, REBCNT size)
 /*
 **		Clone a listening port as a new accept port.
+**		Size is that of its state (the request, maybe extended).
 **
 ***********************************************************************/
 {
@@ -84,13 +170,196 @@ enum Transport_Types {
 	SET_NONE(OFV(port, STD_PORT_STATE)); // just to be sure.
 
 	// Copy over the new sock data:
-	sock = Use_Port_State(port, RDI_NET, sizeof(*sock));
+	sock = Use_Port_State(port, RDI_NET, size);
 	*sock = *nsock;
-	sock->clen = sizeof(*sock);
+	sock->clen = size;
 	sock->port = port;
 	OS_FREE(nsock); // allocated by dev_net.c (MT issues?)
 }
 
+/***********************************************************************
+**
+*/	static REBCNT Gather_Block(REBVAL *block, REBVAL *keep)
+/*
+**		Make the segment list for writing a block of values
+**		without joining them (see RST_GATHER in dev-net.c).
+**		Binaries are sent as is, and strings as UTF-8. An open
+**		file port is sent from its index to its end, by the OS
+**		if it can (sendfile).
+**
+**		A file can be larger than one write (the request length is
+**		32 bits), so the list ends after GATHER_MAX bytes of files.
+**		Gather_Sent then makes the list for the rest of the block.
+**
+**		Keep is set to a block that holds the block (at the value
+**		the write starts from), the segment list, the index to go
+**		on from, and all data it refers to (GC safe while the write
+**		pends). Returns the total length.
+**
+***********************************************************************/
+{
+	REBSER *hold = Make_Block(VAL_LEN(block) + 3);
+	REBSER *list;
+	REBIOV *seg;
+	REBVAL *val;
+	REBVAL *next;
+	REBVAL *state;
+	REBSER *ser;
+	REBREQ *file;
+	REBCNT total = 0;
+	i64 left;
+
+	Set_Block(keep, hold);
+	Append_Val(hold, block);
+	list = Make_Binary((VAL_LEN(block) + 1) * sizeof(REBIOV));
+	Set_Binary(Append_Value(hold), list);
+	next = Append_Value(hold);
+	seg = (REBIOV *)BIN_HEAD(list);
+
+	for (val = VAL_BLK_DATA(block); NOT_END(val) && total < GATHER_MAX; val++, seg++) {
+		CLEARS(seg);
+		if (IS_BINARY(val)) {
+			seg->data = VAL_BIN_DATA(val);
+			seg->length = VAL_LEN(val);
+		}
+		else if (ANY_STR(val)) {
+			ser = Encode_UTF8_Value(val, VAL_LEN(val), ENCF_NO_COPY);
+			if (ser) {
+				Set_Binary(Append_Value(hold), ser);
+				seg->data = BIN_HEAD(ser);
+				seg->length = SERIES_TAIL(ser);
+			}
+			else {
+				seg->data = VAL_BIN_DATA(val);
+				seg->length = VAL_LEN(val);
+			}
+		}
+#ifdef HAS_SENDFILE
+		else if (
+			IS_PORT(val)
+			&& IS_BINARY(state = BLK_SKIP(VAL_PORT(val), STD_PORT_STATE))
+			&& (file = (REBREQ*)VAL_BIN(state))->device == RDI_FILE
+			&& IS_OPEN(file)
+			&& !GET_FLAG(file->modes, RFM_DIR)
+		) {
+			seg->file = file->id;
+			seg->index = file->file.index;
+			left = file->file.size - file->file.index;
+			if (left < 0) left = 0;
+			seg->length = (REBCNT)MIN(left, GATHER_MAX - total);
+			if (seg->length < left) {
+				// The rest of the file is sent by the next write:
+				total += seg->length;
+				seg++;
+				break;
+			}
+		}
+#endif
+		else Trap_Arg(val);
+		total += seg->length;
+	}
+
+	SERIES_TAIL(list) = (REBCNT)(seg - (REBIOV *)BIN_HEAD(list)) * sizeof(REBIOV);
+	SET_INTEGER(next, (REBINT)(val - BLK_HEAD(VAL_SERIES(block))));
+
+	return total;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Gather_Sent(REBVAL *keep)
+/*
+**		After a gathered write is done, advance the index of each
+**		file port by what was sent from it. If more of the block
+**		is left (see Gather_Block), make the list for it in keep
+**		and return its length, else return zero.
+**
+**		More is left only when a file was larger than one write.
+**		The next write is then made by A_UPDATE, for the WROTE
+**		event of this one.
+**
+***********************************************************************/
+{
+	REBSER *hold = VAL_SERIES(keep);
+	REBSER *list = VAL_SERIES(BLK_SKIP(hold, 1));
+	REBIOV *seg = (REBIOV *)BIN_HEAD(list);
+	REBCNT n = SERIES_TAIL(list) / sizeof(REBIOV);
+	REBVAL *val = VAL_BLK_DATA(BLK_HEAD(hold));
+	REBVAL *state;
+	REBREQ *file;
+	REBVAL next;
+
+	for (; n > 0; n--, seg++, val++) {
+		if (
+			!seg->data
+			&& IS_PORT(val)
+			&& IS_BINARY(state = BLK_SKIP(VAL_PORT(val), STD_PORT_STATE))
+		) {
+			file = (REBREQ*)VAL_BIN(state);
+			file->file.index += seg->length;
+			SET_FLAG(file->modes, RFM_RESEEK); // (sendfile does not move it)
+		}
+	}
+
+	next = *BLK_HEAD(hold);
+	VAL_INDEX(&next) = VAL_INT32(BLK_SKIP(hold, 2));
+	if (VAL_INDEX(&next) >= VAL_TAIL(&next)) return 0;
+	return Gather_Block(&next, keep);
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Gather_Left(REBVAL *keep)
+/*
+**		Return TRUE if a gathered write has more of its block to
+**		send after the current write (see Gather_Sent).
+**
+***********************************************************************/
+{
+	REBSER *hold = VAL_SERIES(keep);
+
+	return VAL_INT32(BLK_SKIP(hold, 2)) < VAL_TAIL(BLK_HEAD(hold));
+}
+
+
+/***********************************************************************
+**
+*/	static void Read_Net(REBSER *port, REBREQ *sock)
+/*
+**		Read data into the port data buffer, expanding the buffer
+**		if needed. If no length is given, program must stop it at
+**		some point.
+**
+***********************************************************************/
+{
+	REBVAL *arg;
+	REBSER *ser;
+	REBINT result;
+
+	// Setup the read buffer (allocate a buffer if needed):
+	arg = OFV(port, STD_PORT_DATA);
+	if (!IS_STRING(arg) && !IS_BINARY(arg)) {
+		Set_Binary(arg, Make_Binary(NET_BUF_SIZE));
+	}
+	ser = VAL_SERIES(arg);
+	sock->length = SERIES_AVAIL(ser); // space available
+	// Grow with the data that is kept (large transfers), so that
+	// a big read takes fewer (and larger) recv calls and extends:
+	if (sock->length < NET_BUF_SIZE/2)
+		Extend_Series(ser, MIN(MAX(NET_BUF_SIZE, SERIES_TAIL(ser)), NET_BUF_MAX));
+	sock->length = SERIES_AVAIL(ser);
+	sock->data = STR_TAIL(ser); // write at tail
+	//if (SERIES_TAIL(ser) == 0)
+	sock->actual = 0;  // Actual for THIS read, not for total.
+
+	//Print("(max read length %d)", sock->length);
+	result = OS_DO_DEVICE(sock, RDC_READ); // recv can happen immediately
+	if (result < 0) Trap_Port(RE_READ_ERROR, port, sock->error);
+}
+
+
 /***********************************************************************
 **
 */	static int Transport_Actor(REBVAL *ds, REBSER *port, REBCNT action, enum Transport_Types proto)
@@ -104,7 +373,6 @@ enum Transport_Types {
 	REBINT result;	// IO result
 	REBCNT refs;	// refinement argument flags
 	REBCNT len;		// generic length
-	REBSER *ser;	// simplifier
 
 	Validate_Port(port, action);
 
@@ -112,7 +380,7 @@ enum Transport_Types {
 	arg = D_ARG(2);
 	refs = 0;
 
-	sock = Use_Port_State(port, RDI_NET, sizeof(*sock));
+	sock = Use_Port_State(port, RDI_NET, proto == TRANSPORT_HTTP ? sizeof(HTTP_CONN) : sizeof(*sock));
 	if (proto == TRANSPORT_UDP) {
 		SET_FLAG(sock->modes, RST_UDP);
 	}
@@ -172,6 +440,9 @@ enum Transport_Types {
 		case A_UPDATE:	// allowed after a close
 			break;
 
+		case A_MODIFY:	// options are set when it is opened
+			break;
+
 		default:
 			Trap_Port(RE_NOT_OPEN, port, -12);
 		}
@@ -188,34 +459,29 @@ enum Transport_Types {
 			if (ANY_BINSTR(arg)) VAL_TAIL(arg) += sock->actual;
 		}
 		else if (sock->command == RDC_WRITE) {
+			if (
+				GET_FLAG(sock->modes, RST_GATHER) && IS_BLOCK(arg)
+				&& NZ(len = Gather_Sent(arg))
+			) {
+				// More of a large file to send (no event until done):
+				sock->data = VAL_BIN(BLK_SKIP(VAL_SERIES(arg), 1));
+				sock->length = len;
+				sock->actual = 0;
+				result = OS_DO_DEVICE(sock, RDC_WRITE);
+				if (result < 0) Trap_Port(RE_WRITE_ERROR, port, sock->error);
+				if (IS_EVENT(D_ARG(2))) VAL_EVENT_TYPE(D_ARG(2)) = EVT_IGNORE;
+				return R_NONE;
+			}
 			SET_NONE(arg);  // Write is done.
 		}
 		return R_NONE;
 
 	case A_READ:
-		// Read data into a buffer, expanding the buffer if needed.
-		// If no length is given, program must stop it at some point.
 		refs = Find_Refines(ds, ALL_READ_REFS);
 		if (!GET_FLAG(sock->modes, RST_UDP)
 			&& !GET_FLAG(sock->state, RSM_CONNECT))
 			Trap_Port(RE_NOT_CONNECTED, port, -15);
-
-		// Setup the read buffer (allocate a buffer if needed):
-		arg = OFV(port, STD_PORT_DATA);
-		if (!IS_STRING(arg) && !IS_BINARY(arg)) {
-			Set_Binary(arg, Make_Binary(NET_BUF_SIZE));
-		}
-		ser = VAL_SERIES(arg);
-		sock->length = SERIES_AVAIL(ser); // space available
-		if (sock->length < NET_BUF_SIZE/2) Extend_Series(ser, NET_BUF_SIZE);
-		sock->length = SERIES_AVAIL(ser);
-		sock->data = STR_TAIL(ser); // write at tail
-		//if (SERIES_TAIL(ser) == 0)
-		sock->actual = 0;  // Actual for THIS read, not for total.
-
-		//Print("(max read length %d)", sock->length);
-		result = OS_DO_DEVICE(sock, RDC_READ); // recv can happen immediately
-		if (result < 0) Trap_Port(RE_READ_ERROR, port, sock->error);
+		Read_Net(port, sock);
 		break;
 
 	case A_WRITE:
@@ -236,22 +502,37 @@ enum Transport_Types {
 		}
 
 		// Setup the write:
-		*OFV(port, STD_PORT_DATA) = *spec;	// keep it GC safe
+		if (IS_BLOCK(spec)) {
+			// Send the values as they are (no join):
+			len = Gather_Block(spec, OFV(port, STD_PORT_DATA)); // keeps it GC safe
+			sock->data = VAL_BIN(BLK_SKIP(VAL_SERIES(OFV(port, STD_PORT_DATA)), 1));
+			SET_FLAG(sock->modes, RST_GATHER);
+		}
+		else {
+			*OFV(port, STD_PORT_DATA) = *spec;	// keep it GC safe
+			sock->data = VAL_BIN_DATA(spec);
+			CLR_FLAG(sock->modes, RST_GATHER);
+		}
 		sock->length = len;
-		sock->data = VAL_BIN_DATA(spec);
 		sock->actual = 0;
 
 		//Print("(write length %d)", len);
 		result = OS_DO_DEVICE(sock, RDC_WRITE); // send can happen immediately
 		if (result < 0) Trap_Port(RE_WRITE_ERROR, port, sock->error);
-		if (result == DR_DONE) SET_NONE(OFV(port, STD_PORT_DATA));
+		if (result == DR_DONE) {
+			// A block with more to send goes on with the event (A_UPDATE):
+			arg = OFV(port, STD_PORT_DATA);
+			if (IS_BLOCK(spec) && Gather_Left(arg)) break;
+			if (IS_BLOCK(spec)) Gather_Sent(arg);
+			SET_NONE(arg);
+		}
 		break;
 
 	case A_PICK:
 		// FIRST server-port returns new port connection.
 		len = Get_Num_Arg(arg); // Position
 		if (len == 1 && GET_FLAG(sock->modes, RST_LISTEN) && sock->data)
-			Accept_New_Port(ds, port, sock); // sets D_RET
+			Accept_New_Port(ds, port, sock, proto == TRANSPORT_HTTP ? sizeof(HTTP_CONN) : sizeof(*sock)); // sets D_RET
 		else
 			Trap_Range(arg);
 		break;
@@ -276,6 +557,16 @@ enum Transport_Types {
 		}
 		break;
 
+	case A_MODIFY:
+		// Set a socket option, e.g. MODIFY port 'no-delay true
+		if (!IS_WORD(arg)) Trap_Arg(arg);
+		len = Find_Int(&Net_Mode_Syms[0], VAL_WORD_CANON(arg));
+		if (len == NOT_FOUND) Trap_Arg(arg);
+		if (IS_TRUE(D_ARG(3))) SET_FLAG(sock->net.options, len);
+		else CLR_FLAG(sock->net.options, len);
+		if (IS_OPEN(sock)) OS_DO_DEVICE(sock, RDC_MODIFY);
+		return R_TRUE;
+
 	case A_LENGTHQ:
 		arg = OFV(port, STD_PORT_DATA);
 		len = ANY_SERIES(arg) ? VAL_TAIL(arg) : 0;
@@ -323,6 +614,442 @@ enum Transport_Types {
 	return Transport_Actor(ds, port, action, TRANSPORT_UDP);
 }
 
+/***********************************************************************
+**
+*/	static REBSER *Request_Object(REBSER *port, REBFLG reset)
+/*
+**		Get the http-request object of a connection (in port/locals),
+**		making it if needed. It is reused for each request, and its
+**		fields are cleared if reset is set (a new request).
+**
+***********************************************************************/
+{
+	REBVAL *locals = OFV(port, STD_PORT_LOCALS);
+	REBSER *std = VAL_OBJ_FRAME(Get_System(SYS_STANDARD, STD_HTTP_REQUEST));
+	REBSER *obj;
+	REBCNT n;
+
+	if (IS_OBJECT(locals) && FRM_WORD_SERIES(VAL_OBJ_FRAME(locals)) == FRM_WORD_SERIES(std)) {
+		obj = VAL_OBJ_FRAME(locals);
+		if (!reset) return obj;
+	}
+	else {
+		obj = CLONE_OBJECT(std);
+		SET_OBJECT(locals, obj);
+		Set_Block(OFV(obj, STD_HTTP_REQUEST_HEADERS), Make_Block(16));
+	}
+
+	for (n = 1; n < SERIES_TAIL(obj); n++) {
+		if (n != STD_HTTP_REQUEST_HEADERS) SET_NONE(OFV(obj, n));
+	}
+	return obj;
+}
+
+
+/***********************************************************************
+**
+*/	static REBINT Parse_Head(REBSER *obj, HTTP_CONN *http, REBYTE *bp, REBCNT len)
+/*
+**		Parse the request line and header fields (len bytes, up to
+**		and including the empty line) into the request object.
+**		Returns 0, or the HTTP status code of the error.
+**
+***********************************************************************/
+{
+	REBVAL *headers = OFV(obj, STD_HTTP_REQUEST_HEADERS);
+	REBYTE *ep = bp + len;
+	REBYTE *cp;			// start of item
+	REBYTE *sp;			// end of item
+	REBYTE *lp;			// end of line
+	REBI64 size = -1;	// content-length
+	REBOOL chunked = FALSE;
+	REBOOL alive;
+	REBOOL close = FALSE;
+	REBINT n;
+
+	if (IS_BLOCK(headers)) {
+		RESET_TAIL(VAL_SERIES(headers));
+		BLK_TERM(VAL_SERIES(headers));
+		VAL_INDEX(headers) = 0;
+	}
+	else Set_Block(headers, Make_Block(16));
+
+	// Request line: method SP request-target SP HTTP-version
+	for (lp = bp; *lp != '\n'; lp++);
+	if (lp > bp && lp[-1] == '\r') lp--;
+
+	for (cp = sp = bp; sp < lp && *sp != ' '; sp++);
+	if (sp == cp || sp == lp) return 400;
+	for (n = 0; HTTP_Methods[n]; n++) {
+		if ((REBCNT)(sp - cp) == LEN_BYTES(HTTP_Methods[n])
+			&& !Compare_Bytes(cp, (REBYTE*)HTTP_Methods[n], sp - cp, FALSE)) break;
+	}
+	if (!HTTP_Methods[n]) return 501;
+	Init_Word(OFV(obj, STD_HTTP_REQUEST_METHOD), Make_Word(cp, sp - cp));
+
+	for (cp = ++sp; sp < lp && *sp != ' '; sp++);
+	if (sp == cp || sp == lp) return 400;
+	Set_String(OFV(obj, STD_HTTP_REQUEST_TARGET), Copy_Bytes(cp, sp - cp));
+
+	cp = sp + 1;
+	if (lp - cp != 8 || Compare_Bytes(cp, (REBYTE*)"HTTP/", 5, FALSE) || cp[6] != '.'
+		|| cp[5] < '0' || cp[5] > '9' || cp[7] < '0' || cp[7] > '9') return 400;
+	if (cp[5] != '1') return 505;
+	SET_DECIMAL(OFV(obj, STD_HTTP_REQUEST_VERSION), cp[7] == '0' ? 1.0 : 1.1);
+	alive = (cp[7] != '0'); // HTTP/1.1 is persistent by default
+
+	// Header fields: field-name ":" OWS field-value OWS
+	for (; *lp != '\n'; lp++);
+	for (cp = lp + 1; cp < ep; cp = lp + 1) {
+		REBYTE *vp;		// value
+		REBYTE *vep;	// end of value
+
+		for (lp = cp; *lp != '\n'; lp++);
+		vep = (lp > cp && lp[-1] == '\r') ? lp - 1 : lp;
+		if (vep == cp) break;	// the empty line
+		if (*cp == ' ' || *cp == '\t') return 400; // obsolete line folding
+
+		for (sp = cp; sp < vep && *sp != ':'; sp++) {
+			if (*sp == ' ' || *sp == '\t') return 400;
+		}
+		if (sp == cp || sp == vep) return 400;
+		for (vp = sp + 1; vp < vep && (*vp == ' ' || *vp == '\t'); vp++);
+		while (vep > vp && (vep[-1] == ' ' || vep[-1] == '\t')) vep--;
+
+		n = sp - cp;
+		if (n == 14 && !Compare_Bytes(cp, (REBYTE*)"content-length", 14, TRUE)) {
+			REBI64 num = 0;
+			REBYTE *tp;
+			if (vp == vep) return 400;
+			for (tp = vp; tp < vep; tp++) {
+				if (*tp < '0' || *tp > '9') return 400;
+				num = num * 10 + (*tp - '0');
+				if (num > MAX_I32) return 413;
+			}
+			if (size >= 0 && size != num) return 400;
+			size = num;
+		}
+		else if (n == 17 && !Compare_Bytes(cp, (REBYTE*)"transfer-encoding", 17, TRUE)) {
+			// Only chunked is supported (no compressed encodings):
+			if (vep - vp != 7 || Compare_Bytes(vp, (REBYTE*)"chunked", 7, TRUE)) return 501;
+			chunked = TRUE;
+		}
+		else if (n == 10 && !Compare_Bytes(cp, (REBYTE*)"connection", 10, TRUE)) {
+			REBYTE *tp;		// token
+			REBYTE *tep;	// end of token
+			for (tp = vp; tp < vep; tp = tep + 1) {
+				for (tep = tp; tep < vep && *tep != ','; tep++);
+				while (tp < tep && (*tp == ' ' || *tp == '\t')) tp++;
+				n = tep - tp;
+				while (n > 0 && (tp[n-1] == ' ' || tp[n-1] == '\t')) n--;
+				if (n == 5 && !Compare_Bytes(tp, (REBYTE*)"close", 5, TRUE)) close = TRUE;
+				if (n == 10 && !Compare_Bytes(tp, (REBYTE*)"keep-alive", 10, TRUE)) alive = TRUE;
+			}
+		}
+
+		Set_String(Append_Value(VAL_SERIES(headers)), Copy_Bytes(cp, sp - cp));
+		Set_String(Append_Value(VAL_SERIES(headers)), Copy_Bytes(vp, vep - vp));
+	}
+
+	// A length and chunked together is a request smuggling risk:
+	if (chunked && size >= 0) return 400;
+	http->length = chunked ? -1 : (size < 0 ? 0 : (REBINT)size);
+	SET_LOGIC(OFV(obj, STD_HTTP_REQUEST_KEEP_ALIVE), alive && !close);
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	static REBINT Dechunk(HTTP_CONN *http, REBYTE *bp, REBCNT tail)
+/*
+**		Decode a chunked body in place, as far as it has been read.
+**		Chunk data is moved down to follow the data decoded before
+**		it (at head + body). Scan is where the next chunk starts.
+**		Returns the end of the request (after the trailer fields),
+**		0 if more data is needed, or minus the HTTP error status.
+**
+***********************************************************************/
+{
+	REBCNT n;
+	REBCNT size;
+	REBCNT data;
+
+	while (TRUE) {
+		// Chunk size line: hex-size [; extensions] CRLF
+		for (n = http->scan; n < tail && bp[n] != '\n'; n++);
+		if (n == tail) return (n - http->scan > HTTP_MAX_CHUNK_LINE) ? -400 : 0;
+		data = n + 1;
+
+		size = 0;
+		for (n = http->scan; n < data; n++) {
+			REBYTE c = bp[n];
+			if (c >= '0' && c <= '9') c -= '0';
+			else if (c >= 'a' && c <= 'f') c -= 'a' - 10;
+			else if (c >= 'A' && c <= 'F') c -= 'A' - 10;
+			else break;
+			if (size > (MAX_I32 >> 4)) return -413;
+			size = (size << 4) + c;
+			if (http->body + size > http->max_body) return -413;
+		}
+		if (n == http->scan) return -400;
+		if (bp[n] != ';' && bp[n] != ' ' && bp[n] != '\t' && bp[n] != '\r' && bp[n] != '\n') return -400;
+
+		if (size == 0) {
+			// Last chunk. Skip the trailer fields, up to the empty line:
+			for (n = data; n < tail; n++) {
+				if (bp[n] != '\n') continue;
+				if (n == data || (n == data + 1 && bp[data] == '\r')) return n + 1;
+				data = n + 1;
+				if (data - http->scan > HTTP_MAX_HEAD) return -431;
+			}
+			// (A trailer line not ended yet counts too.)
+			return (tail - http->scan > HTTP_MAX_HEAD) ? -431 : 0;
+		}
+
+		// Chunk data CRLF:
+		if (tail < data + size + 1) return 0;
+		n = data + size;
+		if (bp[n] == '\r') {
+			if (tail < n + 2) return 0;
+			n++;
+		}
+		if (bp[n] != '\n') return -400;
+		memmove(bp + http->head + http->body, bp + data, size);
+		http->body += size;
+		http->scan = n + 1;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Parse_Request(REBSER *port, HTTP_CONN *http)
+/*
+**		Parse the request in the port data buffer, as far as it has
+**		been read. Returns TRUE when it is complete (or is an error),
+**		and the request object is set, otherwise FALSE.
+**
+**		The body is not copied: it is the data buffer at its index,
+**		and the buffer tail is set to its end. Data that follows it
+**		(pipelined requests) is moved out of the buffer, as the port
+**		data may be changed or expanded (see Next_Request).
+**
+***********************************************************************/
+{
+	REBVAL *data = OFV(port, STD_PORT_DATA);
+	REBVAL *val;
+	REBSER *obj;
+	REBSER *ser;
+	REBYTE *bp;
+	REBCNT tail;
+	REBCNT n;
+	REBINT end = 0;
+	REBINT status = 0;
+
+	if (!IS_BINARY(data)) return FALSE;
+	ser = VAL_SERIES(data);
+	bp = BIN_HEAD(ser);
+	tail = SERIES_TAIL(ser);
+
+	if (!http->head) {
+		// Skip empty lines before a request line:
+		for (n = 0; n < tail && (bp[n] == '\r' || bp[n] == '\n'); n++);
+		if (n > 0) {
+			memmove(bp, bp + n, tail - n);
+			SERIES_TAIL(ser) = tail -= n;
+			http->scan = 0;
+		}
+
+		// Find the empty line that ends the headers:
+		for (n = MAX(http->scan, 1); n < tail; n++) {
+			if (bp[n] == '\n' && (bp[n-1] == '\n' || (n > 1 && bp[n-1] == '\r' && bp[n-2] == '\n'))) break;
+		}
+		if (n >= tail) {
+			http->scan = tail;
+			if (tail <= HTTP_MAX_HEAD) return FALSE;
+		}
+		if (n >= HTTP_MAX_HEAD) {
+			// Too large, even if all of it came in one read:
+			obj = Request_Object(port, TRUE);
+			status = 431;
+			goto done;
+		}
+
+		http->head = n + 1;
+		http->scan = n + 1;
+		http->body = 0;
+		obj = Request_Object(port, TRUE);
+		status = Parse_Head(obj, http, bp, http->head);
+		if (status) goto done;
+
+		// The body size limit (before any of it is read):
+		val = Obj_Value(OFV(port, STD_PORT_SPEC), STD_PORT_SPEC_HTTP_SERVER_MAX_BODY);
+		http->max_body = (val && IS_INTEGER(val)) ? Int32s(val, 0) : HTTP_MAX_BODY;
+		if (http->length > 0 && (REBCNT)http->length > http->max_body) {
+			status = 413;
+			goto done;
+		}
+	}
+	else obj = Request_Object(port, FALSE);
+
+	if (http->length >= 0) {
+		if (tail - http->head < (REBCNT)http->length) return FALSE;
+		http->body = http->length;
+		end = http->head + http->length;
+	}
+	else {
+		end = Dechunk(http, bp, tail);
+		if (end == 0) return FALSE;
+		if (end < 0) status = -end;
+	}
+
+done:
+	if (status) {
+		// The connection cannot be used after a bad request:
+		http->used = tail;
+		http->body = 0;
+		SET_INTEGER(OFV(obj, STD_HTTP_REQUEST_ERROR), status);
+		SET_FALSE(OFV(obj, STD_HTTP_REQUEST_KEEP_ALIVE));
+		SET_NONE(OFV(obj, STD_HTTP_REQUEST_BODY));
+	}
+	else {
+		http->used = end;
+		if (tail > (REBCNT)end) {
+			http->rest_len = tail - end;
+			http->rest = Make_Mem(http->rest_len);
+			memcpy(http->rest, bp + end, http->rest_len);
+		}
+		SERIES_TAIL(ser) = http->head + http->body;
+		TERM_SERIES(ser);
+		SET_NONE(OFV(obj, STD_HTTP_REQUEST_ERROR));
+		if (http->body) {
+			Set_Binary(OFV(obj, STD_HTTP_REQUEST_BODY), ser);
+			VAL_INDEX(OFV(obj, STD_HTTP_REQUEST_BODY)) = http->head;
+		}
+		else SET_NONE(OFV(obj, STD_HTTP_REQUEST_BODY));
+	}
+	Set_Binary(OFV(obj, STD_HTTP_REQUEST_DATA), ser);
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static void Free_Rest(HTTP_CONN *http)
+/*
+**		Free the data read after the current request.
+**
+***********************************************************************/
+{
+	if (http->rest) Free_Mem(http->rest, http->rest_len);
+	http->rest = 0;
+	http->rest_len = 0;
+}
+
+
+/***********************************************************************
+**
+*/	static void Next_Request(REBSER *port, HTTP_CONN *http)
+/*
+**		Done with the current request: data read after it
+**		(pipelined requests) is put back in the data buffer.
+**		The buffer is restored if a WRITE replaced it.
+**
+***********************************************************************/
+{
+	REBVAL *data = OFV(port, STD_PORT_DATA);
+	REBVAL *obj = OFV(port, STD_PORT_LOCALS);
+	REBSER *ser;
+
+	if (!http->used) return;
+
+	if (!IS_BINARY(data) && IS_OBJECT(obj)) {
+		obj = OFV(VAL_OBJ_FRAME(obj), STD_HTTP_REQUEST_DATA);
+		if (IS_BINARY(obj)) {
+			*data = *obj;
+			VAL_INDEX(data) = 0;
+		}
+	}
+
+	if (IS_BINARY(data)) {
+		ser = VAL_SERIES(data);
+		RESET_SERIES(ser);
+		if (http->rest) Append_Series(ser, http->rest, http->rest_len);
+	}
+
+	Free_Rest(http);
+	http->scan = http->head = http->body = http->used = 0;
+	http->length = 0;
+}
+
+
+/***********************************************************************
+**
+*/	static int HTTP_Server_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+**		A TCP port that reads whole HTTP/1.1 requests. Each READ
+**		event is for a complete request, held in the http-request
+**		object in port/locals. A response is written to the port
+**		as is (a block can be used to send it without joining,
+**		and sends file ports from the OS). READ again is for the
+**		next request on the connection.
+**
+**		A body larger than the spec max-body (default 16 MB) is
+**		not read: the request error is 413, for the reply.
+**
+***********************************************************************/
+{
+	HTTP_CONN *http = Use_Port_State(port, RDI_NET, sizeof(HTTP_CONN));
+	REBVAL *event = D_ARG(2);
+	int result;
+
+	switch (action) {
+
+	case A_UPDATE:
+		result = Transport_Actor(ds, port, action, TRANSPORT_HTTP);
+		if (
+			http->sock.command == RDC_READ && !http->used
+			&& GET_FLAG(http->sock.state, RSM_CONNECT)
+			&& IS_EVENT(event) && VAL_EVENT_TYPE(event) == EVT_READ
+			&& !Parse_Request(port, http)
+		) {
+			// Not all of it yet, read more (and no event for it):
+			Read_Net(port, &http->sock);
+			VAL_EVENT_TYPE(event) = EVT_IGNORE;
+		}
+		return result;
+
+	case A_READ:
+		if (!GET_FLAG(http->sock.state, RSM_CONNECT)) break;
+		Next_Request(port, http);
+		if (Parse_Request(port, http)) {
+			// A pipelined request was read already:
+			event = Append_Event();		// sets signal
+			if (event) {
+				VAL_SET(event, REB_EVENT);
+				VAL_EVENT_TYPE(event) = EVT_READ;
+				VAL_EVENT_FLAGS(event) = 0;
+				VAL_EVENT_WIN(event) = 0;
+				VAL_EVENT_MODEL(event) = EVM_DEVICE;
+				VAL_EVENT_DATA(event) = 0;
+				VAL_EVENT_REQ(event) = &http->sock;
+			}
+			http->sock.command = RDC_READ;
+			http->sock.actual = 0;
+			*D_RET = *D_ARG(1);
+			return R_RET;
+		}
+		break;
+
+	case A_CLOSE:
+		Free_Rest(http);
+		break;
+	}
+
+	return Transport_Actor(ds, port, action, TRANSPORT_HTTP);
+}
+
 /***********************************************************************
 **
 */	void Init_TCP_Scheme(void)
@@ -339,3 +1066,12 @@ enum Transport_Types {
 {
 	Register_Scheme(SYM_UDP, 0, UDP_Actor);
 }
+
+/***********************************************************************
+**
+*/	void Init_HTTP_Server_Scheme(void)
+/*
+***********************************************************************/
+{
+	Register_Scheme(SYM_HTTP_SERVER, 0, HTTP_Server_Actor);
+}
@@ -0,0 +1,267 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  p-process.c
+**  Summary: process port interface
+**  Section: ports
+**  Notes:
+**		A process port runs a program without waiting for it (as
+**		CALL/OUTPUT does). Its output is read as it comes, and its
+**		input can be written, with the usual port events:
+**
+**			p: open [scheme: 'process command: "ls -l"]
+**			read p		; output is added to p/data, READ event
+**			write p "x"	; to its stdin, WROTE event
+**			write p ""	; closes its stdin
+**			query p		; [id exit-code]
+**
+**		After the output has ended, a READ gets a CLOSE event when
+**		the program exits. CLOSE stops it if it is still running.
+**
+**		If spec/error is a string or binary, stderr output is added
+**		to it (else stderr is inherited).
+**
+**		As for TCP, a port does one READ or WRITE at a time.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+#ifdef HAS_POSIX_SPAWN
+
+#define PROCESS_BUF_SIZE 32*1024
+
+
+/***********************************************************************
+**
+*/	static void Start_Process(REBSER *port, REBREQ *req, REBVAL *spec)
+/*
+**		Make the argv for the command and start it.
+**
+**		A string is a command line, run by the shell. A block is
+**		the program and its arguments (strings or files). A file
+**		is a program run without arguments.
+**
+**		Strings are copied as UTF-8 (not left in a shared buffer),
+**		because there can be more than one.
+**
+***********************************************************************/
+{
+	REBVAL *cmd = Obj_Value(spec, STD_PORT_SPEC_PROCESS_COMMAND);
+	REBVAL *err = Obj_Value(spec, STD_PORT_SPEC_PROCESS_ERROR);
+	REBCHR **argv;
+	REBSER *ser;
+	REBVAL *val;
+	REBCNT len;
+	REBCNT n;
+
+	if (!cmd) Trap_Port(RE_INVALID_SPEC, port, -10);
+	Check_Security(SYM_CALL, POL_EXEC, cmd);
+
+	if (IS_BLOCK(cmd)) len = VAL_LEN(cmd);
+	else if (IS_STRING(cmd) || IS_FILE(cmd)) len = 1;
+	else len = 0;
+	if (len == 0) Trap_Port(RE_INVALID_SPEC, port, -10);
+
+	ser = Make_Series(len + 1, sizeof(REBCHR*), FALSE);
+	argv = (REBCHR**)SERIES_DATA(ser);
+
+	for (n = 0; n < len; n++) {
+		val = IS_BLOCK(cmd) ? VAL_BLK_SKIP(cmd, n) : cmd;
+		if (IS_FILE(val)) ser = Value_To_OS_Path(val, FALSE);
+		else if (IS_STRING(val)) ser = Encode_UTF8_Value(val, VAL_LEN(val), 0);
+		else Trap_Arg(val);
+		argv[n] = (REBCHR*)SERIES_DATA(ser);
+	}
+	argv[len] = 0;
+
+	req->modes = 0;
+	if (IS_STRING(cmd)) SET_FLAG(req->modes, RPM_SHELL);
+	if (err && (IS_STRING(err) || IS_BINARY(err))) SET_FLAG(req->modes, RPM_CAPTURE_ERROR);
+	req->process.argv = argv;
+
+	if (OS_DO_DEVICE(req, RDC_OPEN)) Trap_Port(RE_CANNOT_OPEN, port, req->error);
+}
+
+
+/***********************************************************************
+**
+*/	static void Ret_Query_Process(REBREQ *req, REBVAL *ret)
+/*
+**		Return an object with the process id and exit code (or
+**		none while it runs). A program ended by a signal has the
+**		negative signal number as its exit code.
+**
+***********************************************************************/
+{
+	REBSER *obj = Make_Frame(2);
+	REBVAL *val = Append_Frame(obj, NULL, SYM_ID);
+
+	SET_INTEGER(val, req->process.pid);
+	val = Append_Frame(obj, NULL, SYM_EXIT_CODE);
+	if (GET_FLAG(req->modes, RPM_EXITED)) SET_INTEGER(val, req->process.exit_code);
+	else SET_NONE(val);
+
+	SET_OBJECT(ret, obj);
+}
+
+
+/***********************************************************************
+**
+*/	static int Process_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+***********************************************************************/
+{
+	REBREQ *req;
+	REBVAL *spec;
+	REBVAL *arg;
+	REBVAL *val;
+	REBINT result;
+	REBSER *ser;
+	REBCNT len;
+
+	Validate_Port(port, action);
+
+	*D_RET = *D_ARG(1);
+
+	req = Use_Port_State(port, RDI_PROCESS, sizeof(REBREQ));
+	spec = OFV(port, STD_PORT_SPEC);
+	if (!IS_OBJECT(spec)) Trap0(RE_INVALID_PORT);
+
+	if (!IS_OPEN(req)) {
+		switch (action) {
+
+		case A_OPEN:
+			Start_Process(port, req, spec);
+			return R_RET;
+
+		case A_CLOSE:
+			return R_RET;
+
+		case A_OPENQ:
+			return R_FALSE;
+
+		case A_UPDATE:	// allowed after a close
+		case A_QUERY:	// the exit code is kept
+			break;
+
+		default:
+			Trap_Port(RE_NOT_OPEN, port, -12);
+		}
+	}
+
+	switch (action) {
+
+	case A_UPDATE:
+		// Update the port object after a READ or WRITE operation.
+		// This is normally called by the WAKE-UP function.
+		arg = OFV(port, STD_PORT_DATA);
+		if (req->command == RDC_READ && req->actual > 0 && IS_BINARY(arg)) {
+			if (GET_FLAG(req->modes, RPM_FROM_ERROR)) {
+				// The stderr data goes to spec/error instead:
+				val = Obj_Value(spec, STD_PORT_SPEC_PROCESS_ERROR);
+				if (IS_BINARY(val))
+					Append_Bytes_Len(VAL_SERIES(val), BIN_TAIL(VAL_SERIES(arg)), req->actual);
+				else if (IS_STRING(val)) {
+					ser = Copy_OS_Str(BIN_TAIL(VAL_SERIES(arg)), req->actual);
+					Append_String(VAL_SERIES(val), ser, 0, SERIES_TAIL(ser));
+				}
+			}
+			else VAL_TAIL(arg) += req->actual;
+			req->actual = 0; // avoid duplicate updates
+		}
+		else if (req->command == RDC_WRITE) {
+			SET_NONE(OFV(port, STD_PORT_LOCALS));  // Write is done.
+		}
+		return R_NONE;
+
+	case A_READ:
+		// Read what the program writes, added to port/data. The buffer
+		// grows with the data kept, so a large output is read in fewer
+		// (larger) reads and expands.
+		arg = OFV(port, STD_PORT_DATA);
+		if (!IS_BINARY(arg)) Set_Binary(arg, Make_Binary(PROCESS_BUF_SIZE));
+		ser = VAL_SERIES(arg);
+		if (SERIES_AVAIL(ser) < PROCESS_BUF_SIZE/2)
+			Extend_Series(ser, MAX(PROCESS_BUF_SIZE, SERIES_TAIL(ser)));
+		req->length = SERIES_AVAIL(ser);
+		req->data = BIN_TAIL(ser);
+		req->actual = 0;
+		result = OS_DO_DEVICE(req, RDC_READ);
+		if (result < 0) Trap_Port(RE_READ_ERROR, port, req->error);
+		break;
+
+	case A_WRITE:
+		// Write to the stdin of the program. An empty value closes it.
+		// The data is kept in port/locals (so port/data is not lost).
+		arg = D_ARG(2);
+		len = VAL_LEN(arg);
+		if (Find_Refines(ds, ALL_WRITE_REFS) & AM_WRITE_PART) {
+			REBCNT n = Int32s(D_ARG(ARG_WRITE_LENGTH), 0);
+			if (n <= len) len = n;
+		}
+		if (IS_STRING(arg)) {
+			ser = Encode_UTF8_Value(arg, len, 0);
+			len = SERIES_TAIL(ser);
+			Set_Binary(OFV(port, STD_PORT_LOCALS), ser);
+		}
+		else if (IS_BINARY(arg)) *OFV(port, STD_PORT_LOCALS) = *arg;
+		else Trap_Arg(arg);
+		req->data = VAL_BIN_DATA(OFV(port, STD_PORT_LOCALS));
+		req->length = len;
+		req->actual = 0;
+		result = OS_DO_DEVICE(req, RDC_WRITE);
+		if (result < 0) Trap_Port(RE_WRITE_ERROR, port, req->error);
+		if (result == DR_DONE) SET_NONE(OFV(port, STD_PORT_LOCALS));
+		break;
+
+	case A_QUERY:
+		Ret_Query_Process(req, D_RET);
+		break;
+
+	case A_OPENQ:
+		return R_TRUE;
+
+	case A_CLOSE:
+		OS_DO_DEVICE(req, RDC_CLOSE);
+		break;
+
+	case A_OPEN:
+		Trap1(RE_ALREADY_OPEN, D_ARG(1));
+
+	default:
+		Trap_Action(REB_PORT, action);
+	}
+
+	return R_RET;
+}
+
+
+/***********************************************************************
+**
+*/	void Init_Process_Scheme(void)
+/*
+***********************************************************************/
+{
+	Register_Scheme(SYM_PROCESS, 0, Process_Actor);
+}
+
+#endif //HAS_POSIX_SPAWN
@@ -0,0 +1,663 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  p-rope.c
+**  Summary: rope port interface for huge editable text
+**  Section: ports
+**  Notes:
+**    A rope port holds text as a sequence of string chunks kept in an
+**    implicit treap (a randomized balanced tree ordered by position).
+**    INSERT, CHANGE, REMOVE and COPY/part take O(log n) in the total
+**    length, where a string! must move its whole tail on each edit.
+**    READ (or COPY) flattens the text to a string! when it is needed
+**    by other natives.
+**
+**        r: open rope://
+**        append r read %big.txt
+**        insert skip r 1000 "text"   ; edits at the port position
+**        str: read r
+**
+**    REPLACE works on a rope too (with FIND and CHANGE at the port
+**    position, see REPLACE in mezz-series.r).
+**
+**    The port state is a block of [nodes chunks]. Nodes is a binary
+**    of ROPE_NODE structs, chunks is a block holding the string! for
+**    each node (so the GC sees them). Node zero is not part of the
+**    tree and holds the rope header fields instead.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+#define CHUNK_MAX	2048	// max chars in a chunk for in-place edits
+#define CHUNK_NEW	1024	// size of chunks made from inserted text
+#define FIND_WINDOW	65536	// chars flattened at a time for FIND
+
+typedef struct rebol_rope_node {
+	REBCNT left;	// child node numbers (zero for none)
+	REBCNT right;
+	REBCNT size;	// chars in this subtree
+	REBCNT prio;	// heap priority
+} ROPE_NODE;
+
+#define ROPE_NODES(r)	VAL_SERIES(BLK_HEAD(r))
+#define ROPE_CHUNKS(r)	VAL_SERIES(BLK_SKIP(r, 1))
+#define NODE(r, n)		(((ROPE_NODE*)BIN_HEAD(ROPE_NODES(r))) + (n))
+#define CHUNK(r, n)		VAL_SERIES(BLK_SKIP(ROPE_CHUNKS(r), n))
+#define CHUNK_LEN(r, n)	SERIES_TAIL(CHUNK(r, n))
+#define SIZE(r, n)		((n) ? NODE(r, n)->size : 0)
+
+// Header fields kept in node zero:
+#define ROPE_ROOT(r)	NODE(r, 0)->left
+#define ROPE_FREE(r)	NODE(r, 0)->right	// free node list
+#define ROPE_INDEX(r)	NODE(r, 0)->size	// port position
+#define ROPE_SEED(r)	NODE(r, 0)->prio
+
+#define ROPE_LEN(r)		SIZE(r, ROPE_ROOT(r))
+
+
+/***********************************************************************
+**
+*/	static REBSER *Make_Rope(void)
+/*
+***********************************************************************/
+{
+	REBSER *rope = Make_Block(2);
+	REBSER *nodes = Make_Binary(sizeof(ROPE_NODE) * 16);
+
+	Set_Binary(Append_Value(rope), nodes);
+	Set_Block(Append_Value(rope), Make_Block(16));
+	SET_NONE(Append_Value(ROPE_CHUNKS(rope)));
+
+	CLEAR(BIN_HEAD(nodes), sizeof(ROPE_NODE));
+	SERIES_TAIL(nodes) = sizeof(ROPE_NODE);
+	ROPE_SEED(rope) = 0x9E3779B9;
+
+	return rope;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT New_Node(REBSER *rope, REBSER *chunk)
+/*
+**		Add a node for the chunk, reusing a free node if possible.
+**
+***********************************************************************/
+{
+	REBSER *nodes = ROPE_NODES(rope);
+	REBCNT n = ROPE_FREE(rope);
+	REBCNT x;
+
+	if (n) ROPE_FREE(rope) = NODE(rope, n)->left;
+	else {
+		n = SERIES_TAIL(nodes) / sizeof(ROPE_NODE);
+		EXPAND_SERIES_TAIL(nodes, sizeof(ROPE_NODE));
+		SET_NONE(Append_Value(ROPE_CHUNKS(rope)));
+	}
+	Set_String(BLK_SKIP(ROPE_CHUNKS(rope), n), chunk);
+
+	// Xorshift for the treap priority:
+	x = ROPE_SEED(rope);
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	ROPE_SEED(rope) = x;
+
+	NODE(rope, n)->left = NODE(rope, n)->right = 0;
+	NODE(rope, n)->size = SERIES_TAIL(chunk);
+	NODE(rope, n)->prio = x;
+
+	return n;
+}
+
+
+/***********************************************************************
+**
+*/	static void Free_Nodes(REBSER *rope, REBCNT t)
+/*
+***********************************************************************/
+{
+	REBCNT r;
+
+	for (; t; t = r) {
+		Free_Nodes(rope, NODE(rope, t)->left);
+		r = NODE(rope, t)->right;
+		SET_NONE(BLK_SKIP(ROPE_CHUNKS(rope), t));
+		NODE(rope, t)->left = ROPE_FREE(rope);
+		ROPE_FREE(rope) = t;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Update_Node(REBSER *rope, REBCNT t)
+/*
+***********************************************************************/
+{
+	NODE(rope, t)->size = SIZE(rope, NODE(rope, t)->left)
+		+ SIZE(rope, NODE(rope, t)->right) + CHUNK_LEN(rope, t);
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Merge_Nodes(REBSER *rope, REBCNT a, REBCNT b)
+/*
+**		Join two trees, with all of A before all of B.
+**
+***********************************************************************/
+{
+	REBCNT n;
+
+	if (!a) return b;
+	if (!b) return a;
+
+	if (NODE(rope, a)->prio > NODE(rope, b)->prio) {
+		n = Merge_Nodes(rope, NODE(rope, a)->right, b);
+		NODE(rope, a)->right = n;
+		Update_Node(rope, a);
+		return a;
+	}
+
+	n = Merge_Nodes(rope, a, NODE(rope, b)->left);
+	NODE(rope, b)->left = n;
+	Update_Node(rope, b);
+	return b;
+}
+
+
+/***********************************************************************
+**
+*/	static void Split_Nodes(REBSER *rope, REBCNT t, REBCNT pos, REBCNT *a, REBCNT *b)
+/*
+**		Split a tree so A holds the first pos chars and B the rest.
+**		A chunk that spans the position is cut in two.
+**
+***********************************************************************/
+{
+	REBCNT l, len, n;
+
+	if (!t) {
+		*a = *b = 0;
+		return;
+	}
+
+	l = SIZE(rope, NODE(rope, t)->left);
+	len = CHUNK_LEN(rope, t);
+
+	if (pos <= l) {
+		Split_Nodes(rope, NODE(rope, t)->left, pos, a, &n);
+		NODE(rope, t)->left = n;
+		Update_Node(rope, t);
+		*b = t;
+	}
+	else if (pos >= l + len) {
+		Split_Nodes(rope, NODE(rope, t)->right, pos - l - len, &n, b);
+		NODE(rope, t)->right = n;
+		Update_Node(rope, t);
+		*a = t;
+	}
+	else {
+		pos -= l;
+		n = New_Node(rope, Copy_String(CHUNK(rope, t), pos, len - pos));
+		SERIES_TAIL(CHUNK(rope, t)) = pos;
+		TERM_SERIES(CHUNK(rope, t));
+		// Same priority keeps the heap order for the moved subtree:
+		NODE(rope, n)->prio = NODE(rope, t)->prio;
+		NODE(rope, n)->right = NODE(rope, t)->right;
+		NODE(rope, t)->right = 0;
+		Update_Node(rope, t);
+		Update_Node(rope, n);
+		*a = t;
+		*b = n;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Find_Chunk(REBSER *rope, REBCNT *pos, REBOOL at_end)
+/*
+**		Find the node whose chunk holds the position, and make pos
+**		relative to that chunk. With at_end, a position just past a
+**		chunk is taken as that chunk (for appending to it).
+**
+***********************************************************************/
+{
+	REBCNT t = ROPE_ROOT(rope);
+	REBCNT l, len;
+
+	while (t) {
+		l = SIZE(rope, NODE(rope, t)->left);
+		len = CHUNK_LEN(rope, t);
+		if (*pos < l) t = NODE(rope, t)->left;
+		else if (*pos < l + len || (at_end && *pos == l + len)) {
+			*pos -= l;
+			return t;
+		}
+		else {
+			*pos -= l + len;
+			t = NODE(rope, t)->right;
+		}
+	}
+
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	static void Resize_Path(REBSER *rope, REBCNT pos, REBCNT target, REBINT delta)
+/*
+**		Adjust subtree sizes from the root down to the target node,
+**		after its chunk was edited in place. The pos is the one that
+**		was given to Find_Chunk (before the edit).
+**
+***********************************************************************/
+{
+	REBCNT t = ROPE_ROOT(rope);
+	REBCNT l;
+
+	while (t) {
+		NODE(rope, t)->size += delta;
+		if (t == target) break;
+		l = SIZE(rope, NODE(rope, t)->left);
+		if (pos < l) t = NODE(rope, t)->left;
+		else {
+			pos -= l + CHUNK_LEN(rope, t);
+			t = NODE(rope, t)->right;
+		}
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Rope_Insert(REBSER *rope, REBCNT pos, REBSER *src, REBCNT idx, REBCNT len)
+/*
+***********************************************************************/
+{
+	REBCNT t, off, a, b, m, n;
+
+	if (!len) return;
+	if (pos > ROPE_LEN(rope)) pos = ROPE_LEN(rope);
+
+	// Small edits go directly into the chunk at the position:
+	off = pos;
+	t = Find_Chunk(rope, &off, TRUE);
+	if (t && CHUNK_LEN(rope, t) + len <= CHUNK_MAX) {
+		Insert_String(CHUNK(rope, t), off, src, idx, len, FALSE);
+		TERM_SERIES(CHUNK(rope, t));
+		Resize_Path(rope, pos, t, len);
+		return;
+	}
+
+	// Otherwise, make new chunks and link them in:
+	for (m = 0; len > 0; idx += n, len -= n) {
+		n = MIN(len, CHUNK_NEW);
+		m = Merge_Nodes(rope, m, New_Node(rope, Copy_String(src, idx, n)));
+	}
+
+	Split_Nodes(rope, ROPE_ROOT(rope), pos, &a, &b);
+	a = Merge_Nodes(rope, a, m);
+	ROPE_ROOT(rope) = Merge_Nodes(rope, a, b);
+}
+
+
+/***********************************************************************
+**
+*/	static void Rope_Remove(REBSER *rope, REBCNT pos, REBCNT len)
+/*
+***********************************************************************/
+{
+	REBCNT t, off, a, b, m;
+
+	if (pos >= ROPE_LEN(rope)) return;
+	if (len > ROPE_LEN(rope) - pos) len = ROPE_LEN(rope) - pos;
+	if (!len) return;
+
+	// Removal within a chunk is done in place:
+	off = pos;
+	t = Find_Chunk(rope, &off, FALSE);
+	if (t && off + len < CHUNK_LEN(rope, t)) {
+		Remove_Series(CHUNK(rope, t), off, len);
+		Resize_Path(rope, pos, t, -(REBINT)len);
+		return;
+	}
+
+	Split_Nodes(rope, ROPE_ROOT(rope), pos, &a, &b);
+	Split_Nodes(rope, b, len, &m, &b);
+	Free_Nodes(rope, m);
+	ROPE_ROOT(rope) = Merge_Nodes(rope, a, b);
+}
+
+
+/***********************************************************************
+**
+*/	static void Copy_Nodes(REBSER *rope, REBCNT t, REBCNT pos, REBCNT len, REBSER *out)
+/*
+**		Append len chars starting at pos of the tree to out.
+**
+***********************************************************************/
+{
+	REBCNT l, n, clen;
+
+	while (t && len) {
+		l = SIZE(rope, NODE(rope, t)->left);
+		if (pos < l) {
+			n = MIN(len, l - pos);
+			Copy_Nodes(rope, NODE(rope, t)->left, pos, n, out);
+			pos += n;
+			len -= n;
+			if (!len) return;
+		}
+		clen = CHUNK_LEN(rope, t);
+		if (pos < l + clen) {
+			n = MIN(len, l + clen - pos);
+			Append_String(out, CHUNK(rope, t), pos - l, n);
+			pos += n;
+			len -= n;
+		}
+		pos -= l + clen;
+		t = NODE(rope, t)->right;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Rope_Copy(REBSER *rope, REBCNT pos, REBCNT len)
+/*
+***********************************************************************/
+{
+	REBSER *ser;
+
+	if (pos > ROPE_LEN(rope)) pos = ROPE_LEN(rope);
+	if (len > ROPE_LEN(rope) - pos) len = ROPE_LEN(rope) - pos;
+
+	ser = Make_Binary(len);
+	Copy_Nodes(rope, ROPE_ROOT(rope), pos, len, ser);
+	TERM_SERIES(ser);
+	return ser;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Rope_Find(REBSER *rope, REBCNT pos, REBSER *pat, REBCNT idx, REBCNT len, REBCNT flags)
+/*
+**		Search a window at a time, overlapping by the pattern size
+**		so matches across windows are found.
+**
+***********************************************************************/
+{
+	REBSER *win;
+	REBCNT total = ROPE_LEN(rope);
+	REBCNT n;
+
+	if (!len) return NOT_FOUND;
+
+	for (; pos + len <= total; pos += FIND_WINDOW) {
+		win = Rope_Copy(rope, pos, FIND_WINDOW + len - 1);
+		n = Find_Str_Str(win, 0, 0, SERIES_TAIL(win), 1, pat, idx, len, flags & ~AM_FIND_TAIL);
+		if (n != NOT_FOUND && n < FIND_WINDOW)
+			return pos + n + ((flags & AM_FIND_TAIL) ? len : 0);
+	}
+
+	return NOT_FOUND;
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Rope_Arg(REBVAL *arg, REBCNT *idx, REBCNT *len)
+/*
+**		Get the string to insert for a value, as done by INSERT.
+**		Binary is taken as UTF-8 (as from a READ of a file).
+**
+***********************************************************************/
+{
+	REBSER *ser;
+
+	if (ANY_STR(arg) && !IS_TAG(arg)) {
+		*idx = VAL_INDEX(arg);
+		*len = VAL_LEN(arg);
+		return VAL_SERIES(arg);
+	}
+
+	if (IS_BINARY(arg)) ser = Decode_UTF_String(VAL_BIN_DATA(arg), VAL_LEN(arg), 8);
+	else if (IS_CHAR(arg)) ser = Append_Byte(0, VAL_CHAR(arg)); // unicode ok too
+	else if (IS_BLOCK(arg)) ser = Form_Tight_Block(arg);
+	else ser = Copy_Form_Value(arg, 0);
+
+	*idx = 0;
+	*len = SERIES_TAIL(ser);
+	return ser;
+}
+
+
+/***********************************************************************
+**
+*/	static REBINT Rope_Num_Arg(REBVAL *arg, REBINT err)
+/*
+**		Get a count or position. A rope has one position, so a /part
+**		can only be a number (err is RE_INVALID_PART), and so can the
+**		PICK, SKIP and AT arg (err is zero).
+**
+***********************************************************************/
+{
+	if (!IS_INTEGER(arg) && !IS_DECIMAL(arg)) {
+		if (err) Trap1(err, arg);
+		Trap_Arg(arg);
+	}
+	return Get_Num_Arg(arg);
+}
+
+
+/***********************************************************************
+**
+*/	static int Rope_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+***********************************************************************/
+{
+	REBVAL *state;
+	REBVAL *arg;
+	REBSER *rope;
+	REBSER *ser;
+	REBCNT index;
+	REBCNT len;
+	REBCNT idx;
+	REBINT n;
+	REBINT dups;
+	REBCNT args;
+
+	Validate_Port(port, action);
+
+	arg = D_ARG(2);
+	state = BLK_SKIP(port, STD_PORT_STATE);
+
+	if (!IS_BLOCK(state)) {
+		switch (action) {
+		case A_OPENQ:
+			return R_FALSE;
+		case A_CLOSE:
+			return R_ARG1;
+		case A_OPEN:
+		case A_READ:
+		case A_WRITE:
+		case A_APPEND:
+		case A_INSERT:
+			Set_Block(state, Make_Rope());
+			break;
+		default:
+			Trap_Port(RE_NOT_OPEN, port, -12);
+		}
+	}
+
+	rope = VAL_SERIES(state);
+	index = ROPE_INDEX(rope);
+	if (index > ROPE_LEN(rope)) index = ROPE_INDEX(rope) = ROPE_LEN(rope);
+
+	switch (action) {
+
+	case A_OPEN:
+	case A_UPDATE:
+		break;
+
+	case A_OPENQ:
+		return R_TRUE;
+
+	case A_CLOSE:
+		SET_NONE(state);
+		break;
+
+	case A_READ:
+		Set_String(D_RET, Rope_Copy(rope, 0, ROPE_LEN(rope)));
+		return R_RET;
+
+	case A_WRITE:
+		Free_Nodes(rope, ROPE_ROOT(rope));
+		ROPE_ROOT(rope) = ROPE_INDEX(rope) = 0;
+		// fall thru
+	case A_APPEND:
+	case A_INSERT:
+	case A_CHANGE:
+		ser = Rope_Arg(arg, &idx, &len);
+		if (action == A_WRITE) {
+			SAVE_SERIES(ser);
+			Rope_Insert(rope, 0, ser, idx, len);
+			UNSAVE_SERIES(ser);
+			break;
+		}
+		if (DS_REF(AN_PART)) {
+			n = Rope_Num_Arg(DS_ARG(AN_LENGTH), RE_INVALID_PART);
+			if (n < 0) n = 0;
+			if (action != A_CHANGE && (REBCNT)n < len) len = n;
+		}
+		dups = DS_REF(AN_DUP) ? Int32(DS_ARG(AN_COUNT)) : 1;
+		if (!DS_REF(AN_PART)) n = (dups > 0) ? len * dups : 0;
+		if (action == A_APPEND) index = ROPE_LEN(rope);
+		if (action == A_CHANGE) Rope_Remove(rope, index, n);
+		SAVE_SERIES(ser); // new chunks may cause a GC
+		for (; dups > 0; dups--) {
+			Rope_Insert(rope, index, ser, idx, len);
+			index += len;
+		}
+		UNSAVE_SERIES(ser);
+		if (action != A_APPEND) ROPE_INDEX(rope) = index;
+		break;
+
+	case A_REMOVE:
+		n = D_REF(2) ? Rope_Num_Arg(D_ARG(3), RE_INVALID_PART) : 1; // /part length
+		if (n > 0) Rope_Remove(rope, index, n);
+		break;
+
+	case A_CLEAR:
+		Rope_Remove(rope, index, ROPE_LEN(rope) - index);
+		break;
+
+	case A_COPY:
+		len = ROPE_LEN(rope) - index;
+		if (D_REF(ARG_COPY_PART)) {
+			n = Rope_Num_Arg(D_ARG(ARG_COPY_LENGTH), RE_INVALID_PART);
+			if (n < 0) n = 0;
+			if ((REBCNT)n < len) len = n;
+		}
+		Set_String(D_RET, Rope_Copy(rope, index, len));
+		return R_RET;
+
+	case A_FIND:
+		args = Find_Refines(ds, ALL_FIND_REFS);
+		if (args & ~(AM_FIND_CASE | AM_FIND_TAIL)) Trap0(RE_BAD_REFINES);
+		ser = Rope_Arg(arg, &idx, &len);
+		idx = Rope_Find(rope, index, ser, idx, len, args);
+		if (idx == NOT_FOUND) return R_NONE;
+		ROPE_INDEX(rope) = idx;
+		break;
+
+	case A_PICK:
+		n = Rope_Num_Arg(arg, 0);
+		if (n == 0) return R_NONE;
+		if (n > 0) n--; // one-based
+		if (n < -(REBINT)index || (REBCNT)(index + n) >= ROPE_LEN(rope)) return R_NONE;
+		idx = index + n;
+		n = Find_Chunk(rope, &idx, FALSE);
+		SET_CHAR(D_RET, GET_ANY_CHAR(CHUNK(rope, n), idx));
+		return R_RET;
+
+	case A_LENGTHQ:
+		SET_INTEGER(D_RET, ROPE_LEN(rope) - index);
+		return R_RET;
+
+	case A_INDEXQ:
+		SET_INTEGER(D_RET, index + 1);
+		return R_RET;
+
+	case A_HEAD:
+		ROPE_INDEX(rope) = 0;
+		break;
+
+	case A_TAIL:
+		ROPE_INDEX(rope) = ROPE_LEN(rope);
+		break;
+
+	case A_NEXT:
+		if (index < ROPE_LEN(rope)) ROPE_INDEX(rope)++;
+		break;
+
+	case A_BACK:
+		if (index > 0) ROPE_INDEX(rope)--;
+		break;
+
+	case A_SKIP:
+	case A_AT:
+		n = Rope_Num_Arg(arg, 0);
+		if (action == A_AT && n > 0) n--;
+		if (n < -(REBINT)index) n = -(REBINT)index;
+		ROPE_INDEX(rope) = MIN(index + n, ROPE_LEN(rope));
+		break;
+
+	case A_HEADQ:
+		if (index == 0) return R_TRUE;
+		return R_FALSE;
+
+	case A_TAILQ:
+		if (index >= ROPE_LEN(rope)) return R_TRUE;
+		return R_FALSE;
+
+	default:
+		Trap_Action(REB_PORT, action);
+	}
+
+	return R_ARG1; // port
+}
+
+
+/***********************************************************************
+**
+*/	void Init_Rope_Scheme(void)
+/*
+***********************************************************************/
+{
+	Register_Scheme(SYM_ROPE, 0, Rope_Actor);
+}
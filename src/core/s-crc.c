@@ -325,6 +325,7 @@ static REBCNT *CRC_Table;
 {
 	CRC_Table = Make_Mem(sizeof(REBCNT) * 256);
 	Make_CRC_Table(PRZCRC);
+	Init_CRC32();
 }
 
 
@@ -358,38 +359,272 @@ static REBCNT *CRC_Table;
 
 
 
-static u32 *crc32_table = 0;
+/***********************************************************************
+**
+**	CRC-32 and CRC-32C
+**
+**		CRC-32 is the CRC of zlib, gzip, PNG and Ethernet. CRC-32C
+**		(Castagnoli) is the one of iSCSI, SCTP and ext4, which x86
+**		has an instruction for (SSE4.2). Both are reflected, so the
+**		portable code is the same: slice-by-8, with 8 tables that
+**		take 8 bytes per step.
+**
+**		On x86, CRC-32C uses the crc32 instruction, and CRC-32 folds
+**		64 bytes at a time with carry-less multiply (PCLMULQDQ), as
+**		in Intel's "Fast CRC Computation Using PCLMULQDQ".
+**
+***********************************************************************/
+
+#define CRC32_POLY		0xedb88320	// reflected 0x04c11db7
+#define CRC32C_POLY		0x82f63b78	// reflected 0x1edc6f41
+
+static u32 CRC32_Tables[8][256];
+static u32 CRC32C_Tables[8][256];
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CRC_NI
+#include <cpuid.h>
+#include <wmmintrin.h>
+#include <smmintrin.h>
+#include <nmmintrin.h>
+#define NI_FUNC static __attribute__((target("pclmul,sse4.2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define CRC_NI
+#include <intrin.h>
+#include <wmmintrin.h>
+#include <nmmintrin.h>
+#define NI_FUNC static
+#endif
+
+#ifdef CRC_NI
+static REBFLG Has_SSE42;	// crc32 instruction (and SSE4.1)
+static REBFLG Has_PCLMUL;
+#endif
+
 
-static void Make_CRC32_Table(void) {
+/***********************************************************************
+**
+*/	static void Make_CRC32_Tables(u32 tables[8][256], u32 poly)
+/*
+**		Table 0 is the usual byte table. Table k is the CRC of
+**		a byte followed by k zero bytes.
+**
+***********************************************************************/
+{
 	u32 c;
-	int n,k;
+	int n, k;
 
-	crc32_table = Make_Mem(256 * sizeof(u32));
+	for (n = 0; n < 256; n++) {
+		c = (u32)n;
+		for (k = 0; k < 8; k++) c = (c & 1) ? poly ^ (c >> 1) : c >> 1;
+		tables[0][n] = c;
+	}
 
-	for(n=0;n<256;n++) {
-		c=(u32)n;
-		for(k=0;k<8;k++) {
-			if(c&1)
-				c=U32_C(0xedb88320)^(c>>1);
-			else
-				c=c>>1;
+	for (n = 0; n < 256; n++) {
+		c = tables[0][n];
+		for (k = 1; k < 8; k++) {
+			c = tables[0][c & 0xff] ^ (c >> 8);
+			tables[k][n] = c;
 		}
-		crc32_table[n]=c;
 	}
 }
 
+
+/***********************************************************************
+**
+*/	static u32 Slice_CRC32(u32 tables[8][256], u32 c, REBYTE *buf, REBCNT len)
+/*
+**		Update a (pre-inverted) reflected CRC, 8 bytes per step.
+**
+***********************************************************************/
+{
+	for (; len >= 8; len -= 8, buf += 8) {
+		c ^= buf[0] | (buf[1] << 8) | (buf[2] << 16) | ((u32)buf[3] << 24);
+		c = tables[7][c & 0xff] ^ tables[6][(c >> 8) & 0xff]
+			^ tables[5][(c >> 16) & 0xff] ^ tables[4][c >> 24]
+			^ tables[3][buf[4]] ^ tables[2][buf[5]]
+			^ tables[1][buf[6]] ^ tables[0][buf[7]];
+	}
+
+	while (len--) c = tables[0][(c ^ *buf++) & 0xff] ^ (c >> 8);
+
+	return c;
+}
+
+
+#ifdef CRC_NI
+
+/***********************************************************************
+**
+*/	static void Check_CRC_CPU(void)
+/*
+**		Check for SSE4.2, SSE4.1 and PCLMULQDQ (CPUID leaf 1, ECX).
+**
+***********************************************************************/
+{
+	unsigned int ecx;
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 1);
+	ecx = (unsigned int)info[2];
+#else
+	unsigned int eax, ebx, edx;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return;
+#endif
+	Has_SSE42 = (ecx & (1 << 20)) && (ecx & (1 << 19));
+	Has_PCLMUL = Has_SSE42 && (ecx & (1 << 1));
+}
+
+
+/***********************************************************************
+**
+*/	NI_FUNC u32 NI_CRC32C(u32 c, REBYTE *buf, REBCNT len)
+/*
+**		CRC-32C with the crc32 instruction.
+**
+***********************************************************************/
+{
+#if defined(__x86_64__) || defined(_M_X64)
+	u64 c64 = c;
+	u64 v;
+
+	for (; len >= 8; len -= 8, buf += 8) {
+		memcpy(&v, buf, 8);
+		c64 = _mm_crc32_u64(c64, v);
+	}
+	c = (u32)c64;
+#else
+	u32 v;
+
+	for (; len >= 4; len -= 4, buf += 4) {
+		memcpy(&v, buf, 4);
+		c = _mm_crc32_u32(c, v);
+	}
+#endif
+	while (len--) c = _mm_crc32_u8(c, *buf++);
+
+	return c;
+}
+
+
+/***********************************************************************
+**
+*/	NI_FUNC u32 NI_CRC32(u32 c, REBYTE *buf, REBCNT len)
+/*
+**		CRC-32 by folding with carry-less multiply. The len must be
+**		64 or more, and a multiple of 16. The constants are powers of
+**		x mod P (bit reflected), and the Barrett reduction constants.
+**
+***********************************************************************/
+{
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+	const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+	const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+	const __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124);
+	const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+	const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+	x1 = _mm_loadu_si128((__m128i *)(buf + 0x00));
+	x2 = _mm_loadu_si128((__m128i *)(buf + 0x10));
+	x3 = _mm_loadu_si128((__m128i *)(buf + 0x20));
+	x4 = _mm_loadu_si128((__m128i *)(buf + 0x30));
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(c));
+	buf += 64;
+	len -= 64;
+
+	// Fold 4 x 128 bits, 64 bytes at a time:
+	x0 = k1k2;
+	for (; len >= 64; len -= 64, buf += 64) {
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+		x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+		x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+		y5 = _mm_loadu_si128((__m128i *)(buf + 0x00));
+		y6 = _mm_loadu_si128((__m128i *)(buf + 0x10));
+		y7 = _mm_loadu_si128((__m128i *)(buf + 0x20));
+		y8 = _mm_loadu_si128((__m128i *)(buf + 0x30));
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+	}
+
+	// Fold into 128 bits:
+	x0 = k3k4;
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+	// Then 16 bytes at a time:
+	for (; len >= 16; len -= 16, buf += 16) {
+		x2 = _mm_loadu_si128((__m128i *)buf);
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+	}
+
+	// Fold 128 bits to 64:
+	x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, mask);
+	x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	// Barrett reduce to 32 bits:
+	x2 = _mm_and_si128(x1, mask);
+	x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+	x2 = _mm_and_si128(x2, mask);
+	x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return (u32)_mm_extract_epi32(x1, 1);
+}
+
+#endif
+
+
+/***********************************************************************
+**
+*/	void Init_CRC32(void)
+/*
+***********************************************************************/
+{
+	Make_CRC32_Tables(CRC32_Tables, CRC32_POLY);
+	Make_CRC32_Tables(CRC32C_Tables, CRC32C_POLY);
+#ifdef CRC_NI
+	Check_CRC_CPU();
+#endif
+}
+
+
 REBCNT Update_CRC32(u32 crc, REBYTE *buf, int len) {
 	u32 c = ~crc;
-	int n;
-
-	if(!crc32_table) Make_CRC32_Table();
+	REBCNT n;
 
-	for(n = 0; n < len; n++)
-		c = crc32_table[(c^buf[n])&0xff]^(c>>8);
+#ifdef CRC_NI
+	if (Has_PCLMUL && len >= 64) {
+		n = len & ~15;
+		c = NI_CRC32(c, buf, n);
+		buf += n;
+		len -= n;
+	}
+#endif
 
-	return ~c;
+	return ~Slice_CRC32(CRC32_Tables, c, buf, len);
 }
 
+
 /***********************************************************************
 **
 */	REBCNT CRC32(REBYTE *buf, REBCNT len)
@@ -400,6 +635,34 @@ REBCNT Update_CRC32(u32 crc, REBYTE *buf, int len) {
 }
 
 
+/***********************************************************************
+**
+*/	REBCNT Update_CRC32C(REBCNT crc, REBYTE *buf, REBCNT len)
+/*
+**		Continue a CRC-32C (start with zero).
+**
+***********************************************************************/
+{
+	u32 c = ~(u32)crc;
+
+#ifdef CRC_NI
+	if (Has_SSE42) return ~NI_CRC32C(c, buf, len);
+#endif
+
+	return ~Slice_CRC32(CRC32C_Tables, c, buf, len);
+}
+
+
+/***********************************************************************
+**
+*/	REBCNT CRC32C(REBYTE *buf, REBCNT len)
+/*
+***********************************************************************/
+{
+	return Update_CRC32C(0, buf, len);
+}
+
+
 
 #ifdef ndef
 Header File
@@ -841,7 +841,7 @@ ConversionResult ConvertUTF8toUTF32 (
 			if (ch == 0) ch = UNI_REPLACEMENT_CHAR; // temporary!
 			if (ch > 0xff) flag = 1;
 		} if (ch == CR && ccr) {
-			if (src[1] == LF) continue;
+			if (len > 1 && src[1] == LF) continue;
 			ch = LF;
 		}
 		*dst++ = (REBUNI)ch;
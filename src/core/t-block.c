@@ -303,6 +303,8 @@ static void No_Nones(REBVAL *arg) {
 	}
 
 	if (IS_BINARY(arg)) {
+		// Slices and file mappings are not NUL terminated; the scanner needs one:
+		if (IS_SHARED_SERIES(VAL_SERIES(arg))) Unshare_Series(VAL_SERIES(arg));
 		ser = Scan_Source(VAL_BIN_DATA(arg), VAL_LEN(arg));
 		goto done;
 	}
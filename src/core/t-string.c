@@ -370,6 +370,9 @@ static REBSER *make_binary(REBVAL *arg, REBOOL make)
 
 	if (n < 0 || (REBCNT)n >= SERIES_TAIL(ser)) return PE_BAD_RANGE;
 
+	TRAP_PROTECT(ser);
+	if (IS_SHARED_SERIES(ser)) Unshare_Series(ser);
+
 	if (IS_CHAR(val)) {
 		c = VAL_CHAR(val);
 		if (c > MAX_CHAR) return PE_BAD_SET;
@@ -391,8 +394,6 @@ static REBSER *make_binary(REBVAL *arg, REBOOL make)
 	else
 		return PE_BAD_SELECT;
 
-	TRAP_PROTECT(ser);
-
 	if (BYTE_SIZE(ser) && c > 0xff) Widen_String(ser);
 	SET_ANY_CHAR(ser, n, c);
 
@@ -471,6 +472,10 @@ static REBSER *make_binary(REBVAL *arg, REBOOL make)
 	if (action >= A_TAKE && action <= A_SORT && IS_PROTECT_SERIES(VAL_SERIES(value)))
 		Trap0(RE_PROTECTED);
 
+	// Shared data (a slice) must be copied before it is modified:
+	if (action >= A_TAKE && action <= A_SORT && IS_SHARED_SERIES(VAL_SERIES(value)))
+		Unshare_Series(VAL_SERIES(value));
+
 	switch (action) {
 
 	//-- Modification:
@@ -626,6 +631,10 @@ zero_str:
 
 	case A_COPY:
 		len = Partial(value, 0, D_ARG(3), 0); // Can modify value index.
+		// Larger binary parts share the data, until modified:
+		if (D_REF(ARG_COPY_PART) && IS_BINARY(value) && len >= MIN_SLICE
+			&& NZ(ser = Make_Slice(VAL_SERIES(value), VAL_INDEX(value), len)))
+			goto ser_exit;
 		ser = Copy_String(VAL_SERIES(value), VAL_INDEX(value), len);
 		goto ser_exit;
 
@@ -679,6 +688,7 @@ zero_str:
 	case A_SWAP:
 		if (VAL_TYPE(value) != VAL_TYPE(arg)) Trap0(RE_NOT_SAME_TYPE);
 		if (IS_PROTECT_SERIES(VAL_SERIES(arg))) Trap0(RE_PROTECTED);
+		if (IS_SHARED_SERIES(VAL_SERIES(arg))) Unshare_Series(VAL_SERIES(arg));
 		if (index < tail && VAL_INDEX(arg) < VAL_TAIL(arg))
 			swap_chars(value, arg);
 		// Trap_Range(arg);  // ignore range error
@@ -711,6 +721,7 @@ zero_str:
 			index += (REBCNT)Random_Int(D_REF(3)) % (tail - index);  // /secure
 			goto pick_it;
 		}
+		if (IS_SHARED_SERIES(VAL_SERIES(value))) Unshare_Series(VAL_SERIES(value));
 		Shuffle_String(value, D_REF(3));  // /secure
 		break;
 
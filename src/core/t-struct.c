@@ -500,6 +500,7 @@ static void set_ext_storage (REBVAL *out, REBINT raw_size, REBUPT raw_addr)
 	Prop_Series(ser, VAL_STRUCT_DATA_BIN(out));
 	ser->data = (REBYTE*)raw_addr;
 	EXT_SERIES(ser);
+	SERIES_LINK(ser) = 0; // not shared (see Make_Slice)
 
 	VAL_STRUCT_DATA_BIN(out) = ser;
 }
@@ -56,13 +56,15 @@
 
 /***********************************************************************
 **
-*/  REBSER *Compress(REBSER *input, REBINT index, REBINT len, REBFLG use_crc)
+*/  REBSER *Compress(REBSER *input, REBINT index, REBINT len, REBFLG use_crc, REBINT level, REBINT threads)
 /*
 **      Compress a binary (only).
 **		data
 **		/part
 **		length
 **		/crc32
+**		level (0 to 9, or -1 for the default)
+**		threads (1 for none, 0 for one per CPU; see Make_Z_Stream)
 **
 **      Note: If the file length is "small", it can't overrun on
 **      compression too much so we use our magic numbers; otherwise,
@@ -75,18 +77,39 @@
 	REBSER *output;
 	REBINT err;
 	REBYTE out_size[sizeof(REBCNT)];
+	z_stream zs;
 
 	if (len < 0) Trap0(RE_PAST_END); // !!! better msg needed
+	if (level < -1 || level > 9) Trap_Num(RE_OUT_OF_RANGE, level);
 	size = len + (len > STERLINGS_MAGIC_NUMBER ? len / 10 + 12 : STERLINGS_MAGIC_FIX);
 	output = Make_Binary(size);
 
-	//DISABLE_GC;	// !!! why??
-	// dest, dest-len, src, src-len, level
-	err = Z_compress2(BIN_HEAD(output), (uLongf*)&size, BIN_HEAD(input) + index, len, use_crc);
-	if (err) {
-		if (err == Z_MEM_ERROR) Trap0(RE_NO_MEMORY);
-		SET_INTEGER(DS_RETURN, err);
-		Trap1(RE_BAD_PRESS, DS_RETURN); //!!!provide error string descriptions
+	if (threads != 1 && !use_crc) {
+		// Parallel blocks make the same zlib stream:
+		Z_Stream(Make_Z_Stream(SYM_ZLIB, level, threads), output, BIN_HEAD(input) + index, len, TRUE);
+		size = SERIES_TAIL(output);
+	}
+	else {
+		//DISABLE_GC;	// !!! why??
+		// As Z_compress2(), but with the level:
+		CLEAR(&zs, sizeof(zs));
+		zs.checksum = use_crc ? crc32 : adler32;
+		zs.next_in = BIN_HEAD(input) + index;
+		zs.avail_in = len;
+		zs.next_out = BIN_HEAD(output);
+		zs.avail_out = size;
+		err = deflateInit(&zs, level);
+		if (!err) {
+			err = deflate(&zs, Z_FINISH);
+			err = (err == Z_STREAM_END) ? Z_OK : (err == Z_OK ? Z_BUF_ERROR : err);
+			size = zs.total_out;
+			deflateEnd(&zs);
+		}
+		if (err) {
+			if (err == Z_MEM_ERROR) Trap0(RE_NO_MEMORY);
+			SET_INTEGER(DS_RETURN, err);
+			Trap1(RE_BAD_PRESS, DS_RETURN); //!!!provide error string descriptions
+		}
 	}
 	SET_STR_END(output, size);
 	SERIES_TAIL(output) = size;
@@ -135,3 +158,732 @@
 	//ENABLE_GC;
 	return output;
 }
+
+
+/***********************************************************************
+**
+**	Streams
+**
+**		A stream compresses (or decompresses) data as it is given,
+**		a part at a time, so the whole of it is never in memory.
+**		Its formats are zlib, raw deflate (no header or check),
+**		and gzip (one or more members, as .gz files have).
+**
+**		A stream is a block of [state allocations...]. The state is
+**		a binary that holds the Z_STREAM struct, and the allocations
+**		are the binaries zlib uses. These are GC managed, so nothing
+**		needs to be freed when the stream is no longer used.
+**
+**		With threads, deflate is done in parallel (as pigz does).
+**		The input is cut into blocks that are deflated at the same
+**		time, each primed with the 32K of data before it, so little
+**		compression is lost. Each block ends with a sync flush (on a
+**		byte boundary), so the blocks simply concatenate to one
+**		deflate stream. The checks of the blocks are combined.
+**
+***********************************************************************/
+
+#define Z_OUT_MIN		16*1024		// min free space of output for a call
+#define Z_BLOCK_SIZE	(128*1024)	// input of a parallel deflate block
+#define Z_DICT_SIZE		(32*1024)		// data before a block, to prime it
+#define Z_MAX_THREADS	64
+
+// Gzip member flags and phases:
+#define GZ_FHCRC		2
+#define GZ_FEXTRA		4
+#define GZ_FNAME		8
+#define GZ_FCOMMENT		16
+
+enum Z_Phases {
+	ZP_HEAD,	// gzip header (first 10 bytes), or start of stream
+	ZP_XLEN,	// gzip extra field length
+	ZP_EXTRA,	// gzip extra field
+	ZP_NAME,	// gzip file name (zero terminated)
+	ZP_COMMENT,	// gzip comment (zero terminated)
+	ZP_HCRC,	// gzip header CRC
+	ZP_DATA,	// deflate data
+	ZP_TAIL,	// gzip trailer (CRC and size)
+	ZP_END		// end of stream (zlib and raw)
+};
+
+typedef struct rebol_z_stream {
+	z_stream zs;
+	REBCNT format;	// SYM_ZLIB, SYM_DEFLATE (raw), SYM_GZIP, or 0 (detect)
+	REBINT level;	// compress level, or -1 to decompress
+	REBINT phase;	// Z_Phases
+	REBCNT have;	// bytes of the gzip header or trailer collected (or skipped)
+	REBCNT need;	// length of the gzip extra field
+	REBFLG init;	// zs has been initialized
+	REBFLG detect;	// format is detected for each stream
+	u32 crc;		// gzip CRC-32 of the uncompressed data (parallel: zlib Adler-32)
+	u32 size;		// gzip size of the uncompressed data (mod 2^32)
+	REBYTE buf[10];	// gzip header or trailer
+	REBCNT threads;	// deflate blocks in parallel (if more than one)
+	REBSER *blocks;	// parallel: Z_BLOCK of each thread
+	REBSER *input;	// parallel: dictionary, then input not yet deflated
+	REBCNT dict;	// parallel: length of dictionary at head of input
+} Z_STREAM;
+
+// A block of input deflated by a thread:
+typedef struct rebol_z_block {
+	z_stream zs;
+	REBYTE *data;	// input of the block
+	REBCNT len;
+	REBYTE *out;	// output buffer
+	REBCNT size;	// size of output buffer
+	REBCNT used;	// output length
+	REBINT flush;	// Z_SYNC_FLUSH or Z_FINISH (last block)
+	REBFLG crc;		// check is CRC-32 (else Adler-32)
+	u32 check;		// check of the input
+	REBINT err;
+	REBFLG init;	// zs has been initialized
+} Z_BLOCK;
+
+#define Z_STATE(s) ((Z_STREAM*)BIN_HEAD(VAL_SERIES(BLK_HEAD(s))))
+
+
+/***********************************************************************
+**
+*/	static voidpf Z_Alloc(voidpf opaque, uInt items, uInt size)
+/*
+**		Zlib allocation function. The memory is a binary kept in
+**		the stream block (opaque).
+**
+***********************************************************************/
+{
+	REBSER *ser = Make_Binary(items * size);
+
+	CLEAR(BIN_HEAD(ser), items * size);
+	Set_Binary(Append_Value((REBSER*)opaque), ser);
+	return BIN_HEAD(ser);
+}
+
+
+/***********************************************************************
+**
+*/	static void Z_Free(voidpf opaque, voidpf ptr)
+/*
+**		Zlib free function. The GC frees it with the stream.
+**
+***********************************************************************/
+{
+}
+
+
+/***********************************************************************
+**
+*/	static void Z_Trap(REBINT err)
+/*
+***********************************************************************/
+{
+	if (err == Z_MEM_ERROR) Trap0(RE_NO_MEMORY);
+	SET_INTEGER(DS_RETURN, err);
+	Trap1(RE_BAD_PRESS, DS_RETURN);
+}
+
+
+/***********************************************************************
+**
+*/	REBSER *Make_Z_Stream(REBCNT format, REBINT level, REBINT threads)
+/*
+**		Make a stream to compress (level 0 to 9, or -1 for zlib's
+**		default) or to decompress (level is -2). Format is SYM_ZLIB,
+**		SYM_DEFLATE or SYM_GZIP. To decompress, it can also be zero
+**		to detect zlib or gzip from the data.
+**
+**		Threads is the number of blocks to deflate in parallel:
+**		1 for none, or 0 for one per CPU.
+**
+***********************************************************************/
+{
+	REBSER *stream = Make_Block(8);
+	REBSER *ser = Make_Binary(sizeof(Z_STREAM));
+	Z_STREAM *z = (Z_STREAM*)BIN_HEAD(ser);
+
+	CLEAR(z, sizeof(Z_STREAM));
+	Set_Binary(Append_Value(stream), ser);
+
+	if (level > 9 || level < -2) Trap_Num(RE_OUT_OF_RANGE, level);
+	if (threads < 0) Trap_Num(RE_OUT_OF_RANGE, threads);
+	z->format = format;
+	z->detect = !format;
+	z->level = level;
+	z->phase = ZP_HEAD;
+	if (threads == 0) threads = OS_GET_CPUS();
+	z->threads = (level >= -1) ? MIN(threads, Z_MAX_THREADS) : 1;
+	return stream;
+}
+
+
+/***********************************************************************
+**
+*/	static void Z_Init(REBSER *stream, Z_STREAM *z)
+/*
+**		Initialize (or reset) zlib for the start of a stream
+**		(or gzip member).
+**
+***********************************************************************/
+{
+	REBINT bits = (z->format == SYM_ZLIB) ? MAX_WBITS : -MAX_WBITS; // no header
+	REBINT err;
+
+	if (z->init) {
+		err = (z->level >= -1) ? deflateReset(&z->zs) : inflateReset(&z->zs);
+	}
+	else {
+		z->zs.zalloc = Z_Alloc;
+		z->zs.zfree = Z_Free;
+		z->zs.opaque = stream;
+		z->zs.checksum = adler32;
+		if (z->level >= -1)
+			err = deflateInit2(&z->zs, z->level, Z_DEFLATED, bits, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+		else
+			err = inflateInit2(&z->zs, bits);
+		z->init = TRUE;
+	}
+	if (err != Z_OK) Z_Trap(err);
+
+	z->crc = crc32(0L, Z_NULL, 0);
+	z->size = 0;
+}
+
+
+/***********************************************************************
+**
+*/	static REBYTE *Z_Out(REBSER *out, REBCNT *avail)
+/*
+**		Get the tail of the output, with space for a zlib call.
+**
+***********************************************************************/
+{
+	if (SERIES_AVAIL(out) < Z_OUT_MIN)
+		Extend_Series(out, MAX(Z_OUT_MIN, SERIES_TAIL(out) / 2));
+	*avail = SERIES_AVAIL(out);
+	return STR_TAIL(out);
+}
+
+
+/***********************************************************************
+**
+*/	static void Z_Deflate(REBSER *stream, Z_STREAM *z, REBSER *out, REBYTE *data, REBCNT len, REBFLG finish)
+/*
+***********************************************************************/
+{
+	static REBYTE gz_head[10] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff};
+	REBINT flush = finish ? Z_FINISH : Z_NO_FLUSH;
+	REBYTE tail[8];
+	REBCNT avail;
+	REBINT err;
+
+	if (z->phase == ZP_HEAD) {
+		Z_Init(stream, z);
+		if (z->format == SYM_GZIP) Append_Series(out, gz_head, 10);
+		z->phase = ZP_DATA;
+	}
+
+	if (z->format == SYM_GZIP) {
+		z->crc = crc32(z->crc, data, len);
+		z->size += len;
+	}
+
+	z->zs.next_in = data;
+	z->zs.avail_in = len;
+	do {
+		z->zs.next_out = Z_Out(out, &avail);
+		z->zs.avail_out = avail;
+		err = deflate(&z->zs, flush);
+		SERIES_TAIL(out) += avail - z->zs.avail_out;
+		if (err == Z_STREAM_END) break;
+		if (err != Z_OK && err != Z_BUF_ERROR) Z_Trap(err);
+	} while (z->zs.avail_in || z->zs.avail_out == 0);
+
+	if (finish) {
+		if (z->format == SYM_GZIP) {
+			REBCNT_To_Bytes(tail, z->crc);		// (little endian)
+			REBCNT_To_Bytes(tail + 4, z->size);
+			Append_Series(out, tail, 8);
+		}
+		z->phase = ZP_HEAD; // next write starts a new stream
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static u32 GF2_Times(u32 *mat, u32 vec)
+/*
+***********************************************************************/
+{
+	u32 sum = 0;
+
+	for (; vec; vec >>= 1, mat++) if (vec & 1) sum ^= *mat;
+	return sum;
+}
+
+
+/***********************************************************************
+**
+*/	static void GF2_Square(u32 *square, u32 *mat)
+/*
+***********************************************************************/
+{
+	REBINT n;
+
+	for (n = 0; n < 32; n++) square[n] = GF2_Times(mat, mat[n]);
+}
+
+
+/***********************************************************************
+**
+*/	static u32 Z_Combine_CRC(u32 crc1, u32 crc2, REBCNT len2)
+/*
+**		CRC-32 of two parts of data, from the CRC-32 of each part
+**		and the length of the second (as zlib 1.2 crc32_combine).
+**
+***********************************************************************/
+{
+	u32 even[32];	// even-power-of-two zeros operator
+	u32 odd[32];	// odd-power-of-two zeros operator
+	u32 row = 1;
+	REBINT n;
+
+	if (len2 == 0) return crc1;
+
+	// Operator for one zero bit:
+	odd[0] = 0xedb88320L;
+	for (n = 1; n < 32; n++, row <<= 1) odd[n] = row;
+
+	GF2_Square(even, odd);	// two zero bits
+	GF2_Square(odd, even);	// four zero bits
+
+	// Apply len2 zero bytes to crc1:
+	do {
+		GF2_Square(even, odd);
+		if (len2 & 1) crc1 = GF2_Times(even, crc1);
+		len2 >>= 1;
+		if (len2 == 0) break;
+		GF2_Square(odd, even);
+		if (len2 & 1) crc1 = GF2_Times(odd, crc1);
+		len2 >>= 1;
+	} while (len2);
+
+	return crc1 ^ crc2;
+}
+
+
+/***********************************************************************
+**
+*/	static u32 Z_Combine_Adler(u32 adler1, u32 adler2, REBCNT len2)
+/*
+**		Adler-32 of two parts of data (as zlib 1.2 adler32_combine).
+**
+***********************************************************************/
+{
+	const u32 base = 65521;
+	u32 rem = len2 % base;
+	u32 sum1 = adler1 & 0xffff;
+	u32 sum2 = (rem * sum1) % base;
+
+	sum1 += (adler2 & 0xffff) + base - 1;
+	sum2 += (adler1 >> 16) + (adler2 >> 16) + base - rem;
+	if (sum1 >= base) sum1 -= base;
+	if (sum1 >= base) sum1 -= base;
+	if (sum2 >= (base << 1)) sum2 -= (base << 1);
+	if (sum2 >= base) sum2 -= base;
+	return sum1 | (sum2 << 16);
+}
+
+
+/***********************************************************************
+**
+*/	static void Z_Block_Job(void *arg)
+/*
+**		Deflate a block (run by a thread). It must not allocate or
+**		trap, so its zlib state was made ready before.
+**
+***********************************************************************/
+{
+	Z_BLOCK *b = (Z_BLOCK*)arg;
+	REBINT err;
+
+	b->zs.next_in = b->data;
+	b->zs.avail_in = b->len;
+	b->zs.next_out = b->out;
+	b->zs.avail_out = b->size;
+	err = deflate(&b->zs, b->flush);
+	b->used = b->size - b->zs.avail_out;
+
+	if (b->flush == Z_FINISH) b->err = (err == Z_STREAM_END) ? Z_OK : (err ? err : Z_BUF_ERROR);
+	// All of the flush must fit:
+	else b->err = (err == Z_OK && b->zs.avail_out > 0) ? Z_OK : (err ? err : Z_BUF_ERROR);
+
+	b->check = b->crc ? crc32(0L, b->data, b->len) : adler32(1L, b->data, b->len);
+}
+
+
+/***********************************************************************
+**
+*/	static void Z_Par_Batch(REBSER *stream, Z_STREAM *z, REBSER *out, REBFLG finish)
+/*
+**		Deflate the input (after the dictionary) as blocks, in
+**		parallel, then append them to the output in order. Finish
+**		ends the stream with the last block (which may be empty).
+**
+***********************************************************************/
+{
+	REBSER *in = z->input;
+	REBYTE *data = BIN_SKIP(in, z->dict);
+	REBCNT len = SERIES_TAIL(in) - z->dict;
+	REBCNT count = MAX(1, (len + Z_BLOCK_SIZE - 1) / Z_BLOCK_SIZE);
+	Z_BLOCK *b;
+	REBCNT dict;
+	REBCNT n;
+	REBINT err;
+
+	// Made ready here, as zlib allocates from series:
+	for (n = 0; n < count; n++) {
+		b = (Z_BLOCK*)BIN_HEAD(z->blocks) + n;
+		b->data = data + n * Z_BLOCK_SIZE;
+		b->len = MIN(Z_BLOCK_SIZE, len - n * Z_BLOCK_SIZE);
+		b->flush = (finish && n == count - 1) ? Z_FINISH : Z_SYNC_FLUSH;
+		b->crc = (z->format == SYM_GZIP);
+		if (b->init) err = deflateReset(&b->zs);
+		else {
+			b->zs.zalloc = Z_Alloc;
+			b->zs.zfree = Z_Free;
+			b->zs.opaque = stream;
+			b->zs.checksum = adler32;
+			err = deflateInit2(&b->zs, z->level, Z_DEFLATED, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+			b->init = TRUE;
+		}
+		dict = MIN(Z_DICT_SIZE, b->data - BIN_HEAD(in));
+		if (err == Z_OK && dict > 0) err = deflateSetDictionary(&b->zs, b->data - dict, dict);
+		if (err != Z_OK) Z_Trap(err);
+	}
+
+	OS_RUN_PARALLEL(Z_Block_Job, BIN_HEAD(z->blocks), sizeof(Z_BLOCK), count, z->threads);
+
+	for (n = 0; n < count; n++) {
+		b = (Z_BLOCK*)BIN_HEAD(z->blocks) + n;
+		if (b->err) Z_Trap(b->err);
+		Append_Series(out, b->out, b->used);
+		z->crc = (b->crc) ? Z_Combine_CRC(z->crc, b->check, b->len)
+			: Z_Combine_Adler(z->crc, b->check, b->len);
+		z->size += b->len;
+	}
+
+	// Keep the end of the data to prime the next blocks:
+	n = MIN(Z_DICT_SIZE, SERIES_TAIL(in));
+	if (finish) n = 0;
+	memmove(BIN_HEAD(in), BIN_SKIP(in, SERIES_TAIL(in) - n), n);
+	SERIES_TAIL(in) = z->dict = n;
+}
+
+
+/***********************************************************************
+**
+*/	static void Z_Par_Deflate(REBSER *stream, Z_STREAM *z, REBSER *out, REBYTE *data, REBCNT len, REBFLG finish)
+/*
+**		Deflate in parallel blocks. The input is collected until
+**		there is a block for each thread (or the stream finishes).
+**
+***********************************************************************/
+{
+	static REBYTE gz_head[10] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff};
+	REBSER *ser;
+	REBYTE tail[8];
+	REBCNT full;
+	REBCNT n;
+
+	if (!z->blocks) {
+		z->blocks = Make_Binary(z->threads * sizeof(Z_BLOCK));
+		CLEAR(BIN_HEAD(z->blocks), z->threads * sizeof(Z_BLOCK));
+		Set_Binary(Append_Value(stream), z->blocks);
+		z->input = Make_Binary(Z_DICT_SIZE + z->threads * Z_BLOCK_SIZE);
+		Set_Binary(Append_Value(stream), z->input);
+		for (n = 0; n < z->threads; n++) {
+			Z_BLOCK *b = (Z_BLOCK*)BIN_HEAD(z->blocks) + n;
+			// Room for stored blocks, and the flush or end:
+			b->size = Z_BLOCK_SIZE + Z_BLOCK_SIZE / 8 + 64;
+			ser = Make_Binary(b->size);
+			Set_Binary(Append_Value(stream), ser);
+			b->out = BIN_HEAD(ser);
+		}
+	}
+
+	if (z->phase == ZP_HEAD) {
+		if (z->format == SYM_GZIP) {
+			Append_Series(out, gz_head, 10);
+			z->crc = 0;
+		}
+		else if (z->format == SYM_ZLIB) {
+			// As deflate() writes it:
+			REBINT level = (z->level < 0) ? 6 : z->level;
+			REBCNT head = (Z_DEFLATED + ((MAX_WBITS - 8) << 4)) << 8;
+			head |= ((level < 2) ? 0 : (level < 6) ? 1 : (level == 6) ? 2 : 3) << 6;
+			head += 31 - (head % 31);
+			tail[0] = (REBYTE)(head >> 8);
+			tail[1] = (REBYTE)head;
+			Append_Series(out, tail, 2);
+			z->crc = 1;
+		}
+		z->size = 0;
+		z->phase = ZP_DATA;
+	}
+
+	full = z->threads * Z_BLOCK_SIZE;
+	do {
+		n = MIN(len, full - (SERIES_TAIL(z->input) - z->dict));
+		Append_Series(z->input, data, n);
+		data += n;
+		len -= n;
+		if ((finish && len == 0) || SERIES_TAIL(z->input) - z->dict == full)
+			Z_Par_Batch(stream, z, out, finish && len == 0);
+	} while (len > 0);
+
+	if (finish) {
+		if (z->format == SYM_GZIP) {
+			REBCNT_To_Bytes(tail, z->crc);		// (little endian)
+			REBCNT_To_Bytes(tail + 4, z->size);
+			Append_Series(out, tail, 8);
+		}
+		else if (z->format == SYM_ZLIB) {
+			for (n = 0; n < 4; n++) tail[n] = (REBYTE)(z->crc >> (24 - 8 * n)); // (big endian)
+			Append_Series(out, tail, 4);
+		}
+		z->phase = ZP_HEAD; // next write starts a new stream
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Z_Gzip_Head(Z_STREAM *z, REBYTE *data, REBCNT len)
+/*
+**		Parse the gzip member header (as far as it has been given).
+**		Returns the number of bytes used.
+**
+***********************************************************************/
+{
+	REBCNT n = 0;
+
+	while (n < len && z->phase < ZP_DATA) {
+		switch (z->phase) {
+
+		case ZP_HEAD:
+			z->buf[z->have++] = data[n++];
+			if (z->have == 1 && z->buf[0] != 0x1f) Z_Trap(Z_DATA_ERROR);
+			if (z->have == 2 && z->buf[1] != 0x8b) Z_Trap(Z_DATA_ERROR);
+			if (z->have == 4 && (z->buf[2] != Z_DEFLATED || (z->buf[3] & 0xe0))) Z_Trap(Z_DATA_ERROR);
+			if (z->have < 10) break;
+			z->have = 0;
+			z->phase = ZP_XLEN;
+			// fall thru
+
+		default:
+			// Skip to the next field that is in the header:
+			while (z->phase < ZP_DATA && z->have == 0) {
+				REBCNT flag = (z->phase == ZP_XLEN) ? GZ_FEXTRA
+					: (z->phase == ZP_NAME) ? GZ_FNAME
+					: (z->phase == ZP_COMMENT) ? GZ_FCOMMENT
+					: (z->phase == ZP_HCRC) ? GZ_FHCRC : 0;
+				if (flag && (z->buf[3] & flag)) break;
+				if (z->phase == ZP_EXTRA && z->need) break;
+				z->phase++;
+			}
+			if (z->phase == ZP_DATA || n == len) break;
+
+			switch (z->phase) {
+			case ZP_XLEN:
+				z->need |= data[n++] << (8 * z->have++);
+				if (z->have == 2) z->have = 0, z->phase++;
+				break;
+			case ZP_EXTRA:
+				if (len - n < z->need) z->need -= len - n, n = len;
+				else n += z->need, z->need = 0, z->phase++;
+				break;
+			case ZP_NAME:
+			case ZP_COMMENT:
+				if (!data[n++]) z->phase++;
+				break;
+			case ZP_HCRC:
+				n++;
+				if (++z->have == 2) z->have = 0, z->phase++;
+				break;
+			}
+		}
+	}
+
+	return n;
+}
+
+
+/***********************************************************************
+**
+*/	static void Z_Inflate(REBSER *stream, Z_STREAM *z, REBSER *out, REBYTE *data, REBCNT len, REBFLG finish)
+/*
+***********************************************************************/
+{
+	REBYTE dummy = 0;
+	REBYTE *bp;
+	REBCNT avail;
+	REBCNT n;
+	REBINT err;
+
+	while (len > 0 || (finish && z->phase == ZP_DATA)) {
+
+		if (z->phase == ZP_END) {
+			// Zlib and raw streams are one per stream:
+			Z_Trap(Z_DATA_ERROR);
+		}
+
+		if (z->phase == ZP_HEAD && z->have == 0) {
+			if (z->detect) z->format = (data[0] == 0x1f) ? SYM_GZIP : SYM_ZLIB;
+			if (z->format != SYM_GZIP) {
+				Z_Init(stream, z);
+				z->phase = ZP_DATA;
+			}
+		}
+
+		if (z->phase < ZP_DATA) {
+			n = Z_Gzip_Head(z, data, len);
+			data += n;
+			len -= n;
+			if (z->phase == ZP_DATA) Z_Init(stream, z);
+			continue;
+		}
+
+		if (z->phase == ZP_TAIL) {
+			for (; len > 0 && z->have < 8; len--) z->buf[z->have++] = *data++;
+			if (z->have < 8) break;
+			if (Bytes_To_REBCNT(z->buf) != z->crc || Bytes_To_REBCNT(z->buf + 4) != z->size)
+				Z_Trap(Z_DATA_ERROR);
+			z->have = 0;
+			z->phase = ZP_HEAD; // another member may follow
+			continue;
+		}
+
+		// Raw deflate data needs one byte past its end (zlib 1.1):
+		if (len == 0) {
+			if (z->format != SYM_DEFLATE) break;
+			data = &dummy;
+			len = 1;
+		}
+
+		z->zs.next_in = data;
+		z->zs.avail_in = len;
+		do {
+			z->zs.next_out = bp = Z_Out(out, &avail);
+			z->zs.avail_out = avail;
+			err = inflate(&z->zs, Z_NO_FLUSH);
+			n = avail - z->zs.avail_out;
+			SERIES_TAIL(out) += n;
+			if (z->format == SYM_GZIP) {
+				z->crc = crc32(z->crc, bp, n);
+				z->size += n;
+			}
+			if (err == Z_STREAM_END) {
+				z->phase = (z->format == SYM_GZIP) ? ZP_TAIL : ZP_END;
+				break;
+			}
+			if (err == Z_BUF_ERROR && !z->zs.avail_in) break;
+			if (err != Z_OK) Z_Trap(err);
+		} while (z->zs.avail_in || z->zs.avail_out == 0);
+
+		if (data == &dummy) {
+			if (z->phase == ZP_DATA) Z_Trap(Z_BUF_ERROR); // truncated
+			break;
+		}
+		data = z->zs.next_in;
+		len = z->zs.avail_in;
+	}
+
+	if (finish) {
+		// The data must have ended (at the end of a gzip member):
+		if (z->phase != ZP_END && (z->phase != ZP_HEAD || z->have != 0 || !z->init))
+			Z_Trap(Z_BUF_ERROR);
+		z->phase = ZP_HEAD;
+		z->have = 0;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	void Z_Stream(REBSER *stream, REBSER *out, REBYTE *data, REBCNT len, REBFLG finish)
+/*
+**		Compress or decompress the data, appending the result to
+**		the out binary. Finish ends the stream (writes the gzip
+**		trailer, or checks that compressed data is complete). The
+**		stream can then be used for another one.
+**
+***********************************************************************/
+{
+	Z_STREAM *z = Z_STATE(stream);
+
+	if (z->level >= -1) {
+		if (z->threads > 1) Z_Par_Deflate(stream, z, out, data, len, finish);
+		else Z_Deflate(stream, z, out, data, len, finish);
+	}
+	else Z_Inflate(stream, z, out, data, len, finish);
+	SET_STR_END(out, SERIES_TAIL(out));
+}
+
+
+/***********************************************************************
+**
+*/	REBINT Codec_GZIP(REBCDI *codi)
+/*
+**		Gzip file codec (.gz), for LOAD and SAVE.
+**		Decodes all members of the file to a binary.
+**
+**		Bad or truncated data is a codec error (as for the other
+**		codecs), not the compression error of the stream.
+**
+***********************************************************************/
+{
+	REBSER *stream;
+	REBSER *out;
+	REBYTE *data;
+	REBOL_STATE state;
+
+	codi->error = 0;
+
+	if (codi->action == CODI_IDENTIFY) {
+		if (codi->len < 18 || codi->data[0] != 0x1f || codi->data[1] != 0x8b)
+			codi->error = CODI_ERR_SIGNATURE;
+		return CODI_CHECK; // error code is inverted result
+	}
+
+	if (codi->action == CODI_DECODE || codi->action == CODI_ENCODE) {
+		data = codi->data;
+		if (codi->action == CODI_ENCODE) {
+			if (codi->w > 1) {
+				codi->error = CODI_ERR_ENCODING; // (wide string)
+				return CODI_ERROR;
+			}
+			data = codi->other;
+		}
+		stream = Make_Z_Stream(SYM_GZIP, (codi->action == CODI_DECODE) ? -2 : -1, 1);
+		out = Make_Binary(codi->len);
+		PUSH_STATE(state, Saved_State);
+		if (SET_JUMP(state)) {
+			POP_STATE(state, Saved_State);
+			Catch_Error(DS_RETURN);
+			if (VAL_ERR_NUM(DS_RETURN) != RE_BAD_PRESS) Throw_Error(VAL_ERR_OBJECT(DS_RETURN));
+			codi->error = CODI_ERR_BAD_DATA;
+			return CODI_ERROR;
+		}
+		SET_STATE(state, Saved_State);
+		Z_Stream(stream, out, data, codi->len, TRUE);
+		POP_STATE(state, Saved_State);
+		// Pass thru (copied by DO-CODEC):
+		codi->data = 0;
+		codi->other = BIN_HEAD(out);
+		codi->len = SERIES_TAIL(out);
+		return CODI_BINARY;
+	}
+
+	codi->error = CODI_ERR_NA;
+	return CODI_ERROR;
+}
@@ -0,0 +1,564 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  u-csv.c
+**  Summary: CSV codec
+**  Section: utility
+**  Notes:
+**		Reads and writes RFC 4180 CSV: fields with a delimiter, quote,
+**		CR or LF are quoted, and a quote in them is doubled. Reading
+**		accepts LF, CRLF or CR line ends and skips blank lines. It
+**		keeps a stray quote in an unquoted field as it is. The
+**		delimiter (comma) and quote (double quote) can be changed.
+**
+**		Records are blocks. Fields are strings, unless types are
+**		inferred: then an unquoted field that scans as a number is
+**		integer! or decimal!, and an empty one is none!.
+**
+**		DECODE gives a block of records (with string fields), and
+**		ENCODE takes a block of records, or a block of fields for
+**		one record. Both take delimiter: and quote: options. The
+**		csv port scans or writes a part at a time, with the chars
+**		and typing of its spec (see CSV_Stream). Options and spec
+**		are checked the same way (see Get_CSV_Chars).
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+// Where the scanner is:
+enum CSV_At {
+	CSV_START,		// start of a field
+	CSV_FIELD,		// in an unquoted field
+	CSV_QUOTED,		// in a quoted field
+	CSV_QUOTE,		// after a quote in a quoted field (end, or a "")
+	CSV_CR			// after a CR at the end of a record (skip LF)
+};
+
+typedef struct rebol_csv_state {
+	REBYTE at;
+	REBYTE delim;
+	REBYTE quote;
+	REBYTE infer;	// scan numbers
+	REBYTE quoted;	// the field was quoted
+} CSV_STATE;
+
+// Parts of the stream block:
+#define STREAM_STATE(s)  ((CSV_STATE*)VAL_BIN(BLK_HEAD(s)))
+#define STREAM_FIELD(s)  VAL_SERIES(BLK_SKIP(s, 1))
+#define STREAM_RECORD(s) BLK_SKIP(s, 2)
+
+
+/***********************************************************************
+**
+*/	REBFLG Get_CSV_Chars(REBVAL *delim, REBVAL *quote, REBYTE *chars)
+/*
+**		Get the delimiter and quote chars (to chars[0] and [1]) from
+**		the values of ENCODE or DECODE options or of the port spec.
+**		None (or zero) is a comma or a double quote. Returns FALSE
+**		if they cannot be used.
+**
+***********************************************************************/
+{
+	REBUNI c;
+	REBINT n;
+
+	chars[0] = ',';
+	chars[1] = '"';
+
+	for (n = 0; n < 2; n++) {
+		REBVAL *val = n ? quote : delim;
+		if (!val || IS_NONE(val)) continue;
+		if (!IS_CHAR(val)) return FALSE;
+		c = VAL_CHAR(val);
+		if (c >= 0x80 || c == CR || c == LF) return FALSE;
+		chars[n] = (REBYTE)c;
+	}
+
+	return chars[0] != chars[1];
+}
+
+
+/***********************************************************************
+**
+*/	static void Make_CSV_Value(CSV_STATE *cs, REBYTE *cp, REBCNT len, REBVAL *out)
+/*
+***********************************************************************/
+{
+	REBYTE *bp;
+	REBYTE *ep = cp + len;
+	REBFLG dec = FALSE;
+	REBFLG digit = FALSE;
+
+	if (cs->infer && !cs->quoted) {
+		if (len == 0) {
+			SET_NONE(out);
+			return;
+		}
+		// Only try a number if all chars could be in one:
+		for (bp = cp; bp < ep; bp++) {
+			if (*bp >= '0' && *bp <= '9') digit = TRUE;
+			else if (*bp == '.' || *bp == 'e' || *bp == 'E') dec = TRUE;
+			else if (*bp != '-' && *bp != '+') break;
+		}
+		if (bp == ep && digit && len <= MAX_NUM_LEN) {
+			if (!dec && Scan_Integer(cp, len, out)) return;
+			if (Scan_Decimal(cp, len, out, TRUE)) return;
+		}
+	}
+
+	for (bp = cp; bp < ep && *bp < 0x80; bp++);
+	Set_String(out, (bp < ep) ? Append_UTF8(0, cp, len) : Copy_Bytes(cp, len));
+}
+
+
+/***********************************************************************
+**
+*/	static void End_CSV_Field(REBSER *stream, REBSER *out, REBYTE c)
+/*
+**		End the field with the char that ended it: the delimiter,
+**		or a CR or LF that also ends the record.
+**
+***********************************************************************/
+{
+	CSV_STATE *cs = STREAM_STATE(stream);
+	REBSER *field = STREAM_FIELD(stream);
+	REBSER *record = VAL_SERIES(STREAM_RECORD(stream));
+
+	// A blank line is not a record:
+	if (c == cs->delim || SERIES_TAIL(record) || SERIES_TAIL(field) || cs->quoted)
+		Make_CSV_Value(cs, BIN_HEAD(field), SERIES_TAIL(field), Append_Value(record));
+	RESET_TAIL(field);
+	cs->quoted = FALSE;
+
+	if (c == cs->delim) {
+		cs->at = CSV_START;
+		return;
+	}
+
+	cs->at = (c == CR) ? CSV_CR : CSV_START;
+	if (SERIES_TAIL(record)) {
+		Set_Block(Append_Value(out), record);
+		// The next is likely the same size:
+		Set_Block(STREAM_RECORD(stream), Make_Block(SERIES_TAIL(record)));
+	}
+}
+
+
+/***********************************************************************
+**
+*/	REBSER *Make_CSV_Stream(REBYTE *chars, REBFLG infer)
+/*
+**		Make the state to scan or write CSV a part at a time, with
+**		the chars of Get_CSV_Chars. A block holds the CSV_STATE, the
+**		field so far, and the record so far.
+**
+***********************************************************************/
+{
+	REBSER *stream = Make_Block(3);
+	REBSER *ser = Make_Binary(sizeof(CSV_STATE));
+	CSV_STATE *cs = (CSV_STATE*)BIN_HEAD(ser);
+
+	CLEAR(cs, sizeof(CSV_STATE));
+	cs->delim = chars[0];
+	cs->quote = chars[1];
+	cs->infer = (REBYTE)infer;
+	SERIES_TAIL(ser) = sizeof(CSV_STATE);
+
+	Set_Binary(Append_Value(stream), ser);
+	Set_Binary(Append_Value(stream), Make_Binary(64));
+	Set_Block(Append_Value(stream), Make_Block(8));
+
+	return stream;
+}
+
+
+/***********************************************************************
+**
+*/	void CSV_Stream(REBSER *stream, REBSER *out, REBYTE *data, REBCNT len, REBFLG end)
+/*
+**		Scan a part of the CSV data, adding each record (a block)
+**		to the out block when its line ends. End completes the last
+**		record; it is an error if a quoted field is not closed.
+**
+***********************************************************************/
+{
+	CSV_STATE *cs = STREAM_STATE(stream);
+	REBSER *field = STREAM_FIELD(stream);
+	REBYTE *cp = data;
+	REBYTE *ep = data + len;
+	REBYTE *bp;
+	REBYTE delim = cs->delim;
+	REBYTE quote = cs->quote;
+
+	while (cp < ep) {
+		switch (cs->at) {
+
+		case CSV_CR:
+			cs->at = CSV_START;
+			if (*cp == LF) cp++;
+			continue;
+
+		case CSV_START:
+			if (*cp == quote) {
+				cs->at = CSV_QUOTED;
+				cs->quoted = TRUE;
+				cp++;
+				continue;
+			}
+			cs->at = CSV_FIELD;
+		case CSV_FIELD:
+			for (bp = cp; bp < ep && *bp != delim && *bp != LF && *bp != CR; bp++);
+			if (bp > cp) Append_Bytes_Len(field, cp, bp - cp);
+			cp = bp;
+			if (cp < ep) End_CSV_Field(stream, out, *cp++);
+			continue;
+
+		case CSV_QUOTED:
+			for (bp = cp; bp < ep && *bp != quote; bp++);
+			if (bp > cp) Append_Bytes_Len(field, cp, bp - cp);
+			cp = bp;
+			if (cp < ep) {
+				cs->at = CSV_QUOTE;
+				cp++;
+			}
+			continue;
+
+		case CSV_QUOTE:
+			if (*cp == quote) {
+				Append_Byte(field, quote);
+				cs->at = CSV_QUOTED;
+				cp++;
+			}
+			else cs->at = CSV_FIELD; // (the rest of the field is kept)
+			continue;
+		}
+	}
+
+	if (end) {
+		if (cs->at == CSV_QUOTED) {
+			cs->at = CSV_START;
+			cs->quoted = FALSE;
+			RESET_TAIL(field);
+			RESET_TAIL(VAL_SERIES(STREAM_RECORD(stream)));
+			Trap0(RE_PAST_END);
+		}
+		if (cs->at != CSV_CR) End_CSV_Field(stream, out, LF);
+		cs->at = CSV_START;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	REBSER *Decode_CSV(REBYTE *cp, REBCNT len, REBYTE *chars, REBFLG infer)
+/*
+**		Decode CSV text (UTF-8) to a block of records.
+**
+***********************************************************************/
+{
+	REBSER *out = Make_Block(len / 64 + 1);
+
+	// Skip a UTF-8 BOM:
+	if (len >= 3 && cp[0] == 0xEF && cp[1] == 0xBB && cp[2] == 0xBF) cp += 3, len -= 3;
+
+	CSV_Stream(Make_CSV_Stream(chars, infer), out, cp, len, TRUE);
+	return out;
+}
+
+
+/***********************************************************************
+**
+*/	REBSER *CSV_Columns(REBSER *records)
+/*
+**		Convert a block of records to a block of columns. A column
+**		of all integers is a 64 bit integer vector!, of all numbers
+**		a 64 bit decimal vector!, else a block (with none where a
+**		record is short).
+**
+***********************************************************************/
+{
+	REBCNT rows = SERIES_TAIL(records);
+	REBCNT cols = 0;
+	REBSER *out;
+	REBSER *ser;
+	REBVAL *rec;
+	REBVAL *val;
+	REBINT type;
+	REBCNT c;
+	REBCNT r;
+
+	for (r = 0; r < rows; r++) {
+		rec = BLK_SKIP(records, r);
+		if (IS_BLOCK(rec) && VAL_LEN(rec) > cols) cols = VAL_LEN(rec);
+	}
+
+	out = Make_Block(cols);
+
+	for (c = 0; c < cols; c++) {
+		// Integer, decimal, or neither (-1) for all of the column:
+		type = REB_INTEGER;
+		for (r = 0; r < rows && type > 0; r++) {
+			rec = BLK_SKIP(records, r);
+			if (!IS_BLOCK(rec) || c >= VAL_LEN(rec)) type = -1;
+			else if (IS_DECIMAL(val = VAL_BLK_DATA(rec) + c)) type = REB_DECIMAL;
+			else if (!IS_INTEGER(val)) type = -1;
+		}
+		if (rows == 0) type = -1;
+
+		if (type == REB_INTEGER) {
+			ser = Make_Vector(0, 0, 1, 64, rows);
+			for (r = 0; r < rows; r++)
+				((i64*)ser->data)[r] = VAL_INT64(VAL_BLK_DATA(BLK_SKIP(records, r)) + c);
+			Set_Series(REB_VECTOR, Append_Value(out), ser);
+		}
+		else if (type == REB_DECIMAL) {
+			ser = Make_Vector(1, 0, 1, 64, rows);
+			for (r = 0; r < rows; r++) {
+				val = VAL_BLK_DATA(BLK_SKIP(records, r)) + c;
+				((REBDEC*)ser->data)[r] = IS_INTEGER(val) ? (REBDEC)VAL_INT64(val) : VAL_DECIMAL(val);
+			}
+			Set_Series(REB_VECTOR, Append_Value(out), ser);
+		}
+		else {
+			ser = Make_Block(rows);
+			for (r = 0; r < rows; r++) {
+				rec = BLK_SKIP(records, r);
+				val = Append_Value(ser);
+				if (IS_BLOCK(rec) && c < VAL_LEN(rec)) *val = VAL_BLK_DATA(rec)[c];
+				else SET_NONE(val);
+			}
+			Set_Block(Append_Value(out), ser);
+		}
+	}
+
+	return out;
+}
+
+
+/***********************************************************************
+**
+*/	static void Encode_CSV_Field(REBSER *out, void *str, REBCNT len, REBCNT wide, REBYTE *chars)
+/*
+**		Wide is 2 for 16 bit chars, 1 for latin-1, or 0 for UTF-8.
+**		Quotes the field if it has to be.
+**
+***********************************************************************/
+{
+	REBYTE *bp = (REBYTE*)str;
+	REBUNI *up = (REBUNI*)str;
+	REBCNT tail = SERIES_TAIL(out);
+	REBFLG quote = FALSE;
+	REBYTE *dp;
+	REBCNT c;
+	REBCNT n;
+
+	for (n = 0; n < len && !quote; n++) {
+		c = (wide == 2) ? up[n] : bp[n];
+		quote = (c == chars[0] || c == chars[1] || c == CR || c == LF);
+	}
+
+	EXPAND_SERIES_TAIL(out, len * (wide ? 3 : 1) * (quote ? 2 : 1) + 2);
+	dp = BIN_SKIP(out, tail);
+
+	if (quote) *dp++ = chars[1];
+	if (wide == 0 && !quote) {
+		memcpy(dp, bp, len);
+		dp += len;
+	}
+	else {
+		for (n = 0; n < len; n++) {
+			c = (wide == 2) ? up[n] : bp[n];
+			if (c == chars[1]) *dp++ = chars[1];
+			if (c >= 0x80 && wide) dp += Encode_UTF8_Char(dp, c);
+			else *dp++ = (REBYTE)c;
+		}
+	}
+	if (quote) *dp++ = chars[1];
+
+	SERIES_TAIL(out) = dp - BIN_HEAD(out);
+}
+
+
+/***********************************************************************
+**
+*/	static void Encode_CSV_Value(REBSER *out, REBVAL *val, REBYTE *chars)
+/*
+***********************************************************************/
+{
+	REBYTE buf[60];
+	REBYTE *name;
+	REBSER *ser;
+	REBUNI chr;
+
+	switch (VAL_TYPE(val)) {
+
+	case REB_NONE:
+	case REB_UNSET:
+		break;
+
+	case REB_LOGIC:
+		if (VAL_LOGIC(val)) Append_Bytes_Len(out, (REBYTE*)"true", 4);
+		else Append_Bytes_Len(out, (REBYTE*)"false", 5);
+		break;
+
+	case REB_INTEGER:
+		Append_Bytes_Len(out, buf, Emit_Integer(buf, VAL_INT64(val)));
+		break;
+
+	case REB_DECIMAL:
+		Append_Bytes_Len(out, buf, Emit_Decimal(buf, VAL_DECIMAL(val), 0, '.', 17));
+		break;
+
+	case REB_CHAR:
+		chr = VAL_CHAR(val);
+		Encode_CSV_Field(out, &chr, 1, 2, chars);
+		break;
+
+	default:
+		if (ANY_WORD(val)) {
+			name = Get_Word_Name(val);
+			Encode_CSV_Field(out, name, LEN_BYTES(name), 0, chars);
+		}
+		else if (ANY_STR(val)) {
+			if (VAL_BYTE_SIZE(val)) Encode_CSV_Field(out, VAL_BIN_DATA(val), VAL_LEN(val), 1, chars);
+			else Encode_CSV_Field(out, VAL_UNI_DATA(val), VAL_LEN(val), 2, chars);
+		}
+		else {
+			// Other datatypes as formed:
+			ser = Copy_Form_Value(val, 0);
+			Encode_CSV_Field(out, ser->data, SERIES_TAIL(ser), BYTE_SIZE(ser) ? 1 : 2, chars);
+		}
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Encode_CSV_Record(REBSER *out, REBVAL *val, REBYTE *chars)
+/*
+***********************************************************************/
+{
+	REBCNT tail = SERIES_TAIL(out);
+
+	for (; NOT_END(val); val++) {
+		Encode_CSV_Value(out, val, chars);
+		if (NOT_END(val + 1)) Append_Byte(out, chars[0]);
+	}
+	// Not a blank line, if it has one empty field:
+	if (SERIES_TAIL(out) == tail) {
+		Append_Byte(out, chars[1]);
+		Append_Byte(out, chars[1]);
+	}
+	Append_Bytes_Len(out, (REBYTE*)"\r\n", 2);
+}
+
+
+/***********************************************************************
+**
+*/	void Encode_CSV(REBSER *out, REBVAL *blk, REBYTE *chars)
+/*
+**		Encode a block of records (blocks), or of the fields of one
+**		record, as CSV text (UTF-8) with CRLF line ends. It is added
+**		to the out binary.
+**
+***********************************************************************/
+{
+	REBVAL *rec = VAL_BLK_DATA(blk);
+
+	if (NOT_END(rec) && !IS_BLOCK(rec)) Encode_CSV_Record(out, rec, chars);
+	else {
+		for (; NOT_END(rec); rec++) {
+			if (!IS_BLOCK(rec)) Trap1(RE_INVALID_DATA, rec);
+			Encode_CSV_Record(out, VAL_BLK_DATA(rec), chars);
+		}
+	}
+
+	TERM_SERIES(out);
+}
+
+
+/***********************************************************************
+**
+*/	void CSV_Write_Stream(REBSER *stream, REBSER *out, REBVAL *blk)
+/*
+**		Encode records written to a csv port, with the chars of its
+**		stream (see Make_CSV_Stream).
+**
+***********************************************************************/
+{
+	CSV_STATE *cs = STREAM_STATE(stream);
+	REBYTE chars[2];
+
+	chars[0] = cs->delim;
+	chars[1] = cs->quote;
+	Encode_CSV(out, blk, chars);
+}
+
+
+/***********************************************************************
+**
+*/	REBINT Codec_CSV(REBCDI *codi)
+/*
+**		CSV codec (.csv) for LOAD, SAVE, DECODE and ENCODE. Comma
+**		delimited, unless the options have a delimiter: (or quote:).
+**
+***********************************************************************/
+{
+	REBSER *out;
+	REBSER *opts = codi->options ? VAL_OBJ_FRAME((REBVAL*)codi->options) : 0;
+	REBYTE chars[2];
+
+	codi->error = 0;
+
+	if (codi->action == CODI_IDENTIFY) {
+		// CSV has no signature to check:
+		codi->error = CODI_ERR_SIGNATURE;
+		return CODI_CHECK; // error code is inverted result
+	}
+
+	if (!Get_CSV_Chars(Find_Word_Value(opts, SYM_DELIMITER), Find_Word_Value(opts, SYM_QUOTE), chars)) {
+		codi->error = CODI_ERR_ENCODING;
+		return CODI_ERROR;
+	}
+
+	if (codi->action == CODI_DECODE) {
+		Set_Block((REBVAL*)codi->value, Decode_CSV(codi->data, codi->len, chars, FALSE));
+		return CODI_VALUE;
+	}
+
+	if (codi->action == CODI_ENCODE) {
+		if (!IS_BLOCK((REBVAL*)codi->value)) {
+			codi->error = CODI_ERR_ENCODING;
+			return CODI_ERROR;
+		}
+		out = Make_Binary(1024);
+		Encode_CSV(out, (REBVAL*)codi->value, chars);
+		// Pass thru (copied by DO-CODEC):
+		codi->data = 0;
+		codi->other = BIN_HEAD(out);
+		codi->len = SERIES_TAIL(out);
+		return CODI_BINARY;
+	}
+
+	codi->error = CODI_ERR_NA;
+	return CODI_ERROR;
+}
@@ -0,0 +1,747 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  u-json.c
+**  Summary: JSON codec
+**  Section: utility
+**  Notes:
+**		Decoding maps objects to map! (with string keys), arrays to
+**		block!, and null, true and false to none! and logic!. Numbers
+**		are integer! unless they have a fraction or exponent or do not
+**		fit in 64 bits. Keys of a map! are not case sensitive, and a
+**		null value is the same as no value, as with any map!.
+**
+**		Encoding takes any value: block! and paren! become arrays,
+**		map! and object! become objects, words and other strings
+**		become strings, and the rest are formed as strings.
+**
+**		One scanner does both the tree of DECODE and the events of
+**		the json port (see JSON_Stream), which parses a part at a
+**		time. It does not recurse, so nesting is only limited by
+**		JSON_MAX_DEPTH.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+#define JSON_MAX_DEPTH 512
+
+// What the scanner wants next:
+enum JSON_Expect {
+	JX_VALUE,		// a value (top level, after a colon or after a comma in an array)
+	JX_FIRST,		// a value or ] (after [)
+	JX_KEY,			// a key (after a comma in an object)
+	JX_FIRST_KEY,	// a key or } (after {)
+	JX_COLON,		// colon after a key
+	JX_NEXT			// comma or the close of the container
+};
+
+typedef struct rebol_json_state {
+	REBINT expect;
+	REBCNT depth;
+	REBCNT done;		// top level values scanned
+	REBCNT scanned;		// bytes of a token not all there yet, already scanned
+	REBFLG esc;			// that string part has escapes
+	REBFLG high;		// that string part has UTF-8
+	REBYTE nest[JSON_MAX_DEPTH];	// { or [ of each open container
+} JSON_STATE;
+
+typedef struct rebol_json_scan {
+	JSON_STATE *js;
+	REBSER *events;		// port: events are added to this block
+	REBSER **open;		// decode: block of each open container
+	REBVAL *result;		// decode: the top value
+	REBSER *buf;		// string chars when unescaping
+	REBFLG final;		// no more data will come
+} JSON_SCAN;
+
+#define IS_JSON_SPACE(c) ((c) == ' ' || (c) == '\n' || (c) == '\r' || (c) == '\t')
+#define IS_DIGIT(c) ((c) >= '0' && (c) <= '9')
+
+
+/***********************************************************************
+**
+*/	static void JSON_Error(REBYTE *cp, REBYTE *end)
+/*
+**		Trap with the text where the error is.
+**
+***********************************************************************/
+{
+	REBCNT len = end - cp;
+
+	if (len > 20) len = 20;
+	Set_String(DS_RETURN, Copy_Bytes(cp, len));
+	Trap1(RE_INVALID_DATA, DS_RETURN);
+}
+
+
+/***********************************************************************
+**
+*/	static REBINT Scan_JSON_Hex4(REBYTE *cp)
+/*
+***********************************************************************/
+{
+	REBINT n = 0;
+	REBINT i;
+	REBYTE c;
+
+	for (i = 0; i < 4; i++) {
+		c = cp[i];
+		if (IS_DIGIT(c)) c -= '0';
+		else if (c >= 'a' && c <= 'f') c -= 'a' - 10;
+		else if (c >= 'A' && c <= 'F') c -= 'A' - 10;
+		else return -1;
+		n = (n << 4) + c;
+	}
+	return n;
+}
+
+
+/***********************************************************************
+**
+*/	static REBYTE *Scan_JSON_String(JSON_SCAN *scan, REBYTE *cp, REBYTE *end, REBVAL *out)
+/*
+**		Scan a string (cp is at its quote). Returns the end of it,
+**		or zero if the data ends first. Then the next part goes on
+**		from where this one stopped (js->scanned).
+**
+***********************************************************************/
+{
+	JSON_STATE *js = scan->js;
+	REBYTE *bp;
+	REBYTE *dp;
+	REBFLG esc = js->esc;
+	REBFLG high = js->high;
+	REBSER *ser;
+	REBINT c;
+	REBINT c2;
+
+	for (bp = cp + (js->scanned ? js->scanned : 1); bp < end; bp++) {
+		if (*bp == '"') break;
+		if (*bp == '\\') {
+			esc = TRUE;
+			bp++;
+		}
+		else if (*bp < 0x20) JSON_Error(bp, end);
+		else if (*bp >= 0x80) high = TRUE;
+	}
+	if (bp >= end) {
+		if (scan->final) JSON_Error(cp, end);
+		js->scanned = bp - cp; // (past end after a backslash)
+		js->esc = esc;
+		js->high = high;
+		return 0;
+	}
+	js->scanned = 0;
+	js->esc = js->high = FALSE;
+
+	cp++;
+	if (!esc) {
+		if (high) ser = Append_UTF8(0, cp, bp - cp);
+		else ser = Copy_Bytes(cp, bp - cp);
+		Set_String(out, ser);
+		return bp + 1;
+	}
+
+	// Unescape to UTF-8 in the buffer (never longer):
+	RESET_TAIL(scan->buf);
+	EXPAND_SERIES_TAIL(scan->buf, bp - cp);
+	dp = BIN_HEAD(scan->buf);
+
+	while (cp < bp) {
+		if (*cp != '\\') {
+			*dp++ = *cp++;
+			continue;
+		}
+		cp++;
+		switch (*cp++) {
+		case '"':  *dp++ = '"'; break;
+		case '\\': *dp++ = '\\'; break;
+		case '/':  *dp++ = '/'; break;
+		case 'b':  *dp++ = 8; break;
+		case 'f':  *dp++ = 12; break;
+		case 'n':  *dp++ = LF; break;
+		case 'r':  *dp++ = CR; break;
+		case 't':  *dp++ = TAB; break;
+		case 'u':
+			if (bp - cp < 4 || (c = Scan_JSON_Hex4(cp)) < 0) JSON_Error(cp - 2, end);
+			cp += 4;
+			if (c >= 0xD800 && c <= 0xDFFF) {
+				// A surrogate pair is one char outside of 16 bits:
+				if (c < 0xDC00 && bp - cp >= 6 && cp[0] == '\\' && cp[1] == 'u'
+					&& (c2 = Scan_JSON_Hex4(cp + 2)) >= 0xDC00 && c2 <= 0xDFFF) cp += 6;
+				c = 0xFFFD; // (strings only hold 16 bit chars)
+			}
+			dp += Encode_UTF8_Char(dp, c);
+			break;
+		default:
+			JSON_Error(cp - 2, end);
+		}
+	}
+
+	Set_String(out, Append_UTF8(0, BIN_HEAD(scan->buf), dp - BIN_HEAD(scan->buf)));
+	return bp + 1;
+}
+
+
+/***********************************************************************
+**
+*/	static REBYTE *Scan_JSON_Number(JSON_SCAN *scan, REBYTE *cp, REBYTE *end, REBVAL *out)
+/*
+**		Returns the end of the number, or zero if the data ends
+**		before it does. Then the next part goes on from where this
+**		one stopped (js->scanned).
+**
+***********************************************************************/
+{
+	JSON_STATE *js = scan->js;
+	REBYTE *bp = cp;
+	REBYTE *ep;
+	REBFLG dec = FALSE;
+	REBU64 n = 0;
+	REBCNT digits = 0;
+	char *se;
+
+	// Find the end of it first, then check and convert it once:
+	for (ep = cp + js->scanned; ep < end && (IS_DIGIT(*ep) || *ep == '-' || *ep == '+'
+		|| *ep == '.' || *ep == 'e' || *ep == 'E'); ep++);
+	if (ep >= end && !scan->final) {
+		js->scanned = ep - cp;
+		return 0;
+	}
+	js->scanned = 0;
+
+	if (*bp == '-') bp++;
+	if (bp < ep && *bp == '0') bp++;
+	else if (bp < ep && IS_DIGIT(*bp)) {
+		for (; bp < ep && IS_DIGIT(*bp); bp++, digits++) n = n * 10 + (*bp - '0');
+	}
+	else JSON_Error(cp, end);
+
+	if (bp < ep && *bp == '.') {
+		dec = TRUE;
+		if (++bp >= ep || !IS_DIGIT(*bp)) JSON_Error(cp, end);
+		while (bp < ep && IS_DIGIT(*bp)) bp++;
+	}
+	if (bp < ep && (*bp == 'e' || *bp == 'E')) {
+		dec = TRUE;
+		if (++bp < ep && (*bp == '+' || *bp == '-')) bp++;
+		if (bp >= ep || !IS_DIGIT(*bp)) JSON_Error(cp, end);
+		while (bp < ep && IS_DIGIT(*bp)) bp++;
+	}
+	if (bp != ep) JSON_Error(cp, end); // (e.g. 01 or 1.2.3)
+
+	if (!dec && digits <= 18) {
+		SET_INTEGER(out, *cp == '-' ? -(REBI64)n : (REBI64)n);
+	}
+	else {
+		// Convert a terminated copy (the data may have no end mark):
+		RESET_TAIL(scan->buf);
+		Append_Bytes_Len(scan->buf, cp, bp - cp);
+		SET_DECIMAL(out, STRTOD((char *)BIN_HEAD(scan->buf), &se));
+		if (fabs(VAL_DECIMAL(out)) == HUGE_VAL) Trap0(RE_OVERFLOW);
+	}
+	return bp;
+}
+
+
+/***********************************************************************
+**
+*/	static void Emit_JSON(JSON_SCAN *scan, REBVAL *val)
+/*
+**		A value is done: add it to its container, or the events.
+**		The val is zero for the end of a container in the events.
+**
+***********************************************************************/
+{
+	JSON_STATE *js = scan->js;
+
+	if (scan->events) {
+		if (val) *Append_Value(scan->events) = *val;
+	}
+	else if (js->depth) *Append_Value(scan->open[js->depth - 1]) = *val;
+	else *scan->result = *val;
+
+	if (js->depth) js->expect = JX_NEXT;
+	else {
+		js->expect = JX_VALUE;
+		js->done++;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Emit_JSON_Event(JSON_SCAN *scan, REBCNT sym)
+/*
+***********************************************************************/
+{
+	Init_Word(Append_Value(scan->events), sym);
+}
+
+
+/***********************************************************************
+**
+*/	static REBYTE *Scan_JSON(JSON_SCAN *scan, REBYTE *cp, REBYTE *end)
+/*
+**		Scan as far as the data goes. Returns where it stopped: the
+**		end, or the start of a token that is not all there yet.
+**		For DECODE, stops after the top value.
+**
+***********************************************************************/
+{
+	JSON_STATE *js = scan->js;
+	REBYTE *bp;
+	REBYTE *word;
+	REBVAL val;
+	REBYTE c;
+
+	while (TRUE) {
+
+		while (cp < end && IS_JSON_SPACE(*cp)) cp++;
+		if (cp >= end || (!scan->events && js->done)) return cp;
+		c = *cp;
+
+		switch (js->expect) {
+
+		case JX_COLON:
+			if (c != ':') JSON_Error(cp, end);
+			cp++;
+			js->expect = JX_VALUE;
+			continue;
+
+		case JX_NEXT:
+			if (c == ',') {
+				cp++;
+				js->expect = (js->nest[js->depth - 1] == '{') ? JX_KEY : JX_VALUE;
+				continue;
+			}
+			break; // close
+
+		case JX_FIRST_KEY:
+			if (c == '}') break;
+		case JX_KEY:
+			if (c != '"') JSON_Error(cp, end);
+			bp = Scan_JSON_String(scan, cp, end, &val);
+			if (!bp) return cp;
+			cp = bp;
+			if (scan->events) Emit_JSON_Event(scan, SYM_KEY);
+			*Append_Value(scan->events ? scan->events : scan->open[js->depth - 1]) = val;
+			js->expect = JX_COLON;
+			continue;
+
+		case JX_FIRST:
+			if (c == ']') break;
+		case JX_VALUE:
+			switch (c) {
+			case '{':
+			case '[':
+				if (js->depth >= JSON_MAX_DEPTH) Trap0(RE_STACK_OVERFLOW);
+				if (scan->events) Emit_JSON_Event(scan, c == '{' ? SYM_OBJECT : SYM_ARRAY);
+				else scan->open[js->depth] = Make_Block(c == '{' ? 8 : 4);
+				js->nest[js->depth++] = c;
+				js->expect = (c == '{') ? JX_FIRST_KEY : JX_FIRST;
+				cp++;
+				continue;
+			case '"':
+				bp = Scan_JSON_String(scan, cp, end, &val);
+				break;
+			case 't':
+			case 'f':
+			case 'n':
+				word = (REBYTE*)((c == 't') ? "true" : (c == 'f') ? "false" : "null");
+				for (bp = cp; bp < end && *word && *bp == *word; bp++, word++);
+				if (*word) {
+					if (bp < end || scan->final) JSON_Error(cp, end);
+					bp = 0;
+				}
+				else if (c == 'n') SET_NONE(&val);
+				else SET_LOGIC(&val, c == 't');
+				break;
+			default:
+				if (c != '-' && !IS_DIGIT(c)) JSON_Error(cp, end);
+				bp = Scan_JSON_Number(scan, cp, end, &val);
+			}
+			if (!bp) return cp;
+			cp = bp;
+			Emit_JSON(scan, &val);
+			continue;
+		}
+
+		// Close of a container:
+		if (js->depth == 0 || c != (js->nest[js->depth - 1] == '{' ? '}' : ']'))
+			JSON_Error(cp, end);
+		cp++;
+		js->depth--;
+		if (scan->events) {
+			Emit_JSON_Event(scan, SYM_END);
+			Emit_JSON(scan, 0);
+		}
+		else {
+			if (c == '}') {
+				Block_As_Map(scan->open[js->depth]);
+				Set_Series(REB_MAP, &val, scan->open[js->depth]);
+			}
+			else Set_Block(&val, scan->open[js->depth]);
+			Emit_JSON(scan, &val);
+		}
+	}
+}
+
+
+/***********************************************************************
+**
+*/	void Decode_JSON(REBYTE *cp, REBCNT len, REBVAL *out)
+/*
+**		Decode a JSON text (UTF-8) to a value.
+**
+***********************************************************************/
+{
+	JSON_STATE js;
+	JSON_SCAN scan;
+	REBSER *open[JSON_MAX_DEPTH];
+	REBYTE *end = cp + len;
+
+	CLEAR(&js, sizeof(js));
+	CLEAR(&scan, sizeof(scan));
+	scan.js = &js;
+	scan.open = open;
+	scan.result = out;
+	scan.buf = Make_Binary(64);
+	scan.final = TRUE;
+
+	// Skip a UTF-8 BOM:
+	if (len >= 3 && cp[0] == 0xEF && cp[1] == 0xBB && cp[2] == 0xBF) cp += 3;
+
+	cp = Scan_JSON(&scan, cp, end);
+	while (cp < end && IS_JSON_SPACE(*cp)) cp++;
+	if (!js.done) Trap0(RE_PAST_END);
+	if (cp < end) JSON_Error(cp, end);
+}
+
+
+/***********************************************************************
+**
+*/	REBSER *Make_JSON_Stream(void)
+/*
+**		Make the state to scan JSON a part at a time. A block holds
+**		the JSON_STATE, the data of a token not all written yet, and
+**		the unescape buffer.
+**
+***********************************************************************/
+{
+	REBSER *stream = Make_Block(3);
+	REBSER *ser = Make_Binary(sizeof(JSON_STATE));
+
+	CLEAR(BIN_HEAD(ser), sizeof(JSON_STATE));
+	SERIES_TAIL(ser) = sizeof(JSON_STATE);
+	Set_Binary(Append_Value(stream), ser);
+	Set_Binary(Append_Value(stream), Make_Binary(64));
+	Set_Binary(Append_Value(stream), Make_Binary(64));
+
+	return stream;
+}
+
+
+/***********************************************************************
+**
+*/	void JSON_Stream(REBSER *stream, REBSER *events, REBYTE *data, REBCNT len, REBFLG end)
+/*
+**		Scan a part of the JSON data, adding its events to a block:
+**
+**			object, array	- start of an object or array
+**			end				- end of the last one started
+**			key "name"		- key of the next value in an object
+**
+**		and the values themselves (string, number, logic or none).
+**		Any number of values can follow at the top level (as in
+**		JSON Lines). End checks that the data was complete, and
+**		then the stream starts again.
+**
+***********************************************************************/
+{
+	JSON_SCAN scan;
+	REBSER *rest = VAL_SERIES(BLK_SKIP(stream, 1));
+	REBYTE *cp;
+
+	CLEAR(&scan, sizeof(scan));
+	scan.js = (JSON_STATE*)VAL_BIN(BLK_HEAD(stream));
+	scan.events = events;
+	scan.buf = VAL_SERIES(BLK_SKIP(stream, 2));
+	scan.final = end;
+
+	// Scan the data in place, unless a token was left over:
+	if (SERIES_TAIL(rest)) {
+		Append_Bytes_Len(rest, data, len);
+		data = BIN_HEAD(rest);
+		len = SERIES_TAIL(rest);
+	}
+
+	cp = Scan_JSON(&scan, data, data + len);
+
+	if (data == BIN_HEAD(rest)) Remove_Series(rest, 0, cp - data);
+	else if (cp < data + len) Append_Bytes_Len(rest, cp, data + len - cp);
+
+	if (end) {
+		RESET_TAIL(rest);
+		if (scan.js->depth || scan.js->expect != JX_VALUE) {
+			CLEAR(scan.js, sizeof(JSON_STATE));
+			Trap0(RE_PAST_END);
+		}
+		CLEAR(scan.js, sizeof(JSON_STATE));
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Encode_JSON_String(REBSER *out, void *str, REBCNT len, REBCNT wide)
+/*
+**		Wide is 2 for 16 bit chars, 1 for latin-1, or 0 for UTF-8.
+**
+***********************************************************************/
+{
+	REBYTE *bp = (REBYTE*)str;
+	REBUNI *up = (REBUNI*)str;
+	REBCNT tail = SERIES_TAIL(out);
+	REBYTE *dp;
+	REBCNT c, c2;
+	REBCNT n;
+
+	EXPAND_SERIES_TAIL(out, len * 6 + 2);
+	dp = BIN_SKIP(out, tail);
+
+	*dp++ = '"';
+	for (n = 0; n < len; n++) {
+		c = (wide == 2) ? up[n] : bp[n];
+		if (c >= 0x80 && wide) {
+			if (c >= 0xD800 && c <= 0xDBFF && n + 1 < len
+				&& (c2 = up[n + 1]) >= 0xDC00 && c2 <= 0xDFFF) {
+				c = 0x10000 + ((c - 0xD800) << 10) + (c2 - 0xDC00);
+				n++;
+			}
+			else if (c >= 0xD800 && c <= 0xDFFF) goto hex;
+			dp += Encode_UTF8_Char(dp, c);
+			continue;
+		}
+		if (c >= 0x20 && c != '"' && c != '\\') {
+			*dp++ = (REBYTE)c;
+			continue;
+		}
+		*dp++ = '\\';
+		switch (c) {
+		case '"':  *dp++ = '"'; continue;
+		case '\\': *dp++ = '\\'; continue;
+		case 8:    *dp++ = 'b'; continue;
+		case 12:   *dp++ = 'f'; continue;
+		case LF:   *dp++ = 'n'; continue;
+		case CR:   *dp++ = 'r'; continue;
+		case TAB:  *dp++ = 't'; continue;
+		}
+		dp--;
+hex:
+		*dp++ = '\\';
+		*dp++ = 'u';
+		dp = Form_Hex2(dp, c >> 8);
+		dp = Form_Hex2(dp, c & 0xff);
+	}
+	*dp++ = '"';
+
+	SERIES_TAIL(out) = dp - BIN_HEAD(out);
+}
+
+
+/***********************************************************************
+**
+*/	static void Encode_JSON_Key(REBSER *out, REBVAL *key)
+/*
+***********************************************************************/
+{
+	REBYTE *name;
+	REBSER *ser;
+
+	if (ANY_WORD(key)) {
+		name = Get_Word_Name(key);
+		Encode_JSON_String(out, name, LEN_BYTES(name), 0);
+	}
+	else if (ANY_STR(key)) {
+		if (VAL_BYTE_SIZE(key)) Encode_JSON_String(out, VAL_BIN_DATA(key), VAL_LEN(key), 1);
+		else Encode_JSON_String(out, VAL_UNI_DATA(key), VAL_LEN(key), 2);
+	}
+	else {
+		ser = Copy_Form_Value(key, 0);
+		Encode_JSON_String(out, ser->data, SERIES_TAIL(ser), BYTE_SIZE(ser) ? 1 : 2);
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Encode_JSON_Value(REBSER *out, REBVAL *val, REBCNT depth)
+/*
+***********************************************************************/
+{
+	REBYTE buf[60];
+	REBVAL *words;
+	REBVAL *vals;
+	REBCNT len;
+	REBCNT n;
+	REBUNI chr;
+	REBFLG first = TRUE;
+
+	if (depth > JSON_MAX_DEPTH) Trap0(RE_STACK_OVERFLOW);
+
+	switch (VAL_TYPE(val)) {
+
+	case REB_NONE:
+	case REB_UNSET:
+		Append_Bytes_Len(out, (REBYTE*)"null", 4);
+		break;
+
+	case REB_LOGIC:
+		if (VAL_LOGIC(val)) Append_Bytes_Len(out, (REBYTE*)"true", 4);
+		else Append_Bytes_Len(out, (REBYTE*)"false", 5);
+		break;
+
+	case REB_INTEGER:
+		len = Emit_Integer(buf, VAL_INT64(val));
+		Append_Bytes_Len(out, buf, len);
+		break;
+
+	case REB_DECIMAL:
+	case REB_PERCENT:
+		// JSON has no NaN or infinity:
+		if (VAL_DECIMAL(val) - VAL_DECIMAL(val) != 0) {
+			Append_Bytes_Len(out, (REBYTE*)"null", 4);
+			break;
+		}
+		len = Emit_Decimal(buf, VAL_DECIMAL(val), 0, '.', 17);
+		Append_Bytes_Len(out, buf, len);
+		break;
+
+	case REB_CHAR:
+		chr = VAL_CHAR(val);
+		Encode_JSON_String(out, &chr, 1, 2);
+		break;
+
+	case REB_BLOCK:
+	case REB_PAREN:
+		Append_Byte(out, '[');
+		for (vals = VAL_BLK_DATA(val); NOT_END(vals); vals++) {
+			if (!first) Append_Byte(out, ',');
+			first = FALSE;
+			Encode_JSON_Value(out, vals, depth + 1);
+		}
+		Append_Byte(out, ']');
+		break;
+
+	case REB_MAP:
+		Append_Byte(out, '{');
+		for (vals = VAL_BLK_DATA(val); NOT_END(vals) && NOT_END(vals+1); vals += 2) {
+			if (IS_NONE(vals+1)) continue; // removed
+			if (!first) Append_Byte(out, ',');
+			first = FALSE;
+			Encode_JSON_Key(out, vals);
+			Append_Byte(out, ':');
+			Encode_JSON_Value(out, vals+1, depth + 1);
+		}
+		Append_Byte(out, '}');
+		break;
+
+	case REB_OBJECT:
+	case REB_MODULE:
+	case REB_ERROR:
+	case REB_PORT:
+		Append_Byte(out, '{');
+		words = BLK_HEAD(VAL_OBJ_WORDS(val));
+		vals = VAL_OBJ_VALUES(val);
+		for (n = 1; n < SERIES_TAIL(VAL_OBJ_WORDS(val)); n++) {
+			if (VAL_GET_OPT(words+n, OPTS_HIDE)) continue;
+			if (!first) Append_Byte(out, ',');
+			first = FALSE;
+			Encode_JSON_Key(out, words+n);
+			Append_Byte(out, ':');
+			Encode_JSON_Value(out, vals+n, depth + 1);
+		}
+		Append_Byte(out, '}');
+		break;
+
+	default:
+		// Strings, words, and the rest formed:
+		Encode_JSON_Key(out, val);
+	}
+}
+
+
+/***********************************************************************
+**
+*/	REBSER *Encode_JSON(REBVAL *val)
+/*
+**		Encode a value as JSON text (UTF-8).
+**
+***********************************************************************/
+{
+	REBSER *out = Make_Binary(256);
+
+	Encode_JSON_Value(out, val, 0);
+	TERM_SERIES(out);
+	return out;
+}
+
+
+/***********************************************************************
+**
+*/	REBINT Codec_JSON(REBCDI *codi)
+/*
+**		JSON codec (.json), for LOAD, SAVE, DECODE and ENCODE.
+**
+***********************************************************************/
+{
+	REBSER *out;
+	REBINT n;
+
+	codi->error = 0;
+
+	if (codi->action == CODI_IDENTIFY) {
+		// An object or array:
+		for (n = 0; n < codi->len && IS_JSON_SPACE(codi->data[n]); n++);
+		if (n >= codi->len || (codi->data[n] != '{' && codi->data[n] != '['))
+			codi->error = CODI_ERR_SIGNATURE;
+		return CODI_CHECK; // error code is inverted result
+	}
+
+	if (codi->action == CODI_DECODE) {
+		Decode_JSON(codi->data, codi->len, (REBVAL*)codi->value);
+		return CODI_VALUE;
+	}
+
+	if (codi->action == CODI_ENCODE) {
+		out = Encode_JSON((REBVAL*)codi->value);
+		// Pass thru (copied by DO-CODEC):
+		codi->data = 0;
+		codi->other = BIN_HEAD(out);
+		codi->len = SERIES_TAIL(out);
+		return CODI_BINARY;
+	}
+
+	codi->error = CODI_ERR_NA;
+	return CODI_ERROR;
+}
@@ -991,9 +991,12 @@ post:
 			else {  // Success actions:
 				count = (begin > index) ? 0 : index - begin; // how much we advanced the input
 				if (GET_FLAG(flags, PF_COPY)) {
-					ser = (IS_BLOCK_INPUT(parse))
-						? Copy_Block_Len(series, begin, count)
-						: Copy_String(series, begin, count); // condenses
+					if (IS_BLOCK_INPUT(parse))
+						ser = Copy_Block_Len(series, begin, count);
+					// Larger binary parts share the data, until modified:
+					else if (parse->type != REB_BINARY || count < MIN_SLICE
+						|| !(ser = Make_Slice(series, begin, count)))
+						ser = Copy_String(series, begin, count); // condenses
 					Set_Var_Series(word, parse->type, ser, 0);
 				}
 				else if (GET_FLAG(flags, PF_SET_OR_COPY)) {
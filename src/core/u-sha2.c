@@ -0,0 +1,474 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  u-sha2.c
+**  Summary: SHA-2 secure hash (SHA-256, SHA-384, SHA-512, FIPS 180-4)
+**  Section: utility
+**  Notes:
+**		Has the same interface as u-sha1.c, for the digests table
+**		of CHECKSUM (n-strings.c). It is also the hash of the TLS 1.2
+**		PRF and Finished message.
+**
+**		On x86 CPUs with the SHA extensions (SHA-NI), SHA-256 blocks
+**		are hashed with them. SHA-384 is SHA-512 with other initial
+**		values, cut to 48 bytes.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+#define SHA256_BLOCK	64
+#define SHA256_LENGTH	32
+#define SHA512_BLOCK	128
+#define SHA512_LENGTH	64
+#define SHA384_LENGTH	48
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SHA_NI
+#include <cpuid.h>
+#include <immintrin.h>
+#define NI_FUNC static __attribute__((target("sha,sse4.1,ssse3")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define SHA_NI
+#include <intrin.h>
+#include <immintrin.h>
+#define NI_FUNC static
+#endif
+
+typedef struct {
+	u32 h[8];
+	u64 len;				// bytes hashed
+	REBYTE buf[SHA256_BLOCK];
+	REBCNT num;				// bytes in buf
+} SHA256_CTX;
+
+typedef struct {
+	u64 h[8];
+	u64 len;				// bytes hashed
+	REBYTE buf[SHA512_BLOCK];
+	REBCNT num;				// bytes in buf
+	REBCNT md_len;			// 64, or 48 for SHA-384
+} SHA512_CTX;
+
+static const u32 K256[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const u64 K512[80] = {
+	U64_C(0x428a2f98d728ae22), U64_C(0x7137449123ef65cd), U64_C(0xb5c0fbcfec4d3b2f), U64_C(0xe9b5dba58189dbbc),
+	U64_C(0x3956c25bf348b538), U64_C(0x59f111f1b605d019), U64_C(0x923f82a4af194f9b), U64_C(0xab1c5ed5da6d8118),
+	U64_C(0xd807aa98a3030242), U64_C(0x12835b0145706fbe), U64_C(0x243185be4ee4b28c), U64_C(0x550c7dc3d5ffb4e2),
+	U64_C(0x72be5d74f27b896f), U64_C(0x80deb1fe3b1696b1), U64_C(0x9bdc06a725c71235), U64_C(0xc19bf174cf692694),
+	U64_C(0xe49b69c19ef14ad2), U64_C(0xefbe4786384f25e3), U64_C(0x0fc19dc68b8cd5b5), U64_C(0x240ca1cc77ac9c65),
+	U64_C(0x2de92c6f592b0275), U64_C(0x4a7484aa6ea6e483), U64_C(0x5cb0a9dcbd41fbd4), U64_C(0x76f988da831153b5),
+	U64_C(0x983e5152ee66dfab), U64_C(0xa831c66d2db43210), U64_C(0xb00327c898fb213f), U64_C(0xbf597fc7beef0ee4),
+	U64_C(0xc6e00bf33da88fc2), U64_C(0xd5a79147930aa725), U64_C(0x06ca6351e003826f), U64_C(0x142929670a0e6e70),
+	U64_C(0x27b70a8546d22ffc), U64_C(0x2e1b21385c26c926), U64_C(0x4d2c6dfc5ac42aed), U64_C(0x53380d139d95b3df),
+	U64_C(0x650a73548baf63de), U64_C(0x766a0abb3c77b2a8), U64_C(0x81c2c92e47edaee6), U64_C(0x92722c851482353b),
+	U64_C(0xa2bfe8a14cf10364), U64_C(0xa81a664bbc423001), U64_C(0xc24b8b70d0f89791), U64_C(0xc76c51a30654be30),
+	U64_C(0xd192e819d6ef5218), U64_C(0xd69906245565a910), U64_C(0xf40e35855771202a), U64_C(0x106aa07032bbd1b8),
+	U64_C(0x19a4c116b8d2d0c8), U64_C(0x1e376c085141ab53), U64_C(0x2748774cdf8eeb99), U64_C(0x34b0bcb5e19b48a8),
+	U64_C(0x391c0cb3c5c95a63), U64_C(0x4ed8aa4ae3418acb), U64_C(0x5b9cca4f7763e373), U64_C(0x682e6ff3d6b2b8a3),
+	U64_C(0x748f82ee5defb2fc), U64_C(0x78a5636f43172f60), U64_C(0x84c87814a1f0ab72), U64_C(0x8cc702081a6439ec),
+	U64_C(0x90befffa23631e28), U64_C(0xa4506cebde82bde9), U64_C(0xbef9a3f7b2c67915), U64_C(0xc67178f2e372532b),
+	U64_C(0xca273eceea26619c), U64_C(0xd186b8c721c0c207), U64_C(0xeada7dd6cde0eb1e), U64_C(0xf57d4f7fee6ed178),
+	U64_C(0x06f067aa72176fba), U64_C(0x0a637dc5a2c898a6), U64_C(0x113f9804bef90dae), U64_C(0x1b710b35131c471b),
+	U64_C(0x28db77f523047d84), U64_C(0x32caab7b40c72493), U64_C(0x3c9ebe0a15c9bebc), U64_C(0x431d67c49c100d4c),
+	U64_C(0x4cc5d4becb3e42b6), U64_C(0x597f299cfc657e2a), U64_C(0x5fcb6fab3ad6faec), U64_C(0x6c44198c4a475817)
+};
+
+#define ROTR(x, n)	(((x) >> (n)) | ((x) << (32 - (n))))
+#define CH(x, y, z)	(((x) & (y)) ^ (~(x) & (z)))
+#define MAJ(x, y, z)	(((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define SIG0(x)		(ROTR(x, 2) ^ ROTR(x, 13) ^ ROTR(x, 22))
+#define SIG1(x)		(ROTR(x, 6) ^ ROTR(x, 11) ^ ROTR(x, 25))
+#define GAM0(x)		(ROTR(x, 7) ^ ROTR(x, 18) ^ ((x) >> 3))
+#define GAM1(x)		(ROTR(x, 17) ^ ROTR(x, 19) ^ ((x) >> 10))
+
+#define GET_BE32(p)	(((u32)(p)[0] << 24) | ((u32)(p)[1] << 16) | ((u32)(p)[2] << 8) | (u32)(p)[3])
+#define PUT_BE32(p, v)	((p)[0] = (REBYTE)((v) >> 24), (p)[1] = (REBYTE)((v) >> 16), \
+						(p)[2] = (REBYTE)((v) >> 8), (p)[3] = (REBYTE)(v))
+#define GET_BE64(p)	(((u64)GET_BE32(p) << 32) | GET_BE32((p) + 4))
+#define PUT_BE64(p, v)	(PUT_BE32(p, (u32)((v) >> 32)), PUT_BE32((p) + 4, (u32)(v)))
+
+#define ROTR64(x, n)	(((x) >> (n)) | ((x) << (64 - (n))))
+#define SIG0_64(x)	(ROTR64(x, 28) ^ ROTR64(x, 34) ^ ROTR64(x, 39))
+#define SIG1_64(x)	(ROTR64(x, 14) ^ ROTR64(x, 18) ^ ROTR64(x, 41))
+#define GAM0_64(x)	(ROTR64(x, 1) ^ ROTR64(x, 8) ^ ((x) >> 7))
+#define GAM1_64(x)	(ROTR64(x, 19) ^ ROTR64(x, 61) ^ ((x) >> 6))
+
+
+#ifdef SHA_NI
+
+/*
+**		Check for the SHA extensions, SSSE3 and SSE4.1
+**		(CPUID leaf 7 EBX, and leaf 1 ECX).
+*/
+static int Has_SHA_NI(void)
+{
+	unsigned int ebx7, ecx1;
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) return 0;
+	__cpuid(info, 1);
+	ecx1 = (unsigned int)info[2];
+	__cpuidex(info, 7, 0);
+	ebx7 = (unsigned int)info[1];
+#else
+	unsigned int eax, ebx, ecx, edx;
+	if (__get_cpuid_max(0, 0) < 7) return 0;
+	__cpuid(1, eax, ebx, ecx, edx);
+	ecx1 = ecx;
+	__cpuid_count(7, 0, eax, ebx, ecx, edx);
+	ebx7 = ebx;
+#endif
+	return (ebx7 & (1 << 29)) && (ecx1 & (1 << 9)) && (ecx1 & (1 << 19));
+}
+
+
+/*
+**		Hash whole 64 byte blocks with the SHA extensions. The state
+**		is kept as ABEF and CDGH, as the instructions need it.
+*/
+NI_FUNC void SHA256_Blocks_NI(SHA256_CTX *c, const REBYTE *data, REBCNT blocks)
+{
+	const __m128i swap = _mm_set_epi64x(U64_C(0x0c0d0e0f08090a0b), U64_C(0x0405060700010203));
+	__m128i state0, state1, abef, cdgh, msg, tmp;
+	__m128i w[4];
+	int i;
+
+	tmp = _mm_loadu_si128((const __m128i *)&c->h[0]);		// ABCD
+	state1 = _mm_loadu_si128((const __m128i *)&c->h[4]);	// EFGH
+	tmp = _mm_shuffle_epi32(tmp, 0xB1);						// CDAB
+	state1 = _mm_shuffle_epi32(state1, 0x1B);				// EFGH -> HGFE
+	state0 = _mm_alignr_epi8(tmp, state1, 8);				// ABEF
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);			// CDGH
+
+	for (; blocks > 0; blocks--, data += SHA256_BLOCK) {
+		abef = state0;
+		cdgh = state1;
+
+		for (i = 0; i < 4; i++)
+			w[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16 * i)), swap);
+
+		// Four rounds at a time, scheduling the words four ahead:
+		for (i = 0; i < 16; i++) {
+			msg = _mm_add_epi32(w[i & 3], _mm_loadu_si128((const __m128i *)&K256[4 * i]));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+			if (i < 12) {
+				tmp = _mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+				tmp = _mm_add_epi32(tmp, _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4));
+				w[i & 3] = _mm_sha256msg2_epu32(tmp, w[(i + 3) & 3]);
+			}
+		}
+
+		state0 = _mm_add_epi32(state0, abef);
+		state1 = _mm_add_epi32(state1, cdgh);
+	}
+
+	tmp = _mm_shuffle_epi32(state0, 0x1B);					// FEBA
+	state1 = _mm_shuffle_epi32(state1, 0xB1);				// DCHG
+	state0 = _mm_blend_epi16(tmp, state1, 0xF0);			// DCBA
+	state1 = _mm_alignr_epi8(state1, tmp, 8);				// HGFE
+	_mm_storeu_si128((__m128i *)&c->h[0], state0);
+	_mm_storeu_si128((__m128i *)&c->h[4], state1);
+}
+
+#endif
+
+
+/*
+**		Hash whole 64 byte blocks.
+*/
+static void SHA256_Blocks(SHA256_CTX *c, const REBYTE *data, REBCNT blocks)
+{
+	u32 w[64];
+	u32 a, b, d, e, f, g, h, t1, t2;
+	u32 cc;
+	int i;
+#ifdef SHA_NI
+	static int ni = -1;
+
+	if (ni < 0) ni = Has_SHA_NI();
+	if (ni) {
+		SHA256_Blocks_NI(c, data, blocks);
+		return;
+	}
+#endif
+
+	for (; blocks > 0; blocks--, data += SHA256_BLOCK) {
+		for (i = 0; i < 16; i++) w[i] = GET_BE32(data + 4 * i);
+		for (; i < 64; i++) w[i] = GAM1(w[i-2]) + w[i-7] + GAM0(w[i-15]) + w[i-16];
+
+		a = c->h[0]; b = c->h[1]; cc = c->h[2]; d = c->h[3];
+		e = c->h[4]; f = c->h[5]; g = c->h[6]; h = c->h[7];
+
+		for (i = 0; i < 64; i++) {
+			t1 = h + SIG1(e) + CH(e, f, g) + K256[i] + w[i];
+			t2 = SIG0(a) + MAJ(a, b, cc);
+			h = g; g = f; f = e; e = d + t1;
+			d = cc; cc = b; b = a; a = t1 + t2;
+		}
+
+		c->h[0] += a; c->h[1] += b; c->h[2] += cc; c->h[3] += d;
+		c->h[4] += e; c->h[5] += f; c->h[6] += g; c->h[7] += h;
+	}
+}
+
+
+void SHA256_Init(void *ctx)
+{
+	SHA256_CTX *c = ctx;
+
+	c->h[0] = 0x6a09e667; c->h[1] = 0xbb67ae85; c->h[2] = 0x3c6ef372; c->h[3] = 0xa54ff53a;
+	c->h[4] = 0x510e527f; c->h[5] = 0x9b05688c; c->h[6] = 0x1f83d9ab; c->h[7] = 0x5be0cd19;
+	c->len = 0;
+	c->num = 0;
+}
+
+
+void SHA256_Update(void *ctx, REBYTE *data, REBCNT len)
+{
+	SHA256_CTX *c = ctx;
+	REBCNT n;
+
+	c->len += len;
+
+	// Fill a partial block first:
+	if (c->num) {
+		n = MIN(len, SHA256_BLOCK - c->num);
+		memcpy(c->buf + c->num, data, n);
+		c->num += n;
+		data += n;
+		len -= n;
+		if (c->num < SHA256_BLOCK) return;
+		SHA256_Blocks(c, c->buf, 1);
+		c->num = 0;
+	}
+
+	// Then whole blocks directly from the data:
+	if (len >= SHA256_BLOCK) {
+		n = len / SHA256_BLOCK;
+		SHA256_Blocks(c, data, n);
+		data += n * SHA256_BLOCK;
+		len -= n * SHA256_BLOCK;
+	}
+
+	if (len) {
+		memcpy(c->buf, data, len);
+		c->num = len;
+	}
+}
+
+
+void SHA256_Final(REBYTE *md, void *ctx)
+{
+	SHA256_CTX *c = ctx;
+	u64 bits = c->len << 3;
+	int i;
+
+	c->buf[c->num++] = 0x80;
+	if (c->num > SHA256_BLOCK - 8) {
+		memset(c->buf + c->num, 0, SHA256_BLOCK - c->num);
+		SHA256_Blocks(c, c->buf, 1);
+		c->num = 0;
+	}
+	memset(c->buf + c->num, 0, SHA256_BLOCK - 8 - c->num);
+	PUT_BE32(c->buf + 56, (u32)(bits >> 32));
+	PUT_BE32(c->buf + 60, (u32)bits);
+	SHA256_Blocks(c, c->buf, 1);
+
+	for (i = 0; i < 8; i++) PUT_BE32(md + 4 * i, c->h[i]);
+	memset(c, 0, sizeof(*c));
+}
+
+
+int SHA256_CtxSize(void)
+{
+	return sizeof(SHA256_CTX);
+}
+
+
+REBYTE *SHA256(REBYTE *data, REBCNT len, REBYTE *md)
+{
+	SHA256_CTX c;
+	static REBYTE m[SHA256_LENGTH];
+
+	if (md == NULL) md = m;
+	SHA256_Init(&c);
+	SHA256_Update(&c, data, len);
+	SHA256_Final(md, &c);
+	return md;
+}
+
+
+/*
+**		Hash whole 128 byte blocks.
+*/
+static void SHA512_Blocks(SHA512_CTX *c, const REBYTE *data, REBCNT blocks)
+{
+	u64 w[80];
+	u64 a, b, d, e, f, g, h, t1, t2;
+	u64 cc;
+	int i;
+
+	for (; blocks > 0; blocks--, data += SHA512_BLOCK) {
+		for (i = 0; i < 16; i++) w[i] = GET_BE64(data + 8 * i);
+		for (; i < 80; i++) w[i] = GAM1_64(w[i-2]) + w[i-7] + GAM0_64(w[i-15]) + w[i-16];
+
+		a = c->h[0]; b = c->h[1]; cc = c->h[2]; d = c->h[3];
+		e = c->h[4]; f = c->h[5]; g = c->h[6]; h = c->h[7];
+
+		for (i = 0; i < 80; i++) {
+			t1 = h + SIG1_64(e) + CH(e, f, g) + K512[i] + w[i];
+			t2 = SIG0_64(a) + MAJ(a, b, cc);
+			h = g; g = f; f = e; e = d + t1;
+			d = cc; cc = b; b = a; a = t1 + t2;
+		}
+
+		c->h[0] += a; c->h[1] += b; c->h[2] += cc; c->h[3] += d;
+		c->h[4] += e; c->h[5] += f; c->h[6] += g; c->h[7] += h;
+	}
+}
+
+
+void SHA512_Init(void *ctx)
+{
+	SHA512_CTX *c = ctx;
+
+	c->h[0] = U64_C(0x6a09e667f3bcc908); c->h[1] = U64_C(0xbb67ae8584caa73b);
+	c->h[2] = U64_C(0x3c6ef372fe94f82b); c->h[3] = U64_C(0xa54ff53a5f1d36f1);
+	c->h[4] = U64_C(0x510e527fade682d1); c->h[5] = U64_C(0x9b05688c2b3e6c1f);
+	c->h[6] = U64_C(0x1f83d9abfb41bd6b); c->h[7] = U64_C(0x5be0cd19137e2179);
+	c->len = 0;
+	c->num = 0;
+	c->md_len = SHA512_LENGTH;
+}
+
+
+void SHA384_Init(void *ctx)
+{
+	SHA512_CTX *c = ctx;
+
+	c->h[0] = U64_C(0xcbbb9d5dc1059ed8); c->h[1] = U64_C(0x629a292a367cd507);
+	c->h[2] = U64_C(0x9159015a3070dd17); c->h[3] = U64_C(0x152fecd8f70e5939);
+	c->h[4] = U64_C(0x67332667ffc00b31); c->h[5] = U64_C(0x8eb44a8768581511);
+	c->h[6] = U64_C(0xdb0c2e0d64f98fa7); c->h[7] = U64_C(0x47b5481dbefa4fa4);
+	c->len = 0;
+	c->num = 0;
+	c->md_len = SHA384_LENGTH;
+}
+
+
+void SHA512_Update(void *ctx, REBYTE *data, REBCNT len)
+{
+	SHA512_CTX *c = ctx;
+	REBCNT n;
+
+	c->len += len;
+
+	if (c->num) {
+		n = MIN(len, SHA512_BLOCK - c->num);
+		memcpy(c->buf + c->num, data, n);
+		c->num += n;
+		data += n;
+		len -= n;
+		if (c->num < SHA512_BLOCK) return;
+		SHA512_Blocks(c, c->buf, 1);
+		c->num = 0;
+	}
+
+	if (len >= SHA512_BLOCK) {
+		n = len / SHA512_BLOCK;
+		SHA512_Blocks(c, data, n);
+		data += n * SHA512_BLOCK;
+		len -= n * SHA512_BLOCK;
+	}
+
+	if (len) {
+		memcpy(c->buf, data, len);
+		c->num = len;
+	}
+}
+
+
+void SHA512_Final(REBYTE *md, void *ctx)
+{
+	SHA512_CTX *c = ctx;
+	u64 bits = c->len << 3;
+	REBCNT i;
+
+	// The length is 128 bits; the top ones are from the byte count:
+	c->buf[c->num++] = 0x80;
+	if (c->num > SHA512_BLOCK - 16) {
+		memset(c->buf + c->num, 0, SHA512_BLOCK - c->num);
+		SHA512_Blocks(c, c->buf, 1);
+		c->num = 0;
+	}
+	memset(c->buf + c->num, 0, SHA512_BLOCK - 16 - c->num);
+	PUT_BE64(c->buf + 112, c->len >> 61);
+	PUT_BE64(c->buf + 120, bits);
+	SHA512_Blocks(c, c->buf, 1);
+
+	for (i = 0; i < c->md_len / 8; i++) PUT_BE64(md + 8 * i, c->h[i]);
+	memset(c, 0, sizeof(*c));
+}
+
+
+int SHA512_CtxSize(void)
+{
+	return sizeof(SHA512_CTX);
+}
+
+
+REBYTE *SHA512(REBYTE *data, REBCNT len, REBYTE *md)
+{
+	SHA512_CTX c;
+	static REBYTE m[SHA512_LENGTH];
+
+	if (md == NULL) md = m;
+	SHA512_Init(&c);
+	SHA512_Update(&c, data, len);
+	SHA512_Final(md, &c);
+	return md;
+}
+
+
+REBYTE *SHA384(REBYTE *data, REBCNT len, REBYTE *md)
+{
+	SHA512_CTX c;
+	static REBYTE m[SHA384_LENGTH];
+
+	if (md == NULL) md = m;
+	SHA384_Init(&c);
+	SHA512_Update(&c, data, len);
+	SHA512_Final(md, &c);
+	return md;
+}
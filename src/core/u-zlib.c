@@ -55,6 +55,17 @@ uLong ZEXPORT adler32(adler, buf, len)
 	return adler32(1L, buf, len);
 }
 
+/***********************************************************************
+**
+*/	unsigned long Update_ADLER32(unsigned long adler, const char *buf, unsigned int len)
+/*
+**		Continue an Adler-32 (start with 1).
+**
+***********************************************************************/
+{
+	return adler32(adler, buf, len);
+}
+
 uLong crc32(uLong num, const Bytef *buf, uInt len)
 {
 #ifndef CRC_DEFINED
@@ -354,6 +365,48 @@ int ZEXPORT deflateInit2_(strm, level, method, windowBits, memLevel, strategy,
     return deflateReset(strm);
 }
 
+/* ========================================================================= */
+int ZEXPORT deflateSetDictionary (strm, dictionary, dictLength)
+    z_streamp strm;
+    const Bytef *dictionary;
+    uInt  dictLength;
+{
+    deflate_state *s;
+    uInt length = dictLength;
+    uInt n;
+    IPos hash_head = 0;
+
+    if (strm == Z_NULL || strm->state == Z_NULL || dictionary == Z_NULL)
+        return Z_STREAM_ERROR;
+
+    s = strm->state;
+    /* A raw (noheader) stream can also be primed, before any input: */
+    if ((!s->noheader && s->status != INIT_STATE) ||
+        s->strstart != 0 || s->lookahead != 0) return Z_STREAM_ERROR;
+
+    strm->adler = adler32(strm->adler, dictionary, dictLength);
+
+    if (length < MIN_MATCH) return Z_OK;
+    if (length > MAX_DIST(s)) {
+        length = MAX_DIST(s);
+        dictionary += dictLength - length; /* use the tail of the dictionary */
+    }
+    zmemcpy(s->window, dictionary, length);
+    s->strstart = length;
+    s->block_start = (long)length;
+
+    /* Insert all strings in the hash table (except for the last two bytes).
+     * s->lookahead stays null, so s->ins_h will be recomputed at the next
+     * call of fill_window.
+     */
+    s->ins_h = s->window[0];
+    UPDATE_HASH(s, s->ins_h, s->window[1]);
+    for (n = 0; n <= length - MIN_MATCH; n++) {
+        INSERT_STRING(s, n, hash_head);
+    }
+    if (hash_head) hash_head = 0;  /* to make compiler happy */
+    return Z_OK;
+}
 
 /* ========================================================================= */
 int ZEXPORT deflateReset (strm)
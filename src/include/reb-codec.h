@@ -45,6 +45,14 @@
 // the REBNATIVE(do_codec) in n-system.c
 // so the deallocation is left to GC
 //
+// If your codec routine returns CODI_VALUE, it has already stored
+// its result in the ->value field (the REBVAL* to return). On
+// encode, ->value is also the REBVAL* of the data argument, for
+// codecs that take other datatypes.
+//
+// The ->options field is the REBVAL* of an object of codec options
+// given by DO-CODEC/options, or zero.
+//
 typedef struct reb_codec_image {
 	int action;
 	int w;
@@ -57,6 +65,8 @@ typedef struct reb_codec_image {
 		void *other;
 	};
 	int error;
+	void *value;
+	void *options;
 } REBCDI;
 
 typedef REBINT (*codo)(REBCDI *cdi);
@@ -70,6 +80,7 @@ enum {
 	CODI_IMAGE,
 	CODI_SOUND,
 	CODI_BLOCK,
+	CODI_VALUE,
 };
 
 // Codec commands:
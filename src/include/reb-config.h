@@ -246,6 +246,10 @@ These are now obsolete (as of A107) and should be removed:
 #ifdef TO_LINUX
 #define HAS_POSIX_SIGNAL
 #define HAS_MSG_NOSIGNAL
+#define HAS_SENDFILE
+#define HAS_IPV6
+#define HAS_ACCEPT4
+#define HAS_POSIX_SPAWN
 #endif
 
 //* Defaults ***********************************************************
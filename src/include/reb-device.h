@@ -45,6 +45,9 @@ enum {
 	RDI_SERIAL,
 #ifdef HAS_POSIX_SIGNAL
 	RDI_SIGNAL,
+#endif
+#ifdef HAS_POSIX_SPAWN
+	RDI_PROCESS,
 #endif
 	RDI_MAX,
 	RDI_LIMIT = 32
@@ -102,6 +105,7 @@ enum {
 	RRF_ALLOC,		// Request is allocated, not a temp on stack
 	RRF_WIDE,		// Wide char IO
 	RRF_ACTIVE,		// Port is active, even no new events yet
+	RRF_WATCH,		// Waiting for OS to report handle ready (not polled)
 };
 
 // REBOL Device Errors:
@@ -130,6 +134,14 @@ enum {
 	SERIAL_FLOW_CONTROL_SOFTWARE
 };
 
+// Process Modes (bitnums):
+enum {
+	RPM_SHELL,			// argv[0] is a command line for the shell
+	RPM_CAPTURE_ERROR,	// stderr is a pipe (else it is inherited)
+	RPM_FROM_ERROR,		// data of the last read came from stderr
+	RPM_EXITED,			// process is done, exit_code is set
+};
+
 #pragma pack(4)
 
 // Forward references:
@@ -205,6 +217,10 @@ struct rebol_devreq {
 			u32  remote_ip;			// remote address
 			u32  remote_port;		// remote port
 			void *host_info;		// for DNS usage
+			u8   remote_ip6[16];		// IPv6 remote address (RSM_IPV6)
+			u8   local_ip6[16];			// IPv6 local address (RSM_IPV6)
+			int  alt_socket;		// IPv6 connect attempt (RSM_RACE)
+			u32  options;			// RSO_ flags (set by MODIFY)
 		} net;
 		struct {
 			REBCHR *path;			//device path string (in OS local format)
@@ -216,6 +232,14 @@ struct rebol_devreq {
 			u8	flow_control;		// hardware or software
 
 		} serial;
+		struct {
+			REBCHR **argv;			// program and arguments (for open)
+			int  pid;				// process id
+			int  pidfd;				// readable when process exits (or -1)
+			int  in;				// stdin pipe, write end (or -1)
+			int  err;				// stderr pipe, read end (or -1)
+			int  exit_code;			// set when RPM_EXITED
+		} process;
 	};
 };
 #pragma pack()
@@ -37,6 +37,10 @@ enum {
 	RFM_TRUNCATE,
 	RFM_RESEEK,			// file index has moved, reseek
 	RFM_NAME_MEM,		// converted name allocated in mem
+	RFM_SYNC,			// flush written data to the disk (MODIFY)
+	RFM_SEQUENTIAL,		// file is used in order (MODIFY, a cache hint)
+	RFM_DEEP,			// dir read also gets size and date (READ/DEEP)
+	RFM_AWAKE,			// READ or WRITE ends with an event (port has AWAKE)
 	RFM_DIR = 16,
 };
 
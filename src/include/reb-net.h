@@ -31,8 +31,17 @@ enum socket_types {
 	RST_UDP,					// TCP or UDP
 	RST_LISTEN = 8,				// LISTEN
 	RST_REVERSE,				// DNS reverse
+	RST_GATHER,					// write data is a list of REBIOV segments
 };
 
+// A segment of a gathered write (block of values):
+typedef struct rebol_net_iov {
+	REBYTE *data;				// bytes to send, or zero for a file
+	u32  length;				// bytes in segment (for this write)
+	int  file;					// file handle (when no data)
+	i64  index;					// file position
+} REBIOV;
+
 // REBOL Socket Modes (state flags)
 enum {
 	RSM_OPEN = 0,				// socket is allocated
@@ -43,6 +52,18 @@ enum {
 	RSM_SEND,					// sending
 	RSM_RECEIVE,				// receiving
 	RSM_ACCEPT,					// an inbound connection
+	RSM_LOOKUP,					// host lookup is running (not HAS_ASYNC_DNS)
+	RSM_IPV6,					// addresses are the IPv6 ones (remote_ip6)
+	RSM_RACE,					// connecting both IPv6 and IPv4 at once
+};
+
+// REBOL Socket Options (set by MODIFY, see Set_Options)
+enum {
+	RSO_NO_DELAY = 0,			// send small writes at once (TCP_NODELAY)
+	RSO_KEEP_ALIVE,				// probe idle connections (SO_KEEPALIVE)
+	RSO_FAST_OPEN,				// accept data with SYN (TCP_FASTOPEN, listen)
+	RSO_REUSE_PORT,				// share the port with others (SO_REUSEPORT, listen)
+	RSO_MAX
 };
 
 #define IPA(a,b,c,d) (a<<24 | b<<16 | c<<8 | d)
@@ -44,10 +44,13 @@
 #define	MAX_NUM_LEN 64			// As many numeric digits we will accept on input
 #define MAX_SAFE_SERIES 5		// quanitity of most recent series to not GC.
 #define MAX_EXPAND_LIST 5		// number of series-1 in Prior_Expand list
+#define MIN_SLICE 256			// min binary COPY/part that shares data (see Make_Slice)
 #define USE_UNICODE 1			// scanner uses unicode
 #define UNICODE_CASES 0x2E00	// size of unicode folding table
 #define HAS_SHA1				// allow it
 #define HAS_MD5					// allow it
+#define HAS_SHA256				// allow it
+#define HAS_SHA512				// allow it (and SHA384)
 
 // External system includes:
 #include <stdlib.h>
@@ -95,6 +98,16 @@ typedef struct rebol_port_action_map {
 	const REBPAF func;
 } PORT_ACTION;
 
+//-- Stream ports, that transform what is written (see Do_Stream_Port):
+typedef struct rebol_stream_port {
+	void (*make)(REBSER *port, REBVAL *state);	// state from the port spec
+	void (*transform)(REBSER *state, REBSER *out, REBYTE *data, REBCNT len, REBFLG end);
+	void (*write)(REBSER *state, REBSER *out, REBVAL *blk);	// WRITE of a block (or zero)
+	void (*read)(REBSER *port, REBVAL *state, REBVAL *out); // READ result (or zero)
+	REBI64 (*length)(REBVAL *state);	// LENGTH? (or zero for the output)
+	REBCNT output;		// port/data type: REB_BINARY, REB_BLOCK (or zero)
+} STREAM_PORT;
+
 typedef struct rebol_mold {
 	REBSER *series;		// destination series (uni)
 	REBCNT opts;		// special option flags
@@ -57,6 +57,7 @@ typedef long __LONG;
 #include <netdb.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <unistd.h>
 
 #define GET_ERROR		errno
@@ -92,5 +93,9 @@ typedef struct hostent HOSTENT;
 typedef struct sockaddr_in SOCKAI; // Internet extensions
 
 #define BAD_SOCKET (~0)
-#define MAX_TRANSFER 32000		// Max send/recv buffer size
+#define MAX_TRANSFER 0x100000	// Max send/recv per system call (1 MB)
+#define MAX_DATAGRAM 32000		// Max UDP send per datagram (under 64 KB)
+#define MAX_GATHER 64			// Max segments per gathered send
 #define MAX_HOST_NAME 256		// Max length of host name
+#define MAX_ACCEPTS 64			// Max connections accepted per poll
+#define FAST_OPEN_QUEUE 64		// Max pending TCP fast open requests
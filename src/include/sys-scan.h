@@ -197,6 +197,7 @@ typedef struct rebol_scan_state {
 	REBYTE *head_line;		// head of current line (used for errors)
 	REBCNT opts;
 	REBCNT errors;
+	REBOOL incomplete;		// input ended inside a value (SCAN_PARTIAL)
 } SCAN_STATE;
 
 #define ACCEPT_TOKEN(s) ((s)->begin = (s)->end)
@@ -207,8 +208,11 @@ enum {
 	SCAN_NEXT,	// load/next feature
 	SCAN_ONLY,  // only single value (no blocks)
 	SCAN_RELAX,	// no error throw
+	SCAN_PARTIAL, // stop before a value cut off by end of input
 };
 
+#define SCAN_INCOMPLETE(s) (GET_FLAG((s)->opts, SCAN_PARTIAL) && (s)->incomplete)
+
 /*
 **  Externally Accessed Variables
 */
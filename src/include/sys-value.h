@@ -328,7 +328,7 @@ typedef struct Reb_Tuple {
 #endif
 	union {
 		REBCNT size;	// used for vectors and bitsets
-		REBSER *series;	// MAP datatype uses this
+		REBSER *series;	// MAP datatype uses this, also shared data (see Make_Slice)
 		struct {
 			REBCNT wide:16;
 			REBCNT high:16;
@@ -429,6 +429,12 @@ enum {
 
 #define TRAP_PROTECT(s) if (IS_PROTECT_SERIES(s)) Trap0(RE_PROTECTED)
 
+// Binary data shared by slices is held by a linked series:
+#define SERIES_LINK(s)    ((s)->series)
+#define IS_SHARED_SERIES(s) (IS_EXT_SERIES(s) && SERIES_LINK(s))
+// A holder linked to itself holds a file mapping (see Make_Mapped_Binary):
+#define IS_MAPPED_SERIES(s) (IS_EXT_SERIES(s) && SERIES_LINK(s) == (s))
+
 #ifdef SERIES_LABELS
 #define LABEL_SERIES(s,l) s->label = (l)
 #else
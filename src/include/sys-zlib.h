@@ -657,9 +657,9 @@ extern int ZEXPORT deflateInit2 OF((z_streamp strm,
    not perform any compression: this will be done by deflate().
 */
                             
-/* extern int ZEXPORT deflateSetDictionary OF((z_streamp strm, */
-/*                                             const Bytef *dictionary, */
-/*                                             uInt  dictLength)); */
+extern int ZEXPORT deflateSetDictionary OF((z_streamp strm,
+                                             const Bytef *dictionary,
+                                             uInt  dictLength));
 /*
      Initializes the compression dictionary from the given byte sequence
    without producing any compressed output. This function must be called
@@ -986,7 +986,7 @@ extern uLong ZEXPORT adler32 OF((uLong adler, const Bytef *buf, uInt len));
      }
      if (adler != original_adler) error();
 */
-/* extern uLong ZEXPORT crc32   OF((uLong crc, const Bytef *buf, uInt len)); */
+extern uLong ZEXPORT crc32   OF((uLong crc, const Bytef *buf, uInt len));
 /*
      Update a running crc with the bytes buf[0..len-1] and return the updated
    crc. If buf is NULL, this function returns the required initial value
@@ -64,6 +64,9 @@ foreach [codec handler] system/codecs [
 				gif  [%.gif]
 				jpeg [%.jpg %.jpeg]
 				png  [%.png]
+				gzip [%.gz]
+				json [%.json]
+				csv  [%.csv]
 			] codec
 		]
 		; Media-types block format: [.abc .def type ...]
@@ -111,7 +111,7 @@ array: func [
 
 replace: func [
 	"Replaces a search value with the replace value within the target series."
-	target  [series!] "Series to replace within (modified)"
+	target  [series! port!] "Series (or rope port) to replace within (modified)"
 	search  "Value to be replaced (converted if necessary)"
 	replace "Value to replace with (called each time if a function)"
 	/all "Replace all occurrences"  ;!!! Note ALL is redefined in here!
@@ -136,8 +136,29 @@ replace: func [
 		any-block? :search [length? :search]
 		true  1
 	]
+	; Replace all in a single pass natively, unless the replace value is a function
+	if lib/all [
+		all not bitset? :search not any-function? :replace
+		any [any-string? target binary? target any-block? target]
+	][
+		return apply :replace-all [target :search :replace case tail]
+	]
 	; /all and /case checked before the while, /tail after
 	do-break: unless all [:break] ; Will be none if not /all, a noop
+	; A port (rope://) finds and changes at its own position:
+	if port? target [
+		if any [not any-string? :search tag? :search] [search: form :search]
+		len: length? search
+		save-target: index? target
+		while pick [
+			[find target search]
+			[find/case target search]
+		] not case [
+			change/part target either any-function? :replace [replace target] [:replace] len
+			do-break
+		]
+		return either tail [target] [at head target save-target]
+	]
 	while pick [
 		[pos: find target :search]
 		[pos: find/case target :search]
@@ -11,7 +11,7 @@ REBOL [
 	}
 	Name: 'http
 	Type: 'module
-	Version: 0.1.4
+	Version: 0.1.5
 	File: %prot-http.r
 	Purpose: {
 		This program defines the HTTP protocol scheme for REBOL 3.
@@ -40,7 +40,9 @@ sync-op: func [port body /local state] [
 read-sync-awake: func [event [event!] /local error] [
 	switch/default event/type [
 		connect ready [
-			do-request event/port
+			; a connection from the pool is ready at open, and SYNC-OP
+			; has sent the request before its connect event
+			if event/port/state/state = 'ready [do-request event/port]
 			false
 		]
 		done [
@@ -67,20 +69,64 @@ http-awake: func [event /local port http-port state awake res] [
 	switch/default event/type [
 		read [
 			awake make event! [type: 'read port: http-port]
-			check-response http-port
+			res: check-response http-port
+			; the data may hold the responses to pipelined requests
+			while [
+				all [
+					state: http-port/state
+					state/state = 'ready
+					not empty? state/queue
+				]
+			] [
+				next-response http-port
+				either empty? any [port/data #{}] [read port] [res: check-response http-port]
+			]
+			res
 		]
 		wrote [
-			awake make event! [type: 'wrote port: http-port]
-			state/state: 'reading-headers
-			read port
+			; send the requests pipelined while writing
+			either empty? state/unsent [
+				state/writing?: no
+			] [
+				write port take/part state/unsent length? state/unsent
+			]
+			if state/state = 'doing-request [
+				awake make event! [type: 'wrote port: http-port]
+				state/state: 'reading-headers
+				read port
+			]
 			false
 		]
 		lookup [open port false]
 		connect [
 			state/state: 'ready
-			awake make event! [type: 'connect port: http-port]
+			either state/retry? [
+				state/retry?: no
+				do-request http-port
+				foreach request state/queue [send-request http-port request/5]
+				false
+			] [
+				awake make event! [type: 'connect port: http-port]
+			]
 		]
 		close [
+			if all [
+				find [doing-request reading-headers] state/state
+				state/reused?
+				empty? any [port/data #{}]
+			] [
+				; a kept connection closed by the server before the response,
+				; send the request again on a new one
+				close port
+				port/awake: none
+				http-pool/stats/retries: http-pool/stats/retries + 1
+				state/retry?: yes
+				state/writing?: no
+				clear state/unsent
+				state/sent: 0
+				open-connection http-port
+				return false
+			]
 			res: switch state/state [
 				ready [
 					awake make event! [type: 'close port: http-port]
@@ -136,7 +182,7 @@ make-http-request: func [
 	result: rejoin [
 		uppercase form method #" "
 		either file? target [next mold target] [target]
-		" HTTP/1.0" CRLF
+		" HTTP/1.1" CRLF
 	]
 	foreach [word string] headers [
 		repend result [mold word #" " string CRLF]
@@ -150,13 +196,12 @@ make-http-request: func [
 	if content [append result content]
 	result
 ]
-do-request: func [
-	"Perform an HTTP request"
+request-data: func [
+	"Make the HTTP request of the port spec (returns binary!)"
 	port [port!]
-	/local spec info
+	/local spec
 ] [
 	spec: port/spec
-	info: port/state/info
 	spec/headers: body-of make make object! [
 		Accept: "*/*"
 		Accept-Charset: "utf-8"
@@ -167,13 +212,85 @@ do-request: func [
 		]
 		User-Agent: "REBOL"
 	] spec/headers
-	port/state/state: 'doing-request
-	info/headers: info/response-line: info/response-parsed: port/data:
-	info/size: info/date: info/name: none
-	write port/state/connection
 	make-http-request spec/method to file! any [spec/path %/]
 	spec/headers spec/content
 ]
+send-request: func [
+	"Write a request to the connection, after the ones being written"
+	port [port!]
+	data [binary!]
+	/local state stats
+] [
+	state: port/state
+	stats: http-pool/stats
+	stats/requests: stats/requests + 1
+	if state/sent > 0 [stats/reused: stats/reused + 1]
+	state/sent: state/sent + 1
+	either state/writing? [
+		append state/unsent data
+	] [
+		state/writing?: yes
+		write state/connection data
+	]
+]
+do-request: func [
+	"Perform an HTTP request"
+	port [port!]
+	/local spec state info
+] [
+	spec: port/spec
+	state: port/state
+	info: state/info
+	state/state: 'doing-request
+	info/headers: info/response-line: info/response-parsed: port/data:
+	info/size: info/date: info/name: none
+	; a request on a kept connection is sent again if the server closed it
+	state/reused?: state/sent > 0
+	send-request port request-data port
+	state/request: reduce [spec/method spec/path spec/headers spec/content]
+]
+pipeline-request: func [
+	"Send a request on a keep-alive connection before the previous ones are answered"
+	port [port!]
+	/local spec state data
+] [
+	spec: port/spec
+	state: port/state
+	unless all [
+		state/keep-alive?
+		find [ready doing-request reading-headers reading-data] state/state
+		find [get head] spec/method
+	] [http-error "Port not ready"]
+	send-request port data: request-data port
+	append/only state/queue reduce [spec/method spec/path spec/headers spec/content data]
+	; the spec is the one of the response being read
+	set-request port state/request
+]
+set-request: func [
+	"Set the port spec to a request (method, path, headers, content)"
+	port [port!]
+	request [block!]
+	/local spec
+] [
+	spec: port/spec
+	spec/method: request/1
+	spec/path: request/2
+	spec/headers: request/3
+	spec/content: request/4
+]
+next-response: func [
+	"Start reading the response to the next pipelined request"
+	port [port!]
+	/local state info
+] [
+	state: port/state
+	info: state/info
+	state/request: take state/queue
+	set-request port state/request
+	info/headers: info/response-line: info/response-parsed: port/data:
+	info/size: info/date: info/name: none
+	state/state: 'reading-headers
+]
 parse-write-dialect: func [port block /local spec] [
 	spec: port/spec
 	parse block [[set block word! (spec/method: block) | (spec/method: 'post)]
@@ -198,6 +315,19 @@ check-response: func [port /local conn res headers d1 d2 line info state awake s
 		info/name: to file! any [spec/path %/]
 		if headers/content-length [info/size: headers/content-length: to integer! headers/content-length]
 		if headers/last-modified [info/date: attempt [to date! headers/last-modified]]
+		; the connection can take another request when the end of the body is known
+		state/keep-alive?: to logic! all [
+			any [
+				integer? headers/content-length
+				headers/transfer-encoding = "chunked"
+				spec/method = 'head
+			]
+			either find/match line "HTTP/1.0" [
+				"keep-alive" = headers/connection
+			] [
+				"close" <> headers/connection
+			]
+		]
 		remove/part conn/data d2
 		state/state: 'reading-data
 	]
@@ -333,7 +463,108 @@ crlf2: to string! crlf2bin
 http-response-headers: context [
 	Content-Length:
 	Transfer-Encoding:
-	Last-Modified: none
+	Last-Modified:
+	Connection:
+	Keep-Alive: none
+]
+digits: charset "0123456789"
+
+; Idle keep-alive connections, taken by the ports opened later on the
+; same scheme, host and port. The stats give the reuse rate of the
+; connections: reused / requests.
+http-pool: context [
+	connections: make block! 16	; [key connection expires ...], most recent first
+	max-idle: 8					; idle connections kept per host
+	timeout: 0:00:15			; idle time before a connection is closed
+	stats: context [
+		requests:	; requests sent
+		connects:	; connections opened
+		reused:		; requests sent on a connection used before
+		retries:	; requests sent again as the server closed a kept connection
+			0
+	]
+]
+open-connection: func [
+	"Open a new connection for the port"
+	port [port!]
+	/local conn
+] [
+	port/state/connection: conn: make port! compose [
+		scheme: (to lit-word! either port/spec/scheme = 'http ['tcp]['tls])
+		host: port/spec/host
+		port-id: port/spec/port-id
+		ref: rejoin [tcp:// host ":" port-id]
+	]
+	conn/awake: :http-awake
+	conn/locals: port
+	http-pool/stats/connects: http-pool/stats/connects + 1
+	open conn
+]
+take-connection: func [
+	"Take an idle connection to the host from the pool (or NONE)"
+	key [string!]
+	/local conns conn
+] [
+	conns: http-pool/connections
+	while [not tail? conns] [
+		either now/precise > conns/3 [
+			close conns/2
+			remove/part conns 3
+		] [
+			conns: skip conns 3
+		]
+	]
+	if conns: find/skip http-pool/connections key 3 [
+		conn: conns/2
+		remove/part conns 3
+		if open? conn [conn]
+	]
+]
+release-connection: func [
+	"Keep the connection of the port in the pool for another request"
+	port [port!]
+	/local state conn timeout conns n
+] [
+	state: port/state
+	conn: state/connection
+	conn/awake: :pool-awake
+	conn/locals: none
+
+	; the server may tell how long it keeps the connection open
+	timeout: http-pool/timeout
+	if all [
+		state/info/headers
+		string? n: state/info/headers/keep-alive
+		parse/all n [thru "timeout=" copy n some digits to end]
+	] [
+		timeout: min timeout to time! (to integer! n) - 1
+	]
+
+	n: 1
+	conns: http-pool/connections
+	while [conns: find/skip conns state/pool-key 3] [
+		either n < http-pool/max-idle [
+			n: n + 1
+			conns: skip conns 3
+		] [
+			close conns/2
+			remove/part conns 3
+		]
+	]
+	insert http-pool/connections reduce [state/pool-key conn now/precise + timeout]
+]
+pool-awake: func [
+	"Awake handler of the idle connections"
+	event [event!]
+	/local conns
+] [
+	if event/type = 'close [
+		if conns: find/only http-pool/connections event/port [
+			remove/part back conns 3
+		]
+		close event/port
+	]
+	false
 ]
 do-redirect: func [port [port!] new-uri [url! string! file!] /local spec state] [
 	spec: port/spec
@@ -361,6 +592,7 @@ do-redirect: func [port [port!] new-uri [url! string! file!] /local spec state]
 		;we need to reset tcp connection here before doing a redirect
 		close port/state/connection
 		open port/state/connection
+		state/sent: 0
 		do-request port
 		false
 	] [
@@ -386,13 +618,14 @@ check-data: func [port /local headers res data out chunk-size mk1 mk2 trailer st
 					chunk-size: to integer! to issue! to string! chunk-size
 					either chunk-size = 0 [
 						if parse/all mk1 [
-							crlfbin (trailer: "") to end | copy trailer to crlf2bin to end
+							crlfbin (trailer: "") mk2: to end | copy trailer to crlf2bin 4 skip mk2: to end
 						] [
 							trailer: construct trailer
 							append headers body-of trailer
 							state/state: 'ready
 							res: state/awake make event! [type: 'custom port: port code: 0]
-							clear data
+							;keep the data past the body, it is the response to a pipelined request
+							remove/part data mk2
 						]
 						true
 					] [
@@ -420,6 +653,11 @@ check-data: func [port /local headers res data out chunk-size mk1 mk2 trailer st
 			either headers/content-length <= length? port/data [
 				state/state: 'ready
 				conn/data: make binary! 32000
+				;keep the data past the body, it is the response to a pipelined request
+				if headers/content-length < length? port/data [
+					append conn/data skip port/data headers/content-length
+					clear skip port/data headers/content-length
+				]
 				res: state/awake make event! [type: 'custom port: port code: 0]
 			] [
 				;Awake from the WAIT loop to prevent timeout when reading big data. --Richard
@@ -455,15 +693,19 @@ sys/make-scheme [
 		response-parsed:
 		headers: none
 	]
+	pool: http-pool
 	actor: [
 		read: func [
 			port [port!]
 		] [
 			either any-function? :port/awake [
 				unless open? port [cause-error 'Access 'not-open port/spec/ref]
-				if port/state/state <> 'ready [http-error "Port not ready"]
 				port/state/awake: :port/awake
-				do-request port
+				either all [port/state/state = 'ready empty? port/state/queue] [
+					do-request port
+				] [
+					pipeline-request port
+				]
 				port
 			] [
 				sync-op port []
@@ -477,10 +719,13 @@ sys/make-scheme [
 			unless block? value [value: reduce [[Content-Type: "application/x-www-form-urlencoded; charset=utf-8"] value]]
 			either any-function? :port/awake [
 				unless open? port [cause-error 'Access 'not-open port/spec/ref]
-				if port/state/state <> 'ready [http-error "Port not ready"]
 				port/state/awake: :port/awake
 				parse-write-dialect port value
-				do-request port
+				either all [port/state/state = 'ready empty? port/state/queue] [
+					do-request port
+				] [
+					pipeline-request port
+				]
 				port
 			] [
 				sync-op port [parse-write-dialect port value]
@@ -499,16 +744,27 @@ sys/make-scheme [
 				close?: no
 				info: make port/scheme/info [type: 'file]
 				awake: :port/awake
+				pool-key: rejoin [form port/spec/scheme "://" port/spec/host ":" port/spec/port-id]
+				keep-alive?: no		; the connection can take another request
+				reused?: no			; the request was sent on a connection used before
+				retry?: no
+				sent: 0				; requests sent on the connection
+				request: none		; [method path headers content] of the response read
+				queue: make block! 4 ; pipelined requests, with their data
+				writing?: no
+				unsent: make binary! 0
 			]
-			port/state/connection: conn: make port! compose [
-				scheme: (to lit-word! either port/spec/scheme = 'http ['tcp]['tls])
-				host: port/spec/host
-				port-id: port/spec/port-id
-				ref: rejoin [tcp:// host ":" port-id]
+			either conn: take-connection port/state/pool-key [
+				port/state/connection: conn
+				conn/awake: :http-awake
+				conn/locals: port
+				port/state/state: 'ready
+				port/state/keep-alive?: yes
+				port/state/sent: 1
+				insert system/ports/system make event! [type: 'connect port: port]
+			] [
+				open-connection port
 			]
-			conn/awake: :http-awake
-			conn/locals: port
-			open conn
 			port
 		]
 		open?: func [
@@ -520,8 +776,19 @@ sys/make-scheme [
 			port [port!]
 		] [
 			if port/state [
-				close port/state/connection
-				port/state/connection/awake: none
+				either all [
+					port/state/state = 'ready
+					port/state/keep-alive?
+					empty? port/state/queue
+					not port/state/writing?
+					empty? any [port/state/connection/data #{}]
+					open? port/state/connection
+				] [
+					release-connection port
+				] [
+					close port/state/connection
+					port/state/connection/awake: none
+				]
 				port/state: none
 			]
 			port
@@ -1,15 +1,14 @@
 REBOL [
-	title: "REBOL 3 TLSv1.0 protocol scheme"
+	title: "REBOL 3 TLSv1.0-1.2 protocol scheme"
 	name: 'tls
 	type: 'module
 	author: rights: "Richard 'Cyphre' Smolak"
-	version: 0.6.1
+	version: 0.7.0
 	todo: {
-		-cached sessions
 		-automagic cert data lookup
-		-add more cipher suites (based on DSA, 3DES, ECDH, ECDHE, ECDSA, SHA256, SHA384 ...)
+		-add more cipher suites (based on 3DES, ECDSA, SHA384 ...)
 		-server role support
-		-SSL3.0, TLS1.1/1.2 compatibility
+		-SSL3.0 compatibility
 		-cert validation
 	}
 ]
@@ -54,16 +53,121 @@ tls-error: func [
 ]
 
 cipher-suites: make object! [
+	TLS_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256:	#{CC A8}
+	TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256:	#{C0 2F}
+	TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA:		#{C0 13}
+	TLS_ECDHE_RSA_WITH_AES_256_CBC_SHA:		#{C0 14}
+	TLS_DHE_RSA_WITH_CHACHA20_POLY1305_SHA256:	#{CC AA}
+	TLS_DHE_RSA_WITH_AES_128_GCM_SHA256:	#{00 9E}
+	TLS_RSA_WITH_AES_128_GCM_SHA256:		#{00 9C}
 	TLS_RSA_WITH_RC4_128_MD5:				#{00 04}
 	TLS_RSA_WITH_RC4_128_SHA:				#{00 05}
 	TLS_RSA_WITH_AES_128_CBC_SHA:			#{00 2F}
 	TLS_RSA_WITH_AES_256_CBC_SHA:			#{00 35}
-	TLS_DHE_DSS_WITH_AES_128_CBC_SHA:		#{00 32}
-	TLS_DHE_DSS_WITH_AES_256_CBC_SHA:		#{00 38}
 	TLS_DHE_RSA_WITH_AES_128_CBC_SHA:		#{00 33}
 	TLS_DHE_RSA_WITH_AES_256_CBC_SHA:		#{00 39}
 ]
 
+; crypt-methods that are AEAD ciphers (TLS 1.2), done natively by AEAD
+aead-methods: [aes-gcm chacha20-poly1305]
+
+tls12?: func [
+	"True if TLS 1.2 has been negotiated"
+	ctx [object!]
+] [
+	ctx/version/2 >= 3
+]
+
+; named curves done natively by ECDH, as offered in supported_groups
+named-curves: [
+	#{00 1D} x25519
+	#{00 17} secp256r1
+]
+
+; DigestInfo prefixes of the hashes offered in signature_algorithms (RSA PKCS#1)
+digest-infos: [
+	sha1	#{30 21 30 09 06 05 2B 0E 03 02 1A 05 00 04 14}
+	sha256	#{30 31 30 0D 06 09 60 86 48 01 65 03 04 02 01 05 00 04 20}
+	sha384	#{30 41 30 0D 06 09 60 86 48 01 65 03 04 02 02 05 00 04 30}
+]
+
+verify-key-exchange: func [
+	"Check the RSA signature of the server key exchange params with the certificate key"
+	ctx [object!]
+	params [binary!] "The signed params"
+	sig-alg [binary! none!] "Hash and signature algorithms (TLS 1.2)"
+	signature [binary!]
+	/local data method hash key
+] [
+	data: rejoin [ctx/client-random ctx/server-random params]
+	either sig-alg [
+		unless all [
+			sig-alg/2 = 1 ; rsa
+			method: switch sig-alg/1 [2 ['sha1] 4 ['sha256] 5 ['sha384]]
+		] [
+			do make error! rejoin ["Unsupported signature algorithm: " mold sig-alg]
+		]
+		hash: append copy select digest-infos method checksum/method data method
+	] [
+		; TLS 1.0 and 1.1 sign the MD5 and SHA1 hashes (no DigestInfo)
+		hash: append checksum/method data 'md5 checksum/method data 'sha1
+	]
+
+	; PKCS#1 v1.5: 00 01 FF .. FF 00 hash, the size of the modulus
+	unless all [
+		binary? ctx/pub-key
+		(length? signature) = length? ctx/pub-key
+		key: rsa-make-key
+		key/n: ctx/pub-key
+		key/e: ctx/pub-exp
+		(rsa/decrypt signature key) = rejoin [
+			#{00 01} append/dup copy #{} #{FF} (length? ctx/pub-key) - 3 - length? hash #{00} hash
+		]
+	] [
+		do make error! "Bad server key exchange signature"
+	]
+]
+
+; sessions to resume, by "host:port" (client side, for this process only)
+session-cache: make block! 16
+session-lifetime: 1:00
+
+find-session: func [
+	"Return the cached session for a host, if it has not expired"
+	key [string!]
+	/local session
+] [
+	all [
+		session: select/skip session-cache key 2
+		now < (session/time + session-lifetime)
+		session
+	]
+]
+
+cache-session: func [
+	"Keep the session keys of a completed handshake for resumption"
+	ctx [object!]
+	/local session pos
+] [
+	if all [empty? ctx/session-id not ctx/session-ticket] [exit]
+
+	session: make object! [
+		session-id: copy ctx/session-id
+		ticket: ctx/session-ticket
+		master-secret: copy ctx/master-secret
+		cipher-suite: ctx/cipher-suite
+		version: ctx/version
+		time: now
+	]
+
+	remove-each [key val] session-cache [now >= (val/time + session-lifetime)]
+	either pos: find/skip session-cache ctx/session-key 2 [
+		change next pos session
+	] [
+		repend session-cache [ctx/session-key session]
+	]
+]
+
 ; ASN.1 format parser code
 
 universal-tags: [
@@ -175,11 +279,12 @@ parse-asn: func [
 
 read-proto-states: [
 	client-hello [server-hello]
-	server-hello [certificate]
+	server-hello [certificate change-cipher-spec new-session-ticket]
 	certificate [server-hello-done server-key-exchange]
 	server-key-exchange [server-hello-done]
 	server-hello-done [#complete]
-	finished [change-cipher-spec alert]
+	finished [change-cipher-spec alert new-session-ticket]
+	new-session-ticket [change-cipher-spec]
 	change-cipher-spec [encrypted-handshake]
 	encrypted-handshake [application #complete]
 	application [application alert #complete]
@@ -191,7 +296,8 @@ write-proto-states: [
 	server-hello-done [client-key-exchange]
 	client-key-exchange [change-cipher-spec]
 	change-cipher-spec [finished]
-	encrypted-handshake [application]
+	encrypted-handshake [application change-cipher-spec]
+	finished [application]
 	application [application alert]
 	alert [close-notify]
 	close-notify []
@@ -237,7 +343,7 @@ update-proto-state: func [
 client-hello: func [
 	ctx [object!]
 	/local
-		beg len cs-data
+		beg len cs-data extensions
 ] [
 	; generate client random struct
 	ctx/client-random: to-bin to integer! difference now/precise 1-Jan-1970 4
@@ -246,20 +352,52 @@ client-hello: func [
 
 	cs-data: rejoin values-of cipher-suites
 
+	; offer a cached session for resumption
+	ctx/session-id: make binary! 32
+	ctx/session-ticket: none
+	if ctx/session: find-session ctx/session-key [
+		ctx/session-ticket: ctx/session/ticket
+		append ctx/session-id ctx/session/session-id
+		if all [empty? ctx/session-id ctx/session-ticket] [
+			; the server echoes this ID when it accepts the ticket
+			loop 32 [append ctx/session-id (random/secure 256) - 1]
+		]
+	]
+
+	extensions: rejoin [
+		#{00 0D}					; signature_algorithms extension
+		#{00 08}					; extension length
+		#{00 06}					; list length
+		#{04 01 05 01 02 01}		; RSA with SHA256, SHA384, SHA1
+		#{00 0A}					; supported_groups extension
+		#{00 06}					; extension length
+		#{00 04}					; list length
+		#{00 1D 00 17}				; x25519, secp256r1
+		#{00 0B}					; ec_point_formats extension
+		#{00 02}					; extension length
+		#{01 00}					; uncompressed only
+		#{00 23}					; SessionTicket extension
+		to-bin length? any [ctx/session-ticket #{}] 2
+		any [ctx/session-ticket #{}]
+	]
+
 	beg: length? ctx/msg
 	emit ctx [
 		#{16}						; protocol type (22=Handshake)
-		ctx/version					; protocol version (3|1 = TLS1.0)
+		ctx/version					; protocol version (3|1 = TLS1.0, for older servers)
 		#{00 00}					; length of SSL record data
 		#{01}						; protocol message type	(1=ClientHello)
 		#{00 00 00} 				; protocol message length
-		ctx/version					; max supported version by client (TLS1.0)
+		ctx/client-version			; max supported version by client (TLS1.2)
 		ctx/client-random			; random struct (4 bytes gmt unix time + 28 random bytes)
-		#{00}						; session ID length
+		to-bin length? ctx/session-id 1	; session ID length
+		ctx/session-id				; session ID (empty for a new session)
 		to-bin length? cs-data 2	; cipher suites length
 		cs-data						; cipher suites list
 		#{01}						; compression method length
 		#{00}						; no compression
+		to-bin length? extensions 2	; extensions length
+		extensions
 	]
 
 	; set the correct msg lengths
@@ -274,12 +412,14 @@ client-hello: func [
 client-key-exchange: func [
 	ctx [object!]
 	/local
-	rsa-key key-data beg len
+	rsa-key key-data key-length beg len
 ] [
+	key-length: 2
+
 	switch ctx/key-method [
 		rsa [
 			; generate pre-master-secret
-			ctx/pre-master-secret: copy ctx/version
+			ctx/pre-master-secret: copy ctx/client-version
 			random/seed now/time/precise
 			loop 46 [append ctx/pre-master-secret (random/secure 256) - 1]
 
@@ -291,7 +431,7 @@ client-key-exchange: func [
 			; supply encrypted pre-master-secret to server
 			key-data: rsa ctx/pre-master-secret rsa-key
 		]
-		dhe-dss dhe-rsa [
+		dhe-rsa [
 			; generate public/private keypair
 			dh-generate-key ctx/dh-key
 
@@ -301,6 +441,17 @@ client-key-exchange: func [
 			; generate pre-master-secret
 			ctx/pre-master-secret: dh-compute-key ctx/dh-key ctx/dh-pub
 		]
+		ecdhe-rsa [
+			ecdh-generate-key ctx/ecdh-key
+
+			; the EC point is sent with a 1 byte length
+			key-data: ctx/ecdh-key/pub-key
+			key-length: 1
+
+			unless ctx/pre-master-secret: ecdh-compute-key ctx/ecdh-key ctx/ecdh-pub [
+				tls-error "Invalid ECDH public key sent by the server"
+			]
+		]
 	]
 
 	beg: length? ctx/msg
@@ -310,7 +461,7 @@ client-key-exchange: func [
 		#{00 00}					; length of SSL record data
 		#{10}						; protocol message type	(16=ClientKeyExchange)
 		#{00 00 00} 				; protocol message length
-		to-bin length? key-data 2	; length of the key (2 bytes)
+		to-bin length? key-data key-length	; length of the key
 		key-data
 	]
 
@@ -321,6 +472,17 @@ client-key-exchange: func [
 	; make all secure data
 	make-master-secret ctx ctx/pre-master-secret
 
+	make-keys ctx
+
+	append ctx/handshake-messages copy at ctx/msg beg + 6
+
+	return ctx/msg
+]
+
+make-keys: func [
+	"Make the record keys from the master secret"
+	ctx [object!]
+] [
 	make-key-block ctx
 
 	; update keys
@@ -329,14 +491,15 @@ client-key-exchange: func [
 	ctx/client-crypt-key: copy/part skip ctx/key-block 2 * ctx/hash-size ctx/crypt-size
 	ctx/server-crypt-key: copy/part skip ctx/key-block 2 * ctx/hash-size + ctx/crypt-size ctx/crypt-size
 
-	if ctx/block-size [
-		ctx/client-iv: copy/part skip ctx/key-block 2 * (ctx/hash-size + ctx/crypt-size) ctx/block-size
-		ctx/server-iv: copy/part skip ctx/key-block 2 * (ctx/hash-size + ctx/crypt-size) + ctx/block-size ctx/block-size
+	if ctx/iv-size [
+		ctx/client-iv: copy/part skip ctx/key-block 2 * (ctx/hash-size + ctx/crypt-size) ctx/iv-size
+		ctx/server-iv: copy/part skip ctx/key-block 2 * (ctx/hash-size + ctx/crypt-size) + ctx/iv-size ctx/iv-size
 	]
 
-	append ctx/handshake-messages copy at ctx/msg beg + 6
-
-	return ctx/msg
+	if find aead-methods ctx/crypt-method [
+		ctx/encrypt-stream: aead-key ctx/crypt-method ctx/client-crypt-key
+		ctx/decrypt-stream: aead-key ctx/crypt-method ctx/server-crypt-key
+	]
 ]
 
 
@@ -405,9 +568,34 @@ finished: func [
 	return rejoin [
 		#{14}		; protocol message type	(20=Finished)
 		#{00 00 0c} ; protocol message length (12 bytes)
-		prf ctx/master-secret either ctx/server? ["server finished"] ["client finished"] rejoin [
+		prf ctx ctx/master-secret either ctx/server? ["server finished"] ["client finished"] handshake-hash ctx 12
+	]
+]
+
+handshake-hash: func [
+	"Hash of the handshake messages, for the Finished message"
+	ctx [object!]
+] [
+	either tls12? ctx [
+		checksum/method ctx/handshake-messages 'sha256
+	] [
+		rejoin [
 			checksum/method ctx/handshake-messages 'md5 checksum/method ctx/handshake-messages 'sha1
-		] 12
+		]
+	]
+]
+
+aead-nonce: func [
+	"Nonce of an AEAD record"
+	ctx [object!]
+	iv [binary!] "the fixed (implicit) IV"
+	seq [binary!] "sequence number or explicit nonce (8 bytes)"
+] [
+	either ctx/crypt-method = 'aes-gcm [
+		join iv seq
+	] [
+		; ChaCha20-Poly1305 xors the padded sequence number into the IV
+		iv xor join #{00 00 00 00} seq
 	]
 ]
 
@@ -417,9 +605,22 @@ encrypt-data: func [
 	/type
 		msg-type [binary!] "application data is default"
 	/local
-		mac padding len
+		mac padding len seq
 ] [
-		data: rejoin [
+	if find aead-methods ctx/crypt-method [
+		seq: to-bin ctx/seq-num-w 8
+		data: aead ctx/encrypt-stream aead-nonce ctx ctx/client-iv seq rejoin [
+			seq									; sequence number (64-bit int in R3)
+			any [msg-type #{17}]				; msg type
+			ctx/version							; version
+			to-bin length? data 2				; msg content length
+		] data
+		; GCM sends the sequence number as the explicit nonce
+		if ctx/crypt-method = 'aes-gcm [insert data seq]
+		return data
+	]
+
+	data: rejoin [
 		data
 		; MAC code
 		mac: checksum/method/key rejoin [
@@ -436,6 +637,12 @@ encrypt-data: func [
 		padding: ctx/block-size - (1 + (length? data) // ctx/block-size)
 		len: 1 + padding
 		append data head insert/dup make binary! len to-bin padding 1 len
+
+		; TLS 1.1+ records start with an explicit IV: encrypting a random
+		; block in the CBC chain gives the same
+		if ctx/version/2 > 1 [
+			loop ctx/block-size [insert data (random/secure 256) - 1]
+		]
 	]
 
 	switch ctx/crypt-method [
@@ -459,9 +666,27 @@ encrypt-data: func [
 decrypt-data: func [
 	ctx [object!]
 	data [binary!]
+	msg-type [binary!]
 	/local
-		crypt-data
+		crypt-data seq
 ] [
+	if find aead-methods ctx/crypt-method [
+		seq: to-bin ctx/seq-num-r 8
+		unless data: aead/decrypt ctx/decrypt-stream aead-nonce ctx ctx/server-iv either ctx/crypt-method = 'aes-gcm [
+			take/part data 8					; explicit nonce
+		] [
+			seq
+		] rejoin [
+			seq									; sequence number (64-bit int in R3)
+			msg-type							; msg type
+			ctx/version							; version
+			to-bin (length? data) - 16 2		; msg content length (without the tag)
+		] data [
+			do make error! "Bad record MAC"
+		]
+		return data
+	]
+
 	switch ctx/crypt-method [
 		rc4 [
 			unless ctx/decrypt-stream [
@@ -497,6 +722,7 @@ message-types: [
 	14 server-hello-done
 	15 certificate-verify
 	16 client-key-exchange
+	4 new-session-ticket
 	20 finished
 ]
 
@@ -537,7 +763,8 @@ parse-protocol: func [
 	]
 	return context [
 		type: proto
-		version: pick [ssl-v3 tls-v1.0 tls-v1.1] data/3 + 1
+		code: data/1
+		version: pick [ssl-v3 tls-v1.0 tls-v1.1 tls-v1.2] data/3 + 1
 		length: to integer! copy/part at data 4 2
 		messages: copy/part at data 6 length
 	]
@@ -547,15 +774,17 @@ parse-messages: func [
 	ctx [object!]
 	proto [object!]
 	/local
-		result data msg-type len clen msg-content mac msg-obj
+		result data msg-type len clen msg-content mac msg-obj curve
 ] [
 	result: make block! 8
 	data: proto/messages
 
 	if ctx/encrypted? [
-		change data decrypt-data ctx data
+		data: decrypt-data ctx data to-bin proto/code 1
 		debug ["decrypting..."]
 		if ctx/block-size [
+			; TLS 1.1+ records start with the explicit IV
+			if ctx/version/2 > 1 [data: skip data ctx/block-size]
 			; deal with padding in CBC mode
 			data: copy/part data (length? data) - 1 - (to integer! last data)
 			debug ["depadding..."]
@@ -590,7 +819,7 @@ parse-messages: func [
 
 						msg-obj: context [
 							type: msg-type
-							version: pick [ssl-v3 tls-v1.0 tls-v1.1] data/6 + 1
+							version: pick [ssl-v3 tls-v1.0 tls-v1.1 tls-v1.2] data/6 + 1
 							length: len
 							server-random: copy/part msg-content 32
 							session-id: copy/part at msg-content 34 msg-content/33
@@ -599,9 +828,63 @@ parse-messages: func [
 							compression-method: either compression-method-length = 0 [none] [copy/part at msg-content 37 + msg-content/33 compression-method-length]
 						]
 						ctx/cipher-suite: msg-obj/cipher-suite
+						ctx/version: copy/part at data 5 2
 
 						; note: the cipher-suite config will be more automatized in later versions
 						switch/default ctx/cipher-suite reduce bind [
+							TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256 [
+								ctx/key-method: 'ecdhe-rsa
+								ctx/crypt-method: 'aes-gcm
+								ctx/crypt-size: 16
+								ctx/iv-size: 4
+								ctx/hash-size: 0
+							]
+							TLS_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256 [
+								ctx/key-method: 'ecdhe-rsa
+								ctx/crypt-method: 'chacha20-poly1305
+								ctx/crypt-size: 32
+								ctx/iv-size: 12
+								ctx/hash-size: 0
+							]
+							TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA [
+								ctx/key-method: 'ecdhe-rsa
+								ctx/crypt-method: 'aes
+								ctx/crypt-size: 16
+								ctx/block-size: 16
+								ctx/iv-size: 16
+								ctx/hash-method: 'sha1
+								ctx/hash-size: 20
+							]
+							TLS_ECDHE_RSA_WITH_AES_256_CBC_SHA [
+								ctx/key-method: 'ecdhe-rsa
+								ctx/crypt-method: 'aes
+								ctx/crypt-size: 32
+								ctx/block-size: 16
+								ctx/iv-size: 16
+								ctx/hash-method: 'sha1
+								ctx/hash-size: 20
+							]
+							TLS_RSA_WITH_AES_128_GCM_SHA256 [
+								ctx/key-method: 'rsa
+								ctx/crypt-method: 'aes-gcm
+								ctx/crypt-size: 16
+								ctx/iv-size: 4
+								ctx/hash-size: 0
+							]
+							TLS_DHE_RSA_WITH_AES_128_GCM_SHA256 [
+								ctx/key-method: 'dhe-rsa
+								ctx/crypt-method: 'aes-gcm
+								ctx/crypt-size: 16
+								ctx/iv-size: 4
+								ctx/hash-size: 0
+							]
+							TLS_DHE_RSA_WITH_CHACHA20_POLY1305_SHA256 [
+								ctx/key-method: 'dhe-rsa
+								ctx/crypt-method: 'chacha20-poly1305
+								ctx/crypt-size: 32
+								ctx/iv-size: 12
+								ctx/hash-size: 0
+							]
 							TLS_RSA_WITH_RC4_128_SHA [
 								ctx/key-method: 'rsa
 								ctx/crypt-method: 'rc4
@@ -634,24 +917,6 @@ parse-messages: func [
 								ctx/hash-method: 'sha1
 								ctx/hash-size: 20
 							]
-							TLS_DHE_DSS_WITH_AES_128_CBC_SHA [
-								ctx/key-method: 'dhe-dss
-								ctx/crypt-method: 'aes
-								ctx/crypt-size: 16
-								ctx/block-size: 16
-								ctx/iv-size: 16
-								ctx/hash-method: 'sha1
-								ctx/hash-size: 20
-							]
-							TLS_DHE_DSS_WITH_AES_256_CBC_SHA [
-								ctx/key-method: 'dhe-dss
-								ctx/crypt-method: 'aes
-								ctx/crypt-size: 32
-								ctx/block-size: 16
-								ctx/iv-size: 16
-								ctx/hash-method: 'sha1
-								ctx/hash-size: 20
-							]
 							TLS_DHE_RSA_WITH_AES_128_CBC_SHA [
 								ctx/key-method: 'dhe-rsa
 								ctx/crypt-method: 'aes
@@ -674,7 +939,32 @@ parse-messages: func [
 							do make error! rejoin ["Current version of TLS scheme doesn't support ciphersuite: " mold ctx/cipher-suite]
 						]
 
+						if all [
+							find aead-methods ctx/crypt-method
+							not tls12? ctx
+						] [
+							do make error! "AEAD ciphersuite requires TLS 1.2"
+						]
+
 						ctx/server-random: msg-obj/server-random
+
+						; the server echoes our session ID when it resumes the session
+						either all [
+							ctx/session
+							not empty? ctx/session-id
+							msg-obj/session-id = ctx/session-id
+						] [
+							if ctx/cipher-suite <> ctx/session/cipher-suite [
+								do make error! "Resumed session with another ciphersuite"
+							]
+							ctx/resumed?: true
+							ctx/master-secret: ctx/session/master-secret
+							make-keys ctx
+						] [
+							; a full handshake, any ticket sent is not valid anymore
+							ctx/session-ticket: none
+						]
+						ctx/session-id: msg-obj/session-id
 						msg-obj
 					]
 					certificate [
@@ -694,8 +984,9 @@ parse-messages: func [
 						; no cert validation - just set it to be used
 						ctx/certificate: parse-asn msg-obj/certificate-list/1
 
-						switch/default ctx/key-method [
-							rsa [
+						; the RSA key is for the premaster secret, or to verify the key exchange signature
+						switch ctx/key-method [
+							rsa dhe-rsa ecdhe-rsa [
 								; get the public key and exponent (hardcoded for now)
 								ctx/pub-key: parse-asn next
 ;								ctx/certificate/1/sequence/4/1/sequence/4/6/sequence/4/2/bit-string/4
@@ -703,14 +994,12 @@ parse-messages: func [
 								ctx/pub-exp: ctx/pub-key/1/sequence/4/2/integer/4
 								ctx/pub-key: next ctx/pub-key/1/sequence/4/1/integer/4
 							]
-						] [
-							; for DH cipher suites the certificate is used just for signing the key exchange data
 						]
 						msg-obj
 					]
 					server-key-exchange [
 						switch/default ctx/key-method [
-							dhe-dss dhe-rsa [
+							dhe-rsa [
 								msg-content: copy/part at data 5 len
 								msg-obj: context [
 									type: msg-type
@@ -721,8 +1010,10 @@ parse-messages: func [
 									g: copy/part at msg-content 3 + p-length + 2 g-length
 									ys-length: to integer! copy/part at msg-content 3 + p-length + 2 + g-length 2
 									ys: copy/part at msg-content 3 + p-length + 2 + g-length + 2 ys-length
-									signature-length: to integer! copy/part at msg-content 3 + p-length + 2 + g-length + 2 + ys-length 2
-									signature: copy/part at msg-content 3 + p-length + 2 + g-length + 2 + ys-length + 2 signature-length
+									; TLS 1.2 puts the hash and signature algorithms before the signature
+									sig-offset: 3 + p-length + 2 + g-length + 2 + ys-length + either tls12? ctx [2] [0]
+									signature-length: to integer! copy/part at msg-content sig-offset 2
+									signature: copy/part at msg-content sig-offset + 2 signature-length
 								]
 
 								ctx/dh-key: dh-make-key
@@ -730,13 +1021,58 @@ parse-messages: func [
 								ctx/dh-key/g: msg-obj/g
 								ctx/dh-pub: msg-obj/ys
 
-								; TODO: the signature sent by server should be verified using DSA or RSA algorithm to be sure the dh-key params are safe
+								verify-key-exchange ctx
+									copy/part msg-content 6 + msg-obj/p-length + msg-obj/g-length + msg-obj/ys-length
+									if tls12? ctx [copy/part at msg-content msg-obj/sig-offset - 2 2]
+									msg-obj/signature
+								msg-obj
+							]
+							ecdhe-rsa [
+								msg-content: copy/part at data 5 len
+								msg-obj: context [
+									type: msg-type
+									length: len
+									curve-type: msg-content/1
+									named-curve: copy/part at msg-content 2 2
+									point-length: msg-content/4
+									point: copy/part at msg-content 5 point-length
+									; TLS 1.2 puts the hash and signature algorithms before the signature
+									sig-offset: 5 + point-length + either tls12? ctx [2] [0]
+									signature-length: to integer! copy/part at msg-content sig-offset 2
+									signature: copy/part at msg-content sig-offset + 2 signature-length
+								]
+
+								unless all [
+									msg-obj/curve-type = 3 ; named_curve
+									curve: select named-curves msg-obj/named-curve
+								] [
+									do make error! rejoin ["Unsupported ECDH curve: " mold msg-obj/named-curve]
+								]
+								ctx/ecdh-key: ecdh-make-key curve
+								ctx/ecdh-pub: msg-obj/point
+
+								verify-key-exchange ctx
+									copy/part msg-content 4 + msg-obj/point-length
+									if tls12? ctx [copy/part at msg-content msg-obj/sig-offset - 2 2]
+									msg-obj/signature
 								msg-obj
 							]
 						] [
 							do make error! "Server-key-exchange message has been sent illegally."
 						]
 					]
+					new-session-ticket [
+						msg-content: copy/part at data 5 len
+						msg-obj: context [
+							type: msg-type
+							length: len
+							lifetime: to integer! copy/part msg-content 4
+							ticket: copy/part at msg-content 7 to integer! copy/part at msg-content 5 2
+						]
+						; an empty ticket means the server will not resume this one
+						ctx/session-ticket: either empty? msg-obj/ticket [none] [msg-obj/ticket]
+						msg-obj
+					]
 					server-hello-done [
 						context [
 							type: msg-type
@@ -747,18 +1083,18 @@ parse-messages: func [
 						msg-content: copy/part at data 7 len
 						context [
 							type: msg-type
-							version: pick [ssl-v3 tls-v1.0 tls-v1.1] data/6 + 1
+							version: pick [ssl-v3 tls-v1.0 tls-v1.1 tls-v1.2] data/6 + 1
 							length: len
 							content: msg-content
 						]
 					]
 					finished [
-						ctx/seq-num-r: 0
 						msg-content: copy/part at data 5 len
-						either msg-content <> prf ctx/master-secret either ctx/server? ["client finished"] ["server finished"] rejoin [checksum/method ctx/handshake-messages 'md5 checksum/method ctx/handshake-messages 'sha1] 12 [
+						either msg-content <> prf ctx ctx/master-secret either ctx/server? ["client finished"] ["server finished"] handshake-hash ctx 12 [
 							do make error! "Bad 'finished' MAC"
 						] [
 							debug "FINISHED MAC verify: OK"
+							cache-session ctx
 						]
 						context [
 							type: msg-type
@@ -770,7 +1106,7 @@ parse-messages: func [
 
 				append ctx/handshake-messages copy/part data len + 4
 
-				data: skip data len + either ctx/encrypted? [
+				data: skip data len + either all [ctx/encrypted? ctx/hash-method] [
 					; check the MAC
 					mac: copy/part skip data len + 4 ctx/hash-size
 					if mac <> checksum/method/key rejoin [
@@ -791,6 +1127,7 @@ parse-messages: func [
 		]
 		change-cipher-spec [
 			ctx/encrypted?: true
+			ctx/seq-num-r: -1 ; the first encrypted record is number 0
 			append result context [
 				type: 'ccs-message-type
 			]
@@ -802,15 +1139,17 @@ parse-messages: func [
 			]
 			len: length? msg-obj/content
 			mac: copy/part skip data len ctx/hash-size
-			; check the MAC
-			if mac <> checksum/method/key rejoin [
-				to-bin ctx/seq-num-r 8	; sequence number (64-bit int in R3)
-				#{17}					; msg type
-				ctx/version				; version
-				to-bin len 2			; msg content length
-				msg-obj/content			; content
-			] ctx/hash-method decode 'text ctx/server-mac-key
-			[
+			; check the MAC (AEAD records were checked when decrypted)
+			if all [
+				ctx/hash-method
+				mac <> checksum/method/key rejoin [
+					to-bin ctx/seq-num-r 8	; sequence number (64-bit int in R3)
+					#{17}					; msg type
+					ctx/version				; version
+					to-bin len 2			; msg content length
+					msg-obj/content			; content
+				] ctx/hash-method decode 'text ctx/server-mac-key
+			] [
 				do make error! "Bad application record MAC"
 			]
 		]
@@ -840,13 +1179,26 @@ parse-response: func [
 ]
 
 prf: func [
+	ctx [object!]
 	secret [binary!]
 	label [string! binary!]
 	seed [binary!]
 	output-length [integer!]
 	/local
-		len mid s-1 s-2 a p-sha1 p-md5
+		len mid s-1 s-2 a p-sha1 p-md5 p-sha256
 ] [
+	if tls12? ctx [
+		; TLS 1.2 uses P_SHA256 alone
+		seed: rejoin [#{} label seed]
+		p-sha256: make binary! output-length
+		a: seed ; A(0)
+		while [output-length > length? p-sha256] [
+			a: checksum/method/key a 'sha256 decode 'text secret ; A(n)
+			append p-sha256 checksum/method/key rejoin [a seed] 'sha256 decode 'text secret
+		]
+		return copy/part p-sha256 output-length
+	]
+
 	len: length? secret
 	mid: to integer! .5 * (len + either odd? len [1] [0])
 
@@ -875,14 +1227,14 @@ prf: func [
 make-key-block: func [
 	ctx [object!]
 ] [
-	ctx/key-block: prf ctx/master-secret "key expansion" rejoin [ctx/server-random ctx/client-random] ctx/hash-size + ctx/crypt-size + (either ctx/block-size [ctx/iv-size] [0]) * 2
+	ctx/key-block: prf ctx ctx/master-secret "key expansion" rejoin [ctx/server-random ctx/client-random] ctx/hash-size + ctx/crypt-size + (any [ctx/iv-size 0]) * 2
 ]
 
 make-master-secret: func [
 	ctx [object!]
 	pre-master-secret [binary!]
 ] [
-	ctx/master-secret: prf pre-master-secret "master secret" rejoin [ctx/client-random ctx/server-random] 48
+	ctx/master-secret: prf ctx pre-master-secret "master secret" rejoin [ctx/client-random ctx/server-random] 48
 ]
 
 do-commands: func [
@@ -927,6 +1279,7 @@ tls-init: func [
 	ctx/seq-num-w: 0
 	ctx/protocol-state: none
 	ctx/encrypted?: false
+	ctx/resumed?: false
 
 	switch ctx/crypt-method [
 		rc4 [
@@ -937,6 +1290,16 @@ tls-init: func [
 				ctx/decrypt-stream: rc4/stream ctx/decrypt-stream none
 			]
 		]
+		aes-gcm chacha20-poly1305 [
+			if ctx/encrypt-stream [
+				aead ctx/encrypt-stream none #{} #{}
+				ctx/encrypt-stream: none
+			]
+			if ctx/decrypt-stream [
+				aead ctx/decrypt-stream none #{} #{}
+				ctx/decrypt-stream: none
+			]
+		]
 	]
 ]
 
@@ -1010,10 +1373,18 @@ tls-awake: function [event [event!]] [
 			do-commands tls-port/state [client-hello]
 
 			if tls-port/state/resp/1/type = 'handshake [
-				do-commands tls-port/state [
-					client-key-exchange
-					change-cipher-spec
-					finished
+				either tls-port/state/resumed? [
+					; abbreviated handshake, the server has sent its Finished already
+					do-commands tls-port/state [
+						change-cipher-spec
+						finished
+					]
+				] [
+					do-commands tls-port/state [
+						client-key-exchange
+						change-cipher-spec
+						finished
+					]
 				]
 			]
 			insert system/ports/system make event! [type: 'connect port: tls-port]
@@ -1028,6 +1399,10 @@ tls-awake: function [event [event!]] [
 					insert system/ports/system make event! [type: 'wrote port: tls-port]
 					return false
 				]
+				finished [
+					; the abbreviated handshake is complete, nothing more to read
+					if tls-port/state/resumed? [return true]
+				]
 			]
 			read port
 			return false
@@ -1081,7 +1456,7 @@ tls-awake: function [event [event!]] [
 
 sys/make-scheme [
 	name: 'tls
-	title: "TLS protocol v1.0"
+	title: "TLS protocol v1.0-1.2"
 	spec: make system/standard/port-spec-net []
 	actor: [
 		read: func [
@@ -1095,7 +1470,7 @@ sys/make-scheme [
 		]
 
 		write: func [port [port!] value [any-type!]] [
-			if find [encrypted-handshake application] port/state/protocol-state [
+			if find [encrypted-handshake finished application] port/state/protocol-state [
 				do-commands/no-wait port/state compose [
 					application (value)
 				]
@@ -1112,7 +1487,8 @@ sys/make-scheme [
 				port-data: make binary! 32000
 				resp: none
 
-				version: #{03 01} ; protocol version used
+				client-version: #{03 03} ; highest protocol version offered
+				version: #{03 01} ; protocol version used (set by the server hello)
 
 				server?: false
 
@@ -1150,6 +1526,12 @@ sys/make-scheme [
 				key-block:
 				certificate: pub-key: pub-exp:
 				dh-key: dh-pub: none
+				ecdh-key: ecdh-pub: none
+
+				; session resumption
+				session-key: rejoin [port/spec/host ":" port/spec/port-id]
+				session: session-id: session-ticket: none
+				resumed?: false
 
 				encrypt-stream: decrypt-stream: none
 
@@ -1208,6 +1590,14 @@ sys/make-scheme [
 						aes/stream port/state/decrypt-stream none
 					]
 				]
+				aes-gcm chacha20-poly1305 [
+					if port/state/encrypt-stream [
+						aead port/state/encrypt-stream none #{} #{}
+					]
+					if port/state/decrypt-stream [
+						aead port/state/decrypt-stream none #{} #{}
+					]
+				]
 			]
 
 			debug "TLS/TCP port closed"
@@ -21,20 +21,22 @@ decode: function [
  	{Decodes a series of bytes into the related datatype (e.g. image!).}
 	type [word!] {Media type (jpeg, png, etc.)}
 	data [binary!] {The data to decode}
+	/options opts [block!] {Special decoding options}
 ][
-	unless all [
-		cod: select system/codecs type
-		data: do-codec cod/entry 'decode data
-	][
+	unless cod: select system/codecs type [
 		cause-error 'access 'no-codec type
 	]
-	data
+	either opts [
+		do-codec/options cod/entry 'decode data construct opts
+	][
+		do-codec cod/entry 'decode data
+	]
 ]
 
 encode: function [
 	{Encodes a datatype (e.g. image!) into a series of bytes.}
 	type [word!] {Media type (jpeg, png, etc.)}
-	data [image! binary! string!] {The data to encode}
+	data [image! binary! string! block! map! object! number! logic! none!] {The data to encode}
 	/options opts [block!] {Special encoding options}
 ][
 	unless all [
@@ -45,7 +47,11 @@ encode: function [
 				lib/to-png data
 			]
 		][
-			do-codec cod/entry 'encode data
+			either opts [
+				do-codec/options cod/entry 'encode data construct opts
+			][
+				do-codec cod/entry 'encode data
+			]
 		]
 	][
 		cause-error 'access 'no-codec type
@@ -105,7 +105,8 @@ make-port*: func [
 
 			; optional host [:port]
 			opt [
-				copy s1 any user-char
+				; IPv6 address in brackets (kept as string, as tuple! is too short)
+				[#"[" copy s1 to #"]" skip | copy s1 any user-char]
 				opt [#":" copy s2 digits (compose/into [port-id: (to integer! s2)] tail out)]
 				(unless empty? s1 [attempt [s1: to tuple! s1] emit host s1])
 			]
@@ -287,17 +288,91 @@ init-schemes: func [
 		awake: func [event] [print ['UDP-event event/type] true]
 	]
 
+	make-scheme [
+		title: "HTTP Server"
+		name: 'http-server
+		spec: system/standard/port-spec-http-server
+		info: system/standard/net-info ; for C enums
+		awake: func [event] [print ['HTTP-server-event event/type] true]
+	]
+
 	make-scheme [
 		title: "Clipboard"
 		name: 'clipboard
 	]
 
+	make-scheme [
+		title: "Rope String"
+		name: 'rope
+	]
+
+	make-scheme [
+		title: "Deflate Stream"
+		name: 'deflate
+		spec: system/standard/port-spec-compress
+	]
+
+	make-scheme [
+		title: "Inflate Stream"
+		name: 'inflate
+		spec: system/standard/port-spec-compress
+	]
+
+	make-scheme [
+		title: "Base Encode Stream"
+		name: 'enbase
+		spec: system/standard/port-spec-base
+	]
+
+	make-scheme [
+		title: "Base Decode Stream"
+		name: 'debase
+		spec: system/standard/port-spec-base
+	]
+
+	make-scheme [
+		title: "JSON Event Stream"
+		name: 'json
+	]
+
+	make-scheme [
+		title: "CSV Record Stream"
+		name: 'csv
+		spec: system/standard/port-spec-csv
+	]
+
+	make-scheme [
+		title: "Checksum Stream"
+		name: 'checksum
+		spec: system/standard/port-spec-checksum
+		init: func [port /local method] [
+			; checksum://sha256 or checksum:sha256
+			if url? port/spec/ref [
+				parse port/spec/ref [thru #":" 0 2 slash copy method to end]
+				if all [method not empty? method] [port/spec/method: to word! method]
+			]
+		]
+	]
+
 	if 4 == fourth system/version [
 		make-scheme [
 			title: "Signal"
 			name: 'signal
 			spec: system/standard/port-spec-signal
 		]
+
+		make-scheme [
+			title: "Process"
+			name: 'process
+			spec: system/standard/port-spec-process
+			awake: func [event] [
+				; Read all of the output, until the program exits:
+				switch/default event/type [
+					read [read event/port false]
+					wrote close error [true]
+				][false]
+			]
+		]
 	]
 
 	make-scheme [
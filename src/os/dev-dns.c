@@ -55,6 +55,13 @@ extern void Signal_Device(REBREQ *req, REBINT type);
 extern HWND Event_Handle;
 #endif
 
+#ifdef USE_DNS_THREADS
+int Resolve_Host(REBREQ *req, char *name);
+int Resolve_Addr(REBREQ *req);
+void Cancel_Resolve(REBREQ *req);
+void Reap_Resolves(void);
+#endif
+
 /***********************************************************************
 **
 */	DEVICE_CMD Open_DNS(REBREQ *sock)
@@ -80,6 +87,10 @@ extern HWND Event_Handle;
 		CLR_FLAG(sock->flags, RRF_PENDING);
 		if (sock->handle) WSACancelAsyncRequest(sock->handle);
 	}
+#endif
+#ifdef USE_DNS_THREADS
+	if (GET_FLAG(sock->state, RSM_LOOKUP)) Cancel_Resolve(sock);
+	sock->state = 0;
 #endif
 	if (sock->net.host_info) OS_Free(sock->net.host_info);
 	sock->net.host_info = 0;
@@ -104,6 +115,9 @@ extern HWND Event_Handle;
 #else
 	HOSTENT *he;
 #endif
+#ifdef USE_DNS_THREADS
+	int result;
+#endif
 
 	host = OS_Make(MAXGETHOSTSTRUCT); // be sure to free it
 
@@ -119,6 +133,31 @@ extern HWND Event_Handle;
 		return DR_PEND; // keep it on pending list
 	}
 #else
+#ifdef USE_DNS_THREADS
+	// Do the lookup on a helper thread (see host-dns.c). Poll_DNS
+	// finishes it. A reverse lookup puts the name in host_info.
+	OS_Free(host);
+	host = OS_Make(MAX_HOST_NAME);
+	sock->net.host_info = host;
+	if (GET_FLAG(sock->modes, RST_REVERSE))
+		result = Resolve_Addr(sock);
+	else
+		result = Resolve_Host(sock, sock->data);
+	if (result == DR_DONE) { // from the cache
+		if (!sock->net.remote_ip) { // IPv6 only (a tuple! cannot hold it)
+			OS_Free(host);
+			sock->net.host_info = 0;
+			sock->error = EAI_NONAME;
+			return DR_ERROR;
+		}
+		SET_FLAG(sock->flags, RRF_DONE);
+		return DR_DONE;
+	}
+	if (result == DR_PEND) {
+		SET_FLAG(sock->state, RSM_LOOKUP);
+		return DR_PEND; // keep it on pending list
+	}
+#endif
 	// Use old-style blocking DNS (mainly for testing purposes):
 	if (GET_FLAG(sock->modes, RST_REVERSE)) {
 		he = gethostbyaddr((char*)&sock->net.remote_ip, 4, AF_INET);
@@ -154,7 +193,8 @@ extern HWND Event_Handle;
 */	DEVICE_CMD Poll_DNS(REBREQ *dr)
 /*
 **		Check for completed DNS requests. These are marked with
-**		RRF_DONE by the windows message event handler (dev-event.c).
+**		RRF_DONE by the windows message event handler (dev-event.c),
+**		or by Reap_Resolves for the lookup threads (host-dns.c).
 **		Completed requests are removed from the pending queue and
 **		event is signalled (for awake dispatch).
 **
@@ -164,7 +204,11 @@ extern HWND Event_Handle;
 	REBREQ **prior = &dev->pending;
 	REBREQ *req;
 	REBOOL change = FALSE;
+#ifdef USE_DNS_THREADS
+	Reap_Resolves();
+#else
 	HOSTENT *host;
+#endif
 
 	// Scan the pending request list:
 	for (req = *prior; req; req = *prior) {
@@ -175,12 +219,19 @@ extern HWND Event_Handle;
 			req->next = 0;
 			CLR_FLAG(req->flags, RRF_PENDING);
 
+#ifdef USE_DNS_THREADS
+			CLR_FLAG(req->state, RSM_LOOKUP);
+			if (!req->error && !GET_FLAG(req->modes, RST_REVERSE) && !req->net.remote_ip)
+				req->error = EAI_NONAME; // IPv6 only (as above)
+#endif
 			if (!req->error) { // success!
+#ifndef USE_DNS_THREADS // (else the result is already set)
 				host = (HOSTENT*)req->net.host_info;
 				if (GET_FLAG(req->modes, RST_REVERSE))
 					req->data = host->h_name;
 				else
 					COPY_MEM((char*)&(req->net.remote_ip), (char *)(*host->h_addr_list), 4); //he->h_length);
+#endif
 				Signal_Device(req, EVT_READ);
 			}
 			else
@@ -35,6 +35,7 @@
 **
 ***********************************************************************/
 
+#define _GNU_SOURCE		// for accept4() (see HAS_ACCEPT4)
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -43,6 +44,13 @@
 #include "host-lib.h"
 #include "sys-net.h"
 
+#ifdef HAS_SENDFILE
+#include <sys/sendfile.h>
+#endif
+#ifndef TO_WIN32
+#include <sys/uio.h>
+#endif
+
 #if (0)
 #define WATCH1(s,a) printf(s, a)
 #define WATCH2(s,a,b) printf(s, a, b)
@@ -55,6 +63,15 @@
 
 void Signal_Device(REBREQ *req, REBINT type);
 DEVICE_CMD Listen_Socket(REBREQ *sock);
+#ifdef USE_EPOLL
+int Watch_Request(REBREQ *req, int fd, int out);
+void Unwatch_Request(REBREQ *req, int fd);
+#endif
+#ifdef USE_DNS_THREADS
+int Resolve_Host(REBREQ *req, char *name);
+void Cancel_Resolve(REBREQ *req);
+void Reap_Resolves(void);
+#endif
 
 #ifdef TO_WIN32
 typedef int socklen_t;
@@ -77,16 +94,148 @@ static void Set_Addr(SOCKAI *sa, long ip, int port)
 	sa->sin_port = htons((unsigned short)port);
 }
 
+#ifdef HAS_IPV6
+static void Set_Addr6(struct sockaddr_in6 *sa, u8 *ip6, int port)
+{
+	// Set the IPv6 address (any, if zero) and port number.
+	memset(sa, 0, sizeof(*sa));
+	sa->sin6_family = AF_INET6;
+	if (ip6) memcpy(&sa->sin6_addr, ip6, 16);
+	sa->sin6_port = htons((unsigned short)port);
+}
+
+static int Get_Addr6(struct sockaddr_in6 *sa, u32 *ip, u8 *ip6)
+{
+	// Get the address from an IPv6 socket_addr struct. IPv4 peers of
+	// a dual-stack socket have a mapped address (::ffff:a.b.c.d),
+	// which is given as IPv4. Returns TRUE for a real IPv6 address.
+	if (IN6_IS_ADDR_V4MAPPED(&sa->sin6_addr)) {
+		memcpy(ip, sa->sin6_addr.s6_addr + 12, 4);
+		return FALSE;
+	}
+	*ip = 0;
+	memcpy(ip6, &sa->sin6_addr, 16);
+	return TRUE;
+}
+#endif
+
 static void Get_Local_IP(REBREQ *sock)
 {
 	// Get the local IP address and port number.
 	// This code should be fast and never fail.
+#ifdef HAS_IPV6
+	struct sockaddr_storage ss;
+	socklen_t len = sizeof(ss);
+
+	getsockname(sock->socket, (struct sockaddr *)&ss, &len);
+	if (ss.ss_family == AF_INET6) {
+		Get_Addr6((struct sockaddr_in6 *)&ss, &sock->net.local_ip, sock->net.local_ip6);
+		sock->net.local_port = ntohs(((struct sockaddr_in6 *)&ss)->sin6_port);
+	}
+	else {
+		sock->net.local_ip = ((SOCKAI *)&ss)->sin_addr.s_addr;
+		sock->net.local_port = ntohs(((SOCKAI *)&ss)->sin_port);
+	}
+#else
 	SOCKAI sa;
 	int len = sizeof(sa);
 
 	getsockname(sock->socket, (struct sockaddr *)&sa, &len);
 	sock->net.local_ip = sa.sin_addr.s_addr; //htonl(ip); NOTE: REBOL stays in network byte order
 	sock->net.local_port = ntohs(sa.sin_port);
+#endif
+}
+
+static int Pend_Socket(REBREQ *sock, int out)
+{
+	// Keep the request pending until the socket is ready to be
+	// read (or written). Without epoll, it is simply polled.
+#ifdef USE_EPOLL
+	Watch_Request(sock, sock->socket, out);
+#ifdef HAS_IPV6
+	if (GET_FLAG(sock->state, RSM_RACE)) Watch_Request(sock, sock->net.alt_socket, out);
+#endif
+#endif
+	return DR_PEND;
+}
+
+static void Set_Options(REBREQ *sock, int listen)
+{
+	// Set the socket options given by MODIFY (RSO_ flags). Options
+	// for listen sockets only are set when listen is TRUE.
+	int on;
+
+	if (!GET_FLAG(sock->modes, RST_UDP)) {
+		on = GET_FLAG(sock->net.options, RSO_NO_DELAY) != 0;
+		setsockopt(sock->socket, IPPROTO_TCP, TCP_NODELAY, (char*)(&on), sizeof(on));
+		on = GET_FLAG(sock->net.options, RSO_KEEP_ALIVE) != 0;
+		setsockopt(sock->socket, SOL_SOCKET, SO_KEEPALIVE, (char*)(&on), sizeof(on));
+	}
+	if (!listen) return;
+#ifdef TCP_FASTOPEN
+	if (!GET_FLAG(sock->modes, RST_UDP)) {
+		on = GET_FLAG(sock->net.options, RSO_FAST_OPEN) ? FAST_OPEN_QUEUE : 0;
+		setsockopt(sock->socket, IPPROTO_TCP, TCP_FASTOPEN, (char*)(&on), sizeof(on));
+	}
+#endif
+#ifdef SO_REUSEPORT
+	on = GET_FLAG(sock->net.options, RSO_REUSE_PORT) != 0;
+	setsockopt(sock->socket, SOL_SOCKET, SO_REUSEPORT, (char*)(&on), sizeof(on));
+#endif
+}
+
+static long Send_Gather(REBREQ *sock, SOCKAI *sa, int flags)
+{
+	// Send the unsent part (from sock->actual) of a block write.
+	// Memory segments are sent together with one sendmsg(). A file
+	// segment is sent by the OS from the file itself (sendfile).
+	// Returns bytes sent, or -1 with the error in GET_ERROR.
+	REBIOV *seg = (REBIOV *)sock->data;
+	u32 skip = sock->actual;
+	u32 left = sock->length - sock->actual;
+	u32 max = sa ? MAX_DATAGRAM : MAX_TRANSFER; // (sa is only given for UDP)
+#ifndef TO_WIN32
+	struct iovec iov[MAX_GATHER];
+	struct msghdr msg;
+	int n;
+#endif
+
+	if (!left) return 0;
+	if (left > max) left = max;
+
+	// Find the first segment not fully sent:
+	for (; skip >= seg->length; seg++) skip -= seg->length;
+
+	if (!seg->data) {
+#ifdef HAS_SENDFILE
+		off_t index = seg->index + skip;
+		long result = sendfile(sock->socket, seg->file, &index, MIN(seg->length - skip, MAX_TRANSFER));
+		if (result == 0) errno = EIO, result = -1; // file got shorter
+		return result;
+#else
+		errno = EINVAL; // no sendfile on this OS (p-net.c does not allow it)
+		return -1;
+#endif
+	}
+
+#ifdef TO_WIN32
+	return sendto(sock->socket, seg->data + skip, MIN(seg->length - skip, max), flags,
+					(struct sockaddr*)sa, sa ? sizeof(*sa) : 0);
+#else
+	for (n = 0; n < MAX_GATHER && left > 0 && seg->data; n++, seg++) {
+		iov[n].iov_base = seg->data + skip;
+		iov[n].iov_len = MIN(seg->length - skip, left);
+		left -= iov[n].iov_len;
+		skip = 0;
+	}
+
+	CLEARS(&msg);
+	msg.msg_name = sa;
+	msg.msg_namelen = sa ? sizeof(*sa) : 0;
+	msg.msg_iov = iov;
+	msg.msg_iovlen = n;
+	return sendmsg(sock->socket, &msg, flags);
+#endif
 }
 
 static REBOOL Nonblocking_Mode(SOCKET sock)
@@ -104,6 +253,100 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 #endif
 }
 
+#ifdef HAS_IPV6
+static int Make_Socket6(void)
+{
+	// Make a non-blocking IPv6 TCP socket, or return BAD_SOCKET.
+	int result = (int)socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+
+	if (result != BAD_SOCKET && !Nonblocking_Mode(result)) {
+		CLOSE_SOCKET(result);
+		return BAD_SOCKET;
+	}
+	return result;
+}
+
+static int Try_Connect(int socket, struct sockaddr *sa, int len)
+{
+	// Start (or check) a connect. Returns zero when connected,
+	// NE_INPROGRESS while still trying, else the error.
+	int result = connect(socket, sa, len);
+
+	if (result == 0) return 0;
+	result = GET_ERROR;
+	if (result == NE_ISCONN) return 0;
+	if (result == NE_WOULDBLOCK || result == NE_INPROGRESS || result == NE_ALREADY)
+		return NE_INPROGRESS;
+	return result;
+}
+
+static void End_Race(REBREQ *sock, int ipv6)
+{
+	// Keep one of the two connect attempts and close the other.
+	int loser = sock->net.alt_socket;
+
+	if (ipv6) {
+		loser = sock->socket;
+		sock->socket = sock->net.alt_socket;
+	}
+	else CLR_FLAG(sock->state, RSM_IPV6);
+	CLR_FLAG(sock->state, RSM_RACE);
+#ifdef USE_EPOLL
+	Unwatch_Request(sock, loser);
+#endif
+	CLOSE_SOCKET(loser);
+}
+
+static int Connect_IPv6(REBREQ *sock)
+{
+	// Connect to a host that has an IPv6 address. If it also has an
+	// IPv4 address, both are tried at once and the first to connect
+	// is kept, so a broken IPv6 route does not stall the connection
+	// (as RFC 8305 "Happy Eyeballs", without the delay for IPv4).
+	// Returns as Try_Connect().
+	struct sockaddr_in6 sa6;
+	SOCKAI sa;
+	int r4, r6;
+
+	Set_Addr(&sa, sock->net.remote_ip, sock->net.remote_port);
+	Set_Addr6(&sa6, sock->net.remote_ip6, sock->net.remote_port);
+
+	// On the first try, make the IPv6 socket (Open_Socket made IPv4):
+	if (!GET_FLAG(sock->state, RSM_ATTEMPT)) {
+		r6 = Make_Socket6();
+		if (r6 == BAD_SOCKET) {
+			if (!sock->net.remote_ip) return GET_ERROR;
+			CLR_FLAG(sock->state, RSM_IPV6); // IPv4 only
+			return Try_Connect(sock->socket, (struct sockaddr *)&sa, sizeof(sa));
+		}
+		if (sock->net.remote_ip) {
+			sock->net.alt_socket = r6;
+			SET_FLAG(sock->state, RSM_RACE);
+		}
+		else {
+			CLOSE_SOCKET(sock->socket);
+			sock->socket = r6;
+		}
+	}
+
+	if (!GET_FLAG(sock->state, RSM_RACE))
+		return Try_Connect(sock->socket, (struct sockaddr *)&sa6, sizeof(sa6));
+
+	r6 = Try_Connect(sock->net.alt_socket, (struct sockaddr *)&sa6, sizeof(sa6));
+	r4 = Try_Connect(sock->socket, (struct sockaddr *)&sa, sizeof(sa));
+
+	if (r6 == 0 || (r6 == NE_INPROGRESS && r4 != 0 && r4 != NE_INPROGRESS)) {
+		End_Race(sock, TRUE);
+		return r6;
+	}
+	if (r4 == 0 || r6 != NE_INPROGRESS) {
+		End_Race(sock, FALSE);
+		return r4;
+	}
+	return NE_INPROGRESS; // both still trying
+}
+#endif
+
 
 /***********************************************************************
 **
@@ -251,6 +494,17 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 
 	if (GET_FLAG(sock->state, RSM_OPEN)) {
 
+#ifdef USE_DNS_THREADS
+		if (GET_FLAG(sock->state, RSM_LOOKUP)) Cancel_Resolve(sock);
+#endif
+#ifdef HAS_IPV6
+		if (GET_FLAG(sock->state, RSM_RACE)) {
+#ifdef USE_EPOLL
+			Unwatch_Request(sock, sock->net.alt_socket);
+#endif
+			CLOSE_SOCKET(sock->net.alt_socket);
+		}
+#endif
 		sock->state = 0;  // clear: RSM_OPEN, RSM_CONNECT
 
 		// If DNS pending, abort it:
@@ -262,6 +516,9 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 			sock->socket = sock->length; // Restore TCP socket (see Lookup)
 		}
 
+#ifdef USE_EPOLL
+		Unwatch_Request(sock, sock->socket);
+#endif
 		if (CLOSE_SOCKET(sock->socket)) {
 			sock->error = GET_ERROR;
 			Signal_Device(sock, EVT_ERROR);
@@ -321,6 +578,31 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 	}
 	OS_Free(host);
 #else
+#ifdef USE_DNS_THREADS
+	// Check if we are polling for completion (see host-dns.c):
+	if (GET_FLAG(sock->state, RSM_LOOKUP)) {
+		Reap_Resolves();
+		if (!GET_FLAG(sock->flags, RRF_DONE)) return DR_PEND; // still waiting
+		CLR_FLAG(sock->flags, RRF_DONE);
+		CLR_FLAG(sock->state, RSM_LOOKUP);
+		if (sock->error) {
+			Signal_Device(sock, EVT_ERROR);
+			return DR_ERROR;
+		}
+		Signal_Device(sock, EVT_LOOKUP);
+		return DR_DONE;
+	}
+
+	// Else, start the lookup (or get it from the cache):
+	switch (Resolve_Host(sock, sock->data)) {
+	case DR_DONE:
+		Signal_Device(sock, EVT_LOOKUP);
+		return DR_DONE;
+	case DR_PEND:
+		SET_FLAG(sock->state, RSM_LOOKUP);
+		return DR_PEND; // keep it on pending list
+	}
+#endif
 	// Use old-style blocking DNS (mainly for testing purposes):
 	host = gethostbyname(sock->data);
 	sock->net.host_info = 0; // no allocated data
@@ -376,10 +658,15 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 		return DR_DONE; // done
 	}
 
-	Set_Addr(&sa, sock->net.remote_ip, sock->net.remote_port);
-	result = connect(sock->socket, (struct sockaddr *)&sa, sizeof(sa));
-
-	if (result != 0) result = GET_ERROR;
+#ifdef HAS_IPV6
+	if (GET_FLAG(sock->state, RSM_IPV6)) result = Connect_IPv6(sock);
+	else
+#endif
+	{
+		Set_Addr(&sa, sock->net.remote_ip, sock->net.remote_port);
+		result = connect(sock->socket, (struct sockaddr *)&sa, sizeof(sa));
+		if (result != 0) result = GET_ERROR;
+	}
 
 	WATCH2("connect() error: %d - %s\n", result, strerror(result));
 
@@ -390,6 +677,7 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 		// Connected, set state:
 		CLR_FLAG(sock->state, RSM_ATTEMPT);
 		SET_FLAG(sock->state, RSM_CONNECT);
+		if (sock->net.options) Set_Options(sock, FALSE);
 		Get_Local_IP(sock);
 		Signal_Device(sock, EVT_CONNECT);
 		return DR_DONE; // done
@@ -402,7 +690,7 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 	case NE_ALREADY:
 		// Still trying:
 		SET_FLAG(sock->state, RSM_ATTEMPT);
-		return DR_PEND;
+		return Pend_Socket(sock, TRUE); // writable when connected
 
 	default:
 		// An error happened:
@@ -445,6 +733,8 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 	SOCKAI remote_addr;
 	socklen_t addr_len = sizeof(remote_addr);
 	int mode = (sock->command == RDC_READ ? RSM_RECEIVE : RSM_SEND);
+	// A UDP write is sent as datagrams that must each fit in 64 KB:
+	long max = (mode == RSM_SEND && GET_FLAG(sock->modes, RST_UDP)) ? MAX_DATAGRAM : MAX_TRANSFER;
 
 	if (!GET_FLAG(sock->state, RSM_CONNECT)
 		&&!GET_FLAG(sock->modes, RST_UDP)) {
@@ -456,7 +746,7 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 	SET_FLAG(sock->state, mode);
 
 	// Limit size of transfer:
-	len = MIN(sock->length - sock->actual, MAX_TRANSFER);
+	len = MIN(sock->length - sock->actual, max);
 
 	if (mode == RSM_SEND) {
 		// If host is no longer connected:
@@ -465,19 +755,33 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 		flags |= MSG_NOSIGNAL;
 #endif
 		Set_Addr(&remote_addr, sock->net.remote_ip, sock->net.remote_port);
-		result = sendto(sock->socket, sock->data, len, flags,
-						(struct sockaddr*)&remote_addr, addr_len);
-		WATCH2("send() len: %d actual: %d\n", len, result);
+
+		// Keep sending until done or the socket buffer is full:
+		do {
+			if (GET_FLAG(sock->modes, RST_GATHER))
+				result = Send_Gather(sock, GET_FLAG(sock->modes, RST_UDP) ? &remote_addr : 0, flags);
+			else {
+				// (The address is ignored when connected, and may be the
+				// wrong family for it, so is only given for UDP.)
+				if (GET_FLAG(sock->modes, RST_UDP))
+					result = sendto(sock->socket, sock->data, len, flags,
+									(struct sockaddr*)&remote_addr, addr_len);
+				else
+					result = send(sock->socket, sock->data, len, flags);
+				if (result > 0) sock->data += result;
+			}
+			WATCH2("send() len: %d actual: %d\n", len, result);
+			if (result > 0) sock->actual += result;
+			len = MIN(sock->length - sock->actual, max);
+		} while (result > 0 && len > 0);
 
 		if (result >= 0) {
-			sock->data += result;
-			sock->actual += result;
 			if (sock->actual >= sock->length) {
 				Signal_Device(sock, EVT_WROTE);
 				return DR_DONE;
 			}
 			SET_FLAG(sock->flags, RRF_ACTIVE); /* notify OS_WAIT of activity */
-			return DR_PEND;
+			return Pend_Socket(sock, TRUE);
 		}
 		// if (result < 0) ...
 	}
@@ -507,7 +811,7 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 	// Check error code:
 	result = GET_ERROR;
 	WATCH2("get error: %d %s\n", result, strerror(result));
-	if (result == NE_WOULDBLOCK) return DR_PEND; // still waiting
+	if (result == NE_WOULDBLOCK) return Pend_Socket(sock, mode == RSM_SEND); // still waiting
 
 	WATCH4("ERROR: recv(%d %x) len: %d error: %d\n", sock->socket, sock->data, len, result);
 	// A nasty error happened:
@@ -534,10 +838,34 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 	int result;
 	int len = 1;
 	SOCKAI sa;
+#ifdef HAS_IPV6
+	struct sockaddr_in6 sa6;
+	int off = 0;
+	int ipv6 = FALSE;
+#endif
 
 	// Setup socket address range and port:
 	Set_Addr(&sa, INADDR_ANY, sock->net.local_port);
 
+#ifdef HAS_IPV6
+	// A TCP server takes both IPv6 and IPv4 connections, using an
+	// IPv6 socket that is not IPv6-only. If that cannot be done,
+	// the IPv4 socket made by Open_Socket is used:
+	if (!GET_FLAG(sock->modes, RST_UDP)) {
+		result = Make_Socket6();
+		if (result != BAD_SOCKET) {
+			if (setsockopt(result, IPPROTO_IPV6, IPV6_V6ONLY, (char*)(&off), sizeof(off))) {
+				CLOSE_SOCKET(result);
+			}
+			else {
+				CLOSE_SOCKET(sock->socket);
+				sock->socket = result;
+				ipv6 = TRUE;
+			}
+		}
+	}
+#endif
+
 	// Allow listen socket reuse:
 	result = setsockopt(sock->socket, SOL_SOCKET, SO_REUSEADDR, (char*)(&len), sizeof(len));
 	if (result) {
@@ -547,7 +875,17 @@ lserr:
 		return DR_ERROR;
 	}
 
+	// Options that must be set before the bind (SO_REUSEPORT):
+	if (sock->net.options) Set_Options(sock, TRUE);
+
 	// Bind the socket to our local address:
+#ifdef HAS_IPV6
+	if (ipv6) {
+		Set_Addr6(&sa6, 0, sock->net.local_port);
+		result = bind(sock->socket, (struct sockaddr *)&sa6, sizeof(sa6));
+	}
+	else
+#endif
 	result = bind(sock->socket, (struct sockaddr *)&sa, sizeof(sa));
 	if (result) goto lserr;
 
@@ -563,7 +901,8 @@ lserr:
 	Get_Local_IP(sock);
 	sock->command = RDC_CREATE;	// the command done on wakeup
 
-	return DR_PEND;
+	if (GET_FLAG(sock->modes, RST_UDP)) return DR_PEND;
+	return Pend_Socket(sock, FALSE); // readable when connection arrives
 }
 
 
@@ -571,7 +910,9 @@ lserr:
 **
 */	 DEVICE_CMD Accept_Socket(REBREQ *sock)
 /*
-**		Accept an inbound connection on a TCP listen socket.
+**		Accept the inbound connections on a TCP listen socket.
+**		All that are waiting (up to MAX_ACCEPTS) are taken at
+**		once, each signalled with its own accept event.
 **
 **		The function will return:
 **			=0: succeeded
@@ -585,51 +926,98 @@ lserr:
 **
 ***********************************************************************/
 {
+#ifdef HAS_IPV6
+	struct sockaddr_storage ss; // (the listen socket may be IPv6)
+	SOCKAI *sap = (SOCKAI *)&ss;
+	int size = sizeof(ss);
+#else
 	SOCKAI sa;
+	SOCKAI *sap = &sa;
+	int size = sizeof(sa);
+#endif
+	socklen_t len;
 	REBREQ *news;
-	int len = sizeof(sa);
 	int result;
+	int count;
 	extern void Attach_Request(REBREQ **prior, REBREQ *req);
 
-	// Accept a new socket, if there is one:
-	result = accept(sock->socket, (struct sockaddr *)&sa, &len);
+	for (count = 0; count < MAX_ACCEPTS; count++) {
 
-	if (result == BAD_SOCKET) {
-		result = GET_ERROR;
-		if (result == NE_WOULDBLOCK) return DR_PEND;
-		sock->error = result;
-		Signal_Device(sock, EVT_ERROR);
-		return DR_ERROR;
-	}
-
-	// To report the new socket, the code here creates a temporary
-	// request and copies the listen request to it. Then, it stores
-	// the new values for IP and ports and links this request to the
-	// original via the sock->data.
-	news = MAKE_NEW(*news);	// Be sure to deallocate it
-	CLEARS(news);
-//	*news = *sock;
-	news->device = sock->device;
+		// Accept a new socket, if there is one:
+		len = size;
+#ifdef HAS_ACCEPT4
+		result = accept4(sock->socket, (struct sockaddr *)sap, &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+		result = accept(sock->socket, (struct sockaddr *)sap, &len);
+#endif
 
-	SET_OPEN(news);
-	SET_FLAG(news->state, RSM_OPEN);
-	SET_FLAG(news->state, RSM_CONNECT);
+		if (result == BAD_SOCKET) {
+			result = GET_ERROR;
+			if (result == NE_WOULDBLOCK) break;
+			if (count > 0) break; // report it on the next try
+			sock->error = result;
+			Signal_Device(sock, EVT_ERROR);
+			return DR_ERROR;
+		}
 
-	news->socket = result;
-	news->net.remote_ip   = sa.sin_addr.s_addr; //htonl(ip); NOTE: REBOL stays in network byte order
-	news->net.remote_port = ntohs(sa.sin_port);
-	Get_Local_IP(news);
+		// To report the new socket, the code here creates a temporary
+		// request and copies the listen request to it. Then, it stores
+		// the new values for IP and ports and links this request to the
+		// original via the sock->data.
+		news = MAKE_NEW(*news);	// Be sure to deallocate it
+		CLEARS(news);
+//		*news = *sock;
+		news->device = sock->device;
+
+		SET_OPEN(news);
+		SET_FLAG(news->state, RSM_OPEN);
+		SET_FLAG(news->state, RSM_CONNECT);
+
+		news->socket = result;
+#ifdef HAS_IPV6
+		if (ss.ss_family == AF_INET6) {
+			if (Get_Addr6((struct sockaddr_in6 *)&ss, &news->net.remote_ip, news->net.remote_ip6))
+				SET_FLAG(news->state, RSM_IPV6);
+			news->net.remote_port = ntohs(((struct sockaddr_in6 *)&ss)->sin6_port);
+		}
+		else
+#endif
+		{
+			news->net.remote_ip   = sap->sin_addr.s_addr; //htonl(ip); NOTE: REBOL stays in network byte order
+			news->net.remote_port = ntohs(sap->sin_port);
+		}
+		Get_Local_IP(news);
 
-	Nonblocking_Mode(news->socket);
+#ifndef HAS_ACCEPT4
+		Nonblocking_Mode(news->socket);
+#endif
+		news->net.options = sock->net.options;
+		if (news->net.options) Set_Options(news, FALSE);
 
-	Attach_Request((REBREQ**)&sock->data, news);
-	Signal_Device(sock, EVT_ACCEPT);
+		Attach_Request((REBREQ**)&sock->data, news);
+		Signal_Device(sock, EVT_ACCEPT);
+	}
 
 	// Even though we signalled, we keep the listen pending to
 	// accept additional connections.
-	return DR_PEND;
+	return Pend_Socket(sock, FALSE);
 }
 
+/***********************************************************************
+**
+*/	DEVICE_CMD Modify_Socket(REBREQ *sock)
+/*
+**		Set the socket options (sock->net.options) now. If it is
+**		not yet connected or listening, they are set when it is.
+**
+***********************************************************************/
+{
+	if (sock->state & ((1<<RSM_CONNECT) | (1<<RSM_BIND)))
+		Set_Options(sock, GET_FLAG(sock->state, RSM_BIND));
+	return DR_DONE;
+}
+
+
 /***********************************************************************
 **
 **	Command Dispatch Table (RDC_ enum order)
@@ -646,7 +1034,7 @@ static DEVICE_CMD_FUNC Dev_Cmds[RDC_MAX] = {
 	0,	// poll
 	Connect_Socket,
 	0,	// query
-	0,	// modify
+	Modify_Socket,
 	Accept_Socket,			// Create
 	0,	// delete
 	0,	// rename
@@ -48,6 +48,9 @@
 #include "rsa/rsa.h"
 #include "dh/dh.h"
 #include "aes/aes.h"
+#include "gcm/gcm.h"
+#include "chacha20/chacha20.h"
+#include "ecdh/ecdh.h"
 
 #define INCLUDE_EXT_DATA
 #include "host-ext-core.h"
@@ -64,6 +67,36 @@ REBINT encapBufferLen;
 RL_LIB *RL; // Link back to reb-lib from embedded extensions
 static u32 *core_ext_words;
 
+// Context of the AEAD command (the handle):
+typedef struct {
+	REBCNT method;	// W_CORE_AES_GCM or W_CORE_CHACHA20_POLY1305
+	union {
+		GCM_CTX gcm;
+		CHACHA20_CTX chacha;
+	} cipher;
+} AEAD_CTX;
+
+/***********************************************************************
+**
+*/	static int Ecdh_Curve(REBSER *obj)
+/*
+**	Get the ECDH curve id from the CURVE field of a key object.
+**
+***********************************************************************/
+{
+	RXIARG val;
+
+	if (RL_GET_FIELD(obj, core_ext_words[W_CORE_CURVE], &val) != RXT_WORD) return 0;
+
+	switch (RL_FIND_WORD(core_ext_words, val.int32a)) {
+		case W_CORE_X25519:
+			return ECDH_X25519;
+		case W_CORE_SECP256R1:
+			return ECDH_SECP256R1;
+	}
+	return 0;
+}
+
 /***********************************************************************
 **
 */	RXIEXT int RXD_Core(int cmd, RXIFRM *frm, REBCEC *data)
@@ -366,6 +399,107 @@ static u32 *core_ext_words;
 			return RXR_VALUE;
 		}
 
+		case CMD_CORE_AEAD_KEY:
+		{
+			AEAD_CTX *ctx;
+			REBSER *key = RXA_SERIES(frm, 2);
+			REBYTE *keyBuffer = (REBYTE *)RL_SERIES(key, RXI_SER_DATA) + RXA_INDEX(frm, 2);
+			REBINT len = RL_SERIES(key, RXI_SER_TAIL) - RXA_INDEX(frm, 2);
+
+			ctx = (AEAD_CTX*)OS_Make(sizeof(*ctx));
+			memset(ctx, 0, sizeof(*ctx));
+			ctx->method = RL_FIND_WORD(core_ext_words, RXA_WORD(frm, 1));
+
+			switch (ctx->method) {
+				case W_CORE_AES_GCM:
+					// uses AES-NI and PCLMULQDQ when the CPU has them
+					if (GCM_set_key(&ctx->cipher.gcm, keyBuffer, len)) break;
+					OS_Free(ctx);
+					return RXR_NONE;
+				case W_CORE_CHACHA20_POLY1305:
+					if (len == CHACHA20_KEY_SIZE) {
+						ChaCha20_set_key(&ctx->cipher.chacha, keyBuffer);
+						break;
+					}
+				default:
+					OS_Free(ctx);
+					return RXR_NONE;
+			}
+
+			RXA_TYPE(frm, 1) = RXT_HANDLE;
+			RXA_HANDLE(frm, 1) = ctx;
+			return RXR_VALUE;
+		}
+
+		case CMD_CORE_AEAD:
+		{
+			AEAD_CTX *ctx = (AEAD_CTX*)RXA_HANDLE(frm, 1);
+			REBSER *nonce, *aad, *data, *binaryOut;
+			REBYTE *nonceBuffer, *aadBuffer, *dataBuffer, *binaryOutBuffer;
+			REBINT aad_len, len, out_len;
+			REBOOL ok = TRUE;
+
+			if (RXA_TYPE(frm, 2) == RXT_NONE) {
+				//destroy context
+				memset(ctx, 0, sizeof(*ctx));
+				OS_Free(ctx);
+				RXA_LOGIC(frm, 1) = TRUE;
+				RXA_TYPE(frm, 1) = RXT_LOGIC;
+				return RXR_VALUE;
+			}
+
+			nonce = RXA_SERIES(frm, 2);
+			nonceBuffer = (REBYTE *)RL_SERIES(nonce, RXI_SER_DATA) + RXA_INDEX(frm, 2);
+			if (RL_SERIES(nonce, RXI_SER_TAIL) - RXA_INDEX(frm, 2) != 12) return RXR_NONE;
+
+			aad = RXA_SERIES(frm, 3);
+			aadBuffer = (REBYTE *)RL_SERIES(aad, RXI_SER_DATA) + RXA_INDEX(frm, 3);
+			aad_len = RL_SERIES(aad, RXI_SER_TAIL) - RXA_INDEX(frm, 3);
+
+			data = RXA_SERIES(frm, 4);
+			dataBuffer = (REBYTE *)RL_SERIES(data, RXI_SER_DATA) + RXA_INDEX(frm, 4);
+			len = RL_SERIES(data, RXI_SER_TAIL) - RXA_INDEX(frm, 4);
+
+			// The 16 byte tag follows the encrypted data:
+			if (RXA_WORD(frm, 5)) { // decrypt refinement
+				if (len < 16) return RXR_NONE;
+				out_len = len - 16;
+			}
+			else out_len = len + 16;
+
+			//allocate new binary! for output
+			binaryOut = (REBSER*)RL_Make_String(out_len, FALSE);
+			binaryOutBuffer = (REBYTE *)RL_SERIES(binaryOut, RXI_SER_DATA);
+
+			if (ctx->method == W_CORE_AES_GCM) {
+				if (RXA_WORD(frm, 5))
+					ok = GCM_decrypt(&ctx->cipher.gcm, nonceBuffer, aadBuffer, aad_len,
+						dataBuffer, binaryOutBuffer, out_len, dataBuffer + out_len);
+				else
+					GCM_encrypt(&ctx->cipher.gcm, nonceBuffer, aadBuffer, aad_len,
+						dataBuffer, binaryOutBuffer, len, binaryOutBuffer + len);
+			} else {
+				if (RXA_WORD(frm, 5))
+					ok = ChaCha20_Poly1305_decrypt(&ctx->cipher.chacha, nonceBuffer, aadBuffer, aad_len,
+						dataBuffer, binaryOutBuffer, out_len, dataBuffer + out_len);
+				else
+					ChaCha20_Poly1305_encrypt(&ctx->cipher.chacha, nonceBuffer, aadBuffer, aad_len,
+						dataBuffer, binaryOutBuffer, len, binaryOutBuffer + len);
+			}
+
+			// Not authentic, so none of it is returned:
+			if (!ok) return RXR_NONE;
+
+			//hack! - will set the tail to buffersize
+			*((REBCNT*)(binaryOut+1)) = out_len;
+
+			//setup returned binary! value
+			RXA_TYPE(frm, 1) = RXT_BINARY;
+			RXA_SERIES(frm, 1) = binaryOut;
+			RXA_INDEX(frm, 1) = 0;
+			return RXR_VALUE;
+		}
+
 		case CMD_CORE_RSA:
 		{
 			RXIARG val;
@@ -604,6 +738,78 @@ static u32 *core_ext_words;
 			return RXR_VALUE;
 		}
 
+		case CMD_CORE_ECDH_GENERATE_KEY:
+		{
+			ECDH_CTX ecdh_ctx;
+			RXIARG priv_key, pub_key;
+			REBSER *obj = RXA_OBJECT(frm, 1);
+			int pub_len;
+
+			memset(&ecdh_ctx, 0, sizeof(ecdh_ctx));
+			ecdh_ctx.curve = Ecdh_Curve(obj);
+			pub_len = ECDH_pub_size(ecdh_ctx.curve);
+
+			if (!pub_len) break;
+
+			//allocate new binary! blocks for priv/pub keys
+			priv_key.series = (REBSER*)RL_Make_String(ECDH_PRIV_SIZE, FALSE);
+			priv_key.index = 0;
+			ecdh_ctx.priv = (REBYTE *)RL_SERIES(priv_key.series, RXI_SER_DATA);
+			//hack! - will set the tail to key size
+			*((REBCNT*)(((void**)priv_key.series)+1)) = ECDH_PRIV_SIZE;
+
+			pub_key.series = (REBSER*)RL_Make_String(pub_len, FALSE);
+			pub_key.index = 0;
+			ecdh_ctx.pub = (REBYTE *)RL_SERIES(pub_key.series, RXI_SER_DATA);
+			//hack! - will set the tail to key size
+			*((REBCNT*)(((void**)pub_key.series)+1)) = pub_len;
+
+			//generate keys
+			ECDH_generate_key(&ecdh_ctx);
+
+			//set the object fields
+			RL_Set_Field(obj, core_ext_words[W_CORE_PRIV_KEY], priv_key, RXT_BINARY);
+			RL_Set_Field(obj, core_ext_words[W_CORE_PUB_KEY], pub_key, RXT_BINARY);
+
+			break;
+		}
+
+		case CMD_CORE_ECDH_COMPUTE_KEY:
+		{
+			ECDH_CTX ecdh_ctx;
+			RXIARG val;
+			REBSER *obj = RXA_OBJECT(frm, 1);
+			REBSER *pub_key = RXA_SERIES(frm, 2);
+			REBSER *binary;
+
+			memset(&ecdh_ctx, 0, sizeof(ecdh_ctx));
+			ecdh_ctx.curve = Ecdh_Curve(obj);
+
+			if (RL_GET_FIELD(obj, core_ext_words[W_CORE_PRIV_KEY], &val) != RXT_BINARY
+				|| RL_SERIES(val.series, RXI_SER_TAIL) - val.index != ECDH_PRIV_SIZE
+			) return RXR_NONE;
+
+			ecdh_ctx.priv = (REBYTE *)RL_SERIES(val.series, RXI_SER_DATA) + val.index;
+			ecdh_ctx.peer = (REBYTE *)RL_SERIES(pub_key, RXI_SER_DATA) + RXA_INDEX(frm, 2);
+			ecdh_ctx.peer_len = RL_SERIES(pub_key, RXI_SER_TAIL) - RXA_INDEX(frm, 2);
+
+			//allocate new binary!
+			binary = (REBSER*)RL_Make_String(ECDH_SECRET_SIZE, FALSE);
+			ecdh_ctx.k = (REBYTE *)RL_SERIES(binary, RXI_SER_DATA);
+
+			// Unknown curve, or the peer's key is not a point of the curve:
+			if (!ECDH_compute_key(&ecdh_ctx)) return RXR_NONE;
+
+			//hack! - will set the tail to buffersize
+			*((REBCNT*)(binary+1)) = ECDH_SECRET_SIZE;
+
+			//setup returned binary! value
+			RXA_TYPE(frm,1) = RXT_BINARY;
+			RXA_SERIES(frm,1) = binary;
+			RXA_INDEX(frm,1) = 0;
+			return RXR_VALUE;
+		}
+
         case CMD_CORE_INIT_WORDS:
             core_ext_words = RL_MAP_WORDS(RXA_SERIES(frm,1));
             break;
@@ -77,6 +77,9 @@ extern REBDEV Dev_Serial;
 #ifdef HAS_POSIX_SIGNAL
 extern REBDEV Dev_Signal;
 #endif
+#ifdef HAS_POSIX_SPAWN
+extern REBDEV Dev_Process;
+#endif
 
 REBDEV *Devices[RDI_LIMIT] =
 {
@@ -95,6 +98,9 @@ REBDEV *Devices[RDI_LIMIT] =
 	&Dev_Serial,
 #ifdef HAS_POSIX_SIGNAL
 	&Dev_Signal,
+#endif
+#ifdef HAS_POSIX_SPAWN
+	&Dev_Process,
 #endif
 	0,
 };
@@ -111,6 +117,12 @@ static int Poll_Default(REBDEV *dev)
 
 	for (req = *prior; req; req = *prior) {
 
+		// Skip it if still waiting for the OS to say it is ready:
+		if (GET_FLAG(req->flags, RRF_WATCH)) {
+			prior = &req->next;
+			continue;
+		}
+
 		// Call command again:
 		if (req->command < RDC_MAX) {
 			CLR_FLAG(req->flags, RRF_ACTIVE);
@@ -326,8 +338,9 @@ static int Poll_Default(REBDEV *dev)
 		return -1;
 	}
 
-	// Do the command:
+	// Do the command (device will watch it again if it must wait):
 	req->command = command;
+	CLR_FLAG(req->flags, RRF_WATCH);
 	result = dev->commands[command](req);
 
 	// If request is pending, attach it to device for polling:
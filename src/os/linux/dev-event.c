@@ -42,6 +42,10 @@
 #include <string.h>
 #include <unistd.h>
 #include <sys/time.h>
+#include <errno.h>
+#ifdef USE_EPOLL
+#include <sys/epoll.h>
+#endif
 
 #include "reb-host.h"
 #include "host-lib.h"
@@ -62,6 +66,145 @@ void X_Finish_Resizing();
 #endif  // REB_CORE
 
 
+#ifdef USE_EPOLL
+#define MAX_READY 64	// ready handles taken per wait
+
+static int Epoll_FD = -1;
+#ifndef REB_CORE
+static int X11_Watched = 0;
+#endif
+
+#define MAX_HANDLES 4	// other handles waited on (e.g. io_uring)
+
+static struct watch_handle {
+	int fd;
+	void (*ready)(void);
+} Handles[MAX_HANDLES];
+static int Num_Handles = 0;
+
+static int Get_Epoll(void)
+{
+	// The epoll set is made on first use (may be before Init_Events).
+	if (Epoll_FD < 0) Epoll_FD = epoll_create1(EPOLL_CLOEXEC);
+	return Epoll_FD;
+}
+
+
+/***********************************************************************
+**
+*/	int Watch_Request(REBREQ *req, int fd, int out)
+/*
+**		Called by a device when a pending request must wait for
+**		its handle to be readable (or writable, if out is set).
+**		The request is not polled again until Query_Events finds
+**		the handle ready. It is armed for a single event, so the
+**		device calls this each time the request would block.
+**
+**		Returns FALSE if the handle cannot be watched (e.g. it is
+**		a regular file). The request is then polled as before.
+**
+***********************************************************************/
+{
+	struct epoll_event ev;
+	int ep = Get_Epoll();
+
+	CLR_FLAG(req->flags, RRF_WATCH);
+	if (ep < 0) return FALSE;
+
+	ev.events = (out ? EPOLLOUT : EPOLLIN) | EPOLLONESHOT;
+	ev.data.ptr = req;
+
+	// Usually already in the set, so try MOD first:
+	if (epoll_ctl(ep, EPOLL_CTL_MOD, fd, &ev) < 0) {
+		if (errno != ENOENT || epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev) < 0)
+			return FALSE;
+	}
+
+	SET_FLAG(req->flags, RRF_WATCH);
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	void Unwatch_Request(REBREQ *req, int fd)
+/*
+**		Remove the handle from the epoll set. Must be called
+**		before the handle is closed (or the request is freed).
+**
+***********************************************************************/
+{
+	CLR_FLAG(req->flags, RRF_WATCH);
+	if (Epoll_FD >= 0) epoll_ctl(Epoll_FD, EPOLL_CTL_DEL, fd, 0);
+}
+
+
+/***********************************************************************
+**
+*/	int Watch_Handle(int fd, void (*ready)(void))
+/*
+**		Wait on a handle that does not belong to a request (such
+**		as the io_uring completion eventfd). Query_Events calls the
+**		ready function each time the handle can be read.
+**
+***********************************************************************/
+{
+	struct epoll_event ev;
+	int ep = Get_Epoll();
+
+	if (ep < 0 || Num_Handles >= MAX_HANDLES) return FALSE;
+
+	Handles[Num_Handles].fd = fd;
+	Handles[Num_Handles].ready = ready;
+	ev.events = EPOLLIN;
+	ev.data.ptr = &Handles[Num_Handles];
+	if (epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev) < 0) return FALSE;
+
+	Num_Handles++;
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static int Wait_Ready(int millisec)
+/*
+**		Wait for watched handles (and X11 events) or the timeout.
+**		Requests that became ready are released for polling.
+**		Returns FALSE if epoll is not available.
+**
+***********************************************************************/
+{
+	struct epoll_event evs[MAX_READY];
+	int ep = Get_Epoll();
+	int n;
+
+	if (ep < 0) return FALSE;
+
+#ifndef REB_CORE
+	if (!X11_Watched && global_x_info->display != NULL) {
+		evs[0].events = EPOLLIN;
+		evs[0].data.ptr = 0; // not a request
+		epoll_ctl(ep, EPOLL_CTL_ADD, ConnectionNumber(global_x_info->display), &evs[0]);
+		X11_Watched = 1;
+	}
+#endif
+
+	n = epoll_wait(ep, evs, MAX_READY, millisec);
+
+	while (n-- > 0) {
+		void *p = evs[n].data.ptr;
+		if (p >= (void*)Handles && p < (void*)&Handles[MAX_HANDLES])
+			((struct watch_handle *)p)->ready();
+		else if (p)
+			CLR_FLAG(((REBREQ*)p)->flags, RRF_WATCH);
+	}
+
+	return TRUE;
+}
+#endif
+
+
 /***********************************************************************
 **
 */	DEVICE_CMD Init_Events(REBREQ *dr)
@@ -111,6 +254,13 @@ void X_Finish_Resizing();
 	fd_set in_fds;
 	int x11_fd = 0;
 
+#ifdef USE_EPOLL
+	if (Wait_Ready(req->length)) {
+		Poll_Events(NULL);
+		return DR_DONE;
+	}
+#endif
+
 	tv.tv_sec = 0;
 	tv.tv_usec = req->length * 1000;
 	FD_ZERO(&in_fds);
@@ -49,6 +49,8 @@
 #include "reb-host.h"
 #include "host-lib.h"
 
+extern void Signal_Device(REBREQ *req, REBINT type);
+
 #ifndef O_BINARY
 #define O_BINARY 0
 #endif
@@ -56,6 +58,11 @@
 // NOTE: the code below assumes a file id will never by zero. This should
 // be safe. In posix, zero is stdin, which is handled by dev-stdio.c.
 
+#ifdef USE_IO_URING
+#define URING_MIN 65536	// smaller IO is faster done directly
+int Uring_Submit(REBREQ *req, int write);
+#endif
+
 
 /***********************************************************************
 **
@@ -113,6 +120,27 @@ static REBOOL Seek_File_64(REBREQ *file)
 	return 1;
 }
 
+static int Write_Rest(REBREQ *file)
+{
+	// Write the data from file->actual to the end. A write can do
+	// less than asked (e.g. when interrupted by a signal), so loop
+	// until it is all written or there is an error.
+	ssize_t bytes;
+
+	while (file->actual < file->length) {
+		bytes = write(file->id, file->data + file->actual, file->length - file->actual);
+		if (bytes < 0 && errno == EINTR) continue;
+		if (bytes <= 0) {
+			if (bytes < 0 && errno == ENOSPC) file->error = -RFE_DISK_FULL;
+			else file->error = -RFE_BAD_WRITE;
+			return DR_ERROR;
+		}
+		file->actual += bytes;
+	}
+
+	return DR_DONE;
+}
+
 static int Get_File_Info(REBREQ *file)
 {
 	struct stat info;
@@ -236,6 +264,21 @@ static int Get_File_Info(REBREQ *file)
 	// Line below DOES NOT WORK -- because we need full path.
 	//Get_File_Info(file); // updates modes, size, time
 
+	// For READ/DEEP, also get the size and date. The stat is done
+	// relative to the open dir, so the full path is not needed (and
+	// not looked up again). Links are not followed, so a link to a
+	// dir is returned as a file and the walk cannot loop.
+	if (GET_FLAG(dir->modes, RFM_DEEP)) {
+		file->file.size = 0;
+		file->file.time.l = 0;
+		if (!fstatat(dirfd(h), cp, &info, AT_SYMLINK_NOFOLLOW)) {
+			CLR_FLAG(file->modes, RFM_DIR);
+			if (S_ISDIR(info.st_mode)) SET_FLAG(file->modes, RFM_DIR);
+			else file->file.size = info.st_size;
+			file->file.time.l = (long)(info.st_mtime);
+		}
+	}
+
 	return DR_DONE;
 }
 
@@ -349,6 +392,21 @@ fail:
 		return Read_Directory(file, (REBREQ*)file->data);
 	}
 
+#ifdef USE_IO_URING
+	// Finish a read that was done in the background:
+	if (GET_FLAG(file->flags, RRF_DONE)) {
+		CLR_FLAG(file->flags, RRF_DONE);
+		if (file->error) {
+			file->error = -RFE_BAD_READ;
+			if (GET_FLAG(file->modes, RFM_AWAKE)) Signal_Device(file, EVT_ERROR);
+			return DR_ERROR;
+		}
+		file->file.index += file->actual;
+		if (GET_FLAG(file->modes, RFM_AWAKE)) Signal_Device(file, EVT_READ);
+		return DR_DONE;
+	}
+#endif
+
 	if (!file->id) {
 		file->error = -RFE_NO_HANDLE;
 		return DR_ERROR;
@@ -360,7 +418,11 @@ fail:
 	}
 
 	// printf("read %d len %d\n", file->id, file->length);
-	
+
+#ifdef USE_IO_URING
+	if (file->length >= URING_MIN && Uring_Submit(file, FALSE)) return DR_PEND;
+#endif
+
 	bytes = read(file->id, file->data, file->length);
 	if (bytes < 0) {
 		file->error = -RFE_BAD_READ;
@@ -382,12 +444,26 @@ fail:
 **
 ***********************************************************************/
 {
-	ssize_t bytes = 0;
 	if (!file->id) {
 		file->error = -RFE_NO_HANDLE;
 		return DR_ERROR;
 	}
 
+#ifdef USE_IO_URING
+	// Finish a write that was done in the background:
+	if (GET_FLAG(file->flags, RRF_DONE)) {
+		REBINT result = DR_ERROR;
+		CLR_FLAG(file->flags, RRF_DONE);
+		if (file->error)
+			file->error = (file->error == ENOSPC) ? -RFE_DISK_FULL : -RFE_BAD_WRITE;
+		else
+			result = Write_Rest(file); // (if only part was written)
+		if (GET_FLAG(file->modes, RFM_AWAKE))
+			Signal_Device(file, result < 0 ? EVT_ERROR : EVT_WROTE);
+		return result;
+	}
+#endif
+
 	if (GET_FLAG(file->modes, RFM_APPEND)) {
 		CLR_FLAG(file->modes, RFM_APPEND);
 		lseek(file->id, 0, SEEK_END);
@@ -402,13 +478,42 @@ fail:
 
 	if (file->length == 0) return DR_DONE;
 
-	file->actual = bytes = write(file->id, file->data, file->length);
-	if (bytes < 0) {
-		if (errno == ENOSPC) file->error = -RFE_DISK_FULL;
-		else file->error = -RFE_BAD_WRITE;
+#ifdef USE_IO_URING
+	if (file->length >= URING_MIN && Uring_Submit(file, TRUE)) return DR_PEND;
+#endif
+
+	file->actual = 0;
+	return Write_Rest(file);
+}
+
+
+/***********************************************************************
+**
+*/	DEVICE_CMD Modify_File(REBREQ *file)
+/*
+**		Apply the modes set by MODIFY to an open file:
+**			RFM_SEQUENTIAL - tell the OS the file is used in order
+**			RFM_SYNC - write the data to the disk now (then cleared)
+**
+***********************************************************************/
+{
+	if (!file->id) {
+		file->error = -RFE_NO_HANDLE;
 		return DR_ERROR;
 	}
 
+#ifdef POSIX_FADV_SEQUENTIAL
+	posix_fadvise(file->id, 0, 0, GET_FLAG(file->modes, RFM_SEQUENTIAL) ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_NORMAL);
+#endif
+
+	if (GET_FLAG(file->modes, RFM_SYNC)) {
+		CLR_FLAG(file->modes, RFM_SYNC);
+		if (fdatasync(file->id) < 0) {
+			file->error = -RFE_BAD_WRITE;
+			return DR_ERROR;
+		}
+	}
+
 	return DR_DONE;
 }
 
@@ -505,10 +610,14 @@ static DEVICE_CMD_FUNC Dev_Cmds[RDC_MAX] = {
 	Close_File,
 	Read_File,
 	Write_File,
+#ifdef USE_IO_URING
+	0,	// poll (default, to finish background IO)
+#else
 	Poll_File,
+#endif
 	0,	// connect
 	Query_File,
-	0,	// modify
+	Modify_File,
 	Create_File,
 	Delete_File,
 	Rename_File,
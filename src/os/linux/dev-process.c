@@ -0,0 +1,389 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Title: Device: Process streams on Linux
+**  Purpose:
+**      Runs a program with its stdin, stdout and stderr connected
+**      to pipes, for the PROCESS port. The pipes are read and written
+**      as the other devices do, so the program runs while REBOL
+**      does other work (no blocking wait as for CALL/OUTPUT).
+**
+**      The exit of the program is watched with a pidfd (Linux 5.3).
+**      Without it, the exit is polled.
+**
+************************************************************************
+**
+**  NOTE to PROGRAMMERS:
+**
+**    1. Keep code clear and simple.
+**    2. Document unusual code, reasoning, or gotchas.
+**    3. Use same style for code, vars, indent(4), comments, etc.
+**    4. Keep in mind Linux, OS X, BSD, big/little endian CPUs.
+**    5. Test everything, then test it again.
+**
+***********************************************************************/
+
+#define _GNU_SOURCE		// pipe2
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <sys/syscall.h>
+
+#include "reb-host.h"
+#include "host-lib.h"
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434	// older headers
+#endif
+
+extern char **environ;
+extern void Signal_Device(REBREQ *req, REBINT type);
+
+#ifdef USE_EPOLL
+int Watch_Request(REBREQ *req, int fd, int out);
+void Unwatch_Request(REBREQ *req, int fd);
+#define WAIT_PROCESS(r,f,o) Watch_Request(r, f, o)
+#define UNWATCH_PROCESS(r,f) Unwatch_Request(r, f)
+#else
+#define WAIT_PROCESS(r,f,o)
+#define UNWATCH_PROCESS(r,f)
+#endif
+
+
+/***********************************************************************
+**
+*/	static void Close_Pipe(REBREQ *req, int *fd)
+/*
+**		Stop watching a pipe (or the pidfd) and close it.
+**
+***********************************************************************/
+{
+	if (*fd < 0) return;
+	UNWATCH_PROCESS(req, *fd);
+	close(*fd);
+	*fd = -1;
+}
+
+
+/***********************************************************************
+**
+*/	static int Reap_Process(REBREQ *req, int wait)
+/*
+**		Get the exit code, if the process is done. Returns FALSE if
+**		it is still running. A process ended by a signal gets the
+**		negative signal number as its exit code.
+**
+***********************************************************************/
+{
+	int status = 0;
+	pid_t pid;
+
+	if (GET_FLAG(req->modes, RPM_EXITED)) return TRUE;
+
+	do pid = waitpid(req->process.pid, &status, wait ? 0 : WNOHANG);
+	while (pid < 0 && errno == EINTR);
+	if (pid == 0) return FALSE;
+
+	if (pid < 0) req->process.exit_code = -1; // reaped by someone else
+	else if (WIFSIGNALED(status)) req->process.exit_code = -WTERMSIG(status);
+	else req->process.exit_code = WEXITSTATUS(status);
+
+	SET_FLAG(req->modes, RPM_EXITED);
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static ssize_t Write_Pipe(int fd, REBYTE *data, size_t len)
+/*
+**		Write to the stdin pipe. If the program has closed it, the
+**		write must fail with EPIPE, not raise SIGPIPE (which would
+**		end REBOL). So, SIGPIPE is blocked during the write, and
+**		taken if it was raised.
+**
+***********************************************************************/
+{
+	struct timespec now = {0, 0};
+	sigset_t pipe_set;
+	sigset_t old_set;
+	ssize_t result;
+
+	sigemptyset(&pipe_set);
+	sigaddset(&pipe_set, SIGPIPE);
+	sigprocmask(SIG_BLOCK, &pipe_set, &old_set);
+
+	result = write(fd, data, len);
+	if (result < 0 && errno == EPIPE && !sigismember(&old_set, SIGPIPE)) {
+		sigtimedwait(&pipe_set, 0, &now);
+		errno = EPIPE;
+	}
+
+	sigprocmask(SIG_SETMASK, &old_set, 0);
+	return result;
+}
+
+
+/***********************************************************************
+**
+*/	DEVICE_CMD Open_Process(REBREQ *req)
+/*
+**		Start the program given by req->process.argv, with its
+**		stdin and stdout (and stderr, if RPM_CAPTURE_ERROR) on pipes.
+**		With RPM_SHELL, argv[0] is a command line run by /bin/sh.
+**
+**		posix_spawnp is used rather than fork, so that the memory of
+**		REBOL is not copied (glibc uses a vfork style clone), and an
+**		exec failure is returned here.
+**
+**		Only this end of each pipe is non-blocking. The program gets
+**		normal pipes and an empty signal mask (signals blocked for a
+**		signal port are not blocked in the program).
+**
+***********************************************************************/
+{
+	posix_spawn_file_actions_t actions;
+	posix_spawnattr_t attr;
+	sigset_t no_signals;
+	char *shell[4];
+	char **argv = (char **)req->process.argv;
+	int in[2]  = {-1, -1};
+	int out[2] = {-1, -1};
+	int err[2] = {-1, -1};
+	pid_t pid;
+	int result;
+
+	req->id = -1;
+	req->process.in = -1;
+	req->process.err = -1;
+	req->process.pidfd = -1;
+	req->process.exit_code = 0;
+	CLR_FLAG(req->modes, RPM_EXITED);
+
+	if (pipe2(in, O_CLOEXEC) < 0 || pipe2(out, O_CLOEXEC) < 0
+		|| (GET_FLAG(req->modes, RPM_CAPTURE_ERROR) && pipe2(err, O_CLOEXEC) < 0)) {
+		result = errno;
+		goto fail;
+	}
+
+	if (GET_FLAG(req->modes, RPM_SHELL)) {
+		shell[0] = "/bin/sh";
+		shell[1] = "-c";
+		shell[2] = argv[0];
+		shell[3] = 0;
+		argv = shell;
+	}
+
+	// The child ends are duplicated to 0, 1 and 2. The originals
+	// are closed by the exec (O_CLOEXEC), as are the parent ends.
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_adddup2(&actions, in[0], STDIN_FILENO);
+	posix_spawn_file_actions_adddup2(&actions, out[1], STDOUT_FILENO);
+	if (err[1] >= 0) posix_spawn_file_actions_adddup2(&actions, err[1], STDERR_FILENO);
+
+	posix_spawnattr_init(&attr);
+	sigemptyset(&no_signals);
+	posix_spawnattr_setsigmask(&attr, &no_signals);
+	posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK);
+
+	result = posix_spawnp(&pid, argv[0], &actions, &attr, argv, environ);
+
+	posix_spawnattr_destroy(&attr);
+	posix_spawn_file_actions_destroy(&actions);
+	if (result) goto fail;
+
+	close(in[0]);
+	close(out[1]);
+	if (err[1] >= 0) close(err[1]);
+
+	fcntl(in[1], F_SETFL, O_NONBLOCK);
+	fcntl(out[0], F_SETFL, O_NONBLOCK);
+	if (err[0] >= 0) fcntl(err[0], F_SETFL, O_NONBLOCK);
+
+	req->id = out[0];
+	req->process.in = in[1];
+	req->process.err = err[0];
+	req->process.pid = pid;
+	req->process.pidfd = syscall(SYS_pidfd_open, pid, 0); // -1 if not supported
+
+	SET_OPEN(req);
+	return DR_DONE;
+
+fail:
+	if (in[0] >= 0)  close(in[0]);
+	if (in[1] >= 0)  close(in[1]);
+	if (out[0] >= 0) close(out[0]);
+	if (out[1] >= 0) close(out[1]);
+	if (err[0] >= 0) close(err[0]);
+	if (err[1] >= 0) close(err[1]);
+	req->error = result;
+	return DR_ERROR;
+}
+
+
+/***********************************************************************
+**
+*/	DEVICE_CMD Close_Process(REBREQ *req)
+/*
+**		Close the pipes. If the program is still running, it is
+**		killed (and reaped, so it does not stay as a zombie).
+**
+***********************************************************************/
+{
+	Close_Pipe(req, &req->process.in);
+	Close_Pipe(req, &req->id);
+	Close_Pipe(req, &req->process.err);
+
+	if (!Reap_Process(req, FALSE)) {
+		kill(req->process.pid, SIGKILL);
+		Reap_Process(req, TRUE);
+	}
+	Close_Pipe(req, &req->process.pidfd);
+
+	SET_CLOSED(req);
+	return DR_DONE;
+}
+
+
+/***********************************************************************
+**
+*/	DEVICE_CMD Read_Process(REBREQ *req)
+/*
+**		Read what the program wrote to stdout, or to stderr (then
+**		RPM_FROM_ERROR is set). Stays pending until there is data.
+**
+**		When both have ended, the request waits for the program to
+**		exit. Then its exit code is set and a CLOSE event is sent.
+**
+***********************************************************************/
+{
+	int *fds[2];
+	ssize_t len;
+	int n;
+
+	fds[0] = &req->id;
+	fds[1] = &req->process.err;
+
+	for (n = 0; n < 2; n++) {
+		if (*fds[n] < 0) continue;
+		len = read(*fds[n], req->data, req->length);
+		if (len > 0) {
+			req->actual = len;
+			if (n) SET_FLAG(req->modes, RPM_FROM_ERROR);
+			else CLR_FLAG(req->modes, RPM_FROM_ERROR);
+			Signal_Device(req, EVT_READ);
+			return DR_DONE;
+		}
+		if (len == 0) Close_Pipe(req, fds[n]); // end of stream
+		else if (errno != EAGAIN && errno != EINTR) {
+			req->error = errno;
+			Signal_Device(req, EVT_ERROR);
+			return DR_ERROR;
+		}
+	}
+
+	req->actual = 0;
+
+	// Wait for more data:
+	if (req->id >= 0 || req->process.err >= 0) {
+		if (req->id >= 0) WAIT_PROCESS(req, req->id, FALSE);
+		if (req->process.err >= 0) WAIT_PROCESS(req, req->process.err, FALSE);
+		return DR_PEND;
+	}
+
+	// Or for the exit:
+	if (!Reap_Process(req, FALSE)) {
+		if (req->process.pidfd >= 0) WAIT_PROCESS(req, req->process.pidfd, FALSE);
+		return DR_PEND;
+	}
+
+	Signal_Device(req, EVT_CLOSE);
+	return DR_DONE;
+}
+
+
+/***********************************************************************
+**
+*/	DEVICE_CMD Write_Process(REBREQ *req)
+/*
+**		Write req->data to the stdin of the program. Stays pending
+**		until all of it is written. A write of zero length closes
+**		stdin, so that the program sees the end of its input.
+**
+***********************************************************************/
+{
+	ssize_t len;
+
+	if (req->length == 0) {
+		Close_Pipe(req, &req->process.in);
+		Signal_Device(req, EVT_WROTE);
+		return DR_DONE;
+	}
+
+	if (req->process.in < 0) {
+		req->error = EPIPE;
+		Signal_Device(req, EVT_ERROR);
+		return DR_ERROR;
+	}
+
+	while (req->actual < req->length) {
+		len = Write_Pipe(req->process.in, req->data + req->actual, req->length - req->actual);
+		if (len < 0) {
+			if (errno == EINTR) continue;
+			if (errno == EAGAIN) {
+				WAIT_PROCESS(req, req->process.in, TRUE);
+				return DR_PEND;
+			}
+			req->error = errno;
+			Signal_Device(req, EVT_ERROR);
+			return DR_ERROR;
+		}
+		req->actual += len;
+	}
+
+	Signal_Device(req, EVT_WROTE);
+	return DR_DONE;
+}
+
+
+/***********************************************************************
+**
+**	Command Dispatch Table (RDC_ enum order)
+**
+***********************************************************************/
+
+static DEVICE_CMD_FUNC Dev_Cmds[RDC_MAX] =
+{
+	0,
+	0,
+	Open_Process,
+	Close_Process,
+	Read_Process,
+	Write_Process,
+	0,	// poll
+};
+
+DEFINE_DEV(Dev_Process, "Process", 1, Dev_Cmds, RDC_MAX, 0);
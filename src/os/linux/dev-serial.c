@@ -50,6 +50,14 @@
 
 #define MAX_SERIAL_PATH 128
 
+#ifdef USE_EPOLL
+int Watch_Request(REBREQ *req, int fd, int out);
+void Unwatch_Request(REBREQ *req, int fd);
+#define WAIT_SERIAL(r,o) Watch_Request(r, (r)->id, o)
+#else
+#define WAIT_SERIAL(r,o)
+#endif
+
 /* BXXX constants are defined in termios.h */ 
 const int speeds[] = {
 	50, B50,
@@ -251,6 +259,9 @@ static REBINT Set_Serial_Settings(int ttyfd, REBREQ *req)
 	if (req->id) {
 		//Warning: should free req->serial.prior_attr termios struct?
 		tcsetattr(req->id, TCSANOW, req->serial.prior_attr);
+#ifdef USE_EPOLL
+		Unwatch_Request(req, req->id);
+#endif
 		close(req->id);
 		req->id = 0;
 	}
@@ -279,6 +290,7 @@ static REBINT Set_Serial_Settings(int ttyfd, REBREQ *req)
 		Signal_Device(req, EVT_ERROR);
 		return DR_ERROR;
 	} else if (result == 0) {
+		WAIT_SERIAL(req, FALSE);
 		return DR_PEND;
 	} else {
 		req->actual = result;
@@ -310,6 +322,7 @@ static REBINT Set_Serial_Settings(int ttyfd, REBREQ *req)
 #endif
 	if (result < 0) {
 		if (errno == EAGAIN) {
+			WAIT_SERIAL(req, TRUE);
 			return DR_PEND;
 		}
 		req->error = -RFE_BAD_WRITE;
@@ -323,6 +336,7 @@ static REBINT Set_Serial_Settings(int ttyfd, REBREQ *req)
 		return DR_DONE;
 	} else {
 		SET_FLAG(req->flags, RRF_ACTIVE); /* notify OS_WAIT of activity */
+		WAIT_SERIAL(req, TRUE);
 		return DR_PEND;
 	}
 }
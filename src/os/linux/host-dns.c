@@ -0,0 +1,410 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Title: Host name lookups done by a pool of threads
+**  Purpose:
+**      getaddrinfo() and getnameinfo() can block for seconds. Here
+**      they run on helper threads, so the DNS and TCP devices can
+**      return DR_PEND and other ports keep running. Only the lookup
+**      itself is done by the threads; everything that touches a
+**      request or the cache is done on the main thread, when the
+**      results are reaped (Reap_Resolves).
+**
+**      A name is looked up for both IPv4 and IPv6. The first address
+**      of each kind is kept; the TCP device connects to both at once.
+**
+**      Recent results are kept in a small cache. getaddrinfo() does
+**      not report the record TTL, so entries expire after a fixed
+**      time (DNS_CACHE_TIME).
+**
+************************************************************************
+**
+**  NOTE to PROGRAMMERS:
+**
+**    1. Keep code clear and simple.
+**    2. Document unusual code, reasoning, or gotchas.
+**    3. Use same style for code, vars, indent(4), comments, etc.
+**    4. Keep in mind Linux, OS X, BSD, big/little endian CPUs.
+**    5. Test everything, then test it again.
+**
+***********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+
+#include "reb-host.h"
+#include "host-lib.h"
+#include "sys-net.h"
+
+#define DNS_THREADS 4		// lookups that can run at once
+#define DNS_CACHE_SIZE 64	// names remembered
+#define DNS_CACHE_TIME 60	// seconds a name is remembered
+
+int Watch_Handle(int fd, void (*ready)(void));
+void Reap_Resolves(void);
+
+typedef struct dns_job {
+	struct dns_job *next;
+	REBREQ *req;		// zero if the request was cancelled
+	int reverse;		// address to name
+	int error;			// getaddrinfo() error, zero if none
+	u32 ip;				// network byte order (zero if none)
+	int has_ip6;		// an IPv6 address was found
+	u8 ip6[16];
+	char name[MAX_HOST_NAME];
+} DNS_JOB;
+
+typedef struct dns_entry {
+	char name[MAX_HOST_NAME];
+	u32 ip;
+	int has_ip6;
+	u8 ip6[16];
+	time_t expires;
+} DNS_ENTRY;
+
+static pthread_mutex_t Dns_Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t Dns_Wake = PTHREAD_COND_INITIALIZER;
+static DNS_JOB *Dns_Todo;	// waiting for a thread (FIFO)
+static DNS_JOB *Dns_Done;	// waiting to be reaped
+static DNS_JOB *Dns_Busy;	// started, still running (for cancel)
+static int Dns_Event = -1;	// signalled when a job is done
+static int Dns_State = 0;	// 0: not started, 1: running, -1: failed
+
+static DNS_ENTRY Dns_Cache[DNS_CACHE_SIZE];
+
+
+/***********************************************************************
+**
+*/	static void *Dns_Thread(void *arg)
+/*
+**		Take jobs from the queue and do the (blocking) lookups.
+**
+***********************************************************************/
+{
+	DNS_JOB *job;
+	DNS_JOB **prior;
+	struct addrinfo hints;
+	struct addrinfo *info;
+	struct addrinfo *ai;
+	SOCKAI sa;
+	u64 one = 1;
+
+	CLEARS(&hints);
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM; // (else each address is listed per type)
+	hints.ai_flags = AI_ADDRCONFIG;  // (no IPv6 results if no IPv6 network)
+
+	for (;;) {
+		pthread_mutex_lock(&Dns_Lock);
+		while (!Dns_Todo) pthread_cond_wait(&Dns_Wake, &Dns_Lock);
+		job = Dns_Todo;
+		Dns_Todo = job->next;
+		job->next = Dns_Busy;
+		Dns_Busy = job;
+		pthread_mutex_unlock(&Dns_Lock);
+
+		if (job->reverse) {
+			CLEARS(&sa);
+			sa.sin_family = AF_INET;
+			sa.sin_addr.s_addr = job->ip;
+			job->error = getnameinfo((struct sockaddr *)&sa, sizeof(sa), job->name, sizeof(job->name), 0, 0, NI_NAMEREQD);
+		}
+		else {
+			job->error = getaddrinfo(job->name, 0, &hints, &info);
+			if (!job->error) {
+				for (ai = info; ai; ai = ai->ai_next) {
+					if (ai->ai_family == AF_INET && !job->ip)
+						job->ip = ((SOCKAI *)ai->ai_addr)->sin_addr.s_addr;
+					else if (ai->ai_family == AF_INET6 && !job->has_ip6) {
+						memcpy(job->ip6, &((struct sockaddr_in6 *)ai->ai_addr)->sin6_addr, 16);
+						job->has_ip6 = TRUE;
+					}
+				}
+				freeaddrinfo(info);
+				if (!job->ip && !job->has_ip6) job->error = EAI_NONAME;
+			}
+		}
+
+		// Move it to the done list and wake up the main thread:
+		pthread_mutex_lock(&Dns_Lock);
+		for (prior = &Dns_Busy; *prior != job; prior = &(*prior)->next);
+		*prior = job->next;
+		job->next = Dns_Done;
+		Dns_Done = job;
+		pthread_mutex_unlock(&Dns_Lock);
+		if (write(Dns_Event, &one, sizeof(one)) < 0) {} // (counter cannot overflow)
+	}
+
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	static int Start_Resolver(void)
+/*
+**		Start the threads on first use. Returns FALSE if that
+**		is not possible (lookups then block as before).
+**
+***********************************************************************/
+{
+	pthread_attr_t attr;
+	pthread_t thread;
+	int n;
+
+	Dns_State = -1;
+
+	Dns_Event = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (Dns_Event < 0) return FALSE;
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	pthread_attr_setstacksize(&attr, 256 * 1024);
+	for (n = 0; n < DNS_THREADS; n++) {
+		if (pthread_create(&thread, &attr, Dns_Thread, 0)) break;
+	}
+	pthread_attr_destroy(&attr);
+	if (n == 0) return FALSE;
+
+	// Wake up the event wait when a lookup is done (if it can):
+	Watch_Handle(Dns_Event, Reap_Resolves);
+
+	Dns_State = 1;
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static DNS_ENTRY *Find_Cached(char *name)
+/*
+**		Return the cache entry for a name, or zero.
+**
+***********************************************************************/
+{
+	DNS_ENTRY *entry;
+	time_t now = time(0);
+
+	for (entry = Dns_Cache; entry < Dns_Cache + DNS_CACHE_SIZE; entry++) {
+		if (entry->expires > now && !strcmp(entry->name, name)) return entry;
+	}
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	static void Set_Host(REBREQ *req, u32 ip, int has_ip6, u8 *ip6)
+/*
+**		Give a looked up address to a request.
+**
+***********************************************************************/
+{
+	req->net.remote_ip = ip;
+	if (has_ip6) {
+		memcpy(req->net.remote_ip6, ip6, 16);
+		SET_FLAG(req->state, RSM_IPV6);
+	}
+	else CLR_FLAG(req->state, RSM_IPV6);
+}
+
+
+/***********************************************************************
+**
+*/	static void Cache_Host(DNS_JOB *job)
+/*
+**		Remember a name. Replaces the entry that expires first.
+**
+***********************************************************************/
+{
+	DNS_ENTRY *entry;
+	DNS_ENTRY *oldest = Dns_Cache;
+
+	for (entry = Dns_Cache; entry < Dns_Cache + DNS_CACHE_SIZE; entry++) {
+		if (!strcmp(entry->name, job->name)) {
+			oldest = entry;
+			break;
+		}
+		if (entry->expires < oldest->expires) oldest = entry;
+	}
+
+	strcpy(oldest->name, job->name); // (length checked by Resolve_Host)
+	oldest->ip = job->ip;
+	oldest->has_ip6 = job->has_ip6;
+	memcpy(oldest->ip6, job->ip6, 16);
+	oldest->expires = time(0) + DNS_CACHE_TIME;
+}
+
+
+/***********************************************************************
+**
+*/	static int Queue_Job(REBREQ *req, char *name, u32 ip)
+/*
+***********************************************************************/
+{
+	DNS_JOB *job;
+	DNS_JOB **tail;
+
+	if (Dns_State == 0) Start_Resolver();
+	if (Dns_State < 0) return DR_ERROR;
+
+	job = OS_Make(sizeof(DNS_JOB));
+	CLEARS(job);
+	job->req = req;
+	job->ip = ip;
+	if (name) strcpy(job->name, name);
+	else job->reverse = TRUE;
+
+	pthread_mutex_lock(&Dns_Lock);
+	for (tail = &Dns_Todo; *tail; tail = &(*tail)->next);
+	*tail = job;
+	pthread_cond_signal(&Dns_Wake);
+	pthread_mutex_unlock(&Dns_Lock);
+
+	CLR_FLAG(req->flags, RRF_DONE);
+	return DR_PEND;
+}
+
+
+/***********************************************************************
+**
+*/	int Resolve_Host(REBREQ *req, char *name)
+/*
+**		Look up the addresses of a host name. The IPv4 address goes
+**		in req->net.remote_ip (zero if none). If there is an IPv6
+**		address, it goes in req->net.remote_ip6 and RSM_IPV6 is set.
+**
+**		Returns:
+**			DR_DONE: found in the cache (result is set)
+**			DR_PEND: being looked up; RRF_DONE is set when done,
+**				with the error (if any) in req->error
+**			DR_ERROR: cannot be done here (caller must do it)
+**
+***********************************************************************/
+{
+	DNS_ENTRY *entry;
+
+	if (strlen(name) >= MAX_HOST_NAME) return DR_ERROR;
+
+	if ((entry = Find_Cached(name)) != 0) {
+		Set_Host(req, entry->ip, entry->has_ip6, entry->ip6);
+		return DR_DONE;
+	}
+
+	return Queue_Job(req, name, 0);
+}
+
+
+/***********************************************************************
+**
+*/	int Resolve_Addr(REBREQ *req)
+/*
+**		Look up the host name of req->net.remote_ip. When done,
+**		the name is copied to req->net.host_info, which must have
+**		room for MAX_HOST_NAME bytes, and req->data points to it.
+**		Returns DR_PEND or DR_ERROR (as Resolve_Host).
+**
+***********************************************************************/
+{
+	return Queue_Job(req, 0, req->net.remote_ip);
+}
+
+
+/***********************************************************************
+**
+*/	void Cancel_Resolve(REBREQ *req)
+/*
+**		The request no longer wants its result (e.g. it was
+**		closed). The lookup may still run, but is ignored.
+**
+***********************************************************************/
+{
+	DNS_JOB *lists[3];
+	DNS_JOB *job;
+	int n;
+
+	if (Dns_State <= 0) return;
+
+	pthread_mutex_lock(&Dns_Lock);
+	lists[0] = Dns_Todo;
+	lists[1] = Dns_Busy;
+	lists[2] = Dns_Done;
+	for (n = 0; n < 3; n++) {
+		for (job = lists[n]; job; job = job->next) {
+			if (job->req == req) job->req = 0;
+		}
+	}
+	pthread_mutex_unlock(&Dns_Lock);
+}
+
+
+/***********************************************************************
+**
+*/	void Reap_Resolves(void)
+/*
+**		Give the finished lookups to their requests (and cache),
+**		setting RRF_DONE. Called when the event wait is woken up,
+**		and by the devices when they poll.
+**
+***********************************************************************/
+{
+	DNS_JOB *job;
+	DNS_JOB *next;
+	REBREQ *req;
+	u64 count;
+
+	if (Dns_State <= 0) return;
+
+	// Reset the wake up first, even when a device poll already took
+	// the job it was for (the workers write it after the list changes),
+	// or it stays readable and the event wait never sleeps:
+	if (read(Dns_Event, &count, sizeof(count)) < 0) {} // (non-blocking)
+
+	pthread_mutex_lock(&Dns_Lock);
+	job = Dns_Done;
+	Dns_Done = 0;
+	pthread_mutex_unlock(&Dns_Lock);
+	if (!job) return;
+
+	for (; job; job = next) {
+		next = job->next;
+		if ((req = job->req) != 0) {
+			req->error = job->error;
+			if (!job->error) {
+				if (job->reverse) {
+					strcpy(req->net.host_info, job->name);
+					req->data = req->net.host_info;
+				}
+				else {
+					Set_Host(req, job->ip, job->has_ip6, job->ip6);
+					Cache_Host(job);
+				}
+			}
+			SET_FLAG(req->flags, RRF_DONE);
+		}
+		OS_Free(job);
+	}
+}
@@ -58,11 +58,14 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <sys/wait.h>
 #include <time.h>
 #include <string.h>
 #include <errno.h>
+#include <pthread.h>
+#include <spawn.h>
 
 #ifndef timeval // for older systems
 #include <sys/time.h>
@@ -84,6 +87,8 @@ REBSER* Gob_To_Image(REBGOB *gob);
 // Semaphore lock to sync sub-task launch:
 static void *Task_Ready;
 
+#define MAX_PAR_THREADS 64	// for OS_Run_Parallel
+
 #ifndef PATH_MAX
 #define PATH_MAX 4096  // generally lacking in Posix
 #endif
@@ -764,6 +769,44 @@ error:
 	}
 }
 
+/***********************************************************************
+**
+*/	void *OS_Map_File(REBREQ *file, i64 index, REBCNT length)
+/*
+**		Map part of an open file into memory (copy-on-write), so it can
+**		be used without reading it. Returns the address of the data
+**		at index, or zero if it cannot be mapped.
+**
+**		Release it with OS_Unmap_File. The file can be closed first.
+**
+***********************************************************************/
+{
+	long page = sysconf(_SC_PAGESIZE);
+	long skip = (long)(index % page); // map must start on a page
+	REBYTE *mem;
+
+	if (!file->id || !length) return 0;
+
+	mem = mmap(0, length + skip, PROT_READ | PROT_WRITE, MAP_PRIVATE, file->id, index - skip);
+	if (mem == MAP_FAILED) return 0;
+	return mem + skip;
+}
+
+
+/***********************************************************************
+**
+*/	void OS_Unmap_File(void *data, REBCNT length)
+/*
+**		Release memory mapped by OS_Map_File.
+**
+***********************************************************************/
+{
+	long skip = (long)((REBUPT)data % sysconf(_SC_PAGESIZE));
+
+	munmap((REBYTE *)data - skip, length + skip);
+}
+
+
 
 /***********************************************************************
 **
@@ -871,6 +914,118 @@ error:
 	//SetEvent(Task_Ready);
 }
 
+
+/***********************************************************************
+**
+*/	REBINT OS_Get_CPUs(void)
+/*
+**		Return the number of processors that are online.
+**
+***********************************************************************/
+{
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return (n > 0) ? (REBINT)n : 1;
+}
+
+
+typedef struct {
+	CFUNC job;
+	REBYTE *jobs;
+	REBCNT size;
+	REBCNT count;
+	REBCNT next;
+	pthread_mutex_t lock;
+} PAR_JOBS;
+
+static void *Run_Jobs(void *arg)
+{
+	PAR_JOBS *par = (PAR_JOBS*)arg;
+	REBCNT n;
+
+	for (;;) {
+		pthread_mutex_lock(&par->lock);
+		n = par->next++;
+		pthread_mutex_unlock(&par->lock);
+		if (n >= par->count) break;
+		par->job(par->jobs + n * par->size);
+	}
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	REBINT OS_Run_Parallel(CFUNC job, void *jobs, REBCNT size, REBCNT count, REBCNT threads)
+/*
+**		Call job for each of count structs (of size bytes) in the
+**		jobs array, on up to threads threads (the calling thread is
+**		one of them). Returns when all jobs are done, with the
+**		number of threads used.
+**
+**		Jobs must not call into REBOL: it is not thread safe.
+**		If a thread cannot be started, the others do its share.
+**
+***********************************************************************/
+{
+	pthread_t tids[MAX_PAR_THREADS];
+	PAR_JOBS par;
+	REBCNT n;
+
+	par.job = job;
+	par.jobs = (REBYTE*)jobs;
+	par.size = size;
+	par.count = count;
+	par.next = 0;
+	pthread_mutex_init(&par.lock, 0);
+
+	threads = MIN(MIN(threads, count), MAX_PAR_THREADS);
+	for (n = 1; n < threads; n++) {
+		if (pthread_create(&tids[n], 0, Run_Jobs, &par)) break;
+	}
+	threads = n;
+
+	Run_Jobs(&par);
+	for (n = 1; n < threads; n++) pthread_join(tids[n], 0);
+
+	pthread_mutex_destroy(&par.lock);
+	return threads;
+}
+
+extern char **environ;
+
+/***********************************************************************
+**
+*/	static ssize_t Read_Pipe(int fd, char **buffer, u32 *len, size_t *size)
+/*
+**		Read all that is ready from a (non-blocking) pipe, adding it
+**		to the buffer. The buffer is doubled as needed, so a large
+**		output takes few reallocations. Returns 0 at the end of the
+**		stream, -1 for EAGAIN or an error (errno), else the last read.
+**
+***********************************************************************/
+{
+	ssize_t nbytes;
+	char *larger;
+
+	for (;;) {
+		if (*len == *size) {
+			larger = realloc(*buffer, *size * 2);
+			if (larger == NULL) {
+				errno = ENOMEM;
+				return -1;
+			}
+			*buffer = larger;
+			*size *= 2;
+		}
+		nbytes = read(fd, *buffer + *len, *size - *len);
+		if (nbytes <= 0) {
+			if (nbytes < 0 && errno == EINTR) continue;
+			return nbytes;
+		}
+		*len += nbytes;
+	}
+}
+
 /***********************************************************************
 **
 */	int OS_Create_Process(REBCHR *call, int argc, char* argv[], u32 flags, u64 *pid, int *exit_code, u32 input_type, void *input, u32 input_len, u32 output_type, void **output, u32 *output_len, u32 err_type, void **err, u32 *err_len)
@@ -910,12 +1065,9 @@ error:
 	int stdin_pipe[] = {-1, -1};
 	int stdout_pipe[] = {-1, -1};
 	int stderr_pipe[] = {-1, -1};
-	int info_pipe[] = {-1, -1};
 	int status = 0;
 	int ret = 0;
-	char *info = NULL;
-	off_t info_size = 0;
-	u32 info_len = 0;
+	posix_spawn_file_actions_t actions;
 	pid_t fpid = 0;
 
 	if (flags & FLAG_WAIT) flag_wait = TRUE;
@@ -923,141 +1075,86 @@ error:
 	if (flags & FLAG_SHELL) flag_shell = TRUE;
 	if (flags & FLAG_INFO) flag_info = TRUE;
 
+	// The pipes are made non-blocking on this side only (after the
+	// spawn), so the program gets normal (blocking) stdin and stdout.
 	if (input_type == STRING_TYPE
 		|| input_type == BINARY_TYPE) {
-		if (pipe2(stdin_pipe, O_CLOEXEC | O_NONBLOCK) < 0) {
+		if (pipe2(stdin_pipe, O_CLOEXEC) < 0) {
 			goto stdin_pipe_err;
 		}
 	}
 	if (output_type == STRING_TYPE
 		|| output_type == BINARY_TYPE) {
-		if (pipe2(stdout_pipe, O_CLOEXEC | O_NONBLOCK) < 0) {
+		if (pipe2(stdout_pipe, O_CLOEXEC) < 0) {
 			goto stdout_pipe_err;
 		}
 	}
 	if (err_type == STRING_TYPE
 		|| err_type == BINARY_TYPE) {
-		if (pipe2(stderr_pipe, O_CLOEXEC | O_NONBLOCK) < 0) {
+		if (pipe2(stderr_pipe, O_CLOEXEC) < 0) {
 			goto stderr_pipe_err;
 		}
 	}
 
-	if (pipe2(info_pipe, O_CLOEXEC | O_NONBLOCK) < 0) {
-		goto info_pipe_err;
+	// The child is started with posix_spawnp rather than fork, so the
+	// memory of REBOL is not copied (glibc uses a vfork style clone).
+	// The redirections are done by file actions in the child, and an
+	// exec failure is returned by posix_spawnp (no info pipe needed).
+	posix_spawn_file_actions_init(&actions);
+
+	if (input_type == STRING_TYPE
+		|| input_type == BINARY_TYPE) {
+		posix_spawn_file_actions_adddup2(&actions, stdin_pipe[R], STDIN_FILENO);
+	} else if (input_type == FILE_TYPE) {
+		posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, input, O_RDONLY, 0);
+	} else if (input_type == NONE_TYPE) {
+		posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+	} else { /* inherit stdin from the parent */
 	}
 
-	fpid = fork();
-	if (fpid == 0) {
-		/* child */
-		if (input_type == STRING_TYPE
-			|| input_type == BINARY_TYPE) {
-			close(stdin_pipe[W]);
-			if (dup2(stdin_pipe[R], STDIN_FILENO) < 0) {
-				goto child_error;
-			}
-			close(stdin_pipe[R]);
-		} else if (input_type == FILE_TYPE) {
-			int fd = open(input, O_RDONLY);
-			if (fd < 0) {
-				goto child_error;
-			}
-			if (dup2(fd, STDIN_FILENO) < 0) {
-				goto child_error;
-			}
-			close(fd);
-		} else if (input_type == NONE_TYPE) {
-			int fd = open("/dev/null", O_RDONLY);
-			if (fd < 0) {
-				goto child_error;
-			}
-			if (dup2(fd, STDIN_FILENO) < 0) {
-				goto child_error;
-			}
-			close(fd);
-		} else { /* inherit stdin from the parent */
-		}
-		
-		if (output_type == STRING_TYPE
-			|| output_type == BINARY_TYPE) {
-			close(stdout_pipe[R]);
-			if (dup2(stdout_pipe[W], STDOUT_FILENO) < 0) {
-				goto child_error;
-			}
-			close(stdout_pipe[W]);
-		} else if (output_type == FILE_TYPE) {
-			int fd = open(*output, O_CREAT|O_WRONLY, 0666);
-			if (fd < 0) {
-				goto child_error;
-			}
-			if (dup2(fd, STDOUT_FILENO) < 0) {
-				goto child_error;
-			}
-			close(fd);
-		} else if (output_type == NONE_TYPE) {
-			int fd = open("/dev/null", O_WRONLY);
-			if (fd < 0) {
-				goto child_error;
-			}
-			if (dup2(fd, STDOUT_FILENO) < 0) {
-				goto child_error;
-			}
-			close(fd);
-		} else { /* inherit stdout from the parent */
-		}
+	if (output_type == STRING_TYPE
+		|| output_type == BINARY_TYPE) {
+		posix_spawn_file_actions_adddup2(&actions, stdout_pipe[W], STDOUT_FILENO);
+	} else if (output_type == FILE_TYPE) {
+		posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, *output, O_CREAT|O_WRONLY, 0666);
+	} else if (output_type == NONE_TYPE) {
+		posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+	} else { /* inherit stdout from the parent */
+	}
 
-		if (err_type == STRING_TYPE
-			|| err_type == BINARY_TYPE) {
-			close(stderr_pipe[R]);
-			if (dup2(stderr_pipe[W], STDERR_FILENO) < 0) {
-				goto child_error;
-			}
-			close(stderr_pipe[W]);
-		} else if (err_type == FILE_TYPE) {
-			int fd = open(*err, O_CREAT|O_WRONLY, 0666);
-			if (fd < 0) {
-				goto child_error;
-			}
-			if (dup2(fd, STDERR_FILENO) < 0) {
-				goto child_error;
-			}
-			close(fd);
-		} else if (err_type == NONE_TYPE) {
-			int fd = open("/dev/null", O_WRONLY);
-			if (fd < 0) {
-				goto child_error;
-			}
-			if (dup2(fd, STDERR_FILENO) < 0) {
-				goto child_error;
-			}
-			close(fd);
-		} else { /* inherit stderr from the parent */
-		}
+	if (err_type == STRING_TYPE
+		|| err_type == BINARY_TYPE) {
+		posix_spawn_file_actions_adddup2(&actions, stderr_pipe[W], STDERR_FILENO);
+	} else if (err_type == FILE_TYPE) {
+		posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, *err, O_CREAT|O_WRONLY, 0666);
+	} else if (err_type == NONE_TYPE) {
+		posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+	} else { /* inherit stderr from the parent */
+	}
 
-		close(info_pipe[R]);
-
-		//printf("flag_shell in child: %hhu\n", flag_shell);
-		if (flag_shell) {
-			const char* sh = NULL;
-			const char ** argv_new = NULL;
-			sh = getenv("SHELL");
-			if (sh == NULL) {
-				int err = 2; /* shell does not exist */
-				write(info_pipe[W], &err, sizeof(err));
-				exit(EXIT_FAILURE);
-			}
+	//printf("flag_shell in child: %hhu\n", flag_shell);
+	if (flag_shell) {
+		const char* sh = NULL;
+		const char ** argv_new = NULL;
+		sh = getenv("SHELL");
+		if (sh == NULL) {
+			ret = 2; /* shell does not exist */
+		} else {
 			argv_new = OS_Make((argc + 3) * sizeof(char*));
 			argv_new[0] = sh;
 			argv_new[1] = "-c";
 			memcpy(&argv_new[2], argv, argc * sizeof(argv[0]));
 			argv_new[argc + 2] = NULL;
-			execvp(sh, (char* const*)argv_new);
-		} else {
-			execvp(argv[0], argv);
+			ret = posix_spawnp(&fpid, sh, &actions, NULL, (char* const*)argv_new, environ);
+			OS_Free(argv_new);
 		}
-child_error:
-		write(info_pipe[W], &errno, sizeof(errno));
-		exit(EXIT_FAILURE); /* get here only when exec fails */
-	} else if (fpid > 0) {
+	} else {
+		ret = posix_spawnp(&fpid, argv[0], &actions, NULL, argv, environ);
+	}
+
+	posix_spawn_file_actions_destroy(&actions);
+
+	if (ret == 0) {
 		/* parent */
 #define BUF_SIZE_CHUNK 4096
 		nfds_t nfds = 0;
@@ -1066,8 +1163,8 @@ child_error:
 		int i;
 		ssize_t nbytes;
 		off_t input_size = 0;
-		off_t output_size = 0;
-		off_t err_size = 0;
+		size_t output_size = 0;
+		size_t err_size = 0;
 		int exited = 0;
 
 		/* initialize outputs */
@@ -1091,6 +1188,7 @@ child_error:
 
 		if (stdin_pipe[W] > 0) {
 			//printf("stdin_pipe[W]: %d\n", stdin_pipe[W]);
+			fcntl(stdin_pipe[W], F_SETFL, O_NONBLOCK);
 			input_size = strlen((char*)input); /* the passed in input_len is in character, not in bytes */
 			input_len = 0;
 			pfds[nfds++] = (struct pollfd){.fd = stdin_pipe[W], .events = POLLOUT};
@@ -1101,6 +1199,7 @@ child_error:
 			//printf("stdout_pipe[R]: %d\n", stdout_pipe[R]);
 			output_size = BUF_SIZE_CHUNK;
 			*output = OS_Make(output_size);
+			fcntl(stdout_pipe[R], F_SETFL, O_NONBLOCK);
 			pfds[nfds++] = (struct pollfd){.fd = stdout_pipe[R], .events = POLLIN};
 			close(stdout_pipe[W]);
 			stdout_pipe[W] = -1;
@@ -1109,19 +1208,12 @@ child_error:
 			//printf("stderr_pipe[R]: %d\n", stderr_pipe[R]);
 			err_size = BUF_SIZE_CHUNK;
 			*err = OS_Make(err_size);
+			fcntl(stderr_pipe[R], F_SETFL, O_NONBLOCK);
 			pfds[nfds++] = (struct pollfd){.fd = stderr_pipe[R], .events = POLLIN};
 			close(stderr_pipe[W]);
 			stderr_pipe[W] = -1;
 		}
 
-		if (info_pipe[R] > 0) {
-			pfds[nfds++] = (struct pollfd){.fd = info_pipe[R], .events = POLLIN};
-			info_size = 4;
-			info = OS_Make(info_size);
-			close(info_pipe[W]);
-			info_pipe[W] = -1;
-		}
-
 		int valid_nfds = nfds;
 		while (valid_nfds > 0) {
 			xpid = waitpid(fpid, &status, WNOHANG);
@@ -1133,22 +1225,10 @@ child_error:
 			if (xpid == fpid) {
 				/* try one more time to read any remainding output/err */
 				if (stdout_pipe[R] > 0) {
-					nbytes = read(stdout_pipe[R], *output + *output_len, output_size - *output_len);
-					if (nbytes > 0) {
-						*output_len += nbytes;
-					}
+					Read_Pipe(stdout_pipe[R], (char**)output, output_len, &output_size);
 				}
 				if (stderr_pipe[R] > 0) {
-					nbytes = read(stderr_pipe[R], *err + *err_len, err_size - *err_len);
-					if (nbytes > 0) {
-						*err_len += nbytes;
-					}
-				}
-				if (info_pipe[R] > 0) {
-					nbytes = read(info_pipe[R], info + info_len, info_size - info_len);
-					if (nbytes > 0) {
-						info_len += nbytes;
-					}
+					Read_Pipe(stderr_pipe[R], (char**)err, err_len, &err_size);
 				}
 
 				break;
@@ -1174,7 +1254,7 @@ child_error:
 					valid_nfds --;
 				} else if (pfds[i].revents & POLLOUT) {
 					//printf("POLLOUT: %d [%d/%d]\n", pfds[i].fd, i, nfds);
-					nbytes = write(pfds[i].fd, input, input_size - input_len);
+					nbytes = write(pfds[i].fd, (char*)input + input_len, input_size - input_len);
 					if (nbytes <= 0) {
 						ret = errno;
 						goto kill;
@@ -1190,44 +1270,27 @@ child_error:
 					//printf("POLLIN: %d [%d/%d]\n", pfds[i].fd, i, nfds);
 					char **buffer = NULL;
 					u32 *offset;
-					size_t to_read = 0;
 					size_t *size = NULL;
 					if (pfds[i].fd == stdout_pipe[R]) {
 						buffer = (char**)output;
 						offset = output_len;
 						size = &output_size;
-					} else if (pfds[i].fd == stderr_pipe[R]) {
+					} else {
 						buffer = (char**)err;
 						offset = err_len;
 						size = &err_size;
-					} else { /* info pipe */
-						buffer = &info;
-						offset = &info_len;
-						size = &info_size;
 					}
-					do {
-						to_read = *size - *offset;
-						//printf("to read %d bytes\n", to_read);
-						nbytes = read(pfds[i].fd, *buffer + *offset, to_read);
-						if (nbytes < 0) {
-							break;
-						}
-						if (nbytes == 0) {
-							/* closed */
-							//printf("the other end closed\n");
-							close(pfds[i].fd);
-							pfds[i].fd = -1;
-							valid_nfds --;
-							break;
-						}
-						//printf("POLLIN: %d bytes\n", nbytes);
-						*offset += nbytes;
-						if (*offset >= *size) {
-							*size += BUF_SIZE_CHUNK;
-							*buffer = realloc(*buffer, *size * sizeof((*buffer)[0]));
-							if (*buffer == NULL) goto kill;
-						}
-					} while (nbytes == to_read);
+					nbytes = Read_Pipe(pfds[i].fd, buffer, offset, size);
+					if (nbytes == 0) {
+						/* closed */
+						//printf("the other end closed\n");
+						close(pfds[i].fd);
+						pfds[i].fd = -1;
+						valid_nfds --;
+					} else if (nbytes < 0 && errno != EAGAIN) {
+						ret = errno;
+						goto kill;
+					}
 				} else if (pfds[i].revents & POLLHUP) {
 					//printf("POLLHUP: %d [%d/%d]\n", pfds[i].fd, i, nfds);
 					close(pfds[i].fd);
@@ -1249,16 +1312,11 @@ child_error:
 		}
 
 	} else {
-		/* error */
-		ret = errno;
+		/* error (or exec failed), ret is the errno */
 		goto error;
 	}
 
-	if (info_len > 0) {
-		/* exec in child process failed */
-		/* set to errno for reporting */
-		ret = *(int*)info;
-	} else if (WIFEXITED(status)) {
+	if (WIFEXITED(status)) {
 		if (exit_code != NULL) *exit_code = WEXITSTATUS(status);
 		if (pid != NULL) *pid = fpid;
 	} else {
@@ -1278,16 +1336,6 @@ cleanup:
 	if (err != NULL && *err != NULL && *err_len <= 0) {
 		OS_Free(*err);
 	}
-	if (info != NULL) {
-		OS_Free(info);
-	}
-	if (info_pipe[R] > 0) {
-		close(info_pipe[R]);
-	}
-	if (info_pipe[W] > 0) {
-		close(info_pipe[W]);
-	}
-info_pipe_err:
 	if (stderr_pipe[R] > 0) {
 		close(stderr_pipe[R]);
 	}
@@ -0,0 +1,235 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Title: Background file IO using the Linux io_uring interface
+**  Purpose:
+**      Lets a device hand a read or write to the kernel and return
+**      DR_PEND, so other devices keep running while a slow disk
+**      does the work. The completion eventfd is waited on with the
+**      other handles in Query_Events (dev-event.c).
+**
+**      Direct system calls are used (no liburing needed). If the
+**      kernel does not have io_uring (or it is not allowed), then
+**      Uring_Submit returns FALSE and the device does the IO itself.
+**
+************************************************************************
+**
+**  NOTE to PROGRAMMERS:
+**
+**    1. Keep code clear and simple.
+**    2. Document unusual code, reasoning, or gotchas.
+**    3. Use same style for code, vars, indent(4), comments, etc.
+**    4. Keep in mind Linux, OS X, BSD, big/little endian CPUs.
+**    5. Test everything, then test it again.
+**
+***********************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#include <linux/io_uring.h>
+
+#include "reb-host.h"
+#include "host-lib.h"
+
+#define URING_SIZE 64	// max requests in flight
+
+int Watch_Handle(int fd, void (*ready)(void));
+
+static struct {
+	int state;			// 0: not yet tried, 1: ready, -1: not available
+	int fd;				// the ring
+	int event;			// eventfd signalled on completion
+	int busy;			// requests in flight
+	unsigned *sq_tail;
+	unsigned *sq_mask;
+	unsigned *sq_array;
+	unsigned *cq_head;
+	unsigned *cq_tail;
+	unsigned *cq_mask;
+	struct io_uring_sqe *sqes;
+	struct io_uring_cqe *cqes;
+} Ring;
+
+
+/***********************************************************************
+**
+*/	static void Reap_Ring(void)
+/*
+**		Called when the eventfd is ready. Take the results of the
+**		completed requests and release them for polling. The
+**		device finishes each one when it sees RRF_DONE.
+**
+***********************************************************************/
+{
+	struct io_uring_cqe *cqe;
+	REBREQ *req;
+	u64 count;
+	unsigned head;
+
+	if (read(Ring.event, &count, sizeof(count)) < 0) {} // reset it
+
+	head = *Ring.cq_head;
+	while (head != __atomic_load_n(Ring.cq_tail, __ATOMIC_ACQUIRE)) {
+		cqe = &Ring.cqes[head & *Ring.cq_mask];
+		req = (REBREQ*)(REBUPT)cqe->user_data;
+		if (cqe->res < 0) {
+			req->error = -cqe->res; // errno (device converts it)
+			req->actual = 0;
+		}
+		else {
+			req->error = 0;
+			req->actual = cqe->res;
+		}
+		SET_FLAG(req->flags, RRF_DONE);
+		CLR_FLAG(req->flags, RRF_WATCH);
+		Ring.busy--;
+		head++;
+	}
+	__atomic_store_n(Ring.cq_head, head, __ATOMIC_RELEASE);
+}
+
+
+/***********************************************************************
+**
+*/	static int Init_Ring(void)
+/*
+**		Setup the ring on first use. Returns FALSE if not possible.
+**		Reads and writes at the current file position need kernel
+**		5.6 or later (IORING_FEAT_RW_CUR_POS).
+**
+***********************************************************************/
+{
+	struct io_uring_params p;
+	size_t sq_size, cq_size;
+	REBYTE *sq = MAP_FAILED;
+	REBYTE *cq = MAP_FAILED;
+	void *sqes = MAP_FAILED;
+	int fd;
+
+	Ring.state = -1;
+
+	CLEARS(&p);
+	fd = syscall(__NR_io_uring_setup, URING_SIZE, &p);
+	if (fd < 0) return FALSE;
+	if (!(p.features & IORING_FEAT_RW_CUR_POS)) goto fail;
+
+	sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+	cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	if (p.features & IORING_FEAT_SINGLE_MMAP) {
+		if (cq_size > sq_size) sq_size = cq_size;
+		cq_size = sq_size;
+	}
+
+	sq = mmap(0, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+	if (sq == MAP_FAILED) goto fail;
+	if (p.features & IORING_FEAT_SINGLE_MMAP) cq = sq;
+	else {
+		cq = mmap(0, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+		if (cq == MAP_FAILED) goto fail;
+	}
+	sqes = mmap(0, p.sq_entries * sizeof(struct io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+	if (sqes == MAP_FAILED) goto fail;
+
+	Ring.sq_tail  = (unsigned *)(sq + p.sq_off.tail);
+	Ring.sq_mask  = (unsigned *)(sq + p.sq_off.ring_mask);
+	Ring.sq_array = (unsigned *)(sq + p.sq_off.array);
+	Ring.cq_head  = (unsigned *)(cq + p.cq_off.head);
+	Ring.cq_tail  = (unsigned *)(cq + p.cq_off.tail);
+	Ring.cq_mask  = (unsigned *)(cq + p.cq_off.ring_mask);
+	Ring.cqes     = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+	Ring.sqes     = sqes;
+
+	// Completions signal the eventfd, which wakes Query_Events:
+	Ring.event = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (Ring.event < 0) goto fail;
+	if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_EVENTFD, &Ring.event, 1) < 0
+		|| !Watch_Handle(Ring.event, Reap_Ring)) {
+		close(Ring.event);
+		goto fail;
+	}
+
+	Ring.fd = fd;
+	Ring.state = 1;
+	return TRUE;
+
+fail:
+	if (sqes != MAP_FAILED) munmap(sqes, p.sq_entries * sizeof(struct io_uring_sqe));
+	if (cq != MAP_FAILED && cq != sq) munmap(cq, cq_size);
+	if (sq != MAP_FAILED) munmap(sq, sq_size);
+	close(fd);
+	return FALSE;
+}
+
+
+/***********************************************************************
+**
+*/	int Uring_Submit(REBREQ *req, int write)
+/*
+**		Start a read (or write) of req->length bytes of req->data
+**		at the current position of the req->id file.
+**
+**		Returns TRUE if the request was started. It is then watched
+**		(RRF_WATCH) until done, and RRF_DONE is set with the actual
+**		length or the errno in req->error.
+**
+**		Returns FALSE if the caller must do it the normal way.
+**
+***********************************************************************/
+{
+	struct io_uring_sqe *sqe;
+	unsigned tail;
+	unsigned index;
+
+	if (Ring.state == 0) Init_Ring();
+	if (Ring.state < 0 || Ring.busy >= URING_SIZE) return FALSE;
+
+	tail = *Ring.sq_tail;
+	index = tail & *Ring.sq_mask;
+	sqe = &Ring.sqes[index];
+
+	CLEARS(sqe);
+	sqe->opcode = write ? IORING_OP_WRITE : IORING_OP_READ;
+	sqe->fd = req->id;
+	sqe->addr = (REBUPT)req->data;
+	sqe->len = req->length;
+	sqe->off = (u64)-1; // use (and update) the file position
+	sqe->user_data = (REBUPT)req;
+
+	Ring.sq_array[index] = index;
+	__atomic_store_n(Ring.sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+	// If the kernel did not take it, it never will (no SQPOLL),
+	// so stop using the ring and let the caller do the IO:
+	if (syscall(__NR_io_uring_enter, Ring.fd, 1, 0, 0, 0, 0) < 1) {
+		Ring.state = -1;
+		return FALSE;
+	}
+
+	Ring.busy++;
+	CLR_FLAG(req->flags, RRF_DONE);
+	SET_FLAG(req->flags, RRF_WATCH);
+	return TRUE;
+}
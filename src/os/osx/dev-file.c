@@ -113,6 +113,27 @@ static REBOOL Seek_File_64(REBREQ *file)
 	return 1;
 }
 
+static int Write_Rest(REBREQ *file)
+{
+	// Write the data from file->actual to the end. A write can do
+	// less than asked (e.g. when interrupted by a signal), so loop
+	// until it is all written or there is an error.
+	ssize_t bytes;
+
+	while (file->actual < file->length) {
+		bytes = write(file->id, file->data + file->actual, file->length - file->actual);
+		if (bytes < 0 && errno == EINTR) continue;
+		if (bytes <= 0) {
+			if (bytes < 0 && errno == ENOSPC) file->error = -RFE_DISK_FULL;
+			else file->error = -RFE_BAD_WRITE;
+			return DR_ERROR;
+		}
+		file->actual += bytes;
+	}
+
+	return DR_DONE;
+}
+
 static int Get_File_Info(REBREQ *file)
 {
 	struct stat info;
@@ -236,6 +257,21 @@ static int Get_File_Info(REBREQ *file)
 	// Line below DOES NOT WORK -- because we need full path.
 	//Get_File_Info(file); // updates modes, size, time
 
+	// For READ/DEEP, also get the size and date. The stat is done
+	// relative to the open dir, so the full path is not needed (and
+	// not looked up again). Links are not followed, so a link to a
+	// dir is returned as a file and the walk cannot loop.
+	if (GET_FLAG(dir->modes, RFM_DEEP)) {
+		file->file.size = 0;
+		file->file.time.l = 0;
+		if (!fstatat(dirfd(h), cp, &info, AT_SYMLINK_NOFOLLOW)) {
+			CLR_FLAG(file->modes, RFM_DIR);
+			if (S_ISDIR(info.st_mode)) SET_FLAG(file->modes, RFM_DIR);
+			else file->file.size = info.st_size;
+			file->file.time.l = (long)(info.st_mtime);
+		}
+	}
+
 	return DR_DONE;
 }
 
@@ -398,13 +434,38 @@ fail:
 
 	if (file->length == 0) return DR_DONE;
 
-	file->actual = write(file->id, file->data, file->length);
-	if (file->actual < 0) {
-		if (errno == ENOSPC) file->error = -RFE_DISK_FULL;
-		else file->error = -RFE_BAD_WRITE;
+	file->actual = 0;
+	return Write_Rest(file);
+}
+
+
+/***********************************************************************
+**
+*/	DEVICE_CMD Modify_File(REBREQ *file)
+/*
+**		Apply the modes set by MODIFY to an open file:
+**			RFM_SEQUENTIAL - tell the OS the file is used in order
+**			RFM_SYNC - write the data to the disk now (then cleared)
+**
+***********************************************************************/
+{
+	if (!file->id) {
+		file->error = -RFE_NO_HANDLE;
 		return DR_ERROR;
 	}
 
+#ifdef POSIX_FADV_SEQUENTIAL
+	posix_fadvise(file->id, 0, 0, GET_FLAG(file->modes, RFM_SEQUENTIAL) ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_NORMAL);
+#endif
+
+	if (GET_FLAG(file->modes, RFM_SYNC)) {
+		CLR_FLAG(file->modes, RFM_SYNC);
+		if (fsync(file->id) < 0) {
+			file->error = -RFE_BAD_WRITE;
+			return DR_ERROR;
+		}
+	}
+
 	return DR_DONE;
 }
 
@@ -504,7 +565,7 @@ static DEVICE_CMD_FUNC Dev_Cmds[RDC_MAX] = {
 	Poll_File,
 	0,	// connect
 	Query_File,
-	0,	// modify
+	Modify_File,
 	Create_File,
 	Delete_File,
 	Rename_File,
@@ -57,11 +57,13 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <sys/wait.h>
 #include <time.h>
 #include <string.h>
 #include <errno.h>
+#include <pthread.h>
 
 #ifndef timeval // for older systems
 #include <sys/time.h>
@@ -81,6 +83,8 @@ REBSER* Gob_To_Image(REBGOB *gob);
 // Semaphore lock to sync sub-task launch:
 static void *Task_Ready;
 
+#define MAX_PAR_THREADS 64	// for OS_Run_Parallel
+
 #ifndef PATH_MAX
 #define PATH_MAX 4096  // generally lacking in Posix
 #endif
@@ -740,6 +744,44 @@ error:
 	}
 }
 
+/***********************************************************************
+**
+*/	void *OS_Map_File(REBREQ *file, i64 index, REBCNT length)
+/*
+**		Map part of an open file into memory (copy-on-write), so it can
+**		be used without reading it. Returns the address of the data
+**		at index, or zero if it cannot be mapped.
+**
+**		Release it with OS_Unmap_File. The file can be closed first.
+**
+***********************************************************************/
+{
+	long page = sysconf(_SC_PAGESIZE);
+	long skip = (long)(index % page); // map must start on a page
+	REBYTE *mem;
+
+	if (!file->id || !length) return 0;
+
+	mem = mmap(0, length + skip, PROT_READ | PROT_WRITE, MAP_PRIVATE, file->id, index - skip);
+	if (mem == MAP_FAILED) return 0;
+	return mem + skip;
+}
+
+
+/***********************************************************************
+**
+*/	void OS_Unmap_File(void *data, REBCNT length)
+/*
+**		Release memory mapped by OS_Map_File.
+**
+***********************************************************************/
+{
+	long skip = (long)((REBUPT)data % sysconf(_SC_PAGESIZE));
+
+	munmap((REBYTE *)data - skip, length + skip);
+}
+
+
 
 /***********************************************************************
 **
@@ -847,6 +889,83 @@ error:
 	//SetEvent(Task_Ready);
 }
 
+
+/***********************************************************************
+**
+*/	REBINT OS_Get_CPUs(void)
+/*
+**		Return the number of processors that are online.
+**
+***********************************************************************/
+{
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return (n > 0) ? (REBINT)n : 1;
+}
+
+
+typedef struct {
+	CFUNC job;
+	REBYTE *jobs;
+	REBCNT size;
+	REBCNT count;
+	REBCNT next;
+	pthread_mutex_t lock;
+} PAR_JOBS;
+
+static void *Run_Jobs(void *arg)
+{
+	PAR_JOBS *par = (PAR_JOBS*)arg;
+	REBCNT n;
+
+	for (;;) {
+		pthread_mutex_lock(&par->lock);
+		n = par->next++;
+		pthread_mutex_unlock(&par->lock);
+		if (n >= par->count) break;
+		par->job(par->jobs + n * par->size);
+	}
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	REBINT OS_Run_Parallel(CFUNC job, void *jobs, REBCNT size, REBCNT count, REBCNT threads)
+/*
+**		Call job for each of count structs (of size bytes) in the
+**		jobs array, on up to threads threads (the calling thread is
+**		one of them). Returns when all jobs are done, with the
+**		number of threads used.
+**
+**		Jobs must not call into REBOL: it is not thread safe.
+**		If a thread cannot be started, the others do its share.
+**
+***********************************************************************/
+{
+	pthread_t tids[MAX_PAR_THREADS];
+	PAR_JOBS par;
+	REBCNT n;
+
+	par.job = job;
+	par.jobs = (REBYTE*)jobs;
+	par.size = size;
+	par.count = count;
+	par.next = 0;
+	pthread_mutex_init(&par.lock, 0);
+
+	threads = MIN(MIN(threads, count), MAX_PAR_THREADS);
+	for (n = 1; n < threads; n++) {
+		if (pthread_create(&tids[n], 0, Run_Jobs, &par)) break;
+	}
+	threads = n;
+
+	Run_Jobs(&par);
+	for (n = 1; n < threads; n++) pthread_join(tids[n], 0);
+
+	pthread_mutex_destroy(&par.lock);
+	return threads;
+}
+
 static inline REBOOL Open_Pipe_Fails(int pipefd[2]) {
 #ifdef USE_PIPE2_NOT_PIPE
     //
@@ -236,6 +236,21 @@ static int Get_File_Info(REBREQ *file)
 	// Line below DOES NOT WORK -- because we need full path.
 	//Get_File_Info(file); // updates modes, size, time
 
+	// For READ/DEEP, also get the size and date. The stat is done
+	// relative to the open dir, so the full path is not needed (and
+	// not looked up again). Links are not followed, so a link to a
+	// dir is returned as a file and the walk cannot loop.
+	if (GET_FLAG(dir->modes, RFM_DEEP)) {
+		file->file.size = 0;
+		file->file.time.l = 0;
+		if (!fstatat(dirfd(h), cp, &info, AT_SYMLINK_NOFOLLOW)) {
+			CLR_FLAG(file->modes, RFM_DIR);
+			if (S_ISDIR(info.st_mode)) SET_FLAG(file->modes, RFM_DIR);
+			else file->file.size = info.st_size;
+			file->file.time.l = (long)(info.st_mtime);
+		}
+	}
+
 	return DR_DONE;
 }
 
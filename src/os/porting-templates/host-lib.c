@@ -485,6 +485,32 @@ static void *Task_Ready;
 	Convert_Date((time_t *)&(file->file.time.l), dat, 0);
 }
 
+/***********************************************************************
+**
+*/	void *OS_Map_File(REBREQ *file, i64 index, REBCNT length)
+/*
+**		Map part of an open file into memory (copy-on-write), so it can
+**		be used without reading it. Returns the address of the data
+**		at index, or zero if it cannot be mapped (the file is then
+**		read as usual).
+**
+***********************************************************************/
+{
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	void OS_Unmap_File(void *data, REBCNT length)
+/*
+**		Release memory mapped by OS_Map_File.
+**
+***********************************************************************/
+{
+}
+
+
 
 /***********************************************************************
 **
@@ -591,6 +617,38 @@ static void *Task_Ready;
 }
 
 
+/***********************************************************************
+**
+*/	REBINT OS_Get_CPUs(void)
+/*
+**		Return the number of processors that are online.
+**
+***********************************************************************/
+{
+	return 1;
+}
+
+
+/***********************************************************************
+**
+*/	REBINT OS_Run_Parallel(CFUNC job, void *jobs, REBCNT size, REBCNT count, REBCNT threads)
+/*
+**		Call job for each of count structs (of size bytes) in the
+**		jobs array, on up to threads threads. Returns when all jobs
+**		are done, with the number of threads used.
+**
+**		Jobs must not call into REBOL: it is not thread safe.
+**		This template runs them all on the calling thread.
+**
+***********************************************************************/
+{
+	REBCNT n;
+
+	for (n = 0; n < count; n++) job((REBYTE*)jobs + n * size);
+	return 1;
+}
+
+
 /***********************************************************************
 **
 */	int OS_Create_Process(REBCHR *call, u32 flags)
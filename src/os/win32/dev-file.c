@@ -170,6 +170,13 @@ static BOOL Seek_File_64(REBREQ *file)
 	if (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) SET_FLAG(file->modes, RFM_DIR);
 	COPY_STR(file->file.path, info.cFileName, MAX_FILE_NAME);
 	file->file.size = ((i64)info.nFileSizeHigh << 32) + info.nFileSizeLow;
+	file->file.time.l = info.ftLastWriteTime.dwLowDateTime;
+	file->file.time.h = info.ftLastWriteTime.dwHighDateTime;
+
+	// For READ/DEEP, a junction or dir link is returned as a file,
+	// so the walk does not follow it (and cannot loop):
+	if (GET_FLAG(dir->modes, RFM_DEEP) && (info.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+		CLR_FLAG(file->modes, RFM_DIR);
 
 	return DR_DONE;
 }
@@ -358,6 +365,35 @@ fail:
 }
 
 
+/***********************************************************************
+**
+*/	DEVICE_CMD Modify_File(REBREQ *file)
+/*
+**		Apply the modes set by MODIFY to an open file:
+**			RFM_SYNC - write the data to the disk now (then cleared)
+**
+**		RFM_SEQUENTIAL is a hint given when a file is opened on
+**		Windows (FILE_FLAG_SEQUENTIAL_SCAN), so it is not used here.
+**
+***********************************************************************/
+{
+	if (!file->handle) {
+		file->error = -RFE_NO_HANDLE;
+		return DR_ERROR;
+	}
+
+	if (GET_FLAG(file->modes, RFM_SYNC)) {
+		CLR_FLAG(file->modes, RFM_SYNC);
+		if (!FlushFileBuffers(file->handle)) {
+			file->error = -RFE_BAD_WRITE;
+			return DR_ERROR;
+		}
+	}
+
+	return DR_DONE;
+}
+
+
 /***********************************************************************
 **
 */	DEVICE_CMD Query_File(REBREQ *file)
@@ -463,7 +499,7 @@ static DEVICE_CMD_FUNC Dev_Cmds[RDC_MAX] = {
 	Poll_File,
 	0,	// connect
 	Query_File,
-	0,	// modify
+	Modify_File,
 	Create_File,
 	Delete_File,
 	Rename_File,
@@ -75,6 +75,8 @@ BOOL osDialogOpen = FALSE;
 // Semaphore lock to sync sub-task launch:
 static void *Task_Ready;
 
+#define MAX_PAR_THREADS 64	// for OS_Run_Parallel
+
 
 /***********************************************************************
 **
@@ -629,6 +631,52 @@ static void *Task_Ready;
 	Convert_Date(&stime, dat, -tzone.Bias);
 }
 
+/***********************************************************************
+**
+*/	void *OS_Map_File(REBREQ *file, i64 index, REBCNT length)
+/*
+**		Map part of an open file into memory (copy-on-write), so it can
+**		be used without reading it. Returns the address of the data
+**		at index, or zero if it cannot be mapped.
+**
+**		Release it with OS_Unmap_File. The file can be closed first.
+**
+***********************************************************************/
+{
+	SYSTEM_INFO info;
+	HANDLE map;
+	REBYTE *mem;
+	i64 base;
+
+	if (!file->handle || !length) return 0;
+
+	GetSystemInfo(&info);
+	base = index - (index % info.dwAllocationGranularity); // where a view can start
+
+	map = CreateFileMapping((HANDLE)file->handle, 0, PAGE_WRITECOPY, 0, 0, 0);
+	if (!map) return 0;
+	mem = MapViewOfFile(map, FILE_MAP_COPY, (DWORD)(base >> 32), (DWORD)base, (SIZE_T)(index - base) + length);
+	CloseHandle(map); // (the view keeps the mapping)
+	if (!mem) return 0;
+	return mem + (index - base);
+}
+
+
+/***********************************************************************
+**
+*/	void OS_Unmap_File(void *data, REBCNT length)
+/*
+**		Release memory mapped by OS_Map_File.
+**
+***********************************************************************/
+{
+	SYSTEM_INFO info;
+
+	GetSystemInfo(&info);
+	UnmapViewOfFile((REBYTE *)data - ((REBUPT)data % info.dwAllocationGranularity));
+}
+
+
 
 /***********************************************************************
 **
@@ -726,6 +774,78 @@ static void *Task_Ready;
 	SetEvent(Task_Ready);
 }
 
+
+/***********************************************************************
+**
+*/	REBINT OS_Get_CPUs(void)
+/*
+**		Return the number of processors that are online.
+**
+***********************************************************************/
+{
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (info.dwNumberOfProcessors > 0) ? (REBINT)info.dwNumberOfProcessors : 1;
+}
+
+
+typedef struct {
+	CFUNC job;
+	REBYTE *jobs;
+	REBCNT size;
+	LONG count;
+	volatile LONG next;
+} PAR_JOBS;
+
+static unsigned __stdcall Run_Jobs(void *arg)
+{
+	PAR_JOBS *par = (PAR_JOBS*)arg;
+	LONG n;
+
+	while ((n = InterlockedIncrement(&par->next) - 1) < par->count)
+		par->job(par->jobs + n * par->size);
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	REBINT OS_Run_Parallel(CFUNC job, void *jobs, REBCNT size, REBCNT count, REBCNT threads)
+/*
+**		Call job for each of count structs (of size bytes) in the
+**		jobs array, on up to threads threads (the calling thread is
+**		one of them). Returns when all jobs are done, with the
+**		number of threads used.
+**
+**		Jobs must not call into REBOL: it is not thread safe.
+**		If a thread cannot be started, the others do its share.
+**
+***********************************************************************/
+{
+	HANDLE handles[MAX_PAR_THREADS];
+	PAR_JOBS par;
+	REBCNT n;
+
+	par.job = job;
+	par.jobs = (REBYTE*)jobs;
+	par.size = size;
+	par.count = count;
+	par.next = 0;
+
+	threads = MIN(MIN(threads, count), MAX_PAR_THREADS);
+	for (n = 0; n + 1 < threads; n++) {
+		handles[n] = (HANDLE)_beginthreadex(0, 0, Run_Jobs, &par, 0, 0);
+		if (!handles[n]) break;
+	}
+	threads = n + 1;
+
+	Run_Jobs(&par);
+	if (n > 0) WaitForMultipleObjects(n, handles, TRUE, INFINITE);
+	while (n > 0) CloseHandle(handles[--n]);
+
+	return threads;
+}
+
 /***********************************************************************
 **
 */	int OS_Create_Process(REBCHR *call, int argc, char* argv[], u32 flags, u64 *pid, int *exit_code, u32 input_type, void *input, u32 input_len, u32 output_type, void **output, u32 *output_len, u32 err_type, void **err, u32 *err_len)
@@ -36,6 +36,7 @@ core: [
 	f-dtoa.c
 	f-enbase.c
 	f-extension.c
+	f-fpconv.c
 	f-math.c
 	f-modify.c
 	f-qsort.c
@@ -56,13 +57,19 @@ core: [
 	n-sets.c
 	n-strings.c
 	n-system.c
+	p-checksum.c
 	p-clipboard.c
+	p-compress.c
 	p-console.c
+	p-csv.c
 	p-dir.c
 	p-dns.c
+	p-enbase.c
 	p-event.c
 	p-file.c
+	p-json.c
 	p-net.c
+	p-rope.c
 	p-serial.c
 	s-cases.c
 	s-crc.c
@@ -100,13 +107,16 @@ core: [
 	t-word.c
 	u-bmp.c
 	u-compress.c
+	u-csv.c
 	u-dialect.c
 	u-gif.c
 	u-jpg.c
+	u-json.c
 	u-md5.c
 	u-parse.c
 	u-png.c
 	u-sha1.c
+	u-sha2.c
 	u-zlib.c
 ]
 